@@ -596,7 +596,7 @@ void Console::AddLogToVisual( const LogElement& logElement,
     }
 }
 
-void Console::AddLogLevelToVector( std::vector<VertexMaster>& textVisual,
+void Console::AddLogLevelToVector( std::vector<Vertex_PCU>& textVisual,
                                    const AABB2& overlayBounds,
                                    const Vec2& alignment,
                                    float lineHeight ) const
@@ -617,7 +617,7 @@ void Console::AddLogLevelToVector( std::vector<VertexMaster>& textVisual,
     }
 }
 
-void Console::AddCommandToVector( std::vector<VertexMaster>& textVisual, const Vec2& bottomLeft,
+void Console::AddCommandToVector( std::vector<Vertex_PCU>& textVisual, const Vec2& bottomLeft,
                                   float lineHeight ) const
 {
     m_ConsoleFont->AddVertsForText( textVisual, m_CurrentCommand, bottomLeft, lineHeight,
@@ -630,7 +630,7 @@ void Console::RenderOverlayAndText( RenderContext& renderer,
     renderer.BindShader( m_ConsoleShader );
 
     // Add overlay
-    std::vector<VertexMaster> background;
+    std::vector<Vertex_PCU> background;
     AppendAABB2( background, overlayBounds, Rgba8::DARK_GRAY_75 );
 
     // Add console entry location
@@ -659,7 +659,7 @@ void Console::RenderOverlayAndText( RenderContext& renderer,
     renderer.DrawVertexArray( background );
 
     // Draw the text on screen
-    std::vector<VertexMaster> nonLogText;
+    std::vector<Vertex_PCU> nonLogText;
     AddCommandToVector( nonLogText, overlayBounds.mins, m_ConsoleLineHeight );
     AddLogLevelToVector( nonLogText, overlayBounds, Vec2::ALIGN_BOTTOM_RIGHT, m_ConsoleLineHeight );
 
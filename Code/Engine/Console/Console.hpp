@@ -10,7 +10,7 @@
 
 #include "Command.hpp"
 
-struct VertexMaster;
+struct Vertex_PCU;
 struct AABB2;
 class BitmapFont;
 class Camera;
@@ -124,7 +124,7 @@ private:
 
     Vec2 m_Padding = Vec2( 5.f, 5.f );
     std::vector<LogElement> m_Logs;
-    std::vector<VertexMaster> m_LogVisual;
+    std::vector<Vertex_PCU> m_LogVisual;
     size_t m_TotalLinesLogged = 0u;
     float m_CurrentVerticalOffset = 0.f;
 
@@ -140,12 +140,12 @@ private:
     void AddLogToVisual( const LogElement& logElement,
                          const Vec2& textPosition);
 
-    void AddLogLevelToVector( std::vector<VertexMaster>& textVisual,
+    void AddLogLevelToVector( std::vector<Vertex_PCU>& textVisual,
                               const AABB2& overlayBounds,
                               const Vec2& alignment,
                               float lineHeight ) const;
 
-    void AddCommandToVector( std::vector<VertexMaster>& textVisual,
+    void AddCommandToVector( std::vector<Vertex_PCU>& textVisual,
                              const Vec2 & bottomLeft,
                              float lineHeight ) const;
 
@@ -2,8 +2,11 @@
 
 #include "Engine/Console/Console.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Utils/PixelUtils.hpp"
 #include "ThirdParty/stb/stb_image.h"
 
+#include <cstring>
+
 Image::Image( const char* filePath )
     : m_FilePath( filePath )
 {
@@ -14,14 +17,29 @@ Image::Image( const std::string& filePath )
 {
 }
 
+Image::Image( const IntVec2& dimensions, const Rgba8& fillColor )
+    : m_Dimension( dimensions )
+      , m_Texels( static_cast<size_t>( dimensions.x ) * dimensions.y, fillColor )
+{
+}
+
 Image::Image( const Image& copy, int orthogonalRotation, bool mirrored )
     : m_FilePath( copy.m_FilePath )
 {
-    m_Texels.reserve( copy.m_Texels.size() );
-
     // Get the dimensions of the rotated version
     int rotation = static_cast<int>(GetAngleZeroTo360( static_cast<float>(orthogonalRotation) ));
-    if ( orthogonalRotation == 0 || orthogonalRotation == 180 )
+    if ( rotation != 0 && rotation != 90 && rotation != 180 && rotation != 270 )
+    {
+    #if !defined(ENGINE_DISABLE_CONSOLE)
+        g_Console->LogWTF( Stringf( "Image: ERROR Orientation %d is not orthogonal", orthogonalRotation ) );
+    #endif // !defined(ENGINE_DISABLE_CONSOLE)
+    #if defined(ENGINE_DISABLE_CONSOLE)
+        ERROR_AND_DIE( Stringf( "Image: ERROR Orientation %d is not orthoganal", orthogonalRotation ) );
+    #endif // defined(ENGINE_DISABLE_CONSOLE)
+        return;
+    }
+
+    if ( rotation == 0 || rotation == 180 )
     {
         m_Dimension = copy.m_Dimension;
     }
@@ -30,168 +48,143 @@ Image::Image( const Image& copy, int orthogonalRotation, bool mirrored )
         m_Dimension = IntVec2( copy.m_Dimension.y, copy.m_Dimension.x );
     }
 
-    // Copy data based on the 8 possible orientations and mirrored directions
-    if ( !mirrored )
-    {
-        switch ( rotation )
-        {
-            case 0:
-                m_Texels = copy.m_Texels;
-                break;
-            case 90:
-                for ( int y = 0; y < m_Dimension.y; ++y )
-                {
-                    for ( int x = m_Dimension.x - 1; x >= 0; --x )
-                    {
-                        int vectorPosition = x * m_Dimension.y + y;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            case 180:
-                for ( int y = copy.m_Dimension.y - 1; y >= 0; --y )
-                {
-                    for ( int x = copy.m_Dimension.x - 1; x >= 0; --x )
-                    {
-                        int vectorPosition = y * copy.m_Dimension.x + x;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            case 270:
-                for ( int y = m_Dimension.y - 1; y >= 0; --y )
-                {
-                    for ( int x = 0; x < m_Dimension.x; ++x )
-                    {
-                        int vectorPosition = x * m_Dimension.y + y;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            default:
-            #if !defined(ENGINE_DISABLE_CONSOLE)
-                g_Console->LogWTF( Stringf( "Image: ERROR Orientation %d is not orthogonal", orthogonalRotation ) );
-            #endif // !defined(ENGINE_DISABLE_CONSOLE)
-            #if defined(ENGINE_DISABLE_CONSOLE)
-                ERROR_AND_DIE( Stringf( "Image: ERROR Orientation %d is not orthoganal", orthogonalRotation ) );
-            #endif // defined(ENGINE_DISABLE_CONSOLE)
-                break;
-        }
-    }
-    else
+    if ( rotation == 0 && !mirrored )
     {
-        switch ( rotation )
-        {
-            case 0:
-                for ( int y = 0; y < m_Dimension.y; ++y )
-                {
-                    for ( int x = m_Dimension.x - 1; x >= 0; --x )
-                    {
-                        int vectorPosition = y * m_Dimension.x + x;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            case 90:
-                for ( int y = m_Dimension.y - 1; y >= 0; --y )
-                {
-                    for ( int x = m_Dimension.x - 1; x >= 0; --x )
-                    {
-                        int vectorPosition = x * m_Dimension.y + y;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            case 180:
-                for ( int y = m_Dimension.y - 1; y >= 0; --y )
-                {
-                    for ( int x = 0; x < m_Dimension.x; x++ )
-                    {
-                        int vectorPosition = y * m_Dimension.x + x;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            case 270:
-                for ( int y = 0; y < m_Dimension.y; y++ )
-                {
-                    for ( int x = 0; x < m_Dimension.x; ++x )
-                    {
-                        int vectorPosition = x * m_Dimension.y + y;
-                        m_Texels.push_back( copy.m_Texels.at( vectorPosition ) );
-                    }
-                }
-                break;
-            default:
-            #if !defined(ENGINE_DISABLE_CONSOLE)
-                g_Console->LogWTF( Stringf( "Image: ERROR Orientation %d is not orthogonal", orthogonalRotation ) );
-            #endif // !defined(ENGINE_DISABLE_CONSOLE)
-            #if defined(ENGINE_DISABLE_CONSOLE)
-                ERROR_AND_DIE( Stringf( "Image: ERROR Orientation %d is not orthoganal", orthogonalRotation ) );
-            #endif // defined(ENGINE_DISABLE_CONSOLE)
-                break;
-        }
+        m_Texels = copy.m_Texels;
+        return;
     }
+
+    m_Texels.resize( copy.m_Texels.size() );
+    RotateTexels( copy.m_Texels.data(), copy.m_Dimension, m_Texels.data(), rotation, mirrored );
 }
 
 
 void Image::Create()
 {
-    int texelSizeX = 0;
-    int texelSizeY = 0;
-    int numComponents = 0;
-    int numComponentsRequested = 0;
-
-    stbi_set_flip_vertically_on_load( 1 );
-    unsigned char* imageData = stbi_load( m_FilePath.c_str(),
-                                          &texelSizeX,
-                                          &texelSizeY,
-                                          &numComponents,
-                                          numComponentsRequested );
+    const bool decoded = DecodeFromFile( m_FilePath, true, m_Dimension, m_Texels );
 
     // Ensure that the data was correctly read in
 #if !defined(ENGINE_DISABLE_CONSOLE)
-    g_Console->GuaranteeOrWTF( imageData, Stringf( "Failed too load image \"%s\"", m_FilePath.c_str() ) );
+    g_Console->GuaranteeOrWTF( decoded, Stringf( "Failed too load image \"%s\"", m_FilePath.c_str() ) );
 #endif // !defined(ENGINE_DISABLE_CONSOLE)
 #if defined(ENGINE_DISABLE_CONSOLE)
-    GUARANTEE_OR_DIE( imageData, Stringf( "Failed to load image \"%s\"", m_FilePath.c_str() ) );
+    GUARANTEE_OR_DIE( decoded, Stringf( "Failed to load image \"%s\"", m_FilePath.c_str() ) );
 #endif // defined(ENGINE_DISABLE_CONSOLE)
 
 #if !defined(ENGINE_DISABLE_CONSOLE)
-    g_Console->GuaranteeOrWTF( (numComponents >= 3 && numComponents <= 4 && texelSizeX > 0 && texelSizeY > 0),
-                               Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)",
-                                        m_FilePath.c_str(),
-                                        numComponents,
-                                        texelSizeX,
-                                        texelSizeY ) );
+    g_Console->Log( LOG_VERBOSE, Stringf( "Image: Successfully loaded image \"%s\" (size=%i,%i)",
+                                          m_FilePath.c_str(),
+                                          m_Dimension.x,
+                                          m_Dimension.y ) );
 #endif // !defined(ENGINE_DISABLE_CONSOLE)
-#if defined(ENGINE_DISABLE_CONSOLE)
-    GUARANTEE_OR_DIE( (numComponents >= 3 && numComponents <= 4 && texelSizeX > 0 && texelSizeY > 0),
-                      Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)",
-                               m_FilePath.c_str(),
-                               numComponents,
-                               texelSizeX,
-                               texelSizeY ) );
-#endif // defined(ENGINE_DISABLE_CONSOLE)
+}
 
-    m_Dimension = IntVec2( texelSizeX, texelSizeY );
+STATIC bool Image::DecodeFromFile( const std::string& filePath, const bool flipV,
+                                   OUT_PARAM IntVec2& dimensions, OUT_PARAM std::vector<Rgba8>& texels )
+{
+    const MappedFile imageFile( filePath );
+    if( !imageFile.IsOpen() )
+    {
+        return false;
+    }
+
+    return DecodeFromMemory( imageFile.GetView(), flipV, dimensions, texels );
+}
 
-    if ( numComponents == 3 )
+STATIC bool Image::DecodeFromMemory( const BufferView& encodedImage, const bool flipV,
+                                     OUT_PARAM IntVec2& dimensions, OUT_PARAM std::vector<Rgba8>& texels )
+{
+    if( !GetDimensionsFromMemory( encodedImage, dimensions ) )
     {
-        ProcessRgbData( imageData );
+        return false;
     }
-    else if ( numComponents == 4 )
+
+    texels.resize( static_cast<size_t>( dimensions.x ) * dimensions.y );
+    return DecodeFromMemory( encodedImage, flipV, dimensions, texels.data(), texels.size() );
+}
+
+STATIC bool Image::DecodeFromMemory( const BufferView& encodedImage, const bool flipV,
+                                     OUT_PARAM IntVec2& dimensions, Rgba8* texels, const size_t texelCapacity )
+{
+    int texelSizeX = 0;
+    int texelSizeY = 0;
+    int numComponents = 0;
+
+    // Decoded in the file's own format and expanded to RGBA here, which is faster than stb's per
+    //  texel conversion. stbi_set_flip_vertically_on_load is global to every thread so it is never
+    //  set, the flip happens during the expand instead
+    unsigned char* imageData = stbi_load_from_memory( encodedImage.data,
+                                                      static_cast<int>( encodedImage.size ),
+                                                      &texelSizeX,
+                                                      &texelSizeY,
+                                                      &numComponents,
+                                                      0 );
+    if( imageData == nullptr || texelSizeX <= 0 || texelSizeY <= 0 ||
+        static_cast<size_t>( texelSizeX ) * texelSizeY > texelCapacity )
     {
-        ProcessRgbaData( imageData );
+        stbi_image_free( imageData );
+        return false;
     }
 
-#if !defined(ENGINE_DISABLE_CONSOLE)
-    g_Console->Log( LOG_VERBOSE, Stringf( "Image: Successfully loaded image \"%s\" (Bpp=%i, size=%i,%i)",
-                                          m_FilePath.c_str(),
-                                          numComponents,
-                                          texelSizeX,
-                                          texelSizeY ) );
-#endif // !defined(ENGINE_DISABLE_CONSOLE)
+    dimensions = IntVec2( texelSizeX, texelSizeY );
+
+    const size_t rowSize = static_cast<size_t>( texelSizeX ) * numComponents;
+    for( int rowIndex = 0; rowIndex < texelSizeY; ++rowIndex )
+    {
+        const int sourceRow = flipV ? texelSizeY - 1 - rowIndex : rowIndex;
+        ExpandTexelsToRgba( imageData + sourceRow * rowSize, numComponents,
+                            texels + static_cast<size_t>( rowIndex ) * texelSizeX, texelSizeX );
+    }
+
+    stbi_image_free( imageData );
+    return true;
+}
+
+STATIC bool Image::GetDimensionsFromMemory( const BufferView& encodedImage, OUT_PARAM IntVec2& dimensions )
+{
+    int texelSizeX = 0;
+    int texelSizeY = 0;
+    int numComponents = 0;
+    if( !stbi_info_from_memory( encodedImage.data, static_cast<int>( encodedImage.size ),
+                                &texelSizeX, &texelSizeY, &numComponents ) ||
+        texelSizeX <= 0 || texelSizeY <= 0 )
+    {
+        return false;
+    }
+
+    dimensions = IntVec2( texelSizeX, texelSizeY );
+    return true;
+}
+
+Image Image::CreateDownsampled() const
+{
+    Image downsampled( GetDownsampledDimensions( m_Dimension ), Rgba8::WHITE );
+    downsampled.m_FilePath = m_FilePath;
+    DownsampleTexels( m_Texels.data(), m_Dimension, downsampled.m_Texels.data() );
+    return downsampled;
+}
+
+void Image::CreateMipChain( OUT_PARAM std::vector<Image>& mips ) const
+{
+    mips.clear();
+
+    int mipCount = 0;
+    for( IntVec2 dimensions = m_Dimension; dimensions.x > 1 || dimensions.y > 1; ++mipCount )
+    {
+        dimensions = GetDownsampledDimensions( dimensions );
+    }
+
+    // Reserved so each level can be built straight from the one before it
+    mips.reserve( mipCount );
+    const Image* previous = this;
+    for( int mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        mips.emplace_back( GetDownsampledDimensions( previous->m_Dimension ), Rgba8::WHITE );
+        Image& mip = mips.back();
+        mip.m_FilePath = m_FilePath;
+        DownsampleTexels( previous->m_Texels.data(), previous->m_Dimension, mip.m_Texels.data() );
+        previous = &mip;
+    }
 }
 
 void Image::Destroy()
@@ -218,6 +211,11 @@ void Image::SetTexelColor( const IntVec2& texelCoords, const Rgba8& color )
     m_Texels[ GetTexelIndexFromCoords( texelCoords ) ] = color;
 }
 
+void Image::PremultiplyAlpha()
+{
+    ::PremultiplyAlpha( m_Texels.data(), m_Texels.size() );
+}
+
 int Image::GetTexelIndexFromCoords( int texelX, int texelY ) const
 {
     return texelY * m_Dimension.x + texelX;
@@ -227,33 +225,3 @@ int Image::GetTexelIndexFromCoords( const IntVec2& texelCoords ) const
 {
     return texelCoords.y * m_Dimension.x + texelCoords.x;
 }
-
-void Image::ProcessRgbData( const unsigned char* imageData )
-{
-    int numTexelData = m_Dimension.x * m_Dimension.y * 3;
-    for ( int currentTexel = 0; currentTexel < numTexelData; currentTexel += 3 )
-    {
-        unsigned char r = imageData[ currentTexel ];
-        unsigned char g = imageData[ currentTexel + 1 ];
-        unsigned char b = imageData[ currentTexel + 2 ];
-        AddRgbaToVector( r, g, b );
-    }
-}
-
-void Image::ProcessRgbaData( const unsigned char* imageData )
-{
-    int numTexelData = m_Dimension.x * m_Dimension.y * 4;
-    for ( int currentTexel = 0; currentTexel < numTexelData; currentTexel += 4 )
-    {
-        unsigned char r = imageData[ currentTexel ];
-        unsigned char g = imageData[ currentTexel + 1 ];
-        unsigned char b = imageData[ currentTexel + 2 ];
-        unsigned char a = imageData[ currentTexel + 3 ];
-        AddRgbaToVector( r, g, b, a );
-    }
-}
-
-void Image::AddRgbaToVector( unsigned char r, unsigned char g, unsigned char b, unsigned char a )
-{
-    m_Texels.push_back( Rgba8( r, g, b, a ) );
-}
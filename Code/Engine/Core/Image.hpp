@@ -3,8 +3,10 @@
 #include <string>
 #include <vector>
 
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/IO/FileUtils.hpp"
 
 
 class Image
@@ -12,22 +14,44 @@ class Image
 public:
     explicit Image( const char* filePath );
     explicit Image( const std::string& filePath );
+    Image( const IntVec2& dimensions, const Rgba8& fillColor );
     Image( const Image& copy, int orthogonalRotation = 0, bool mirrored = false );
 
     void Create();
     void Destroy();
 
+    // Decodes to tightly packed RGBA rows, bottom row first when flipV. Touches no shared state
+    //  so it is safe to call from worker threads
+    static bool DecodeFromFile( const std::string& filePath, bool flipV,
+                                OUT_PARAM IntVec2& dimensions, OUT_PARAM std::vector<Rgba8>& texels );
+    // Same, from an encoded file already in memory. texels keeps its capacity, so reusing one
+    //  vector across decodes stops reallocating once it is big enough
+    static bool DecodeFromMemory( const BufferView& encodedImage, bool flipV,
+                                  OUT_PARAM IntVec2& dimensions, OUT_PARAM std::vector<Rgba8>& texels );
+    // Decodes into memory the caller owns, such as a mapped upload buffer. Fails without writing
+    //  if the image has more than texelCapacity texels, GetDimensionsFromMemory gives the size first
+    static bool DecodeFromMemory( const BufferView& encodedImage, bool flipV,
+                                  OUT_PARAM IntVec2& dimensions, Rgba8* texels, size_t texelCapacity );
+    static bool GetDimensionsFromMemory( const BufferView& encodedImage, OUT_PARAM IntVec2& dimensions );
+
+    // Half size with a 2x2 box filter
+    Image CreateDownsampled() const;
+    // Every level below this one down to 1x1, largest first
+    void CreateMipChain( OUT_PARAM std::vector<Image>& mips ) const;
+
     //-------------------------------------------------------------------------
     // Image Accessors (const)
     const std::string GetImageFilePath() const { return m_FilePath; }
     const IntVec2 GetDimensions() const { return m_Dimension; }
     const Rgba8 GetTexelColor( int texelX, int texelY ) const;
     const Rgba8 GetTexelColor( const IntVec2& texelCoords ) const;
+    const Rgba8* GetTexels() const { return m_Texels.data(); }
 
     //-------------------------------------------------------------------------
     // Image Modifiers (non-const)
     void SetTexelColor( int texelX, int texelY, const Rgba8& color );
     void SetTexelColor( const IntVec2& texelCoords, const Rgba8& color );
+    void PremultiplyAlpha();
 
 private:
     std::string m_FilePath;
@@ -36,11 +60,4 @@ private:
 
     int GetTexelIndexFromCoords( int texelX, int texelY ) const;
     int GetTexelIndexFromCoords( const IntVec2& texelCoords ) const;
-
-    void ProcessRgbData( const unsigned char* imageData );
-    void ProcessRgbaData( const unsigned char* imageData );
-    void AddRgbaToVector( unsigned char r, 
-                          unsigned char g, 
-                          unsigned char b, 
-                          unsigned char a = 255 );
 };
\ No newline at end of file
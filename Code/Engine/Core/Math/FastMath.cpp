@@ -0,0 +1,402 @@
+#include "FastMath.hpp"
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Math/FastMathSimd.hpp"
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Math/Primatives/Vec3.hpp"
+
+// Squared lengths below this are treated as zero, rsqrt of a denormal is infinite
+constexpr float SMALLEST_NORMALIZABLE_LENGTH_SQUARED = 1.17549435e-38f;
+
+//-----------------------------------------------------------------------------
+// Splits degrees into a whole number of quarter turns and the rest in [-45, 45]. quadrant * 90
+//  is exact and so is the subtraction, so only the conversion to radians rounds
+static int ReduceDegrees( const float degrees, OUT_PARAM float& reducedRadians )
+{
+#if defined(ENGINE_SIMD_SSE)
+    // Round to nearest even, the same as _mm_cvtps_epi32 in the batch version
+    const int quadrant = _mm_cvtss_si32( _mm_set_ss( degrees * FastMath::QUADRANTS_PER_DEGREE ) );
+#else
+    const int quadrant = static_cast<int>( floorf( degrees * FastMath::QUADRANTS_PER_DEGREE + .5f ) );
+#endif // defined(ENGINE_SIMD_SSE)
+    reducedRadians = (degrees - static_cast<float>( quadrant ) * 90.f) * FastMath::RADIANS_PER_DEGREE;
+    return quadrant;
+}
+
+static float GetSinPolynomial( const float radians )
+{
+    const float radians2 = radians * radians;
+    const float polynomial = (FastMath::SIN_COEFFICIENT_7 * radians2 + FastMath::SIN_COEFFICIENT_5) * radians2 + FastMath::SIN_COEFFICIENT_3;
+    return polynomial * radians2 * radians + radians;
+}
+
+static float GetCosPolynomial( const float radians )
+{
+    const float radians2 = radians * radians;
+    const float polynomial = (FastMath::COS_COEFFICIENT_8 * radians2 + FastMath::COS_COEFFICIENT_6) * radians2 + FastMath::COS_COEFFICIENT_4;
+    return polynomial * radians2 * radians2 - .5f * radians2 + 1.f;
+}
+
+static float GetAtanPolynomial( const float ratio )
+{
+    const float ratio2 = ratio * ratio;
+    float polynomial = FastMath::ATAN_COEFFICIENT_11 * ratio2 + FastMath::ATAN_COEFFICIENT_9;
+    polynomial = polynomial * ratio2 + FastMath::ATAN_COEFFICIENT_7;
+    polynomial = polynomial * ratio2 + FastMath::ATAN_COEFFICIENT_5;
+    polynomial = polynomial * ratio2 + FastMath::ATAN_COEFFICIENT_3;
+    polynomial = polynomial * ratio2 + FastMath::ATAN_COEFFICIENT_1;
+    return polynomial * ratio;
+}
+
+//-----------------------------------------------------------------------------
+// Hue in degrees, saturation and lightness in [0, 1]. When two channels tie for the largest the
+//  later one wins, like ConvertRgbToHSL
+static Vec3 ConvertRgbToHSLFast( const Rgba8& color )
+{
+    const float red = static_cast<float>( color.r ) / 255.f;
+    const float green = static_cast<float>( color.g ) / 255.f;
+    const float blue = static_cast<float>( color.b ) / 255.f;
+
+    const float largest = Maxf( red, green, blue );
+    const float smallest = Minf( red, green, blue );
+    const float delta = largest - smallest;
+    const float lightness = (largest + smallest) * .5f;
+    if( delta <= 0.f )
+    {
+        return Vec3( 0.f, 0.f, lightness );
+    }
+
+    float hue;
+    if( blue == largest )
+    {
+        hue = (red - green) / delta + 4.f;
+    }
+    else if( green == largest )
+    {
+        hue = (blue - red) / delta + 2.f;
+    }
+    else
+    {
+        hue = (green - blue) / delta;
+        hue = hue < 0.f ? hue + 6.f : hue;
+    }
+
+    const float saturation = delta / (1.f - fabsf( 2.f * lightness - 1.f ));
+    return Vec3( hue * 60.f, saturation, lightness );
+}
+
+// One channel of HSL to RGB without picking a sector. sector is hue / 30 plus 0, 8 or 4 for red,
+//  green and blue, and the channel ramps between lightness - halfChroma and lightness + halfChroma
+static unsigned char GetHSLChannel( float sector, const float lightness, const float halfChroma )
+{
+    sector -= 12.f * static_cast<float>( static_cast<int>( sector * (1.f / 12.f) ) );
+
+    const float rising = sector - 3.f;
+    const float falling = 9.f - sector;
+    float ramp = rising < falling ? rising : falling;
+    ramp = ramp < 1.f ? ramp : 1.f;
+    ramp = ramp > -1.f ? ramp : -1.f;
+
+    return static_cast<unsigned char>( static_cast<int>( (lightness - halfChroma * ramp) * 255.f ) );
+}
+
+static Rgba8 ConvertHSLToRgbFast( const float hue, const float saturation, const float lightness )
+{
+    const float halfChroma = saturation * (lightness < 1.f - lightness ? lightness : 1.f - lightness);
+    const float sector = hue * (1.f / 30.f);
+    return Rgba8( GetHSLChannel( sector, lightness, halfChroma ),
+                  GetHSLChannel( sector + 8.f, lightness, halfChroma ),
+                  GetHSLChannel( sector + 4.f, lightness, halfChroma ) );
+}
+
+#if defined(ENGINE_SIMD_SSE)
+static __m128i GetHSLChannel4( __m128 sector, const __m128 lightness, const __m128 halfChroma )
+{
+    const __m128i wraps = _mm_cvttps_epi32( _mm_mul_ps( sector, _mm_set1_ps( 1.f / 12.f ) ) );
+    sector = _mm_sub_ps( sector, _mm_mul_ps( _mm_set1_ps( 12.f ), _mm_cvtepi32_ps( wraps ) ) );
+
+    const __m128 rising = _mm_sub_ps( sector, _mm_set1_ps( 3.f ) );
+    const __m128 falling = _mm_sub_ps( _mm_set1_ps( 9.f ), sector );
+    __m128 ramp = _mm_min_ps( rising, falling );
+    ramp = _mm_min_ps( ramp, _mm_set1_ps( 1.f ) );
+    ramp = _mm_max_ps( ramp, _mm_set1_ps( -1.f ) );
+
+    const __m128 channel = _mm_sub_ps( lightness, _mm_mul_ps( halfChroma, ramp ) );
+    return _mm_cvttps_epi32( _mm_mul_ps( channel, _mm_set1_ps( 255.f ) ) );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+namespace FastMath
+{
+
+//-----------------------------------------------------------------------------
+float SinDegrees( const float degrees )
+{
+    float radians;
+    const int quadrant = ReduceDegrees( degrees, radians );
+    const float sine = (quadrant & 1) ? GetCosPolynomial( radians ) : GetSinPolynomial( radians );
+    return (quadrant & 2) ? -sine : sine;
+}
+
+float CosDegrees( const float degrees )
+{
+    float radians;
+    const int quadrant = ReduceDegrees( degrees, radians );
+    const float cosine = (quadrant & 1) ? GetSinPolynomial( radians ) : GetCosPolynomial( radians );
+    return ((quadrant + 1) & 2) ? -cosine : cosine;
+}
+
+void SinCosDegrees( const float degrees, float& sine, float& cosine )
+{
+    float radians;
+    const int quadrant = ReduceDegrees( degrees, radians );
+    const float sinPolynomial = GetSinPolynomial( radians );
+    const float cosPolynomial = GetCosPolynomial( radians );
+
+    const float swappedSine = (quadrant & 1) ? cosPolynomial : sinPolynomial;
+    const float swappedCosine = (quadrant & 1) ? sinPolynomial : cosPolynomial;
+    sine = (quadrant & 2) ? -swappedSine : swappedSine;
+    cosine = ((quadrant + 1) & 2) ? -swappedCosine : swappedCosine;
+}
+
+void SinCosDegrees( const float* degrees, float* sines, float* cosines, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 sine;
+        __m128 cosine;
+        SinCosDegrees4( _mm_loadu_ps( degrees + index ), sine, cosine );
+        _mm_storeu_ps( sines + index, sine );
+        _mm_storeu_ps( cosines + index, cosine );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        SinCosDegrees( degrees[ index ], sines[ index ], cosines[ index ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Folded to [0, 1] with the smaller over the larger component, then unfolded by octant
+float Atan2Degrees( const float y, const float x )
+{
+    const float absX = fabsf( x );
+    const float absY = fabsf( y );
+    const float largest = absX > absY ? absX : absY;
+    const float smallest = absX < absY ? absX : absY;
+    const float ratio = largest > 0.f ? smallest / largest : 0.f;
+
+    float degrees = GetAtanPolynomial( ratio ) * DEGREES_PER_RADIAN;
+    degrees = absY > absX ? 90.f - degrees : degrees;
+    degrees = x < 0.f ? 180.f - degrees : degrees;
+    return y < 0.f ? -degrees : degrees;
+}
+
+void Atan2Degrees( const float* ys, const float* xs, float* degrees, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    for( ; index + 4 <= count; index += 4 )
+    {
+        _mm_storeu_ps( degrees + index, Atan2Degrees4( _mm_loadu_ps( ys + index ), _mm_loadu_ps( xs + index ) ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        degrees[ index ] = Atan2Degrees( ys[ index ], xs[ index ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+float InverseSqrt( const float value )
+{
+#if defined(ENGINE_SIMD_SSE)
+    const float estimate = _mm_cvtss_f32( _mm_rsqrt_ss( _mm_set_ss( value ) ) );
+    const float halfValue = .5f * value;
+    return estimate * (1.5f - halfValue * estimate * estimate);
+#else
+    return 1.f / sqrtf( value );
+#endif // defined(ENGINE_SIMD_SSE)
+}
+
+void InverseSqrt( const float* values, float* results, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    for( ; index + 4 <= count; index += 4 )
+    {
+        _mm_storeu_ps( results + index, InverseSqrt4( _mm_loadu_ps( values + index ) ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        results[ index ] = InverseSqrt( values[ index ] );
+    }
+}
+
+float GetLength( const Vec2& vector )
+{
+    const float lengthSquared = (vector.x * vector.x) + (vector.y * vector.y);
+    return lengthSquared >= SMALLEST_NORMALIZABLE_LENGTH_SQUARED ? lengthSquared * InverseSqrt( lengthSquared ) : 0.f;
+}
+
+float GetLength( const Vec3& vector )
+{
+    const float lengthSquared = (vector.x * vector.x) + (vector.y * vector.y) + (vector.z * vector.z);
+    return lengthSquared >= SMALLEST_NORMALIZABLE_LENGTH_SQUARED ? lengthSquared * InverseSqrt( lengthSquared ) : 0.f;
+}
+
+Vec2 GetNormalized( const Vec2& vector )
+{
+    const float lengthSquared = (vector.x * vector.x) + (vector.y * vector.y);
+    if( lengthSquared < SMALLEST_NORMALIZABLE_LENGTH_SQUARED )
+    {
+        return Vec2( 0.f, 0.f );
+    }
+
+    const float inverseLength = InverseSqrt( lengthSquared );
+    return Vec2( vector.x * inverseLength, vector.y * inverseLength );
+}
+
+Vec3 GetNormalized( const Vec3& vector )
+{
+    const float lengthSquared = (vector.x * vector.x) + (vector.y * vector.y) + (vector.z * vector.z);
+    if( lengthSquared < SMALLEST_NORMALIZABLE_LENGTH_SQUARED )
+    {
+        return Vec3( 0.f, 0.f, 0.f );
+    }
+
+    const float inverseLength = InverseSqrt( lengthSquared );
+    return Vec3( vector.x * inverseLength, vector.y * inverseLength, vector.z * inverseLength );
+}
+
+void Normalize( Vec2* vectors, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 smallest = _mm_set1_ps( SMALLEST_NORMALIZABLE_LENGTH_SQUARED );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        // Two vectors per load, then split into x and y lanes
+        float* components = &vectors[ index ].x;
+        const __m128 low = _mm_loadu_ps( components );
+        const __m128 high = _mm_loadu_ps( components + 4 );
+        const __m128 x = _mm_shuffle_ps( low, high, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+        const __m128 y = _mm_shuffle_ps( low, high, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+
+        const __m128 lengthSquared = _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+        const __m128 isLongEnough = _mm_cmpge_ps( lengthSquared, smallest );
+        const __m128 inverseLength = _mm_and_ps( isLongEnough, InverseSqrt4( lengthSquared ) );
+        const __m128 normalX = _mm_and_ps( isLongEnough, _mm_mul_ps( x, inverseLength ) );
+        const __m128 normalY = _mm_and_ps( isLongEnough, _mm_mul_ps( y, inverseLength ) );
+
+        _mm_storeu_ps( components, _mm_unpacklo_ps( normalX, normalY ) );
+        _mm_storeu_ps( components + 4, _mm_unpackhi_ps( normalX, normalY ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        vectors[ index ] = GetNormalized( vectors[ index ] );
+    }
+}
+
+void Normalize( Vec3* vectors, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 smallest = _mm_set1_ps( SMALLEST_NORMALIZABLE_LENGTH_SQUARED );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        Vec3* batch = vectors + index;
+        const __m128 x = _mm_setr_ps( batch[ 0 ].x, batch[ 1 ].x, batch[ 2 ].x, batch[ 3 ].x );
+        const __m128 y = _mm_setr_ps( batch[ 0 ].y, batch[ 1 ].y, batch[ 2 ].y, batch[ 3 ].y );
+        const __m128 z = _mm_setr_ps( batch[ 0 ].z, batch[ 1 ].z, batch[ 2 ].z, batch[ 3 ].z );
+
+        const __m128 lengthSquared = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) );
+        const __m128 isLongEnough = _mm_cmpge_ps( lengthSquared, smallest );
+        const __m128 inverseLength = _mm_and_ps( isLongEnough, InverseSqrt4( lengthSquared ) );
+
+        float normalX[ 4 ];
+        float normalY[ 4 ];
+        float normalZ[ 4 ];
+        _mm_storeu_ps( normalX, _mm_and_ps( isLongEnough, _mm_mul_ps( x, inverseLength ) ) );
+        _mm_storeu_ps( normalY, _mm_and_ps( isLongEnough, _mm_mul_ps( y, inverseLength ) ) );
+        _mm_storeu_ps( normalZ, _mm_and_ps( isLongEnough, _mm_mul_ps( z, inverseLength ) ) );
+        for( int lane = 0; lane < 4; ++lane )
+        {
+            batch[ lane ] = Vec3( normalX[ lane ], normalY[ lane ], normalZ[ lane ] );
+        }
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        vectors[ index ] = GetNormalized( vectors[ index ] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+Rgba8 LerpAsHSL( const Rgba8& from, const Rgba8& to, const float percentage )
+{
+    const Vec3 fromHSL = ConvertRgbToHSLFast( from );
+    const Vec3 toHSL = ConvertRgbToHSLFast( to );
+    return ConvertHSLToRgbFast( fromHSL.x + percentage * (toHSL.x - fromHSL.x),
+                                fromHSL.y + percentage * (toHSL.y - fromHSL.y),
+                                fromHSL.z + percentage * (toHSL.z - fromHSL.z) );
+}
+
+void LerpAsHSL( const Rgba8& from, const Rgba8& to, const float* percentages, Rgba8* colors,
+                const unsigned int count )
+{
+    const Vec3 fromHSL = ConvertRgbToHSLFast( from );
+    const Vec3 toHSL = ConvertRgbToHSLFast( to );
+    const Vec3 deltaHSL = toHSL - fromHSL;
+
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128i opaqueAlpha = _mm_set1_epi32( static_cast<int>( 0xff000000 ) );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        const __m128 percentage = _mm_loadu_ps( percentages + index );
+        const __m128 hue = _mm_add_ps( _mm_set1_ps( fromHSL.x ), _mm_mul_ps( percentage, _mm_set1_ps( deltaHSL.x ) ) );
+        const __m128 saturation = _mm_add_ps( _mm_set1_ps( fromHSL.y ), _mm_mul_ps( percentage, _mm_set1_ps( deltaHSL.y ) ) );
+        const __m128 lightness = _mm_add_ps( _mm_set1_ps( fromHSL.z ), _mm_mul_ps( percentage, _mm_set1_ps( deltaHSL.z ) ) );
+
+        const __m128 oneMinusLightness = _mm_sub_ps( _mm_set1_ps( 1.f ), lightness );
+        const __m128 halfChroma = _mm_mul_ps( saturation, _mm_min_ps( lightness, oneMinusLightness ) );
+        const __m128 sector = _mm_mul_ps( hue, _mm_set1_ps( 1.f / 30.f ) );
+
+        const __m128i red = GetHSLChannel4( sector, lightness, halfChroma );
+        const __m128i green = GetHSLChannel4( _mm_add_ps( sector, _mm_set1_ps( 8.f ) ), lightness, halfChroma );
+        const __m128i blue = GetHSLChannel4( _mm_add_ps( sector, _mm_set1_ps( 4.f ) ), lightness, halfChroma );
+
+        // Rgba8 is four bytes in r, g, b, a order
+        __m128i packed = _mm_or_si128( red, _mm_slli_epi32( green, 8 ) );
+        packed = _mm_or_si128( packed, _mm_slli_epi32( blue, 16 ) );
+        packed = _mm_or_si128( packed, opaqueAlpha );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( static_cast<void*>( colors + index ) ), packed );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        const float percentage = percentages[ index ];
+        colors[ index ] = ConvertHSLToRgbFast( fromHSL.x + percentage * deltaHSL.x,
+                                               fromHSL.y + percentage * deltaHSL.y,
+                                               fromHSL.z + percentage * deltaHSL.z );
+    }
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+struct Rgba8;
+struct Vec2;
+struct Vec3;
+
+//-----------------------------------------------------------------------------
+// Approximate versions of the trig, length and color functions used on hot paths. Nothing
+//  switches to these on its own; call them where the error bounds below are acceptable and keep
+//  MathUtils, Vec2, Vec3 and Rgba8 for everything else.
+//
+// Every batch version runs four values per SSE2 step and gives the same bits as calling the
+//  single version on each value
+namespace FastMath
+{
+
+//-----------------------------------------------------------------------------
+// Trig in degrees. The reduction to [-45, 45] degrees is exact for |degrees| below 3e7, so the
+//  absolute error stays under 1e-7 over that whole range instead of growing with the angle
+float SinDegrees( float degrees );
+float CosDegrees( float degrees );
+void SinCosDegrees( float degrees, OUT_PARAM float& sine, OUT_PARAM float& cosine );
+void SinCosDegrees( const float* degrees, OUT_PARAM float* sines, OUT_PARAM float* cosines, unsigned int count );
+
+// Absolute error under 2e-4 degrees. Returns 0 for ( 0, 0 )
+float Atan2Degrees( float y, float x );
+void Atan2Degrees( const float* ys, const float* xs, OUT_PARAM float* degrees, unsigned int count );
+
+//-----------------------------------------------------------------------------
+// Hardware reciprocal square root refined by one Newton step, relative error under 5e-7.
+//  value must be greater than zero. Without SIMD this is 1 / sqrtf
+float InverseSqrt( float value );
+void InverseSqrt( const float* values, OUT_PARAM float* results, unsigned int count );
+
+// Relative error under 5e-7. Zero vectors stay zero, like GetNormalized
+float GetLength( const Vec2& vector );
+float GetLength( const Vec3& vector );
+Vec2 GetNormalized( const Vec2& vector );
+Vec3 GetNormalized( const Vec3& vector );
+void Normalize( Vec2* vectors, unsigned int count );
+void Normalize( Vec3* vectors, unsigned int count );
+
+//-----------------------------------------------------------------------------
+// Branchless HSL to RGB, every channel within 1 of Rgba8::LerpAsHSL. Alpha is 255 to match it.
+//  The batch version converts the endpoints once and fills one color per percentage
+Rgba8 LerpAsHSL( const Rgba8& from, const Rgba8& to, float percentage );
+void LerpAsHSL( const Rgba8& from, const Rgba8& to, const float* percentages, OUT_PARAM Rgba8* colors,
+                unsigned int count );
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/SimdCommon.hpp"
+
+//-----------------------------------------------------------------------------
+// Polynomials and SSE2 kernels behind FastMath. The kernels follow the scalar functions operation
+//  for operation, so anything built on them gives the same bits as the single versions
+namespace FastMath
+{
+
+// Minimax polynomials for sin and cos on [-pi/4, pi/4], the ones Cephes sinf and cosf use
+constexpr float SIN_COEFFICIENT_3 = -1.6666654611e-1f;
+constexpr float SIN_COEFFICIENT_5 = 8.3321608736e-3f;
+constexpr float SIN_COEFFICIENT_7 = -1.9515295891e-4f;
+constexpr float COS_COEFFICIENT_4 = 4.166664568298827e-2f;
+constexpr float COS_COEFFICIENT_6 = -1.388731625493765e-3f;
+constexpr float COS_COEFFICIENT_8 = 2.443315711809948e-5f;
+
+// Minimax polynomial for atan on [0, 1], odd powers only
+constexpr float ATAN_COEFFICIENT_1 = .99997726f;
+constexpr float ATAN_COEFFICIENT_3 = -.33262347f;
+constexpr float ATAN_COEFFICIENT_5 = .19354346f;
+constexpr float ATAN_COEFFICIENT_7 = -.11643287f;
+constexpr float ATAN_COEFFICIENT_9 = .05265332f;
+constexpr float ATAN_COEFFICIENT_11 = -.01172120f;
+
+constexpr float QUADRANTS_PER_DEGREE = 1.f / 90.f;
+constexpr float RADIANS_PER_DEGREE = g_PIf / 180.f;
+constexpr float DEGREES_PER_RADIAN = 180.f / g_PIf;
+
+#if defined(ENGINE_SIMD_SSE)
+inline __m128 SelectFloat4( const __m128& mask, const __m128& ifTrue, const __m128& ifFalse )
+{
+    return _mm_or_ps( _mm_and_ps( mask, ifTrue ), _mm_andnot_ps( mask, ifFalse ) );
+}
+
+inline void SinCosDegrees4( const __m128& degrees, OUT_PARAM __m128& sines, OUT_PARAM __m128& cosines )
+{
+    const __m128i quadrant = _mm_cvtps_epi32( _mm_mul_ps( degrees, _mm_set1_ps( QUADRANTS_PER_DEGREE ) ) );
+    const __m128 quarterTurns = _mm_mul_ps( _mm_cvtepi32_ps( quadrant ), _mm_set1_ps( 90.f ) );
+    const __m128 radians = _mm_mul_ps( _mm_sub_ps( degrees, quarterTurns ), _mm_set1_ps( RADIANS_PER_DEGREE ) );
+    const __m128 radians2 = _mm_mul_ps( radians, radians );
+
+    __m128 sinPolynomial = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( SIN_COEFFICIENT_7 ), radians2 ),
+                                       _mm_set1_ps( SIN_COEFFICIENT_5 ) );
+    sinPolynomial = _mm_add_ps( _mm_mul_ps( sinPolynomial, radians2 ), _mm_set1_ps( SIN_COEFFICIENT_3 ) );
+    sinPolynomial = _mm_add_ps( _mm_mul_ps( _mm_mul_ps( sinPolynomial, radians2 ), radians ), radians );
+
+    __m128 cosPolynomial = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( COS_COEFFICIENT_8 ), radians2 ),
+                                       _mm_set1_ps( COS_COEFFICIENT_6 ) );
+    cosPolynomial = _mm_add_ps( _mm_mul_ps( cosPolynomial, radians2 ), _mm_set1_ps( COS_COEFFICIENT_4 ) );
+    cosPolynomial = _mm_sub_ps( _mm_mul_ps( _mm_mul_ps( cosPolynomial, radians2 ), radians2 ),
+                                _mm_mul_ps( _mm_set1_ps( .5f ), radians2 ) );
+    cosPolynomial = _mm_add_ps( cosPolynomial, _mm_set1_ps( 1.f ) );
+
+    // Odd quadrants swap sin and cos, bit 1 of the quadrant ( and of quadrant + 1 for cos ) is
+    //  moved up to the sign bit
+    const __m128i oneInt = _mm_set1_epi32( 1 );
+    const __m128i twoInt = _mm_set1_epi32( 2 );
+    const __m128 swapMask = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( quadrant, oneInt ), oneInt ) );
+    const __m128 sinSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( quadrant, twoInt ), 30 ) );
+    const __m128 cosSign = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( _mm_add_epi32( quadrant, oneInt ), twoInt ), 30 ) );
+
+    sines = _mm_xor_ps( SelectFloat4( swapMask, cosPolynomial, sinPolynomial ), sinSign );
+    cosines = _mm_xor_ps( SelectFloat4( swapMask, sinPolynomial, cosPolynomial ), cosSign );
+}
+
+inline __m128 Atan2Degrees4( const __m128& y, const __m128& x )
+{
+    const __m128 signBit = _mm_set1_ps( -0.f );
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 absX = _mm_andnot_ps( signBit, x );
+    const __m128 absY = _mm_andnot_ps( signBit, y );
+    const __m128 largest = _mm_max_ps( absX, absY );
+    const __m128 smallest = _mm_min_ps( absX, absY );
+    const __m128 ratio = _mm_and_ps( _mm_cmpgt_ps( largest, zero ), _mm_div_ps( smallest, largest ) );
+    const __m128 ratio2 = _mm_mul_ps( ratio, ratio );
+
+    __m128 polynomial = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( ATAN_COEFFICIENT_11 ), ratio2 ),
+                                    _mm_set1_ps( ATAN_COEFFICIENT_9 ) );
+    polynomial = _mm_add_ps( _mm_mul_ps( polynomial, ratio2 ), _mm_set1_ps( ATAN_COEFFICIENT_7 ) );
+    polynomial = _mm_add_ps( _mm_mul_ps( polynomial, ratio2 ), _mm_set1_ps( ATAN_COEFFICIENT_5 ) );
+    polynomial = _mm_add_ps( _mm_mul_ps( polynomial, ratio2 ), _mm_set1_ps( ATAN_COEFFICIENT_3 ) );
+    polynomial = _mm_add_ps( _mm_mul_ps( polynomial, ratio2 ), _mm_set1_ps( ATAN_COEFFICIENT_1 ) );
+
+    __m128 angle = _mm_mul_ps( _mm_mul_ps( polynomial, ratio ), _mm_set1_ps( DEGREES_PER_RADIAN ) );
+    angle = SelectFloat4( _mm_cmpgt_ps( absY, absX ), _mm_sub_ps( _mm_set1_ps( 90.f ), angle ), angle );
+    angle = SelectFloat4( _mm_cmplt_ps( x, zero ), _mm_sub_ps( _mm_set1_ps( 180.f ), angle ), angle );
+    return _mm_xor_ps( angle, _mm_and_ps( _mm_cmplt_ps( y, zero ), signBit ) );
+}
+
+inline __m128 InverseSqrt4( const __m128& values )
+{
+    const __m128 estimate = _mm_rsqrt_ps( values );
+    const __m128 halfValues = _mm_mul_ps( _mm_set1_ps( .5f ), values );
+    const __m128 correction = _mm_sub_ps( _mm_set1_ps( 1.5f ),
+                                          _mm_mul_ps( _mm_mul_ps( halfValues, estimate ), estimate ) );
+    return _mm_mul_ps( estimate, correction );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Engine/Core/Math/SimdCommon.hpp"
+
+//-----------------------------------------------------------------------------
+// RawNoise on four indices at once. Each lane gives exactly what the scalar function gives for
+//  that index, so batched and single lookups can be mixed freely
+#if defined(ENGINE_SIMD_SSE)
+namespace RawNoise
+{
+
+// Low 32 bits of each lane product. SSE2 only multiplies the even lanes, the odd lanes go
+//  through a shift
+inline __m128i MultiplyLow32( const __m128i& a, const __m128i& b )
+{
+    const __m128i even = _mm_mul_epu32( a, b );
+    const __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                               _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+inline __m128i GetNoiseUint4( const __m128i& index, const unsigned int seed )
+{
+    __m128i mangledBits = MultiplyLow32( index, _mm_set1_epi32( static_cast<int>( 0xd2a80a23 ) ) );
+    mangledBits = _mm_add_epi32( mangledBits, _mm_set1_epi32( static_cast<int>( seed ) ) );
+    mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 7 ) );
+    mangledBits = _mm_add_epi32( mangledBits, _mm_set1_epi32( static_cast<int>( 0xa884f197 ) ) );
+    mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+    mangledBits = MultiplyLow32( mangledBits, _mm_set1_epi32( static_cast<int>( 0x1b56c4e9 ) ) );
+    return _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 11 ) );
+}
+
+inline __m128i GetNoiseUint4( const __m128i& indexX, const __m128i& indexY, const unsigned int seed )
+{
+    return GetNoiseUint4( _mm_add_epi32( indexX, MultiplyLow32( indexY, _mm_set1_epi32( 198491317 ) ) ), seed );
+}
+
+inline __m128i GetNoiseUint4( const __m128i& indexX, const __m128i& indexY, const __m128i& indexZ, const unsigned int seed )
+{
+    const __m128i index = _mm_add_epi32( _mm_add_epi32( indexX, MultiplyLow32( indexY, _mm_set1_epi32( 198491317 ) ) ),
+                                         MultiplyLow32( indexZ, _mm_set1_epi32( 6542989 ) ) );
+    return GetNoiseUint4( index, seed );
+}
+
+// Each lane as an unsigned int times scale, rounded through double like the scalar conversions
+inline __m128 ScaleUintToFloat4( const __m128i& bits, const double scale )
+{
+    const __m128d wrap = _mm_set1_pd( 4294967296.0 );
+    const __m128d scale2 = _mm_set1_pd( scale );
+    __m128d low = _mm_cvtepi32_pd( bits );
+    __m128d high = _mm_cvtepi32_pd( _mm_shuffle_epi32( bits, _MM_SHUFFLE( 3, 2, 3, 2 ) ) );
+    low = _mm_add_pd( low, _mm_and_pd( _mm_cmplt_pd( low, _mm_setzero_pd() ), wrap ) );
+    high = _mm_add_pd( high, _mm_and_pd( _mm_cmplt_pd( high, _mm_setzero_pd() ), wrap ) );
+    return _mm_movelh_ps( _mm_cvtpd_ps( _mm_mul_pd( low, scale2 ) ), _mm_cvtpd_ps( _mm_mul_pd( high, scale2 ) ) );
+}
+
+inline __m128 GetNoiseZeroToOne4( const __m128i& index, const unsigned int seed )
+{
+    return ScaleUintToFloat4( GetNoiseUint4( index, seed ), 1.0 / static_cast<double>( 0xFFFFFFFF ) );
+}
+
+}
+#endif // defined(ENGINE_SIMD_SSE)
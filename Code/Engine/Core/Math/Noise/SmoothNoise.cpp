@@ -0,0 +1,968 @@
+#include "SmoothNoise.hpp"
+
+#include "Engine/Core/Math/Noise/RawNoise.hpp"
+#include "Engine/Core/Math/Noise/RawNoiseSimd.hpp"
+#include "Engine/Event/JobSystem.hpp"
+
+#include <cmath>
+
+// Scales from Stefan Gustavson's noise1234 and simplexnoise1234 that bring each basis to about [-1, 1]
+constexpr float PERLIN_SCALE_1D = .188f;
+constexpr float PERLIN_SCALE_2D = .507f;
+constexpr float PERLIN_SCALE_3D = .936f;
+constexpr float PERLIN_SCALE_4D = .87f;
+constexpr float SIMPLEX_SCALE_1D = .395f;
+constexpr float SIMPLEX_SCALE_2D = 40.f;
+constexpr float SIMPLEX_SCALE_3D = 32.f;
+constexpr float SIMPLEX_SCALE_4D = 27.f;
+
+// Skew to the simplex grid and back, ( sqrt( n + 1 ) - 1 ) / n and ( 1 - 1 / sqrt( n + 1 ) ) / n
+constexpr float SIMPLEX_SKEW_2D = .366025403f;
+constexpr float SIMPLEX_UNSKEW_2D = .211324865f;
+constexpr float SIMPLEX_SKEW_3D = 1.f / 3.f;
+constexpr float SIMPLEX_UNSKEW_3D = 1.f / 6.f;
+constexpr float SIMPLEX_SKEW_4D = .309016994f;
+constexpr float SIMPLEX_UNSKEW_4D = .138196601f;
+
+// Top 24 bits of a lattice hash, exact in a float, to [-1, 1]
+constexpr float VALUE_SCALE = 2.f / 16777215.f;
+
+// Offsets for the warp displacement so it is not the sampled noise itself
+constexpr unsigned int WARP_SEED_X = 0x68e31da4;
+constexpr unsigned int WARP_SEED_Y = 0xb5297a4d;
+constexpr unsigned int WARP_SEED_Z = 0x1b56c4e9;
+
+constexpr unsigned int GRID_SAMPLES_PER_BATCH = 1 << 14;
+
+//-----------------------------------------------------------------------------
+// Scalar building blocks. The SSE2 versions below do the same operations in the same order so
+//  grids match single samples bit for bit
+static int FloorToInt( const float value )
+{
+    const int truncated = static_cast<int>( value );
+    return value < static_cast<float>( truncated ) ? truncated - 1 : truncated;
+}
+
+static float Fade( const float t )
+{
+    return t * t * t * ( t * ( t * 6.f - 15.f ) + 10.f );
+}
+
+static float LerpNoise( const float a, const float b, const float t )
+{
+    return a + t * ( b - a );
+}
+
+static float GetLatticeValue( const unsigned int hash )
+{
+    return static_cast<float>( hash >> 8 ) * VALUE_SCALE - 1.f;
+}
+
+static float GetSimplexFalloff( const float t )
+{
+    const float clamped = t > 0.f ? t : 0.f;
+    const float squared = clamped * clamped;
+    return squared * squared;
+}
+
+static float Gradient1( const unsigned int hash, const float x )
+{
+    const unsigned int h = hash & 15;
+    const float gradient = 1.f + static_cast<float>( h & 7 );
+    return ( h & 8 ) ? -gradient * x : gradient * x;
+}
+
+static float Gradient2( const unsigned int hash, const float x, const float y )
+{
+    const unsigned int h = hash & 7;
+    const float u = h < 4 ? x : y;
+    const float v = h < 4 ? y : x;
+    return ( ( h & 1 ) ? -u : u ) + ( ( h & 2 ) ? -v * 2.f : v * 2.f );
+}
+
+static float Gradient3( const unsigned int hash, const float x, const float y, const float z )
+{
+    const unsigned int h = hash & 15;
+    const float u = h < 8 ? x : y;
+    const float v = h < 4 ? y : ( ( h == 12 || h == 14 ) ? x : z );
+    return ( ( h & 1 ) ? -u : u ) + ( ( h & 2 ) ? -v : v );
+}
+
+static float Gradient4( const unsigned int hash, const float x, const float y, const float z, const float t )
+{
+    const unsigned int h = hash & 31;
+    const float u = h < 24 ? x : y;
+    const float v = h < 16 ? y : z;
+    const float w = h < 8 ? z : t;
+    return ( ( h & 1 ) ? -u : u ) + ( ( h & 2 ) ? -v : v ) + ( ( h & 4 ) ? -w : w );
+}
+
+//-----------------------------------------------------------------------------
+float SmoothNoise::GetValueNoise( const float x, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const float fx = x - static_cast<float>( ix );
+
+    const float v0 = GetLatticeValue( RawNoise::GetNoiseUint( ix, seed ) );
+    const float v1 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, seed ) );
+    return LerpNoise( v0, v1, Fade( fx ) );
+}
+
+float SmoothNoise::GetValueNoise( const float x, const float y, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const float sx = Fade( x - static_cast<float>( ix ) );
+    const float sy = Fade( y - static_cast<float>( iy ) );
+
+    const float v00 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy, seed ) );
+    const float v10 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy, seed ) );
+    const float v01 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy + 1, seed ) );
+    const float v11 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy + 1, seed ) );
+    return LerpNoise( LerpNoise( v00, v10, sx ), LerpNoise( v01, v11, sx ), sy );
+}
+
+float SmoothNoise::GetValueNoise( const float x, const float y, const float z, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const int iz = FloorToInt( z );
+    const float sx = Fade( x - static_cast<float>( ix ) );
+    const float sy = Fade( y - static_cast<float>( iy ) );
+    const float sz = Fade( z - static_cast<float>( iz ) );
+
+    const float v000 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy, iz, seed ) );
+    const float v100 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy, iz, seed ) );
+    const float v010 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy + 1, iz, seed ) );
+    const float v110 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy + 1, iz, seed ) );
+    const float v001 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy, iz + 1, seed ) );
+    const float v101 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy, iz + 1, seed ) );
+    const float v011 = GetLatticeValue( RawNoise::GetNoiseUint( ix, iy + 1, iz + 1, seed ) );
+    const float v111 = GetLatticeValue( RawNoise::GetNoiseUint( ix + 1, iy + 1, iz + 1, seed ) );
+
+    const float near = LerpNoise( LerpNoise( v000, v100, sx ), LerpNoise( v010, v110, sx ), sy );
+    const float far = LerpNoise( LerpNoise( v001, v101, sx ), LerpNoise( v011, v111, sx ), sy );
+    return LerpNoise( near, far, sz );
+}
+
+float SmoothNoise::GetValueNoise( const float x, const float y, const float z, const float t, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const int iz = FloorToInt( z );
+    const int it = FloorToInt( t );
+    const float sx = Fade( x - static_cast<float>( ix ) );
+    const float sy = Fade( y - static_cast<float>( iy ) );
+    const float sz = Fade( z - static_cast<float>( iz ) );
+    const float st = Fade( t - static_cast<float>( it ) );
+
+    // Each corner of the hypercube, x in bit 0 through t in bit 3, then collapsed one axis at a time
+    float corners[ 16 ];
+    for( int corner = 0; corner < 16; ++corner )
+    {
+        corners[ corner ] = GetLatticeValue( RawNoise::GetNoiseUint( ix + ( corner & 1 ), iy + ( ( corner >> 1 ) & 1 ),
+                                                                     iz + ( ( corner >> 2 ) & 1 ), it + ( corner >> 3 ), seed ) );
+    }
+    for( int corner = 0; corner < 8; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sx );
+    }
+    for( int corner = 0; corner < 4; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sy );
+    }
+    for( int corner = 0; corner < 2; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sz );
+    }
+    return LerpNoise( corners[ 0 ], corners[ 1 ], st );
+}
+
+//-----------------------------------------------------------------------------
+float SmoothNoise::GetPerlinNoise( const float x, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const float fx0 = x - static_cast<float>( ix );
+    const float fx1 = fx0 - 1.f;
+
+    const float n0 = Gradient1( RawNoise::GetNoiseUint( ix, seed ), fx0 );
+    const float n1 = Gradient1( RawNoise::GetNoiseUint( ix + 1, seed ), fx1 );
+    return PERLIN_SCALE_1D * LerpNoise( n0, n1, Fade( fx0 ) );
+}
+
+float SmoothNoise::GetPerlinNoise( const float x, const float y, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const float fx0 = x - static_cast<float>( ix );
+    const float fy0 = y - static_cast<float>( iy );
+    const float fx1 = fx0 - 1.f;
+    const float fy1 = fy0 - 1.f;
+
+    const float n00 = Gradient2( RawNoise::GetNoiseUint( ix, iy, seed ), fx0, fy0 );
+    const float n10 = Gradient2( RawNoise::GetNoiseUint( ix + 1, iy, seed ), fx1, fy0 );
+    const float n01 = Gradient2( RawNoise::GetNoiseUint( ix, iy + 1, seed ), fx0, fy1 );
+    const float n11 = Gradient2( RawNoise::GetNoiseUint( ix + 1, iy + 1, seed ), fx1, fy1 );
+
+    const float sx = Fade( fx0 );
+    return PERLIN_SCALE_2D * LerpNoise( LerpNoise( n00, n10, sx ), LerpNoise( n01, n11, sx ), Fade( fy0 ) );
+}
+
+float SmoothNoise::GetPerlinNoise( const float x, const float y, const float z, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const int iz = FloorToInt( z );
+    const float fx0 = x - static_cast<float>( ix );
+    const float fy0 = y - static_cast<float>( iy );
+    const float fz0 = z - static_cast<float>( iz );
+    const float fx1 = fx0 - 1.f;
+    const float fy1 = fy0 - 1.f;
+    const float fz1 = fz0 - 1.f;
+
+    const float n000 = Gradient3( RawNoise::GetNoiseUint( ix, iy, iz, seed ), fx0, fy0, fz0 );
+    const float n100 = Gradient3( RawNoise::GetNoiseUint( ix + 1, iy, iz, seed ), fx1, fy0, fz0 );
+    const float n010 = Gradient3( RawNoise::GetNoiseUint( ix, iy + 1, iz, seed ), fx0, fy1, fz0 );
+    const float n110 = Gradient3( RawNoise::GetNoiseUint( ix + 1, iy + 1, iz, seed ), fx1, fy1, fz0 );
+    const float n001 = Gradient3( RawNoise::GetNoiseUint( ix, iy, iz + 1, seed ), fx0, fy0, fz1 );
+    const float n101 = Gradient3( RawNoise::GetNoiseUint( ix + 1, iy, iz + 1, seed ), fx1, fy0, fz1 );
+    const float n011 = Gradient3( RawNoise::GetNoiseUint( ix, iy + 1, iz + 1, seed ), fx0, fy1, fz1 );
+    const float n111 = Gradient3( RawNoise::GetNoiseUint( ix + 1, iy + 1, iz + 1, seed ), fx1, fy1, fz1 );
+
+    const float sx = Fade( fx0 );
+    const float sy = Fade( fy0 );
+    const float near = LerpNoise( LerpNoise( n000, n100, sx ), LerpNoise( n010, n110, sx ), sy );
+    const float far = LerpNoise( LerpNoise( n001, n101, sx ), LerpNoise( n011, n111, sx ), sy );
+    return PERLIN_SCALE_3D * LerpNoise( near, far, Fade( fz0 ) );
+}
+
+float SmoothNoise::GetPerlinNoise( const float x, const float y, const float z, const float t, const unsigned int seed )
+{
+    const int ix = FloorToInt( x );
+    const int iy = FloorToInt( y );
+    const int iz = FloorToInt( z );
+    const int it = FloorToInt( t );
+    const float fx0 = x - static_cast<float>( ix );
+    const float fy0 = y - static_cast<float>( iy );
+    const float fz0 = z - static_cast<float>( iz );
+    const float ft0 = t - static_cast<float>( it );
+
+    float corners[ 16 ];
+    for( int corner = 0; corner < 16; ++corner )
+    {
+        const int cx = corner & 1;
+        const int cy = ( corner >> 1 ) & 1;
+        const int cz = ( corner >> 2 ) & 1;
+        const int ct = corner >> 3;
+        corners[ corner ] = Gradient4( RawNoise::GetNoiseUint( ix + cx, iy + cy, iz + cz, it + ct, seed ),
+                                       fx0 - static_cast<float>( cx ), fy0 - static_cast<float>( cy ),
+                                       fz0 - static_cast<float>( cz ), ft0 - static_cast<float>( ct ) );
+    }
+
+    const float sx = Fade( fx0 );
+    const float sy = Fade( fy0 );
+    const float sz = Fade( fz0 );
+    for( int corner = 0; corner < 8; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sx );
+    }
+    for( int corner = 0; corner < 4; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sy );
+    }
+    for( int corner = 0; corner < 2; ++corner )
+    {
+        corners[ corner ] = LerpNoise( corners[ corner * 2 ], corners[ corner * 2 + 1 ], sz );
+    }
+    return PERLIN_SCALE_4D * LerpNoise( corners[ 0 ], corners[ 1 ], Fade( ft0 ) );
+}
+
+//-----------------------------------------------------------------------------
+float SmoothNoise::GetSimplexNoise( const float x, const unsigned int seed )
+{
+    const int i0 = FloorToInt( x );
+    const float x0 = x - static_cast<float>( i0 );
+    const float x1 = x0 - 1.f;
+
+    const float n0 = GetSimplexFalloff( 1.f - x0 * x0 ) * Gradient1( RawNoise::GetNoiseUint( i0, seed ), x0 );
+    const float n1 = GetSimplexFalloff( 1.f - x1 * x1 ) * Gradient1( RawNoise::GetNoiseUint( i0 + 1, seed ), x1 );
+    return SIMPLEX_SCALE_1D * ( n0 + n1 );
+}
+
+float SmoothNoise::GetSimplexNoise( const float x, const float y, const unsigned int seed )
+{
+    const float skew = ( x + y ) * SIMPLEX_SKEW_2D;
+    const int i = FloorToInt( x + skew );
+    const int j = FloorToInt( y + skew );
+    const float unskew = static_cast<float>( i + j ) * SIMPLEX_UNSKEW_2D;
+    const float x0 = x - ( static_cast<float>( i ) - unskew );
+    const float y0 = y - ( static_cast<float>( j ) - unskew );
+
+    // Lower or upper triangle of the skewed cell
+    const int i1 = x0 > y0 ? 1 : 0;
+    const int j1 = x0 > y0 ? 0 : 1;
+
+    const float x1 = x0 - static_cast<float>( i1 ) + SIMPLEX_UNSKEW_2D;
+    const float y1 = y0 - static_cast<float>( j1 ) + SIMPLEX_UNSKEW_2D;
+    const float x2 = x0 - 1.f + 2.f * SIMPLEX_UNSKEW_2D;
+    const float y2 = y0 - 1.f + 2.f * SIMPLEX_UNSKEW_2D;
+
+    const float n0 = GetSimplexFalloff( .5f - x0 * x0 - y0 * y0 ) * Gradient2( RawNoise::GetNoiseUint( i, j, seed ), x0, y0 );
+    const float n1 = GetSimplexFalloff( .5f - x1 * x1 - y1 * y1 ) * Gradient2( RawNoise::GetNoiseUint( i + i1, j + j1, seed ), x1, y1 );
+    const float n2 = GetSimplexFalloff( .5f - x2 * x2 - y2 * y2 ) * Gradient2( RawNoise::GetNoiseUint( i + 1, j + 1, seed ), x2, y2 );
+    return SIMPLEX_SCALE_2D * ( n0 + n1 + n2 );
+}
+
+float SmoothNoise::GetSimplexNoise( const float x, const float y, const float z, const unsigned int seed )
+{
+    const float skew = ( x + y + z ) * SIMPLEX_SKEW_3D;
+    const int i = FloorToInt( x + skew );
+    const int j = FloorToInt( y + skew );
+    const int k = FloorToInt( z + skew );
+    const float unskew = static_cast<float>( i + j + k ) * SIMPLEX_UNSKEW_3D;
+    const float x0 = x - ( static_cast<float>( i ) - unskew );
+    const float y0 = y - ( static_cast<float>( j ) - unskew );
+    const float z0 = z - ( static_cast<float>( k ) - unskew );
+
+    // Which of the six tetrahedra, from the order of the offsets
+    const bool xy = x0 >= y0;
+    const bool yz = y0 >= z0;
+    const bool xz = x0 >= z0;
+    const int i1 = xy && xz ? 1 : 0;
+    const int j1 = !xy && yz ? 1 : 0;
+    const int k1 = !xz && !yz ? 1 : 0;
+    const int i2 = xy || xz ? 1 : 0;
+    const int j2 = !xy || yz ? 1 : 0;
+    const int k2 = !xz || !yz ? 1 : 0;
+
+    const float x1 = x0 - static_cast<float>( i1 ) + SIMPLEX_UNSKEW_3D;
+    const float y1 = y0 - static_cast<float>( j1 ) + SIMPLEX_UNSKEW_3D;
+    const float z1 = z0 - static_cast<float>( k1 ) + SIMPLEX_UNSKEW_3D;
+    const float x2 = x0 - static_cast<float>( i2 ) + 2.f * SIMPLEX_UNSKEW_3D;
+    const float y2 = y0 - static_cast<float>( j2 ) + 2.f * SIMPLEX_UNSKEW_3D;
+    const float z2 = z0 - static_cast<float>( k2 ) + 2.f * SIMPLEX_UNSKEW_3D;
+    const float x3 = x0 - 1.f + 3.f * SIMPLEX_UNSKEW_3D;
+    const float y3 = y0 - 1.f + 3.f * SIMPLEX_UNSKEW_3D;
+    const float z3 = z0 - 1.f + 3.f * SIMPLEX_UNSKEW_3D;
+
+    const float n0 = GetSimplexFalloff( .6f - x0 * x0 - y0 * y0 - z0 * z0 ) *
+                     Gradient3( RawNoise::GetNoiseUint( i, j, k, seed ), x0, y0, z0 );
+    const float n1 = GetSimplexFalloff( .6f - x1 * x1 - y1 * y1 - z1 * z1 ) *
+                     Gradient3( RawNoise::GetNoiseUint( i + i1, j + j1, k + k1, seed ), x1, y1, z1 );
+    const float n2 = GetSimplexFalloff( .6f - x2 * x2 - y2 * y2 - z2 * z2 ) *
+                     Gradient3( RawNoise::GetNoiseUint( i + i2, j + j2, k + k2, seed ), x2, y2, z2 );
+    const float n3 = GetSimplexFalloff( .6f - x3 * x3 - y3 * y3 - z3 * z3 ) *
+                     Gradient3( RawNoise::GetNoiseUint( i + 1, j + 1, k + 1, seed ), x3, y3, z3 );
+    return SIMPLEX_SCALE_3D * ( n0 + n1 + n2 + n3 );
+}
+
+float SmoothNoise::GetSimplexNoise( const float x, const float y, const float z, const float t, const unsigned int seed )
+{
+    const float skew = ( x + y + z + t ) * SIMPLEX_SKEW_4D;
+    const int i = FloorToInt( x + skew );
+    const int j = FloorToInt( y + skew );
+    const int k = FloorToInt( z + skew );
+    const int l = FloorToInt( t + skew );
+    const float unskew = static_cast<float>( i + j + k + l ) * SIMPLEX_UNSKEW_4D;
+    const float offsets[ 4 ] = {
+        x - ( static_cast<float>( i ) - unskew ),
+        y - ( static_cast<float>( j ) - unskew ),
+        z - ( static_cast<float>( k ) - unskew ),
+        t - ( static_cast<float>( l ) - unskew ),
+    };
+
+    // Rank each axis by how many others it beats, the simplex walks the axes largest first
+    int ranks[ 4 ] = { 0, 0, 0, 0 };
+    for( int first = 0; first < 4; ++first )
+    {
+        for( int second = first + 1; second < 4; ++second )
+        {
+            ++ranks[ offsets[ first ] > offsets[ second ] ? first : second ];
+        }
+    }
+
+    const int base[ 4 ] = { i, j, k, l };
+    float total = 0.f;
+    for( int corner = 0; corner < 5; ++corner )
+    {
+        // Corner c has stepped along every axis ranked at least 4 - c
+        int lattice[ 4 ];
+        float cornerOffset[ 4 ];
+        float falloff = .6f;
+        for( int axis = 0; axis < 4; ++axis )
+        {
+            const int step = ranks[ axis ] >= 4 - corner ? 1 : 0;
+            lattice[ axis ] = base[ axis ] + step;
+            cornerOffset[ axis ] = offsets[ axis ] - static_cast<float>( step ) + static_cast<float>( corner ) * SIMPLEX_UNSKEW_4D;
+            falloff -= cornerOffset[ axis ] * cornerOffset[ axis ];
+        }
+
+        const unsigned int hash = RawNoise::GetNoiseUint( lattice[ 0 ], lattice[ 1 ], lattice[ 2 ], lattice[ 3 ], seed );
+        total += GetSimplexFalloff( falloff ) * Gradient4( hash, cornerOffset[ 0 ], cornerOffset[ 1 ], cornerOffset[ 2 ], cornerOffset[ 3 ] );
+    }
+    return SIMPLEX_SCALE_4D * total;
+}
+
+//-----------------------------------------------------------------------------
+// sampleOctave( frequency, octaveSeed ) gives one basis sample
+template <typename SampleFunction>
+static float AccumulateOctaves( const NoiseFractalSettings& settings, const unsigned int seed, const SampleFunction& sampleOctave )
+{
+    float total = 0.f;
+    float amplitude = 1.f;
+    float amplitudeSum = 0.f;
+    float frequency = settings.frequency;
+    for( int octave = 0; octave < settings.octaveCount; ++octave )
+    {
+        float sample = sampleOctave( frequency, seed + static_cast<unsigned int>( octave ) );
+        if( settings.isRidged )
+        {
+            sample = 1.f - fabsf( sample );
+            sample = sample * sample * 2.f - 1.f;
+        }
+
+        total += sample * amplitude;
+        amplitudeSum += amplitude;
+        amplitude *= settings.persistence;
+        frequency *= settings.lacunarity;
+    }
+
+    return settings.renormalize && amplitudeSum > 0.f ? total / amplitudeSum : total;
+}
+
+float SmoothNoise::GetFractalNoise( const float x, const NoiseFractalSettings& settings, const unsigned int seed )
+{
+    return AccumulateOctaves( settings, seed, [&]( const float frequency, const unsigned int octaveSeed )
+    {
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise( x * frequency, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise( x * frequency, octaveSeed );
+            default: return GetPerlinNoise( x * frequency, octaveSeed );
+        }
+    } );
+}
+
+float SmoothNoise::GetFractalNoise( const float x, const float y, const NoiseFractalSettings& settings, const unsigned int seed )
+{
+    return AccumulateOctaves( settings, seed, [&]( const float frequency, const unsigned int octaveSeed )
+    {
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise( x * frequency, y * frequency, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise( x * frequency, y * frequency, octaveSeed );
+            default: return GetPerlinNoise( x * frequency, y * frequency, octaveSeed );
+        }
+    } );
+}
+
+float SmoothNoise::GetFractalNoise( const float x, const float y, const float z, const NoiseFractalSettings& settings,
+                                    const unsigned int seed )
+{
+    return AccumulateOctaves( settings, seed, [&]( const float frequency, const unsigned int octaveSeed )
+    {
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise( x * frequency, y * frequency, z * frequency, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise( x * frequency, y * frequency, z * frequency, octaveSeed );
+            default: return GetPerlinNoise( x * frequency, y * frequency, z * frequency, octaveSeed );
+        }
+    } );
+}
+
+float SmoothNoise::GetFractalNoise( const float x, const float y, const float z, const float t,
+                                    const NoiseFractalSettings& settings, const unsigned int seed )
+{
+    return AccumulateOctaves( settings, seed, [&]( const float frequency, const unsigned int octaveSeed )
+    {
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise( x * frequency, y * frequency, z * frequency, t * frequency, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise( x * frequency, y * frequency, z * frequency, t * frequency, octaveSeed );
+            default: return GetPerlinNoise( x * frequency, y * frequency, z * frequency, t * frequency, octaveSeed );
+        }
+    } );
+}
+
+float SmoothNoise::GetWarpedNoise( const float x, const float y, const NoiseFractalSettings& settings,
+                                   const NoiseWarpSettings& warp, const unsigned int seed )
+{
+    const float offsetX = GetFractalNoise( x, y, warp.offsetNoise, seed + WARP_SEED_X );
+    const float offsetY = GetFractalNoise( x, y, warp.offsetNoise, seed + WARP_SEED_Y );
+    return GetFractalNoise( x + offsetX * warp.amplitude, y + offsetY * warp.amplitude, settings, seed );
+}
+
+float SmoothNoise::GetWarpedNoise( const float x, const float y, const float z, const NoiseFractalSettings& settings,
+                                   const NoiseWarpSettings& warp, const unsigned int seed )
+{
+    const float offsetX = GetFractalNoise( x, y, z, warp.offsetNoise, seed + WARP_SEED_X );
+    const float offsetY = GetFractalNoise( x, y, z, warp.offsetNoise, seed + WARP_SEED_Y );
+    const float offsetZ = GetFractalNoise( x, y, z, warp.offsetNoise, seed + WARP_SEED_Z );
+    return GetFractalNoise( x + offsetX * warp.amplitude, y + offsetY * warp.amplitude, z + offsetZ * warp.amplitude,
+                            settings, seed );
+}
+
+//-----------------------------------------------------------------------------
+// Four samples per call, one per lane
+#if defined(ENGINE_SIMD_SSE)
+// The y and z parts of the 3D lattice index, shared by the corners of a cell
+static void GetLatticeOffsets4( const __m128i& iy, const __m128i& iz, __m128i* offsets )
+{
+    const __m128i yPrime = _mm_set1_epi32( 198491317 );
+    const __m128i zPrime = _mm_set1_epi32( 6542989 );
+    const __m128i nearY = RawNoise::MultiplyLow32( iy, yPrime );
+    const __m128i farY = _mm_add_epi32( nearY, yPrime );
+    const __m128i nearZ = RawNoise::MultiplyLow32( iz, zPrime );
+    const __m128i farZ = _mm_add_epi32( nearZ, zPrime );
+    offsets[ 0 ] = _mm_add_epi32( nearY, nearZ );
+    offsets[ 1 ] = _mm_add_epi32( farY, nearZ );
+    offsets[ 2 ] = _mm_add_epi32( nearY, farZ );
+    offsets[ 3 ] = _mm_add_epi32( farY, farZ );
+}
+
+static __m128i FloorToInt4( const __m128& value )
+{
+    const __m128i truncated = _mm_cvttps_epi32( value );
+    const __m128 isBelow = _mm_cmplt_ps( value, _mm_cvtepi32_ps( truncated ) );
+    return _mm_add_epi32( truncated, _mm_castps_si128( isBelow ) );
+}
+
+static __m128 Select4( const __m128& mask, const __m128& ifTrue, const __m128& ifFalse )
+{
+    return _mm_or_ps( _mm_and_ps( mask, ifTrue ), _mm_andnot_ps( mask, ifFalse ) );
+}
+
+// Lanes of hash with bit set, as a float mask
+static __m128 HasBit4( const __m128i& hash, const int bit )
+{
+    const __m128i bitMask = _mm_set1_epi32( bit );
+    return _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( hash, bitMask ), bitMask ) );
+}
+
+// Flips the sign of value where the bit of hash is set
+static __m128 FlipSign4( const __m128i& hash, const int bit, const __m128& value )
+{
+    return _mm_xor_ps( value, _mm_and_ps( HasBit4( hash, bit ), _mm_set1_ps( -0.f ) ) );
+}
+
+static __m128 Fade4( const __m128& t )
+{
+    const __m128 inner = _mm_add_ps( _mm_mul_ps( t, _mm_sub_ps( _mm_mul_ps( t, _mm_set1_ps( 6.f ) ), _mm_set1_ps( 15.f ) ) ),
+                                     _mm_set1_ps( 10.f ) );
+    return _mm_mul_ps( _mm_mul_ps( _mm_mul_ps( t, t ), t ), inner );
+}
+
+static __m128 Lerp4( const __m128& a, const __m128& b, const __m128& t )
+{
+    return _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a ) ) );
+}
+
+static __m128 GetLatticeValue4( const __m128i& hash )
+{
+    return _mm_sub_ps( _mm_mul_ps( _mm_cvtepi32_ps( _mm_srli_epi32( hash, 8 ) ), _mm_set1_ps( VALUE_SCALE ) ), _mm_set1_ps( 1.f ) );
+}
+
+static __m128 GetSimplexFalloff4( const __m128& t )
+{
+    const __m128 clamped = _mm_max_ps( t, _mm_setzero_ps() );
+    const __m128 squared = _mm_mul_ps( clamped, clamped );
+    return _mm_mul_ps( squared, squared );
+}
+
+static __m128 Gradient2_4( const __m128i& hash, const __m128& x, const __m128& y )
+{
+    const __m128 isHigh = HasBit4( hash, 4 );
+    const __m128 u = Select4( isHigh, y, x );
+    const __m128 v = Select4( isHigh, x, y );
+    return _mm_add_ps( FlipSign4( hash, 1, u ), FlipSign4( hash, 2, _mm_mul_ps( v, _mm_set1_ps( 2.f ) ) ) );
+}
+
+static __m128 Gradient3_4( const __m128i& hash, const __m128& x, const __m128& y, const __m128& z )
+{
+    const __m128i low4 = _mm_and_si128( hash, _mm_set1_epi32( 15 ) );
+    const __m128 isBelow8 = _mm_castsi128_ps( _mm_cmplt_epi32( low4, _mm_set1_epi32( 8 ) ) );
+    const __m128 isBelow4 = _mm_castsi128_ps( _mm_cmplt_epi32( low4, _mm_set1_epi32( 4 ) ) );
+    const __m128 is12Or14 = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( low4, _mm_set1_epi32( 13 ) ), _mm_set1_epi32( 12 ) ) );
+
+    const __m128 u = Select4( isBelow8, x, y );
+    const __m128 v = Select4( isBelow4, y, Select4( is12Or14, x, z ) );
+    return _mm_add_ps( FlipSign4( hash, 1, u ), FlipSign4( hash, 2, v ) );
+}
+
+static __m128 GetValueNoise4( const __m128& x, const __m128& y, const unsigned int seed )
+{
+    const __m128i ix = FloorToInt4( x );
+    const __m128i iy = FloorToInt4( y );
+    const __m128i one = _mm_set1_epi32( 1 );
+    const __m128i ix1 = _mm_add_epi32( ix, one );
+    const __m128i iy1 = _mm_add_epi32( iy, one );
+    const __m128 sx = Fade4( _mm_sub_ps( x, _mm_cvtepi32_ps( ix ) ) );
+    const __m128 sy = Fade4( _mm_sub_ps( y, _mm_cvtepi32_ps( iy ) ) );
+
+    const __m128 v00 = GetLatticeValue4( RawNoise::GetNoiseUint4( ix, iy, seed ) );
+    const __m128 v10 = GetLatticeValue4( RawNoise::GetNoiseUint4( ix1, iy, seed ) );
+    const __m128 v01 = GetLatticeValue4( RawNoise::GetNoiseUint4( ix, iy1, seed ) );
+    const __m128 v11 = GetLatticeValue4( RawNoise::GetNoiseUint4( ix1, iy1, seed ) );
+    return Lerp4( Lerp4( v00, v10, sx ), Lerp4( v01, v11, sx ), sy );
+}
+
+static __m128 GetValueNoise4( const __m128& x, const __m128& y, const __m128& z, const unsigned int seed )
+{
+    const __m128i ix = FloorToInt4( x );
+    const __m128i iy = FloorToInt4( y );
+    const __m128i iz = FloorToInt4( z );
+    const __m128i one = _mm_set1_epi32( 1 );
+    const __m128i ix1 = _mm_add_epi32( ix, one );
+    __m128i offsets[ 4 ];
+    GetLatticeOffsets4( iy, iz, offsets );
+    const __m128 sx = Fade4( _mm_sub_ps( x, _mm_cvtepi32_ps( ix ) ) );
+    const __m128 sy = Fade4( _mm_sub_ps( y, _mm_cvtepi32_ps( iy ) ) );
+    const __m128 sz = Fade4( _mm_sub_ps( z, _mm_cvtepi32_ps( iz ) ) );
+
+    const __m128 v000 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 0 ] ), seed ) );
+    const __m128 v100 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 0 ] ), seed ) );
+    const __m128 v010 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 1 ] ), seed ) );
+    const __m128 v110 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 1 ] ), seed ) );
+    const __m128 v001 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 2 ] ), seed ) );
+    const __m128 v101 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 2 ] ), seed ) );
+    const __m128 v011 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 3 ] ), seed ) );
+    const __m128 v111 = GetLatticeValue4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 3 ] ), seed ) );
+
+    const __m128 near = Lerp4( Lerp4( v000, v100, sx ), Lerp4( v010, v110, sx ), sy );
+    const __m128 far = Lerp4( Lerp4( v001, v101, sx ), Lerp4( v011, v111, sx ), sy );
+    return Lerp4( near, far, sz );
+}
+
+static __m128 GetPerlinNoise4( const __m128& x, const __m128& y, const unsigned int seed )
+{
+    const __m128i ix = FloorToInt4( x );
+    const __m128i iy = FloorToInt4( y );
+    const __m128i one = _mm_set1_epi32( 1 );
+    const __m128i ix1 = _mm_add_epi32( ix, one );
+    const __m128i iy1 = _mm_add_epi32( iy, one );
+    const __m128 fx0 = _mm_sub_ps( x, _mm_cvtepi32_ps( ix ) );
+    const __m128 fy0 = _mm_sub_ps( y, _mm_cvtepi32_ps( iy ) );
+    const __m128 fx1 = _mm_sub_ps( fx0, _mm_set1_ps( 1.f ) );
+    const __m128 fy1 = _mm_sub_ps( fy0, _mm_set1_ps( 1.f ) );
+
+    const __m128 n00 = Gradient2_4( RawNoise::GetNoiseUint4( ix, iy, seed ), fx0, fy0 );
+    const __m128 n10 = Gradient2_4( RawNoise::GetNoiseUint4( ix1, iy, seed ), fx1, fy0 );
+    const __m128 n01 = Gradient2_4( RawNoise::GetNoiseUint4( ix, iy1, seed ), fx0, fy1 );
+    const __m128 n11 = Gradient2_4( RawNoise::GetNoiseUint4( ix1, iy1, seed ), fx1, fy1 );
+
+    const __m128 sx = Fade4( fx0 );
+    const __m128 result = Lerp4( Lerp4( n00, n10, sx ), Lerp4( n01, n11, sx ), Fade4( fy0 ) );
+    return _mm_mul_ps( _mm_set1_ps( PERLIN_SCALE_2D ), result );
+}
+
+static __m128 GetPerlinNoise4( const __m128& x, const __m128& y, const __m128& z, const unsigned int seed )
+{
+    const __m128i ix = FloorToInt4( x );
+    const __m128i iy = FloorToInt4( y );
+    const __m128i iz = FloorToInt4( z );
+    const __m128i one = _mm_set1_epi32( 1 );
+    const __m128i ix1 = _mm_add_epi32( ix, one );
+    __m128i offsets[ 4 ];
+    GetLatticeOffsets4( iy, iz, offsets );
+    const __m128 fx0 = _mm_sub_ps( x, _mm_cvtepi32_ps( ix ) );
+    const __m128 fy0 = _mm_sub_ps( y, _mm_cvtepi32_ps( iy ) );
+    const __m128 fz0 = _mm_sub_ps( z, _mm_cvtepi32_ps( iz ) );
+    const __m128 fx1 = _mm_sub_ps( fx0, _mm_set1_ps( 1.f ) );
+    const __m128 fy1 = _mm_sub_ps( fy0, _mm_set1_ps( 1.f ) );
+    const __m128 fz1 = _mm_sub_ps( fz0, _mm_set1_ps( 1.f ) );
+
+    const __m128 n000 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 0 ] ), seed ), fx0, fy0, fz0 );
+    const __m128 n100 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 0 ] ), seed ), fx1, fy0, fz0 );
+    const __m128 n010 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 1 ] ), seed ), fx0, fy1, fz0 );
+    const __m128 n110 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 1 ] ), seed ), fx1, fy1, fz0 );
+    const __m128 n001 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 2 ] ), seed ), fx0, fy0, fz1 );
+    const __m128 n101 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 2 ] ), seed ), fx1, fy0, fz1 );
+    const __m128 n011 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix, offsets[ 3 ] ), seed ), fx0, fy1, fz1 );
+    const __m128 n111 = Gradient3_4( RawNoise::GetNoiseUint4( _mm_add_epi32( ix1, offsets[ 3 ] ), seed ), fx1, fy1, fz1 );
+
+    const __m128 sx = Fade4( fx0 );
+    const __m128 sy = Fade4( fy0 );
+    const __m128 near = Lerp4( Lerp4( n000, n100, sx ), Lerp4( n010, n110, sx ), sy );
+    const __m128 far = Lerp4( Lerp4( n001, n101, sx ), Lerp4( n011, n111, sx ), sy );
+    return _mm_mul_ps( _mm_set1_ps( PERLIN_SCALE_3D ), Lerp4( near, far, Fade4( fz0 ) ) );
+}
+
+static __m128 GetSimplexNoise4( const __m128& x, const __m128& y, const unsigned int seed )
+{
+    const __m128 skew = _mm_mul_ps( _mm_add_ps( x, y ), _mm_set1_ps( SIMPLEX_SKEW_2D ) );
+    const __m128i i = FloorToInt4( _mm_add_ps( x, skew ) );
+    const __m128i j = FloorToInt4( _mm_add_ps( y, skew ) );
+    const __m128 unskew = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( i, j ) ), _mm_set1_ps( SIMPLEX_UNSKEW_2D ) );
+    const __m128 x0 = _mm_sub_ps( x, _mm_sub_ps( _mm_cvtepi32_ps( i ), unskew ) );
+    const __m128 y0 = _mm_sub_ps( y, _mm_sub_ps( _mm_cvtepi32_ps( j ), unskew ) );
+
+    const __m128 one = _mm_set1_ps( 1.f );
+    const __m128 isLower = _mm_cmpgt_ps( x0, y0 );
+    const __m128 i1 = _mm_and_ps( isLower, one );
+    const __m128 j1 = _mm_andnot_ps( isLower, one );
+
+    const __m128 unskew1 = _mm_set1_ps( SIMPLEX_UNSKEW_2D );
+    const __m128 unskew2 = _mm_set1_ps( 2.f * SIMPLEX_UNSKEW_2D );
+    const __m128 x1 = _mm_add_ps( _mm_sub_ps( x0, i1 ), unskew1 );
+    const __m128 y1 = _mm_add_ps( _mm_sub_ps( y0, j1 ), unskew1 );
+    const __m128 x2 = _mm_add_ps( _mm_sub_ps( x0, one ), unskew2 );
+    const __m128 y2 = _mm_add_ps( _mm_sub_ps( y0, one ), unskew2 );
+
+    const __m128 half = _mm_set1_ps( .5f );
+    const __m128 t0 = _mm_sub_ps( _mm_sub_ps( half, _mm_mul_ps( x0, x0 ) ), _mm_mul_ps( y0, y0 ) );
+    const __m128 t1 = _mm_sub_ps( _mm_sub_ps( half, _mm_mul_ps( x1, x1 ) ), _mm_mul_ps( y1, y1 ) );
+    const __m128 t2 = _mm_sub_ps( _mm_sub_ps( half, _mm_mul_ps( x2, x2 ) ), _mm_mul_ps( y2, y2 ) );
+
+    const __m128i oneInt = _mm_set1_epi32( 1 );
+    const __m128i i1Int = _mm_and_si128( _mm_castps_si128( isLower ), oneInt );
+    const __m128i j1Int = _mm_andnot_si128( _mm_castps_si128( isLower ), oneInt );
+    const __m128 n0 = _mm_mul_ps( GetSimplexFalloff4( t0 ), Gradient2_4( RawNoise::GetNoiseUint4( i, j, seed ), x0, y0 ) );
+    const __m128 n1 = _mm_mul_ps( GetSimplexFalloff4( t1 ),
+                                  Gradient2_4( RawNoise::GetNoiseUint4( _mm_add_epi32( i, i1Int ), _mm_add_epi32( j, j1Int ), seed ), x1, y1 ) );
+    const __m128 n2 = _mm_mul_ps( GetSimplexFalloff4( t2 ),
+                                  Gradient2_4( RawNoise::GetNoiseUint4( _mm_add_epi32( i, oneInt ), _mm_add_epi32( j, oneInt ), seed ), x2, y2 ) );
+    return _mm_mul_ps( _mm_set1_ps( SIMPLEX_SCALE_2D ), _mm_add_ps( _mm_add_ps( n0, n1 ), n2 ) );
+}
+
+static __m128 GetSimplexNoise4( const __m128& x, const __m128& y, const __m128& z, const unsigned int seed )
+{
+    const __m128 skew = _mm_mul_ps( _mm_add_ps( _mm_add_ps( x, y ), z ), _mm_set1_ps( SIMPLEX_SKEW_3D ) );
+    const __m128i i = FloorToInt4( _mm_add_ps( x, skew ) );
+    const __m128i j = FloorToInt4( _mm_add_ps( y, skew ) );
+    const __m128i k = FloorToInt4( _mm_add_ps( z, skew ) );
+    const __m128 unskew = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( _mm_add_epi32( i, j ), k ) ), _mm_set1_ps( SIMPLEX_UNSKEW_3D ) );
+    const __m128 x0 = _mm_sub_ps( x, _mm_sub_ps( _mm_cvtepi32_ps( i ), unskew ) );
+    const __m128 y0 = _mm_sub_ps( y, _mm_sub_ps( _mm_cvtepi32_ps( j ), unskew ) );
+    const __m128 z0 = _mm_sub_ps( z, _mm_sub_ps( _mm_cvtepi32_ps( k ), unskew ) );
+
+    const __m128 xy = _mm_cmpge_ps( x0, y0 );
+    const __m128 yz = _mm_cmpge_ps( y0, z0 );
+    const __m128 xz = _mm_cmpge_ps( x0, z0 );
+    const __m128 i1 = _mm_and_ps( xy, xz );
+    const __m128 j1 = _mm_andnot_ps( xy, yz );
+    const __m128 k1 = _mm_andnot_ps( _mm_or_ps( xz, yz ), _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+    const __m128 i2 = _mm_or_ps( xy, xz );
+    const __m128 j2 = _mm_or_ps( _mm_andnot_ps( xy, _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) ), yz );
+    const __m128 k2 = _mm_andnot_ps( _mm_and_ps( xz, yz ), _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+
+    const __m128 one = _mm_set1_ps( 1.f );
+    const __m128 unskew1 = _mm_set1_ps( SIMPLEX_UNSKEW_3D );
+    const __m128 unskew2 = _mm_set1_ps( 2.f * SIMPLEX_UNSKEW_3D );
+    const __m128 unskew3 = _mm_set1_ps( 3.f * SIMPLEX_UNSKEW_3D );
+    const __m128 x1 = _mm_add_ps( _mm_sub_ps( x0, _mm_and_ps( i1, one ) ), unskew1 );
+    const __m128 y1 = _mm_add_ps( _mm_sub_ps( y0, _mm_and_ps( j1, one ) ), unskew1 );
+    const __m128 z1 = _mm_add_ps( _mm_sub_ps( z0, _mm_and_ps( k1, one ) ), unskew1 );
+    const __m128 x2 = _mm_add_ps( _mm_sub_ps( x0, _mm_and_ps( i2, one ) ), unskew2 );
+    const __m128 y2 = _mm_add_ps( _mm_sub_ps( y0, _mm_and_ps( j2, one ) ), unskew2 );
+    const __m128 z2 = _mm_add_ps( _mm_sub_ps( z0, _mm_and_ps( k2, one ) ), unskew2 );
+    const __m128 x3 = _mm_add_ps( _mm_sub_ps( x0, one ), unskew3 );
+    const __m128 y3 = _mm_add_ps( _mm_sub_ps( y0, one ), unskew3 );
+    const __m128 z3 = _mm_add_ps( _mm_sub_ps( z0, one ), unskew3 );
+
+    const __m128 falloffStart = _mm_set1_ps( .6f );
+    const __m128 t0 = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( falloffStart, _mm_mul_ps( x0, x0 ) ), _mm_mul_ps( y0, y0 ) ), _mm_mul_ps( z0, z0 ) );
+    const __m128 t1 = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( falloffStart, _mm_mul_ps( x1, x1 ) ), _mm_mul_ps( y1, y1 ) ), _mm_mul_ps( z1, z1 ) );
+    const __m128 t2 = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( falloffStart, _mm_mul_ps( x2, x2 ) ), _mm_mul_ps( y2, y2 ) ), _mm_mul_ps( z2, z2 ) );
+    const __m128 t3 = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( falloffStart, _mm_mul_ps( x3, x3 ) ), _mm_mul_ps( y3, y3 ) ), _mm_mul_ps( z3, z3 ) );
+
+    // A true mask is -1, so subtracting it steps the lattice coordinate by one
+    const __m128i oneInt = _mm_set1_epi32( 1 );
+    const __m128i hash0 = RawNoise::GetNoiseUint4( i, j, k, seed );
+    const __m128i hash1 = RawNoise::GetNoiseUint4( _mm_sub_epi32( i, _mm_castps_si128( i1 ) ), _mm_sub_epi32( j, _mm_castps_si128( j1 ) ),
+                                      _mm_sub_epi32( k, _mm_castps_si128( k1 ) ), seed );
+    const __m128i hash2 = RawNoise::GetNoiseUint4( _mm_sub_epi32( i, _mm_castps_si128( i2 ) ), _mm_sub_epi32( j, _mm_castps_si128( j2 ) ),
+                                      _mm_sub_epi32( k, _mm_castps_si128( k2 ) ), seed );
+    const __m128i hash3 = RawNoise::GetNoiseUint4( _mm_add_epi32( i, oneInt ), _mm_add_epi32( j, oneInt ), _mm_add_epi32( k, oneInt ), seed );
+
+    const __m128 n0 = _mm_mul_ps( GetSimplexFalloff4( t0 ), Gradient3_4( hash0, x0, y0, z0 ) );
+    const __m128 n1 = _mm_mul_ps( GetSimplexFalloff4( t1 ), Gradient3_4( hash1, x1, y1, z1 ) );
+    const __m128 n2 = _mm_mul_ps( GetSimplexFalloff4( t2 ), Gradient3_4( hash2, x2, y2, z2 ) );
+    const __m128 n3 = _mm_mul_ps( GetSimplexFalloff4( t3 ), Gradient3_4( hash3, x3, y3, z3 ) );
+    return _mm_mul_ps( _mm_set1_ps( SIMPLEX_SCALE_3D ), _mm_add_ps( _mm_add_ps( _mm_add_ps( n0, n1 ), n2 ), n3 ) );
+}
+
+template <typename SampleFunction>
+static __m128 AccumulateOctaves4( const NoiseFractalSettings& settings, const unsigned int seed, const SampleFunction& sampleOctave )
+{
+    __m128 total = _mm_setzero_ps();
+    float amplitude = 1.f;
+    float amplitudeSum = 0.f;
+    float frequency = settings.frequency;
+    for( int octave = 0; octave < settings.octaveCount; ++octave )
+    {
+        __m128 sample = sampleOctave( _mm_set1_ps( frequency ), seed + static_cast<unsigned int>( octave ) );
+        if( settings.isRidged )
+        {
+            sample = _mm_sub_ps( _mm_set1_ps( 1.f ), _mm_andnot_ps( _mm_set1_ps( -0.f ), sample ) );
+            sample = _mm_sub_ps( _mm_mul_ps( _mm_mul_ps( sample, sample ), _mm_set1_ps( 2.f ) ), _mm_set1_ps( 1.f ) );
+        }
+
+        total = _mm_add_ps( total, _mm_mul_ps( sample, _mm_set1_ps( amplitude ) ) );
+        amplitudeSum += amplitude;
+        amplitude *= settings.persistence;
+        frequency *= settings.lacunarity;
+    }
+
+    return settings.renormalize && amplitudeSum > 0.f ? _mm_div_ps( total, _mm_set1_ps( amplitudeSum ) ) : total;
+}
+
+static __m128 GetFractalNoise4( const __m128& x, const __m128& y, const NoiseFractalSettings& settings, const unsigned int seed )
+{
+    return AccumulateOctaves4( settings, seed, [&]( const __m128& frequency, const unsigned int octaveSeed )
+    {
+        const __m128 sampleX = _mm_mul_ps( x, frequency );
+        const __m128 sampleY = _mm_mul_ps( y, frequency );
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise4( sampleX, sampleY, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise4( sampleX, sampleY, octaveSeed );
+            default: return GetPerlinNoise4( sampleX, sampleY, octaveSeed );
+        }
+    } );
+}
+
+static __m128 GetFractalNoise4( const __m128& x, const __m128& y, const __m128& z, const NoiseFractalSettings& settings,
+                                const unsigned int seed )
+{
+    return AccumulateOctaves4( settings, seed, [&]( const __m128& frequency, const unsigned int octaveSeed )
+    {
+        const __m128 sampleX = _mm_mul_ps( x, frequency );
+        const __m128 sampleY = _mm_mul_ps( y, frequency );
+        const __m128 sampleZ = _mm_mul_ps( z, frequency );
+        switch( settings.basis )
+        {
+            case NoiseBasis::VALUE: return GetValueNoise4( sampleX, sampleY, sampleZ, octaveSeed );
+            case NoiseBasis::SIMPLEX: return GetSimplexNoise4( sampleX, sampleY, sampleZ, octaveSeed );
+            default: return GetPerlinNoise4( sampleX, sampleY, sampleZ, octaveSeed );
+        }
+    } );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+//-----------------------------------------------------------------------------
+static void FillNoiseRow( float* output, const int count, const float originX, const float stepX, const float y,
+                          const NoiseFractalSettings& settings, const unsigned int seed, const NoiseWarpSettings* warp )
+{
+    int column = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 origin4 = _mm_set1_ps( originX );
+    const __m128 step4 = _mm_set1_ps( stepX );
+    const __m128 y4 = _mm_set1_ps( y );
+    for( ; column + 4 <= count; column += 4 )
+    {
+        const __m128 columns = _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( column ), _mm_set_epi32( 3, 2, 1, 0 ) ) );
+        const __m128 x4 = _mm_add_ps( origin4, _mm_mul_ps( step4, columns ) );
+        __m128 samples;
+        if( warp != nullptr )
+        {
+            const __m128 amplitude = _mm_set1_ps( warp->amplitude );
+            const __m128 offsetX = GetFractalNoise4( x4, y4, warp->offsetNoise, seed + WARP_SEED_X );
+            const __m128 offsetY = GetFractalNoise4( x4, y4, warp->offsetNoise, seed + WARP_SEED_Y );
+            samples = GetFractalNoise4( _mm_add_ps( x4, _mm_mul_ps( offsetX, amplitude ) ),
+                                        _mm_add_ps( y4, _mm_mul_ps( offsetY, amplitude ) ), settings, seed );
+        }
+        else
+        {
+            samples = GetFractalNoise4( x4, y4, settings, seed );
+        }
+        _mm_storeu_ps( output + column, samples );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; column < count; ++column )
+    {
+        const float x = originX + stepX * static_cast<float>( column );
+        output[ column ] = warp != nullptr ? SmoothNoise::GetWarpedNoise( x, y, settings, *warp, seed )
+                                           : SmoothNoise::GetFractalNoise( x, y, settings, seed );
+    }
+}
+
+static void FillNoiseRow( float* output, const int count, const float originX, const float stepX, const float y,
+                          const float z, const NoiseFractalSettings& settings, const unsigned int seed,
+                          const NoiseWarpSettings* warp )
+{
+    int column = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 origin4 = _mm_set1_ps( originX );
+    const __m128 step4 = _mm_set1_ps( stepX );
+    const __m128 y4 = _mm_set1_ps( y );
+    const __m128 z4 = _mm_set1_ps( z );
+    for( ; column + 4 <= count; column += 4 )
+    {
+        const __m128 columns = _mm_cvtepi32_ps( _mm_add_epi32( _mm_set1_epi32( column ), _mm_set_epi32( 3, 2, 1, 0 ) ) );
+        const __m128 x4 = _mm_add_ps( origin4, _mm_mul_ps( step4, columns ) );
+        __m128 samples;
+        if( warp != nullptr )
+        {
+            const __m128 amplitude = _mm_set1_ps( warp->amplitude );
+            const __m128 offsetX = GetFractalNoise4( x4, y4, z4, warp->offsetNoise, seed + WARP_SEED_X );
+            const __m128 offsetY = GetFractalNoise4( x4, y4, z4, warp->offsetNoise, seed + WARP_SEED_Y );
+            const __m128 offsetZ = GetFractalNoise4( x4, y4, z4, warp->offsetNoise, seed + WARP_SEED_Z );
+            samples = GetFractalNoise4( _mm_add_ps( x4, _mm_mul_ps( offsetX, amplitude ) ),
+                                        _mm_add_ps( y4, _mm_mul_ps( offsetY, amplitude ) ),
+                                        _mm_add_ps( z4, _mm_mul_ps( offsetZ, amplitude ) ), settings, seed );
+        }
+        else
+        {
+            samples = GetFractalNoise4( x4, y4, z4, settings, seed );
+        }
+        _mm_storeu_ps( output + column, samples );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; column < count; ++column )
+    {
+        const float x = originX + stepX * static_cast<float>( column );
+        output[ column ] = warp != nullptr ? SmoothNoise::GetWarpedNoise( x, y, z, settings, *warp, seed )
+                                           : SmoothNoise::GetFractalNoise( x, y, z, settings, seed );
+    }
+}
+
+void SmoothNoise::FillNoiseGrid( float* output, const IntVec2& dimensions, const Vec2& origin, const Vec2& step,
+                                 const NoiseFractalSettings& settings, const unsigned int seed,
+                                 const NoiseWarpSettings* warp )
+{
+    if( output == nullptr || dimensions.x <= 0 || dimensions.y <= 0 )
+    {
+        return;
+    }
+
+    const unsigned int rowsPerBatch = GRID_SAMPLES_PER_BATCH / static_cast<unsigned int>( dimensions.x );
+    JobSystem::INSTANCE().ParallelFor( static_cast<unsigned int>( dimensions.y ), rowsPerBatch > 0 ? rowsPerBatch : 1,
+                                       [&]( const unsigned int startRow, const unsigned int endRow )
+                                       {
+                                           for( unsigned int row = startRow; row < endRow; ++row )
+                                           {
+                                               const float y = origin.y + step.y * static_cast<float>( row );
+                                               FillNoiseRow( output + static_cast<size_t>( row ) * dimensions.x, dimensions.x,
+                                                             origin.x, step.x, y, settings, seed, warp );
+                                           }
+                                       } );
+}
+
+void SmoothNoise::FillNoiseGrid( float* output, const IntVec3& dimensions, const Vec3& origin, const Vec3& step,
+                                 const NoiseFractalSettings& settings, const unsigned int seed,
+                                 const NoiseWarpSettings* warp )
+{
+    if( output == nullptr || dimensions.x <= 0 || dimensions.y <= 0 || dimensions.z <= 0 )
+    {
+        return;
+    }
+
+    // Every ( y, z ) pair is one row of x
+    const unsigned int rowCount = static_cast<unsigned int>( dimensions.y ) * static_cast<unsigned int>( dimensions.z );
+    const unsigned int rowsPerBatch = GRID_SAMPLES_PER_BATCH / static_cast<unsigned int>( dimensions.x );
+    JobSystem::INSTANCE().ParallelFor( rowCount, rowsPerBatch > 0 ? rowsPerBatch : 1,
+                                       [&]( const unsigned int startRow, const unsigned int endRow )
+                                       {
+                                           for( unsigned int row = startRow; row < endRow; ++row )
+                                           {
+                                               const unsigned int rowY = row % static_cast<unsigned int>( dimensions.y );
+                                               const unsigned int rowZ = row / static_cast<unsigned int>( dimensions.y );
+                                               const float y = origin.y + step.y * static_cast<float>( rowY );
+                                               const float z = origin.z + step.z * static_cast<float>( rowZ );
+                                               FillNoiseRow( output + static_cast<size_t>( row ) * dimensions.x, dimensions.x,
+                                                             origin.x, step.x, y, z, settings, seed, warp );
+                                           }
+                                       } );
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/Core/Math/Primatives/IntVec3.hpp"
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+#include "Engine/Core/Math/Primatives/Vec3.hpp"
+
+//-----------------------------------------------------------------------------
+// Coherent noise built on RawNoise. Every lattice point is hashed with RawNoise::GetNoiseUint
+//  and the seed, so results are deterministic and random access like the raw functions.
+//  Samples are roughly in [-1, 1]
+enum class NoiseBasis : unsigned int
+{
+    VALUE,      // Random value per lattice point, blocky but cheapest
+    PERLIN,     // Gradient per lattice point
+    SIMPLEX,    // Gradients on a simplex grid, fewer axis aligned artifacts and cheaper in 3D and 4D
+};
+
+struct NoiseFractalSettings
+{
+    NoiseBasis basis = NoiseBasis::PERLIN;
+    int octaveCount = 1;
+    float frequency = 1.f;      // Cycles per unit of the first octave
+    float persistence = .5f;    // Amplitude scale from one octave to the next
+    float lacunarity = 2.f;     // Frequency scale from one octave to the next
+    bool isRidged = false;      // Folds each octave to sharp crests, ( 1 - |n| )^2 remapped to [-1, 1]
+    bool renormalize = true;    // Divides by the summed amplitudes to stay in about [-1, 1]
+};
+
+// Displaces each sample by a vector of fractal noise before sampling
+struct NoiseWarpSettings
+{
+    NoiseFractalSettings offsetNoise;
+    float amplitude = 1.f;      // Largest displacement, in input units
+};
+
+namespace SmoothNoise
+{
+
+//-----------------------------------------------------------------------------
+// Single samples
+float GetValueNoise( float x, unsigned int seed = 0 );
+float GetValueNoise( float x, float y, unsigned int seed = 0 );
+float GetValueNoise( float x, float y, float z, unsigned int seed = 0 );
+float GetValueNoise( float x, float y, float z, float t, unsigned int seed = 0 );
+
+float GetPerlinNoise( float x, unsigned int seed = 0 );
+float GetPerlinNoise( float x, float y, unsigned int seed = 0 );
+float GetPerlinNoise( float x, float y, float z, unsigned int seed = 0 );
+float GetPerlinNoise( float x, float y, float z, float t, unsigned int seed = 0 );
+
+float GetSimplexNoise( float x, unsigned int seed = 0 );
+float GetSimplexNoise( float x, float y, unsigned int seed = 0 );
+float GetSimplexNoise( float x, float y, float z, unsigned int seed = 0 );
+float GetSimplexNoise( float x, float y, float z, float t, unsigned int seed = 0 );
+
+// Octave i uses seed + i so octaves never line up at the origin
+float GetFractalNoise( float x, const NoiseFractalSettings& settings, unsigned int seed = 0 );
+float GetFractalNoise( float x, float y, const NoiseFractalSettings& settings, unsigned int seed = 0 );
+float GetFractalNoise( float x, float y, float z, const NoiseFractalSettings& settings, unsigned int seed = 0 );
+float GetFractalNoise( float x, float y, float z, float t, const NoiseFractalSettings& settings, unsigned int seed = 0 );
+
+float GetWarpedNoise( float x, float y, const NoiseFractalSettings& settings, const NoiseWarpSettings& warp,
+                      unsigned int seed = 0 );
+float GetWarpedNoise( float x, float y, float z, const NoiseFractalSettings& settings, const NoiseWarpSettings& warp,
+                      unsigned int seed = 0 );
+
+//-----------------------------------------------------------------------------
+// Grids of fractal samples at origin + step * index, x fastest then y then z. Rows are split
+//  across the JobSystem and each row runs four samples per SSE2 step. The results are the same
+//  as GetFractalNoise or GetWarpedNoise at each point. warp is optional
+void FillNoiseGrid( float* output, const IntVec2& dimensions, const Vec2& origin, const Vec2& step,
+                    const NoiseFractalSettings& settings, unsigned int seed = 0,
+                    const NoiseWarpSettings* warp = nullptr );
+void FillNoiseGrid( float* output, const IntVec3& dimensions, const Vec3& origin, const Vec3& step,
+                    const NoiseFractalSettings& settings, unsigned int seed = 0,
+                    const NoiseWarpSettings* warp = nullptr );
+
+}
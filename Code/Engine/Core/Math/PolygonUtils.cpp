@@ -0,0 +1,295 @@
+#include "PolygonUtils.hpp"
+
+#include "Engine/Core/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+// Positive when a -> b -> c turns left
+static float GetTurn( const Vec2& a, const Vec2& b, const Vec2& c )
+{
+    const Vec2 ab = b - a;
+    const Vec2 bc = c - b;
+    return ab.x * bc.y - ab.y * bc.x;
+}
+
+static bool IsCornerConvex( const Vec2& previous, const Vec2& corner, const Vec2& next,
+                            const float toleranceRadians )
+{
+    const float turn = GetTurn( previous, corner, next );
+    if( turn >= 0.f )
+    {
+        return true;
+    }
+
+    const float forward = Vec2::Dot( corner - previous, next - corner );
+    return std::atan2( turn, forward ) >= -toleranceRadians;
+}
+
+// Inside or on the edges of counter-clockwise triangle a b c
+static bool IsPointInTriangle( const Vec2& point, const Vec2& a, const Vec2& b, const Vec2& c )
+{
+    return GetTurn( a, b, point ) >= 0.f && GetTurn( b, c, point ) >= 0.f && GetTurn( c, a, point ) >= 0.f;
+}
+
+// Counter-clockwise copy without repeated or collinear points
+static void GetCleanPolygon( const std::vector<Vec2>& polygon, OUT_PARAM std::vector<Vec2>& cleanPolygon )
+{
+    cleanPolygon = polygon;
+    if( GetSignedArea2D( cleanPolygon ) < 0.f )
+    {
+        std::reverse( cleanPolygon.begin(), cleanPolygon.end() );
+    }
+
+    bool isRemoving = true;
+    while( isRemoving && cleanPolygon.size() >= 3 )
+    {
+        isRemoving = false;
+        for( size_t index = 0; index < cleanPolygon.size() && cleanPolygon.size() >= 3; )
+        {
+            const size_t count = cleanPolygon.size();
+            const Vec2& previous = cleanPolygon[ ( index + count - 1 ) % count ];
+            const Vec2& next = cleanPolygon[ ( index + 1 ) % count ];
+            if( cleanPolygon[ index ] == next || GetTurn( previous, cleanPolygon[ index ], next ) == 0.f )
+            {
+                cleanPolygon.erase( cleanPolygon.begin() + index );
+                isRemoving = true;
+            }
+            else
+            {
+                ++index;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+float GetSignedArea2D( const std::vector<Vec2>& polygon )
+{
+    float doubleArea = 0.f;
+    for( size_t index = 0; index < polygon.size(); ++index )
+    {
+        const Vec2& start = polygon[ index ];
+        const Vec2& end = polygon[ ( index + 1 ) % polygon.size() ];
+        doubleArea += start.x * end.y - end.x * start.y;
+    }
+    return doubleArea * .5f;
+}
+
+void GetConvexHull2D( const std::vector<Vec2>& points, OUT_PARAM std::vector<Vec2>& hull )
+{
+    std::vector<Vec2> sorted = points;
+    std::sort( sorted.begin(), sorted.end(), []( const Vec2& lhs, const Vec2& rhs )
+    {
+        return lhs.x < rhs.x || ( lhs.x == rhs.x && lhs.y < rhs.y );
+    } );
+    sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+
+    hull.clear();
+    if( sorted.size() < 3 )
+    {
+        hull = sorted;
+        return;
+    }
+
+    // Lower chain left to right, then the upper chain back. Each keeps only left turns
+    hull.reserve( sorted.size() + 1 );
+    for( const Vec2& point : sorted )
+    {
+        while( hull.size() >= 2 && GetTurn( hull[ hull.size() - 2 ], hull.back(), point ) <= 0.f )
+        {
+            hull.pop_back();
+        }
+        hull.push_back( point );
+    }
+
+    const size_t lowerCount = hull.size() + 1;
+    for( size_t index = sorted.size() - 1; index-- > 0; )
+    {
+        while( hull.size() >= lowerCount && GetTurn( hull[ hull.size() - 2 ], hull.back(), sorted[ index ] ) <= 0.f )
+        {
+            hull.pop_back();
+        }
+        hull.push_back( sorted[ index ] );
+    }
+
+    // The upper chain ends back on the first point
+    hull.pop_back();
+}
+
+void DecomposeIntoConvexPolygons2D( const std::vector<Vec2>& polygon,
+                                    OUT_PARAM std::vector<std::vector<Vec2>>& convexPieces,
+                                    const float concavityToleranceDegrees )
+{
+    convexPieces.clear();
+
+    std::vector<Vec2> points;
+    GetCleanPolygon( polygon, points );
+    if( points.size() < 3 )
+    {
+        return;
+    }
+
+    const int pointCount = static_cast<int>( points.size() );
+    const float toleranceRadians = ConvertDegreesToRadians( concavityToleranceDegrees );
+
+    // +++++ Ear clipping +++++
+    // Each triangle is counter-clockwise, every clip but the last leaves a diagonal behind
+    std::vector<std::vector<int>> pieces;
+    std::vector<std::pair<int, int>> diagonals;
+    pieces.reserve( pointCount - 2 );
+    diagonals.reserve( pointCount - 3 );
+
+    std::vector<int> remaining( pointCount );
+    for( int index = 0; index < pointCount; ++index )
+    {
+        remaining[ index ] = index;
+    }
+
+    while( remaining.size() > 3 )
+    {
+        const int remainingCount = static_cast<int>( remaining.size() );
+        int earIndex = -1;
+        int fallbackIndex = 0;
+        float fallbackTurn = -INFINITY;
+        for( int corner = 0; corner < remainingCount && earIndex < 0; ++corner )
+        {
+            const Vec2& previous = points[ remaining[ ( corner + remainingCount - 1 ) % remainingCount ] ];
+            const Vec2& current = points[ remaining[ corner ] ];
+            const Vec2& next = points[ remaining[ ( corner + 1 ) % remainingCount ] ];
+
+            const float turn = GetTurn( previous, current, next );
+            if( turn > fallbackTurn )
+            {
+                fallbackTurn = turn;
+                fallbackIndex = corner;
+            }
+            if( turn <= 0.f )
+            {
+                continue;
+            }
+
+            // Only a reflex corner can poke into a convex one's triangle
+            bool isEar = true;
+            for( int other = 0; other < remainingCount && isEar; ++other )
+            {
+                const Vec2& otherPoint = points[ remaining[ other ] ];
+                if( otherPoint == previous || otherPoint == current || otherPoint == next )
+                {
+                    continue;
+                }
+
+                const Vec2& otherPrevious = points[ remaining[ ( other + remainingCount - 1 ) % remainingCount ] ];
+                const Vec2& otherNext = points[ remaining[ ( other + 1 ) % remainingCount ] ];
+                if( GetTurn( otherPrevious, otherPoint, otherNext ) <= 0.f )
+                {
+                    isEar = !IsPointInTriangle( otherPoint, previous, current, next );
+                }
+            }
+
+            if( isEar )
+            {
+                earIndex = corner;
+            }
+        }
+
+        if( earIndex < 0 )
+        {
+            GUARANTEE_RECOVERABLE( false, "DecomposeIntoConvexPolygons2D: Polygon is not simple, pieces may overlap" );
+            earIndex = fallbackIndex;
+        }
+
+        const int previousPoint = remaining[ ( earIndex + remainingCount - 1 ) % remainingCount ];
+        const int nextPoint = remaining[ ( earIndex + 1 ) % remainingCount ];
+        pieces.push_back( { previousPoint, remaining[ earIndex ], nextPoint } );
+        diagonals.emplace_back( nextPoint, previousPoint );
+        remaining.erase( remaining.begin() + earIndex );
+    }
+    pieces.push_back( remaining );
+
+    // +++++ Merging +++++
+    // Diagonal a -> b is an edge of the piece it was clipped with and b -> a of the other one
+    std::map<std::pair<int, int>, int> edgeToTriangle;
+    for( int triangle = 0; triangle < static_cast<int>( pieces.size() ); ++triangle )
+    {
+        for( int corner = 0; corner < 3; ++corner )
+        {
+            edgeToTriangle[ { pieces[ triangle ][ corner ], pieces[ triangle ][ ( corner + 1 ) % 3 ] } ] = triangle;
+        }
+    }
+
+    // Merged triangles point at the piece that took them in
+    std::vector<int> mergedInto( pieces.size() );
+    for( int triangle = 0; triangle < static_cast<int>( pieces.size() ); ++triangle )
+    {
+        mergedInto[ triangle ] = triangle;
+    }
+    auto findPiece = [&]( int triangle )
+    {
+        while( mergedInto[ triangle ] != triangle )
+        {
+            mergedInto[ triangle ] = mergedInto[ mergedInto[ triangle ] ];
+            triangle = mergedInto[ triangle ];
+        }
+        return triangle;
+    };
+
+    std::vector<int> merged;
+    for( const std::pair<int, int>& diagonal : diagonals )
+    {
+        const int diagonalStart = diagonal.first;
+        const int diagonalEnd = diagonal.second;
+        const int pieceIndex = findPiece( edgeToTriangle[ diagonal ] );
+        const int otherIndex = findPiece( edgeToTriangle[ { diagonalEnd, diagonalStart } ] );
+        const std::vector<int>& piece = pieces[ pieceIndex ];
+        const std::vector<int>& other = pieces[ otherIndex ];
+
+        // piece walked from the diagonal's end around to its start, then the rest of other
+        const size_t pieceStart = std::find( piece.begin(), piece.end(), diagonalEnd ) - piece.begin();
+        const size_t otherStart = std::find( other.begin(), other.end(), diagonalStart ) - other.begin();
+        merged.clear();
+        for( size_t step = 0; step < piece.size(); ++step )
+        {
+            merged.push_back( piece[ ( pieceStart + step ) % piece.size() ] );
+        }
+        for( size_t step = 1; step + 1 < other.size(); ++step )
+        {
+            merged.push_back( other[ ( otherStart + step ) % other.size() ] );
+        }
+
+        const size_t mergedCount = merged.size();
+        const size_t startCorner = piece.size() - 1;
+        const bool isStartConvex = IsCornerConvex( points[ merged[ startCorner - 1 ] ],
+                                                   points[ merged[ startCorner ] ],
+                                                   points[ merged[ ( startCorner + 1 ) % mergedCount ] ],
+                                                   toleranceRadians );
+        const bool isEndConvex = IsCornerConvex( points[ merged[ mergedCount - 1 ] ],
+                                                 points[ merged[ 0 ] ],
+                                                 points[ merged[ 1 ] ],
+                                                 toleranceRadians );
+        if( isStartConvex && isEndConvex )
+        {
+            pieces[ pieceIndex ] = merged;
+            pieces[ otherIndex ].clear();
+            mergedInto[ otherIndex ] = pieceIndex;
+        }
+    }
+
+    for( const std::vector<int>& piece : pieces )
+    {
+        if( piece.empty() )
+        {
+            continue;
+        }
+
+        convexPieces.emplace_back();
+        std::vector<Vec2>& convexPiece = convexPieces.back();
+        convexPiece.reserve( piece.size() );
+        for( const int pointIndex : piece )
+        {
+            convexPiece.push_back( points[ pointIndex ] );
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Polygons are lists of points, counter-clockwise unless said otherwise
+
+// Positive for counter-clockwise
+float GetSignedArea2D( const std::vector<Vec2>& polygon );
+
+// Andrew's monotone chain, O( n log n ). Counter-clockwise starting at the lowest x ( then y )
+//  point, with collinear and repeated points dropped. Fewer than 3 points means every point was
+//  on one line
+void GetConvexHull2D( const std::vector<Vec2>& points, OUT_PARAM std::vector<Vec2>& hull );
+
+// Splits a simple polygon of either winding into convex pieces: ear clipping, then merging
+//  triangles back together across every diagonal that leaves both ends convex (Hertel-Mehlhorn,
+//  at most four times the fewest pieces possible). Corners that turn the wrong way by no more
+//  than concavityToleranceDegrees still count as convex, trading a few slightly concave pieces
+//  for fewer of them; take their hulls when they have to be exactly convex
+void DecomposeIntoConvexPolygons2D( const std::vector<Vec2>& polygon,
+                                    OUT_PARAM std::vector<std::vector<Vec2>>& convexPieces,
+                                    float concavityToleranceDegrees = 0.f );
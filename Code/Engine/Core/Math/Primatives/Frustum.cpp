@@ -0,0 +1,78 @@
+#include "Frustum.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/AABB3.hpp"
+#include "Engine/Core/Math/Primatives/Mat44.hpp"
+
+#include <cmath>
+
+// Builds the plane ( a, b, c ) . p + d >= 0 out of two rows of the matrix
+static Plane3D CreatePlaneFromRows( const Vec4& rowA, const Vec4& rowB, const float signB )
+{
+    Plane3D plane( Vec3( rowA.x + rowB.x * signB, rowA.y + rowB.y * signB, rowA.z + rowB.z * signB ),
+                   -(rowA.w + rowB.w * signB) );
+    plane.Normalize();
+    return plane;
+}
+
+STATIC Frustum Frustum::CreateFromWorldToClip( const Mat44& worldToClip )
+{
+    const Mat44& m = worldToClip;
+    const Vec4 rowX( m.Ix, m.Jx, m.Kx, m.Tx );
+    const Vec4 rowY( m.Iy, m.Jy, m.Ky, m.Ty );
+    const Vec4 rowZ( m.Iz, m.Jz, m.Kz, m.Tz );
+    const Vec4 rowW( m.Iw, m.Jw, m.Kw, m.Tw );
+
+    Frustum frustum;
+    frustum.planes[ FRUSTUM_PLANE_LEFT ] = CreatePlaneFromRows( rowW, rowX, 1.f );
+    frustum.planes[ FRUSTUM_PLANE_RIGHT ] = CreatePlaneFromRows( rowW, rowX, -1.f );
+    frustum.planes[ FRUSTUM_PLANE_BOTTOM ] = CreatePlaneFromRows( rowW, rowY, 1.f );
+    frustum.planes[ FRUSTUM_PLANE_TOP ] = CreatePlaneFromRows( rowW, rowY, -1.f );
+    frustum.planes[ FRUSTUM_PLANE_NEAR ] = CreatePlaneFromRows( rowZ, Vec4::ZERO, 0.f );
+    frustum.planes[ FRUSTUM_PLANE_FAR ] = CreatePlaneFromRows( rowW, rowZ, -1.f );
+    return frustum;
+}
+
+bool Frustum::IsPointInside( const Vec3& point ) const
+{
+    for( const Plane3D& plane : planes )
+    {
+        if( plane.GetSignedDistance( point ) < 0.f )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::IsSphereOutside( const Vec3& center, const float radius ) const
+{
+    for( const Plane3D& plane : planes )
+    {
+        if( plane.GetSignedDistance( center ) < -radius )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Frustum::IsAABBOutside( const AABB3& bounds ) const
+{
+    return IsAABBOutside( bounds.GetCenter(), bounds.GetDimensions() * .5f );
+}
+
+bool Frustum::IsAABBOutside( const Vec3& center, const Vec3& halfExtents ) const
+{
+    for( const Plane3D& plane : planes )
+    {
+        const float projectedRadius = fabsf( plane.normal.x ) * halfExtents.x +
+                                      fabsf( plane.normal.y ) * halfExtents.y +
+                                      fabsf( plane.normal.z ) * halfExtents.z;
+        if( plane.GetSignedDistance( center ) < -projectedRadius )
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Plane3D.hpp"
+
+struct AABB3;
+struct Mat44;
+
+enum FrustumPlane : unsigned int
+{
+    FRUSTUM_PLANE_LEFT = 0,
+    FRUSTUM_PLANE_RIGHT,
+    FRUSTUM_PLANE_BOTTOM,
+    FRUSTUM_PLANE_TOP,
+    FRUSTUM_PLANE_NEAR,
+    FRUSTUM_PLANE_FAR,
+
+    FRUSTUM_PLANE_COUNT,
+};
+
+// Six planes with normals pointing into the visible volume
+struct Frustum
+{
+    Plane3D planes[ FRUSTUM_PLANE_COUNT ];
+
+public:
+    Frustum() = default;
+
+    // Expects the D3D clip convention (-w <= x, y <= w and 0 <= z <= w) used by Camera
+    static Frustum CreateFromWorldToClip( const Mat44& worldToClip );
+
+    bool IsPointInside( const Vec3& point ) const;
+    bool IsSphereOutside( const Vec3& center, float radius ) const;
+    bool IsAABBOutside( const AABB3& bounds ) const;
+    bool IsAABBOutside( const Vec3& center, const Vec3& halfExtents ) const;
+};
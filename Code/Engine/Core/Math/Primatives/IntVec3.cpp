@@ -1,2 +1,89 @@
 #include "IntVec3.hpp"
 
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Utils/StringUtils.hpp"
+
+#include <cstdlib>
+
+IntVec3::IntVec3( const IntVec3& copyFrom )
+    : x( copyFrom.x )
+    , y( copyFrom.y )
+    , z( copyFrom.z )
+{
+}
+
+IntVec3::IntVec3( int initialX, int initialY, int initialZ )
+    : x( initialX )
+    , y( initialY )
+    , z( initialZ )
+{
+}
+
+int IntVec3::GetLengthSquared() const
+{
+    return (x * x) + (y * y) + (z * z);
+}
+
+int IntVec3::GetTaxiCabLength() const
+{
+    return abs( x ) + abs( y ) + abs( z );
+}
+
+bool IntVec3::operator==( const IntVec3& compare ) const
+{
+    return x == compare.x && y == compare.y && z == compare.z;
+}
+
+bool IntVec3::operator!=( const IntVec3& compare ) const
+{
+    return x != compare.x || y != compare.y || z != compare.z;
+}
+
+const IntVec3 IntVec3::operator+( const IntVec3& vecToAdd ) const
+{
+    return IntVec3( x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z );
+}
+
+const IntVec3 IntVec3::operator-( const IntVec3& vecToSubtract ) const
+{
+    return IntVec3( x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z );
+}
+
+const IntVec3 IntVec3::operator-() const
+{
+    return IntVec3( -x, -y, -z );
+}
+
+const IntVec3 IntVec3::operator*( int uniformScale ) const
+{
+    return IntVec3( x * uniformScale, y * uniformScale, z * uniformScale );
+}
+
+void IntVec3::operator+=( const IntVec3& vecToAdd )
+{
+    x += vecToAdd.x;
+    y += vecToAdd.y;
+    z += vecToAdd.z;
+}
+
+void IntVec3::operator-=( const IntVec3& vecToSubtract )
+{
+    x -= vecToSubtract.x;
+    y -= vecToSubtract.y;
+    z -= vecToSubtract.z;
+}
+
+void IntVec3::operator=( const IntVec3& copyFrom )
+{
+    x = copyFrom.x;
+    y = copyFrom.y;
+    z = copyFrom.z;
+}
+
+const std::string IntVec3::ToString() const
+{
+    return Stringf( "%d,%d,%d", x, y, z );
+}
+
+STATIC IntVec3 IntVec3::ZERO = IntVec3( 0, 0, 0 );
+STATIC IntVec3 IntVec3::ONE = IntVec3( 1, 1, 1 );
@@ -1,8 +1,43 @@
 #pragma once
 
+#include <string>
+
+/**
+    Three Dimensional Integer Vector, same shape as IntVec2
+*/
 class IntVec3
 {
-    int x;
-    int y;
-    int z;
-};
\ No newline at end of file
+public: // NOTE: this is one of the few cases where we break both the "m_" naming rule AND the avoid-public-members rule
+    int x = 0;
+    int y = 0;
+    int z = 0;
+
+public:
+    // Construction/Destruction
+    ~IntVec3() {}
+    IntVec3() {}
+    IntVec3( const IntVec3& copyFrom );
+    explicit IntVec3( int initialX, int initialY, int initialZ );
+
+    static IntVec3 ZERO;
+    static IntVec3 ONE;
+
+    // Accessors (const methods)
+    int             GetLengthSquared() const;
+    int             GetTaxiCabLength() const;
+
+    // Operators (const)
+    bool		    operator==( const IntVec3& compare ) const;
+    bool		    operator!=( const IntVec3& compare ) const;
+    const IntVec3	operator+( const IntVec3& vecToAdd ) const;
+    const IntVec3	operator-( const IntVec3& vecToSubtract ) const;
+    const IntVec3	operator-() const;
+    const IntVec3	operator*( int uniformScale ) const;
+
+    // Operators (self-mutating / non-const)
+    void		    operator+=( const IntVec3& vecToAdd );
+    void		    operator-=( const IntVec3& vecToSubtract );
+    void		    operator=( const IntVec3& copyFrom );
+
+    const std::string ToString() const;
+};
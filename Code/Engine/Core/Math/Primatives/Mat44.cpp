@@ -2,6 +2,7 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Math/SimdCommon.hpp"
 #include "Engine/Core/Utils/StringUtils.hpp"
 
 Mat44::Mat44( float* sixteenFloatArray )
@@ -311,6 +312,157 @@ Vec4 Mat44::TransformHomogeneous( const Vec4& homogeneousPoint ) const
                  (v.x * Iw) + (v.y * Jw) + (v.z * Kw) + (v.w * Tw) );
 }
 
+#if defined(ENGINE_SIMD_SSE)
+// Four packed Vec3 (12 floats in three registers) to and from one register per component
+static void DeinterleaveVec3s( const float* vec3s, __m128& x, __m128& y, __m128& z )
+{
+    const __m128 a = _mm_loadu_ps( vec3s );     // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps( vec3s + 4 ); // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps( vec3s + 8 ); // z2 x3 y3 z3
+
+    x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 1, 1 ) ),
+                        _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 2, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 1, 2, 2 ) ), c, _MM_SHUFFLE( 3, 0, 2, 0 ) );
+}
+
+static void InterleaveVec3s( const __m128& x, const __m128& y, const __m128& z, float* vec3s )
+{
+    const __m128 a = _mm_shuffle_ps( _mm_unpacklo_ps( x, y ), _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) ),
+                                     _MM_SHUFFLE( 2, 0, 1, 0 ) );
+    const __m128 b = _mm_shuffle_ps( _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) ), _mm_unpackhi_ps( x, y ),
+                                     _MM_SHUFFLE( 1, 0, 2, 0 ) );
+    const __m128 c = _mm_shuffle_ps( _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) ),
+                                     _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+
+    _mm_storeu_ps( vec3s, a );
+    _mm_storeu_ps( vec3s + 4, b );
+    _mm_storeu_ps( vec3s + 8, c );
+}
+
+// x, y and z lanes only, the element after a Vec3 is never touched
+static void StoreVec3( const __m128& vec3, float* destination )
+{
+    _mm_storel_pi( reinterpret_cast<__m64*>( destination ), vec3 );
+    _mm_store_ss( destination + 2, _mm_movehl_ps( vec3, vec3 ) );
+}
+
+// iBasis * weights.x + jBasis * weights.y + kBasis * weights.z + tBasis * weights.w
+static __m128 CombineBases( const __m128& iBasis, const __m128& jBasis, const __m128& kBasis,
+                            const __m128& tBasis, const __m128& weights )
+{
+    __m128 result = _mm_mul_ps( iBasis, _mm_shuffle_ps( weights, weights, _MM_SHUFFLE( 0, 0, 0, 0 ) ) );
+    result = _mm_add_ps( result, _mm_mul_ps( jBasis, _mm_shuffle_ps( weights, weights, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+    result = _mm_add_ps( result, _mm_mul_ps( kBasis, _mm_shuffle_ps( weights, weights, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+    return _mm_add_ps( result, _mm_mul_ps( tBasis, _mm_shuffle_ps( weights, weights, _MM_SHUFFLE( 3, 3, 3, 3 ) ) ) );
+}
+
+// One output component for four inputs. Adds in the scalar order so results match bit for bit
+static __m128 TransformComponent( const __m128& x, const __m128& y, const __m128& z,
+                                  const float i, const float j, const float k )
+{
+    __m128 result = _mm_mul_ps( x, _mm_set1_ps( i ) );
+    result = _mm_add_ps( result, _mm_mul_ps( y, _mm_set1_ps( j ) ) );
+    return _mm_add_ps( result, _mm_mul_ps( z, _mm_set1_ps( k ) ) );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+void Mat44::TransformPositions( const Vec3* positions, const size_t count, Vec3* output ) const
+{
+    size_t index = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 translationX = _mm_set1_ps( Tx );
+    const __m128 translationY = _mm_set1_ps( Ty );
+    const __m128 translationZ = _mm_set1_ps( Tz );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 x, y, z;
+        DeinterleaveVec3s( &positions[ index ].x, x, y, z );
+        const __m128 resultX = _mm_add_ps( TransformComponent( x, y, z, Ix, Jx, Kx ), translationX );
+        const __m128 resultY = _mm_add_ps( TransformComponent( x, y, z, Iy, Jy, Ky ), translationY );
+        const __m128 resultZ = _mm_add_ps( TransformComponent( x, y, z, Iz, Jz, Kz ), translationZ );
+        InterleaveVec3s( resultX, resultY, resultZ, &output[ index ].x );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        output[ index ] = TransformPosition( positions[ index ] );
+    }
+}
+
+void Mat44::TransformVectors( const Vec3* vectors, const size_t count, Vec3* output ) const
+{
+    size_t index = 0;
+#if defined(ENGINE_SIMD_SSE)
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 x, y, z;
+        DeinterleaveVec3s( &vectors[ index ].x, x, y, z );
+        InterleaveVec3s( TransformComponent( x, y, z, Ix, Jx, Kx ),
+                         TransformComponent( x, y, z, Iy, Jy, Ky ),
+                         TransformComponent( x, y, z, Iz, Jz, Kz ), &output[ index ].x );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        output[ index ] = TransformVector( vectors[ index ] );
+    }
+}
+
+void Mat44::TransformPositionsStrided( Vec3* firstPosition, const size_t count, const size_t strideBytes ) const
+{
+    unsigned char* element = reinterpret_cast<unsigned char*>( firstPosition );
+#if defined(ENGINE_SIMD_SSE)
+    // One element at a time with the basis in registers. Gathering strided elements into a
+    //  packed block costs more than it saves
+    const __m128 iBasis = _mm_loadu_ps( &Ix );
+    const __m128 jBasis = _mm_loadu_ps( &Jx );
+    const __m128 kBasis = _mm_loadu_ps( &Kx );
+    const __m128 translation = _mm_loadu_ps( &Tx );
+    for( size_t index = 0; index < count; ++index, element += strideBytes )
+    {
+        float* position = reinterpret_cast<float*>( element );
+        __m128 result = _mm_mul_ps( iBasis, _mm_set1_ps( position[ 0 ] ) );
+        result = _mm_add_ps( result, _mm_mul_ps( jBasis, _mm_set1_ps( position[ 1 ] ) ) );
+        result = _mm_add_ps( result, _mm_mul_ps( kBasis, _mm_set1_ps( position[ 2 ] ) ) );
+        result = _mm_add_ps( result, translation );
+        StoreVec3( result, position );
+    }
+#else
+    for( size_t index = 0; index < count; ++index, element += strideBytes )
+    {
+        Vec3& position = *reinterpret_cast<Vec3*>( element );
+        position = TransformPosition( position );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+}
+
+void Mat44::TransformVectorsStrided( Vec3* firstVector, const size_t count, const size_t strideBytes ) const
+{
+    unsigned char* element = reinterpret_cast<unsigned char*>( firstVector );
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 iBasis = _mm_loadu_ps( &Ix );
+    const __m128 jBasis = _mm_loadu_ps( &Jx );
+    const __m128 kBasis = _mm_loadu_ps( &Kx );
+    for( size_t index = 0; index < count; ++index, element += strideBytes )
+    {
+        float* vector = reinterpret_cast<float*>( element );
+        __m128 result = _mm_mul_ps( iBasis, _mm_set1_ps( vector[ 0 ] ) );
+        result = _mm_add_ps( result, _mm_mul_ps( jBasis, _mm_set1_ps( vector[ 1 ] ) ) );
+        result = _mm_add_ps( result, _mm_mul_ps( kBasis, _mm_set1_ps( vector[ 2 ] ) ) );
+        StoreVec3( result, vector );
+    }
+#else
+    for( size_t index = 0; index < count; ++index, element += strideBytes )
+    {
+        Vec3& vector = *reinterpret_cast<Vec3*>( element );
+        vector = TransformVector( vector );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+}
+
 Vec2 Mat44::GetIBasis2D() const
 {
     return Vec2( Ix, Iy );
@@ -651,6 +803,17 @@ void Mat44::Scale( const Vec3& scale )
 
 void Mat44::Transpose()
 {
+#if defined(ENGINE_SIMD_SSE)
+    __m128 iBasis = _mm_loadu_ps( &Ix );
+    __m128 jBasis = _mm_loadu_ps( &Jx );
+    __m128 kBasis = _mm_loadu_ps( &Kx );
+    __m128 tBasis = _mm_loadu_ps( &Tx );
+    _MM_TRANSPOSE4_PS( iBasis, jBasis, kBasis, tBasis );
+    _mm_storeu_ps( &Ix, iBasis );
+    _mm_storeu_ps( &Jx, jBasis );
+    _mm_storeu_ps( &Kx, kBasis );
+    _mm_storeu_ps( &Tx, tBasis );
+#else
     float temp = Iy;
     Iy = Jx;
     Jx = temp;
@@ -674,12 +837,33 @@ void Mat44::Transpose()
     temp = Kw;
     Kw = Tz;
     Tz = temp;
+#endif // defined(ENGINE_SIMD_SSE)
 }
 
 void Mat44::PushMatrix( const Mat44& arbitraryTransform )
 {
+#if defined(ENGINE_SIMD_SSE)
+    // Column by column, each is this matrix applied to that column of the transform. Same
+    //  order of operations as the scalar path so both give the same bits
+    const __m128 iBasis = _mm_loadu_ps( &Ix );
+    const __m128 jBasis = _mm_loadu_ps( &Jx );
+    const __m128 kBasis = _mm_loadu_ps( &Kx );
+    const __m128 tBasis = _mm_loadu_ps( &Tx );
+
+    const float* t = arbitraryTransform.GetReadonlyFloatArray();
+    const __m128 iColumn = CombineBases( iBasis, jBasis, kBasis, tBasis, _mm_loadu_ps( t ) );
+    const __m128 jColumn = CombineBases( iBasis, jBasis, kBasis, tBasis, _mm_loadu_ps( t + 4 ) );
+    const __m128 kColumn = CombineBases( iBasis, jBasis, kBasis, tBasis, _mm_loadu_ps( t + 8 ) );
+    const __m128 tColumn = CombineBases( iBasis, jBasis, kBasis, tBasis, _mm_loadu_ps( t + 12 ) );
+
+    _mm_storeu_ps( &Ix, iColumn );
+    _mm_storeu_ps( &Jx, jColumn );
+    _mm_storeu_ps( &Kx, kColumn );
+    _mm_storeu_ps( &Tx, tColumn );
+#else
+    // Copies of both, pushing a matrix onto itself reads t while writing this
     const Mat44 a = *this;
-    const Mat44& t = arbitraryTransform;
+    const Mat44 t = arbitraryTransform;
 
     Ix = (a.Ix * t.Ix) + (a.Jx * t.Iy) + (a.Kx * t.Iz) + (a.Tx * t.Iw);
     Iy = (a.Iy * t.Ix) + (a.Jy * t.Iy) + (a.Ky * t.Iz) + (a.Ty * t.Iw);
@@ -700,6 +884,7 @@ void Mat44::PushMatrix( const Mat44& arbitraryTransform )
     Ty = (a.Iy * t.Tx) + (a.Jy * t.Ty) + (a.Ky * t.Tz) + (a.Ty * t.Tw);
     Tz = (a.Iz * t.Tx) + (a.Jz * t.Ty) + (a.Kz * t.Tz) + (a.Tz * t.Tw);
     Tw = (a.Iw * t.Tx) + (a.Jw * t.Ty) + (a.Kw * t.Tz) + (a.Tw * t.Tw);
+#endif // defined(ENGINE_SIMD_SSE)
 }
 
 void Mat44::InvertOrthonormal()
@@ -741,6 +926,98 @@ float& Mat44::operator[]( size_t index )
 
 bool Mat44::Invert()
 {
+#if defined(ENGINE_SIMD_SSE)
+    // Cramer's rule four cofactors at a time, after Intel's "Streaming SIMD Extensions - Inverse
+    //  of 4x4 Matrix". Inverting the transpose and storing it transposed is the same inverse, so
+    //  the column major layout goes through unchanged
+    float* m = &Ix;
+    __m128 scratch = _mm_setzero_ps();
+    __m128 row0, row1, row2, row3;
+    __m128 minor0, minor1, minor2, minor3;
+
+    scratch = _mm_loadh_pi( _mm_loadl_pi( scratch, reinterpret_cast<const __m64*>( m ) ), reinterpret_cast<const __m64*>( m + 4 ) );
+    row1 = _mm_loadh_pi( _mm_loadl_pi( scratch, reinterpret_cast<const __m64*>( m + 8 ) ), reinterpret_cast<const __m64*>( m + 12 ) );
+    row0 = _mm_shuffle_ps( scratch, row1, 0x88 );
+    row1 = _mm_shuffle_ps( row1, scratch, 0xDD );
+    scratch = _mm_loadh_pi( _mm_loadl_pi( scratch, reinterpret_cast<const __m64*>( m + 2 ) ), reinterpret_cast<const __m64*>( m + 6 ) );
+    row3 = _mm_loadh_pi( _mm_loadl_pi( scratch, reinterpret_cast<const __m64*>( m + 10 ) ), reinterpret_cast<const __m64*>( m + 14 ) );
+    row2 = _mm_shuffle_ps( scratch, row3, 0x88 );
+    row3 = _mm_shuffle_ps( row3, scratch, 0xDD );
+
+    scratch = _mm_mul_ps( row2, row3 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    minor0 = _mm_mul_ps( row1, scratch );
+    minor1 = _mm_mul_ps( row0, scratch );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor0 = _mm_sub_ps( _mm_mul_ps( row1, scratch ), minor0 );
+    minor1 = _mm_sub_ps( _mm_mul_ps( row0, scratch ), minor1 );
+    minor1 = _mm_shuffle_ps( minor1, minor1, 0x4E );
+
+    scratch = _mm_mul_ps( row1, row2 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    minor0 = _mm_add_ps( _mm_mul_ps( row3, scratch ), minor0 );
+    minor3 = _mm_mul_ps( row0, scratch );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row3, scratch ) );
+    minor3 = _mm_sub_ps( _mm_mul_ps( row0, scratch ), minor3 );
+    minor3 = _mm_shuffle_ps( minor3, minor3, 0x4E );
+
+    scratch = _mm_mul_ps( _mm_shuffle_ps( row1, row1, 0x4E ), row3 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    row2 = _mm_shuffle_ps( row2, row2, 0x4E );
+    minor0 = _mm_add_ps( _mm_mul_ps( row2, scratch ), minor0 );
+    minor2 = _mm_mul_ps( row0, scratch );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor0 = _mm_sub_ps( minor0, _mm_mul_ps( row2, scratch ) );
+    minor2 = _mm_sub_ps( _mm_mul_ps( row0, scratch ), minor2 );
+    minor2 = _mm_shuffle_ps( minor2, minor2, 0x4E );
+
+    scratch = _mm_mul_ps( row0, row1 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    minor2 = _mm_add_ps( _mm_mul_ps( row3, scratch ), minor2 );
+    minor3 = _mm_sub_ps( _mm_mul_ps( row2, scratch ), minor3 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor2 = _mm_sub_ps( _mm_mul_ps( row3, scratch ), minor2 );
+    minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row2, scratch ) );
+
+    scratch = _mm_mul_ps( row0, row3 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row2, scratch ) );
+    minor2 = _mm_add_ps( _mm_mul_ps( row1, scratch ), minor2 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor1 = _mm_add_ps( _mm_mul_ps( row2, scratch ), minor1 );
+    minor2 = _mm_sub_ps( minor2, _mm_mul_ps( row1, scratch ) );
+
+    scratch = _mm_mul_ps( row0, row2 );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0xB1 );
+    minor1 = _mm_add_ps( _mm_mul_ps( row3, scratch ), minor1 );
+    minor3 = _mm_sub_ps( minor3, _mm_mul_ps( row1, scratch ) );
+    scratch = _mm_shuffle_ps( scratch, scratch, 0x4E );
+    minor1 = _mm_sub_ps( minor1, _mm_mul_ps( row3, scratch ) );
+    minor3 = _mm_add_ps( _mm_mul_ps( row1, scratch ), minor3 );
+
+    __m128 det = _mm_mul_ps( row0, minor0 );
+    det = _mm_add_ps( _mm_shuffle_ps( det, det, 0x4E ), det );
+    det = _mm_add_ss( _mm_shuffle_ps( det, det, 0xB1 ), det );
+
+    // Like the scalar path a singular matrix is left holding the unscaled adjugate
+    const bool isInvertible = _mm_cvtss_f32( det ) != 0.f;
+    if( isInvertible )
+    {
+        det = _mm_div_ss( _mm_set_ss( 1.f ), det );
+        det = _mm_shuffle_ps( det, det, 0x00 );
+        minor0 = _mm_mul_ps( det, minor0 );
+        minor1 = _mm_mul_ps( det, minor1 );
+        minor2 = _mm_mul_ps( det, minor2 );
+        minor3 = _mm_mul_ps( det, minor3 );
+    }
+
+    _mm_storeu_ps( m, minor0 );
+    _mm_storeu_ps( m + 4, minor1 );
+    _mm_storeu_ps( m + 8, minor2 );
+    _mm_storeu_ps( m + 12, minor3 );
+    return isInvertible;
+#else
     const Mat44 copy = *this;
 
     this->Ix = copy.Jy * copy.Kz * copy.Tw -
@@ -868,6 +1145,7 @@ bool Mat44::Invert()
     }
 
     return true;
+#endif // defined(ENGINE_SIMD_SSE)
 }
 
 bool Mat44::operator==( const Mat44& rhs ) const
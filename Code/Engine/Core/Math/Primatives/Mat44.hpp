@@ -4,6 +4,8 @@
 #include "Engine/Core/Math/Primatives/Vec3.hpp"
 #include "Engine/Core/Math/Primatives/Vec4.hpp"
 
+#include <cstddef>
+
 struct Rgba8;
 
 struct Mat44
@@ -77,6 +79,14 @@ public:
     Vec3 TransformPosition( const Vec3& positionQuantity ) const;
     Vec4 TransformHomogeneous( const Vec4& homogeneousPoint ) const;
 
+    // Batched over count elements, SSE2 when ENGINE_SIMD_SSE is on. Same results as the single
+    //  calls, and output may be the input array
+    void TransformPositions( const Vec3* positions, size_t count, Vec3* output ) const;
+    void TransformVectors( const Vec3* vectors, size_t count, Vec3* output ) const;
+    // In place on a Vec3 member of an array of structs, such as the position of each vertex
+    void TransformPositionsStrided( Vec3* firstPosition, size_t count, size_t strideBytes ) const;
+    void TransformVectorsStrided( Vec3* firstVector, size_t count, size_t strideBytes ) const;
+
     //-------------------------------------------------------------------------
     // Basic accessors
     const float* GetReadonlyFloatArray() const { return &Ix; }
@@ -0,0 +1,34 @@
+#include "Plane3D.hpp"
+
+Plane3D::Plane3D( const Vec3& direction, const float dist )
+    : normal( direction )
+      , distance( dist )
+{
+}
+
+Plane3D::Plane3D( const Vec3& direction, const Vec3& point )
+    : normal( direction )
+      , distance( Vec3::Dot( normal, point ) )
+{
+}
+
+float Plane3D::GetSignedDistance( const Vec3& point ) const
+{
+    return Vec3::Dot( normal, point ) - distance;
+}
+
+bool Plane3D::IsOnPositiveSide( const Vec3& point ) const
+{
+    return Vec3::Dot( point, normal ) > distance;
+}
+
+void Plane3D::Normalize()
+{
+    const float length = normal.GetLength();
+    if( length > 0.f )
+    {
+        const float inverseLength = 1.f / length;
+        normal *= inverseLength;
+        distance *= inverseLength;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Vec3.hpp"
+
+struct Plane3D
+{
+    Vec3 normal;
+    float distance = 0.f;
+
+public:
+    Plane3D() = default;
+    Plane3D( const Vec3& direction, float dist );
+    Plane3D( const Vec3& direction, const Vec3& point );
+
+    float GetSignedDistance( const Vec3& point ) const;
+    bool IsOnPositiveSide( const Vec3& point ) const;
+    void Normalize();
+};
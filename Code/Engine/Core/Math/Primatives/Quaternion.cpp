@@ -0,0 +1,505 @@
+#include "Quaternion.hpp"
+
+#include "Engine/Core/Math/FastMath.hpp"
+#include "Engine/Core/Math/FastMathSimd.hpp"
+
+// Above this cosine the slerp weights lose precision and nlerp is indistinguishable
+constexpr float SLERP_NLERP_THRESHOLD = .9995f;
+
+// Below this cosine of the pitch it is treated as straight up or down
+constexpr float EULER_GIMBAL_THRESHOLD = 5e-4f;
+
+//-----------------------------------------------------------------------------
+static Quaternion InterpolateAndNormalize( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    const float x = from.x + percentage * (to.x - from.x);
+    const float y = from.y + percentage * (to.y - from.y);
+    const float z = from.z + percentage * (to.z - from.z);
+    const float w = from.w + percentage * (to.w - from.w);
+    const float inverseLength = 1.f / sqrtf( x * x + y * y + z * z + w * w );
+    return Quaternion( x * inverseLength, y * inverseLength, z * inverseLength, w * inverseLength );
+}
+
+static Quaternion FastInterpolateAndNormalize( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    const float x = from.x + percentage * (to.x - from.x);
+    const float y = from.y + percentage * (to.y - from.y);
+    const float z = from.z + percentage * (to.z - from.z);
+    const float w = from.w + percentage * (to.w - from.w);
+    const float inverseLength = FastMath::InverseSqrt( x * x + y * y + z * z + w * w );
+    return Quaternion( x * inverseLength, y * inverseLength, z * inverseLength, w * inverseLength );
+}
+
+#if defined(ENGINE_SIMD_SSE)
+static void LoadTransposed( const Quaternion* rotations, OUT_PARAM __m128& x, OUT_PARAM __m128& y,
+                            OUT_PARAM __m128& z, OUT_PARAM __m128& w )
+{
+    x = _mm_loadu_ps( &rotations[ 0 ].x );
+    y = _mm_loadu_ps( &rotations[ 1 ].x );
+    z = _mm_loadu_ps( &rotations[ 2 ].x );
+    w = _mm_loadu_ps( &rotations[ 3 ].x );
+    _MM_TRANSPOSE4_PS( x, y, z, w );
+}
+
+static void StoreTransposed( __m128 x, __m128 y, __m128 z, __m128 w, OUT_PARAM Quaternion* rotations )
+{
+    _MM_TRANSPOSE4_PS( x, y, z, w );
+    _mm_storeu_ps( &rotations[ 0 ].x, x );
+    _mm_storeu_ps( &rotations[ 1 ].x, y );
+    _mm_storeu_ps( &rotations[ 2 ].x, z );
+    _mm_storeu_ps( &rotations[ 3 ].x, w );
+}
+
+static __m128 Interpolate4( const __m128& from, const __m128& to, const __m128& percentage )
+{
+    return _mm_add_ps( from, _mm_mul_ps( percentage, _mm_sub_ps( to, from ) ) );
+}
+
+static __m128 Dot4( const __m128& ax, const __m128& ay, const __m128& az, const __m128& aw,
+                    const __m128& bx, const __m128& by, const __m128& bz, const __m128& bw )
+{
+    __m128 dot = _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) );
+    dot = _mm_add_ps( dot, _mm_mul_ps( az, bz ) );
+    return _mm_add_ps( dot, _mm_mul_ps( aw, bw ) );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+//-----------------------------------------------------------------------------
+Quaternion::Quaternion( const float initialX, const float initialY, const float initialZ, const float initialW )
+    : x( initialX )
+    , y( initialY )
+    , z( initialZ )
+    , w( initialW )
+{
+}
+
+STATIC Quaternion Quaternion::CreateFromAxisAngleDegrees( const Vec3& unitAxis, const float angleDegrees )
+{
+    const float halfSin = sinfDegrees( angleDegrees * .5f );
+    const float halfCos = cosfDegrees( angleDegrees * .5f );
+    return Quaternion( unitAxis.x * halfSin, unitAxis.y * halfSin, unitAxis.z * halfSin, halfCos );
+}
+
+// Z * Y * X expanded, each factor a rotation around one axis by half its angle
+STATIC Quaternion Quaternion::CreateFromEulerDegrees( const Vec3& rotationAroundAxis )
+{
+    const float sinX = sinfDegrees( rotationAroundAxis.x * .5f );
+    const float cosX = cosfDegrees( rotationAroundAxis.x * .5f );
+    const float sinY = sinfDegrees( rotationAroundAxis.y * .5f );
+    const float cosY = cosfDegrees( rotationAroundAxis.y * .5f );
+    const float sinZ = sinfDegrees( rotationAroundAxis.z * .5f );
+    const float cosZ = cosfDegrees( rotationAroundAxis.z * .5f );
+
+    return Quaternion( cosZ * cosY * sinX - sinZ * sinY * cosX,
+                       cosZ * sinY * cosX + sinZ * cosY * sinX,
+                       sinZ * cosY * cosX - cosZ * sinY * sinX,
+                       cosZ * cosY * cosX + sinZ * sinY * sinX );
+}
+
+// Branches on the largest diagonal term so the square root never gets close to zero
+STATIC Quaternion Quaternion::CreateFromMatrix( const Mat44& rotation )
+{
+    const Mat44& m = rotation;
+    const float trace = m.Ix + m.Jy + m.Kz;
+
+    Quaternion result;
+    if( trace > 0.f )
+    {
+        const float scale = .5f / sqrtf( trace + 1.f );
+        result = Quaternion( (m.Jz - m.Ky) * scale, (m.Kx - m.Iz) * scale, (m.Iy - m.Jx) * scale, .25f / scale );
+    }
+    else if( m.Ix > m.Jy && m.Ix > m.Kz )
+    {
+        const float scale = 2.f * sqrtf( 1.f + m.Ix - m.Jy - m.Kz );
+        result = Quaternion( .25f * scale, (m.Jx + m.Iy) / scale, (m.Kx + m.Iz) / scale, (m.Jz - m.Ky) / scale );
+    }
+    else if( m.Jy > m.Kz )
+    {
+        const float scale = 2.f * sqrtf( 1.f + m.Jy - m.Ix - m.Kz );
+        result = Quaternion( (m.Jx + m.Iy) / scale, .25f * scale, (m.Ky + m.Jz) / scale, (m.Kx - m.Iz) / scale );
+    }
+    else
+    {
+        const float scale = 2.f * sqrtf( 1.f + m.Kz - m.Ix - m.Jy );
+        result = Quaternion( (m.Kx + m.Iz) / scale, (m.Ky + m.Jz) / scale, .25f * scale, (m.Iy - m.Jx) / scale );
+    }
+
+    result.Normalize();
+    return result;
+}
+
+STATIC Quaternion Quaternion::IDENTITY;
+
+//-----------------------------------------------------------------------------
+Mat44 Quaternion::GetAsMatrix() const
+{
+    const float xx = x * x;
+    const float yy = y * y;
+    const float zz = z * z;
+    const float xy = x * y;
+    const float xz = x * z;
+    const float yz = y * z;
+    const float wx = w * x;
+    const float wy = w * y;
+    const float wz = w * z;
+
+    Mat44 matrix;
+    matrix.Ix = 1.f - 2.f * (yy + zz);
+    matrix.Iy = 2.f * (xy + wz);
+    matrix.Iz = 2.f * (xz - wy);
+
+    matrix.Jx = 2.f * (xy - wz);
+    matrix.Jy = 1.f - 2.f * (xx + zz);
+    matrix.Jz = 2.f * (yz + wx);
+
+    matrix.Kx = 2.f * (xz + wy);
+    matrix.Ky = 2.f * (yz - wx);
+    matrix.Kz = 1.f - 2.f * (xx + yy);
+    return matrix;
+}
+
+// Read back from the matrix terms: Iz is -sin( y ), Jz / Kz and Iy / Ix are the tangents of x and z
+// Pitch comes from atan2 of the first column instead of asin, asin loses most of its precision
+//  near the poles where the roll and yaw need it most
+Vec3 Quaternion::GetEulerDegrees() const
+{
+    const float sinY = -2.f * (x * z - w * y);
+    const float ix = 1.f - 2.f * (y * y + z * z);
+    const float iy = 2.f * (x * y + w * z);
+    const float cosY = sqrtf( ix * ix + iy * iy );
+    const float yDegrees = atan2fDegrees( sinY, cosY );
+
+    if( cosY < EULER_GIMBAL_THRESHOLD )
+    {
+        // x and z turn around the same axis here, so all of it goes to z
+        const float jx = 2.f * (x * y - w * z);
+        const float jy = 1.f - 2.f * (x * x + z * z);
+        return Vec3( 0.f, yDegrees, atan2fDegrees( -jx, jy ) );
+    }
+
+    const float xDegrees = atan2fDegrees( 2.f * (y * z + w * x), 1.f - 2.f * (x * x + y * y) );
+    const float zDegrees = atan2fDegrees( iy, ix );
+    return Vec3( xDegrees, yDegrees, zDegrees );
+}
+
+// v + 2w( q x v ) + 2q x ( q x v ), without building the matrix
+Vec3 Quaternion::RotateVector( const Vec3& vector ) const
+{
+    const Vec3 axis( x, y, z );
+    const Vec3 twiceCross = axis.GetCross( vector ) * 2.f;
+    return vector + twiceCross * w + axis.GetCross( twiceCross );
+}
+
+Quaternion Quaternion::GetConjugate() const
+{
+    return Quaternion( -x, -y, -z, w );
+}
+
+Quaternion Quaternion::GetNormalized() const
+{
+    Quaternion normalized = *this;
+    normalized.Normalize();
+    return normalized;
+}
+
+float Quaternion::GetLengthSquared() const
+{
+    return Dot( *this, *this );
+}
+
+void Quaternion::Normalize()
+{
+    const float lengthSquared = GetLengthSquared();
+    if( lengthSquared <= 0.f )
+    {
+        *this = IDENTITY;
+        return;
+    }
+
+    const float inverseLength = 1.f / sqrtf( lengthSquared );
+    x *= inverseLength;
+    y *= inverseLength;
+    z *= inverseLength;
+    w *= inverseLength;
+}
+
+//-----------------------------------------------------------------------------
+STATIC float Quaternion::Dot( const Quaternion& a, const Quaternion& b )
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+STATIC Quaternion Quaternion::Nlerp( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    // q and -q are the same rotation, the one closer to from is the shorter way
+    const Quaternion target = Dot( from, to ) < 0.f ? Quaternion( -to.x, -to.y, -to.z, -to.w ) : to;
+    return InterpolateAndNormalize( from, target, percentage );
+}
+
+STATIC Quaternion Quaternion::Slerp( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    float cosAngle = Dot( from, to );
+    Quaternion target = to;
+    if( cosAngle < 0.f )
+    {
+        cosAngle = -cosAngle;
+        target = Quaternion( -to.x, -to.y, -to.z, -to.w );
+    }
+
+    if( cosAngle > SLERP_NLERP_THRESHOLD )
+    {
+        return InterpolateAndNormalize( from, target, percentage );
+    }
+
+    const float sinAngle = sqrtf( 1.f - cosAngle * cosAngle );
+    const float angleDegrees = atan2fDegrees( sinAngle, cosAngle );
+    const float inverseSin = 1.f / sinAngle;
+    const float fromWeight = sinfDegrees( (1.f - percentage) * angleDegrees ) * inverseSin;
+    const float toWeight = sinfDegrees( percentage * angleDegrees ) * inverseSin;
+
+    return Quaternion( from.x * fromWeight + target.x * toWeight,
+                       from.y * fromWeight + target.y * toWeight,
+                       from.z * fromWeight + target.z * toWeight,
+                       from.w * fromWeight + target.w * toWeight );
+}
+
+STATIC Quaternion Quaternion::FastNlerp( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    const Quaternion target = Dot( from, to ) < 0.f ? Quaternion( -to.x, -to.y, -to.z, -to.w ) : to;
+    return FastInterpolateAndNormalize( from, target, percentage );
+}
+
+STATIC Quaternion Quaternion::FastSlerp( const Quaternion& from, const Quaternion& to, const float percentage )
+{
+    float cosAngle = Dot( from, to );
+    Quaternion target = to;
+    if( cosAngle < 0.f )
+    {
+        cosAngle = -cosAngle;
+        target = Quaternion( -to.x, -to.y, -to.z, -to.w );
+    }
+
+    if( cosAngle > SLERP_NLERP_THRESHOLD )
+    {
+        return FastInterpolateAndNormalize( from, target, percentage );
+    }
+
+    const float sinAngle = sqrtf( 1.f - cosAngle * cosAngle );
+    const float angleDegrees = FastMath::Atan2Degrees( sinAngle, cosAngle );
+    const float inverseSin = 1.f / sinAngle;
+    const float fromWeight = FastMath::SinDegrees( (1.f - percentage) * angleDegrees ) * inverseSin;
+    const float toWeight = FastMath::SinDegrees( percentage * angleDegrees ) * inverseSin;
+
+    return Quaternion( from.x * fromWeight + target.x * toWeight,
+                       from.y * fromWeight + target.y * toWeight,
+                       from.z * fromWeight + target.z * toWeight,
+                       from.w * fromWeight + target.w * toWeight );
+}
+
+STATIC void Quaternion::Nlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                               Quaternion* results, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 signBit = _mm_set1_ps( -0.f );
+    const __m128 one = _mm_set1_ps( 1.f );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 fromX, fromY, fromZ, fromW;
+        __m128 toX, toY, toZ, toW;
+        LoadTransposed( from + index, fromX, fromY, fromZ, fromW );
+        LoadTransposed( to + index, toX, toY, toZ, toW );
+        const __m128 percentage = _mm_loadu_ps( percentages + index );
+
+        const __m128 cosAngle = Dot4( fromX, fromY, fromZ, fromW, toX, toY, toZ, toW );
+        const __m128 flip = _mm_and_ps( _mm_cmplt_ps( cosAngle, _mm_setzero_ps() ), signBit );
+        const __m128 x = Interpolate4( fromX, _mm_xor_ps( toX, flip ), percentage );
+        const __m128 y = Interpolate4( fromY, _mm_xor_ps( toY, flip ), percentage );
+        const __m128 z = Interpolate4( fromZ, _mm_xor_ps( toZ, flip ), percentage );
+        const __m128 w = Interpolate4( fromW, _mm_xor_ps( toW, flip ), percentage );
+
+        const __m128 inverseLength = _mm_div_ps( one, _mm_sqrt_ps( Dot4( x, y, z, w, x, y, z, w ) ) );
+        StoreTransposed( _mm_mul_ps( x, inverseLength ), _mm_mul_ps( y, inverseLength ),
+                         _mm_mul_ps( z, inverseLength ), _mm_mul_ps( w, inverseLength ), results + index );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        results[ index ] = Nlerp( from[ index ], to[ index ], percentages[ index ] );
+    }
+}
+
+// Exact sines and arctangents have no four wide version, so this is the single one per rotation
+STATIC void Quaternion::Slerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                               Quaternion* results, const unsigned int count )
+{
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        results[ index ] = Slerp( from[ index ], to[ index ], percentages[ index ] );
+    }
+}
+
+STATIC void Quaternion::FastNlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                                   Quaternion* results, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 signBit = _mm_set1_ps( -0.f );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 fromX, fromY, fromZ, fromW;
+        __m128 toX, toY, toZ, toW;
+        LoadTransposed( from + index, fromX, fromY, fromZ, fromW );
+        LoadTransposed( to + index, toX, toY, toZ, toW );
+        const __m128 percentage = _mm_loadu_ps( percentages + index );
+
+        const __m128 cosAngle = Dot4( fromX, fromY, fromZ, fromW, toX, toY, toZ, toW );
+        const __m128 flip = _mm_and_ps( _mm_cmplt_ps( cosAngle, _mm_setzero_ps() ), signBit );
+        const __m128 x = Interpolate4( fromX, _mm_xor_ps( toX, flip ), percentage );
+        const __m128 y = Interpolate4( fromY, _mm_xor_ps( toY, flip ), percentage );
+        const __m128 z = Interpolate4( fromZ, _mm_xor_ps( toZ, flip ), percentage );
+        const __m128 w = Interpolate4( fromW, _mm_xor_ps( toW, flip ), percentage );
+
+        const __m128 inverseLength = FastMath::InverseSqrt4( Dot4( x, y, z, w, x, y, z, w ) );
+        StoreTransposed( _mm_mul_ps( x, inverseLength ), _mm_mul_ps( y, inverseLength ),
+                         _mm_mul_ps( z, inverseLength ), _mm_mul_ps( w, inverseLength ), results + index );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        results[ index ] = FastNlerp( from[ index ], to[ index ], percentages[ index ] );
+    }
+}
+
+// Every lane works out both the nlerp and the slerp and keeps the one the single version would
+STATIC void Quaternion::FastSlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                                   Quaternion* results, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 signBit = _mm_set1_ps( -0.f );
+    const __m128 one = _mm_set1_ps( 1.f );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 fromX, fromY, fromZ, fromW;
+        __m128 toX, toY, toZ, toW;
+        LoadTransposed( from + index, fromX, fromY, fromZ, fromW );
+        LoadTransposed( to + index, toX, toY, toZ, toW );
+        const __m128 percentage = _mm_loadu_ps( percentages + index );
+
+        __m128 cosAngle = Dot4( fromX, fromY, fromZ, fromW, toX, toY, toZ, toW );
+        const __m128 flip = _mm_and_ps( _mm_cmplt_ps( cosAngle, _mm_setzero_ps() ), signBit );
+        cosAngle = _mm_xor_ps( cosAngle, flip );
+        toX = _mm_xor_ps( toX, flip );
+        toY = _mm_xor_ps( toY, flip );
+        toZ = _mm_xor_ps( toZ, flip );
+        toW = _mm_xor_ps( toW, flip );
+
+        const __m128 nlerpX = Interpolate4( fromX, toX, percentage );
+        const __m128 nlerpY = Interpolate4( fromY, toY, percentage );
+        const __m128 nlerpZ = Interpolate4( fromZ, toZ, percentage );
+        const __m128 nlerpW = Interpolate4( fromW, toW, percentage );
+        const __m128 inverseLength = FastMath::InverseSqrt4( Dot4( nlerpX, nlerpY, nlerpZ, nlerpW,
+                                                                       nlerpX, nlerpY, nlerpZ, nlerpW ) );
+
+        const __m128 sinAngle = _mm_sqrt_ps( _mm_sub_ps( one, _mm_mul_ps( cosAngle, cosAngle ) ) );
+        const __m128 angleDegrees = FastMath::Atan2Degrees4( sinAngle, cosAngle );
+        const __m128 inverseSin = _mm_div_ps( one, sinAngle );
+        __m128 fromSin, toSin, unusedCos;
+        FastMath::SinCosDegrees4( _mm_mul_ps( _mm_sub_ps( one, percentage ), angleDegrees ), fromSin, unusedCos );
+        FastMath::SinCosDegrees4( _mm_mul_ps( percentage, angleDegrees ), toSin, unusedCos );
+        const __m128 fromWeight = _mm_mul_ps( fromSin, inverseSin );
+        const __m128 toWeight = _mm_mul_ps( toSin, inverseSin );
+
+        const __m128 useNlerp = _mm_cmpgt_ps( cosAngle, _mm_set1_ps( SLERP_NLERP_THRESHOLD ) );
+        const __m128 x = FastMath::SelectFloat4( useNlerp, _mm_mul_ps( nlerpX, inverseLength ),
+                                                     _mm_add_ps( _mm_mul_ps( fromX, fromWeight ), _mm_mul_ps( toX, toWeight ) ) );
+        const __m128 y = FastMath::SelectFloat4( useNlerp, _mm_mul_ps( nlerpY, inverseLength ),
+                                                     _mm_add_ps( _mm_mul_ps( fromY, fromWeight ), _mm_mul_ps( toY, toWeight ) ) );
+        const __m128 z = FastMath::SelectFloat4( useNlerp, _mm_mul_ps( nlerpZ, inverseLength ),
+                                                     _mm_add_ps( _mm_mul_ps( fromZ, fromWeight ), _mm_mul_ps( toZ, toWeight ) ) );
+        const __m128 w = FastMath::SelectFloat4( useNlerp, _mm_mul_ps( nlerpW, inverseLength ),
+                                                     _mm_add_ps( _mm_mul_ps( fromW, fromWeight ), _mm_mul_ps( toW, toWeight ) ) );
+        StoreTransposed( x, y, z, w, results + index );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        results[ index ] = FastSlerp( from[ index ], to[ index ], percentages[ index ] );
+    }
+}
+
+STATIC void Quaternion::GetAsMatrices( const Quaternion* rotations, Mat44* matrices, const unsigned int count )
+{
+    unsigned int index = 0;
+
+#if defined(ENGINE_SIMD_SSE)
+    const __m128 one = _mm_set1_ps( 1.f );
+    const __m128 two = _mm_set1_ps( 2.f );
+    const __m128 zero = _mm_setzero_ps();
+    for( ; index + 4 <= count; index += 4 )
+    {
+        __m128 x, y, z, w;
+        LoadTransposed( rotations + index, x, y, z, w );
+
+        const __m128 xx = _mm_mul_ps( x, x );
+        const __m128 yy = _mm_mul_ps( y, y );
+        const __m128 zz = _mm_mul_ps( z, z );
+        const __m128 xy = _mm_mul_ps( x, y );
+        const __m128 xz = _mm_mul_ps( x, z );
+        const __m128 yz = _mm_mul_ps( y, z );
+        const __m128 wx = _mm_mul_ps( w, x );
+        const __m128 wy = _mm_mul_ps( w, y );
+        const __m128 wz = _mm_mul_ps( w, z );
+
+        // One register per matrix term across the four rotations, transposed back into columns
+        __m128 ix = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( yy, zz ) ) );
+        __m128 iy = _mm_mul_ps( two, _mm_add_ps( xy, wz ) );
+        __m128 iz = _mm_mul_ps( two, _mm_sub_ps( xz, wy ) );
+        __m128 iw = zero;
+        __m128 jx = _mm_mul_ps( two, _mm_sub_ps( xy, wz ) );
+        __m128 jy = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, zz ) ) );
+        __m128 jz = _mm_mul_ps( two, _mm_add_ps( yz, wx ) );
+        __m128 jw = zero;
+        __m128 kx = _mm_mul_ps( two, _mm_add_ps( xz, wy ) );
+        __m128 ky = _mm_mul_ps( two, _mm_sub_ps( yz, wx ) );
+        __m128 kz = _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, yy ) ) );
+        __m128 kw = zero;
+        _MM_TRANSPOSE4_PS( ix, iy, iz, iw );
+        _MM_TRANSPOSE4_PS( jx, jy, jz, jw );
+        _MM_TRANSPOSE4_PS( kx, ky, kz, kw );
+
+        const __m128 iColumns[ 4 ] = { ix, iy, iz, iw };
+        const __m128 jColumns[ 4 ] = { jx, jy, jz, jw };
+        const __m128 kColumns[ 4 ] = { kx, ky, kz, kw };
+        for( int lane = 0; lane < 4; ++lane )
+        {
+            Mat44& matrix = matrices[ index + lane ];
+            _mm_storeu_ps( &matrix.Ix, iColumns[ lane ] );
+            _mm_storeu_ps( &matrix.Jx, jColumns[ lane ] );
+            _mm_storeu_ps( &matrix.Kx, kColumns[ lane ] );
+            _mm_storeu_ps( &matrix.Tx, _mm_setr_ps( 0.f, 0.f, 0.f, 1.f ) );
+        }
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        matrices[ index ] = rotations[ index ].GetAsMatrix();
+    }
+}
+
+//-----------------------------------------------------------------------------
+Quaternion Quaternion::operator*( const Quaternion& rhs ) const
+{
+    return Quaternion( w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+                       w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+                       w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+                       w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z );
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/Mat44.hpp"
+#include "Engine/Core/Math/Primatives/Vec3.hpp"
+
+//-----------------------------------------------------------------------------
+// Unit quaternion rotation, x y z is the axis scaled by sin( angle / 2 ) and w is cos( angle / 2 ).
+//  Four floats in x y z w order, so four of them load straight into SSE registers.
+//
+// Euler angles follow Transform: degrees around x, then y, then z, the same as
+//  Z * Y * X rotation matrices
+struct Quaternion
+{
+    float x = 0.f;
+    float y = 0.f;
+    float z = 0.f;
+    float w = 1.f;
+
+public:
+    Quaternion() = default;
+    explicit Quaternion( float initialX, float initialY, float initialZ, float initialW );
+
+    static Quaternion CreateFromAxisAngleDegrees( const Vec3& unitAxis, float angleDegrees );
+    static Quaternion CreateFromEulerDegrees( const Vec3& rotationAroundAxis );
+    // Rotation part of the matrix, which must not have scale
+    static Quaternion CreateFromMatrix( const Mat44& rotation );
+
+    static Quaternion IDENTITY;
+
+    //-------------------------------------------------------------------------
+    // Accessors
+    Mat44 GetAsMatrix() const;
+    // y is kept in [-90, 90], within .03 degrees of the poles all of the turn goes into z
+    Vec3 GetEulerDegrees() const;
+    Vec3 RotateVector( const Vec3& vector ) const;
+    Quaternion GetConjugate() const;
+    Quaternion GetNormalized() const;
+    float GetLengthSquared() const;
+
+    void Normalize();
+
+    //-------------------------------------------------------------------------
+    // Interpolation, both take the shorter way around. Nearly equal rotations fall back to Nlerp
+    static float Dot( const Quaternion& a, const Quaternion& b );
+    static Quaternion Nlerp( const Quaternion& from, const Quaternion& to, float percentage );
+    static Quaternion Slerp( const Quaternion& from, const Quaternion& to, float percentage );
+
+    // Same as above with the square roots and angles from FastMath, within 3e-5 of the exact ones.
+    //  Only for callers that can take that error
+    static Quaternion FastNlerp( const Quaternion& from, const Quaternion& to, float percentage );
+    static Quaternion FastSlerp( const Quaternion& from, const Quaternion& to, float percentage );
+
+    // The same bits as the single versions. Four per SSE2 step except Slerp, which has no four wide
+    //  exact sine
+    static void Nlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                       OUT_PARAM Quaternion* results, unsigned int count );
+    static void Slerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                       OUT_PARAM Quaternion* results, unsigned int count );
+    static void FastNlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                           OUT_PARAM Quaternion* results, unsigned int count );
+    static void FastSlerp( const Quaternion* from, const Quaternion* to, const float* percentages,
+                           OUT_PARAM Quaternion* results, unsigned int count );
+    static void GetAsMatrices( const Quaternion* rotations, OUT_PARAM Mat44* matrices, unsigned int count );
+
+    // Rotates by rhs first, then by this, like Mat44 multiplication
+    Quaternion operator*( const Quaternion& rhs ) const;
+};
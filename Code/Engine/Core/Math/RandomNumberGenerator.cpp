@@ -1,5 +1,58 @@
 #include "RandomNumberGenerator.hpp"
 
+#include "Engine/Core/Math/Noise/RawNoiseSimd.hpp"
+#include "Engine/Core/Math/Primatives/Vec2.hpp"
+
+#include <cmath>
+
+// Keeps sub stream seeds apart from the values the parent stream rolls. The 2D key hashes to
+//  keyX + prime * keyY, so it gets its own salt or ( key, 0 ) would match the 1D stream for key
+constexpr unsigned int SUB_STREAM_SALT = 0x9e3779b9;
+constexpr unsigned int SUB_STREAM_SALT_2D = 0x85ebca6b;
+
+//-----------------------------------------------------------------------------
+// Raw bits for positions [position, position + count)
+static void FillNoiseUints( unsigned int* values, const int count, const int position, const unsigned int seed )
+{
+    int index = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128i laneOffsets = _mm_set_epi32( 3, 2, 1, 0 );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        const __m128i positions = _mm_add_epi32( _mm_set1_epi32( position + index ), laneOffsets );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>( values + index ), RawNoise::GetNoiseUint4( positions, seed ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        values[ index ] = RawNoise::GetNoiseUint( position + index, seed );
+    }
+}
+
+// GetNoiseZeroToOne for positions [position, position + count), then lower + value * range
+static void FillNoiseFloats( float* values, const int count, const int position, const unsigned int seed,
+                             const float lower, const float range )
+{
+    int index = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128i laneOffsets = _mm_set_epi32( 3, 2, 1, 0 );
+    const __m128 lower4 = _mm_set1_ps( lower );
+    const __m128 range4 = _mm_set1_ps( range );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        const __m128i positions = _mm_add_epi32( _mm_set1_epi32( position + index ), laneOffsets );
+        const __m128 zeroToOne = RawNoise::GetNoiseZeroToOne4( positions, seed );
+        _mm_storeu_ps( values + index, _mm_add_ps( lower4, _mm_mul_ps( zeroToOne, range4 ) ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        values[ index ] = lower + RawNoise::GetNoiseZeroToOne( position + index, seed ) * range;
+    }
+}
+
 //-----------------------------------------------------------------------------
 RandomNumberGenerator::RandomNumberGenerator( unsigned int seed )
     : m_Seed( seed )
@@ -14,6 +67,18 @@ void RandomNumberGenerator::Reset( unsigned int seed, int position )
     m_Position = position;
 }
 
+//-----------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::CreateSubStream( unsigned int key ) const
+{
+    return RandomNumberGenerator( RawNoise::GetNoiseUint( static_cast<int>( key ), m_Seed ^ SUB_STREAM_SALT ) );
+}
+
+//-----------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::CreateSubStream( int keyX, int keyY ) const
+{
+    return RandomNumberGenerator( RawNoise::GetNoiseUint( keyX, keyY, m_Seed ^ SUB_STREAM_SALT_2D ) );
+}
+
 //-----------------------------------------------------------------------------
 bool RandomNumberGenerator::FiftyFifty()
 {
@@ -119,3 +184,75 @@ void RandomNumberGenerator::RandomDirection( OUT_PARAM float& x,
     x = cosf( radians );
     y = sinf( radians );
 }
+
+//-----------------------------------------------------------------------------
+void RandomNumberGenerator::FillInt32s( OUT_PARAM unsigned int* values, int count )
+{
+    if( count <= 0 )
+    {
+        return;
+    }
+
+    FillNoiseUints( values, count, m_Position, m_Seed );
+    m_Position += count;
+}
+
+//-----------------------------------------------------------------------------
+void RandomNumberGenerator::FillInts( OUT_PARAM int* values, int count,
+                                      int lowerBoundInclusive, int upperBoundInclusive )
+{
+    if( count <= 0 )
+    {
+        return;
+    }
+
+    // SSE2 has no integer divide, so only the hashing is wide
+    unsigned int* bits = reinterpret_cast<unsigned int*>( values );
+    FillNoiseUints( bits, count, m_Position, m_Seed );
+    m_Position += count;
+
+    const unsigned int range = static_cast<unsigned int>( upperBoundInclusive - lowerBoundInclusive + 1 );
+    for( int index = 0; index < count; ++index )
+    {
+        values[ index ] = lowerBoundInclusive + static_cast<int>( bits[ index ] % range );
+    }
+}
+
+//-----------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloats( OUT_PARAM float* values, int count )
+{
+    FillFloats( values, count, 0.f, 1.f );
+}
+
+//-----------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloats( OUT_PARAM float* values, int count,
+                                        float lowerBoundInclusive, float upperBoundInclusive )
+{
+    if( count <= 0 )
+    {
+        return;
+    }
+
+    FillNoiseFloats( values, count, m_Position, m_Seed, lowerBoundInclusive, upperBoundInclusive - lowerBoundInclusive );
+    m_Position += count;
+}
+
+//-----------------------------------------------------------------------------
+void RandomNumberGenerator::RandomDirections( OUT_PARAM Vec2* directions, int count )
+{
+    // Angles a block at a time, rolled the same way RandomDirection does
+    constexpr int ANGLE_BLOCK_SIZE = 64;
+    float radians[ ANGLE_BLOCK_SIZE ];
+    for( int blockStart = 0; blockStart < count; blockStart += ANGLE_BLOCK_SIZE )
+    {
+        const int blockCount = count - blockStart < ANGLE_BLOCK_SIZE ? count - blockStart : ANGLE_BLOCK_SIZE;
+        FillNoiseFloats( radians, blockCount, m_Position, m_Seed, 0.f, g_PIf * 2.f );
+        m_Position += blockCount;
+
+        for( int index = 0; index < blockCount; ++index )
+        {
+            directions[ blockStart + index ].x = cosf( radians[ index ] );
+            directions[ blockStart + index ].y = sinf( radians[ index ] );
+        }
+    }
+}
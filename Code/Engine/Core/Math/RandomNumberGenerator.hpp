@@ -3,6 +3,11 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Math/Noise/RawNoise.hpp"
 
+struct Vec2;
+
+//-----------------------------------------------------------------------------
+// Counter based, every value is RawNoise of ( position, seed ) so any position can be rolled
+//  without rolling the ones before it
 class RandomNumberGenerator
 {
 public:
@@ -15,6 +20,15 @@ public:
     unsigned int GetSeed() const { return m_Seed; }
     int GetPosition() const { return m_Position; }
     void SetPosition( int position ) { m_Position = position; }
+    void Skip( int count ) { m_Position += count; }
+
+    //-------------------------------------------------------------------------
+    // Streams
+    // A generator with a seed derived from this seed and the key, at position 0. The position
+    //  is neither used nor advanced, so a job handed CreateSubStream( jobIndex ) rolls the same
+    //  values however the jobs are scheduled. Sub streams can be split again
+    RandomNumberGenerator CreateSubStream( unsigned int key ) const;
+    RandomNumberGenerator CreateSubStream( int keyX, int keyY ) const;
 
     //-------------------------------------------------------------------------
     // Random Functions
@@ -41,6 +55,15 @@ public:
 
     void RandomDirection( OUT_PARAM float& x, OUT_PARAM float& y );
 
+    //-------------------------------------------------------------------------
+    // Bulk Functions
+    // Same values as count calls to the single function, four positions per SSE2 step
+    void FillInt32s( OUT_PARAM unsigned int* values, int count );
+    void FillInts( OUT_PARAM int* values, int count, int lowerBoundInclusive, int upperBoundInclusive );
+    void FillFloats( OUT_PARAM float* values, int count );
+    void FillFloats( OUT_PARAM float* values, int count, float lowerBoundInclusive, float upperBoundInclusive );
+    void RandomDirections( OUT_PARAM Vec2* directions, int count );
+
 private:
     unsigned int m_Seed = 0;
     int m_Position = 0;
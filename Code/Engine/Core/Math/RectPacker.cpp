@@ -0,0 +1,216 @@
+#include "RectPacker.hpp"
+
+#include <algorithm>
+#include <climits>
+
+//-----------------------------------------------------------------------------
+RectPacker::RectPacker( const IntVec2& binSize )
+{
+    Reset( binSize );
+}
+
+void RectPacker::Reset( const IntVec2& binSize )
+{
+    m_BinSize = binSize;
+    m_UsedArea = 0;
+    m_FreeRects.clear();
+
+    FreeRect wholeBin;
+    wholeBin.maxs = binSize;
+    m_FreeRects.push_back( wholeBin );
+}
+
+bool RectPacker::Insert( const IntVec2& size, OUT_PARAM IntVec2& position )
+{
+    if( size.x <= 0 || size.y <= 0 )
+    {
+        return false;
+    }
+
+    // Best short side fit, ties go to the best long side fit
+    int bestShortSide = INT_MAX;
+    int bestLongSide = INT_MAX;
+    const FreeRect* bestRect = nullptr;
+    for( const FreeRect& freeRect : m_FreeRects )
+    {
+        const int leftoverX = freeRect.maxs.x - freeRect.mins.x - size.x;
+        const int leftoverY = freeRect.maxs.y - freeRect.mins.y - size.y;
+        if( leftoverX < 0 || leftoverY < 0 )
+        {
+            continue;
+        }
+
+        const int shortSide = std::min( leftoverX, leftoverY );
+        const int longSide = std::max( leftoverX, leftoverY );
+        if( shortSide < bestShortSide || ( shortSide == bestShortSide && longSide < bestLongSide ) )
+        {
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            bestRect = &freeRect;
+        }
+    }
+
+    if( bestRect == nullptr )
+    {
+        return false;
+    }
+
+    FreeRect usedRect;
+    usedRect.mins = bestRect->mins;
+    usedRect.maxs = bestRect->mins + size;
+    position = usedRect.mins;
+
+    SplitFreeRects( usedRect );
+    m_UsedArea += static_cast<long long>( size.x ) * size.y;
+    return true;
+}
+
+float RectPacker::GetOccupancy() const
+{
+    const long long binArea = static_cast<long long>( m_BinSize.x ) * m_BinSize.y;
+    return binArea > 0 ? static_cast<float>( static_cast<double>( m_UsedArea ) / static_cast<double>( binArea ) ) : 0.f;
+}
+
+void RectPacker::SplitFreeRects( const FreeRect& usedRect )
+{
+    // Every free rect the used rect touches is replaced by up to four maximal rects around it
+    const size_t oldRectCount = m_FreeRects.size();
+    size_t keptCount = 0;
+    for( size_t rectIndex = 0; rectIndex < oldRectCount; ++rectIndex )
+    {
+        const FreeRect freeRect = m_FreeRects[ rectIndex ];
+        const bool overlaps = usedRect.mins.x < freeRect.maxs.x && usedRect.maxs.x > freeRect.mins.x &&
+                              usedRect.mins.y < freeRect.maxs.y && usedRect.maxs.y > freeRect.mins.y;
+        if( !overlaps )
+        {
+            m_FreeRects[ keptCount++ ] = freeRect;
+            continue;
+        }
+
+        if( usedRect.mins.x > freeRect.mins.x )
+        {
+            FreeRect left = freeRect;
+            left.maxs.x = usedRect.mins.x;
+            m_FreeRects.push_back( left );
+        }
+        if( usedRect.maxs.x < freeRect.maxs.x )
+        {
+            FreeRect right = freeRect;
+            right.mins.x = usedRect.maxs.x;
+            m_FreeRects.push_back( right );
+        }
+        if( usedRect.mins.y > freeRect.mins.y )
+        {
+            FreeRect below = freeRect;
+            below.maxs.y = usedRect.mins.y;
+            m_FreeRects.push_back( below );
+        }
+        if( usedRect.maxs.y < freeRect.maxs.y )
+        {
+            FreeRect above = freeRect;
+            above.mins.y = usedRect.maxs.y;
+            m_FreeRects.push_back( above );
+        }
+    }
+
+    // Close the gap left by the removed rects, the new ones follow the kept ones
+    m_FreeRects.erase( m_FreeRects.begin() + keptCount, m_FreeRects.begin() + oldRectCount );
+    PruneFreeRects( keptCount );
+}
+
+void RectPacker::PruneFreeRects( const size_t firstNewRect )
+{
+    // The kept rects were already maximal among themselves, so only pairs with a new rect
+    //  need testing
+    const auto contains = []( const FreeRect& outer, const FreeRect& inner )
+    {
+        return inner.mins.x >= outer.mins.x && inner.mins.y >= outer.mins.y &&
+               inner.maxs.x <= outer.maxs.x && inner.maxs.y <= outer.maxs.y;
+    };
+
+    std::vector<bool> isRedundant( m_FreeRects.size(), false );
+    for( size_t newIndex = firstNewRect; newIndex < m_FreeRects.size(); ++newIndex )
+    {
+        for( size_t otherIndex = 0; otherIndex < m_FreeRects.size(); ++otherIndex )
+        {
+            if( otherIndex == newIndex || isRedundant[ otherIndex ] )
+            {
+                continue;
+            }
+
+            if( contains( m_FreeRects[ otherIndex ], m_FreeRects[ newIndex ] ) )
+            {
+                isRedundant[ newIndex ] = true;
+                break;
+            }
+            if( otherIndex < firstNewRect && contains( m_FreeRects[ newIndex ], m_FreeRects[ otherIndex ] ) )
+            {
+                isRedundant[ otherIndex ] = true;
+            }
+        }
+    }
+
+    size_t keptCount = 0;
+    for( size_t rectIndex = 0; rectIndex < m_FreeRects.size(); ++rectIndex )
+    {
+        if( !isRedundant[ rectIndex ] )
+        {
+            m_FreeRects[ keptCount++ ] = m_FreeRects[ rectIndex ];
+        }
+    }
+    m_FreeRects.resize( keptCount );
+}
+
+//-----------------------------------------------------------------------------
+int PackRects( const std::vector<IntVec2>& sizes, const IntVec2& binSize,
+               OUT_PARAM std::vector<RectPlacement>& placements )
+{
+    placements.assign( sizes.size(), RectPlacement() );
+
+    // Big and awkward rects first, the small ones fill the gaps they leave
+    std::vector<size_t> order( sizes.size() );
+    for( size_t sizeIndex = 0; sizeIndex < sizes.size(); ++sizeIndex )
+    {
+        order[ sizeIndex ] = sizeIndex;
+    }
+    std::stable_sort( order.begin(), order.end(), [&sizes]( const size_t lhs, const size_t rhs )
+    {
+        const int lhsLongSide = std::max( sizes[ lhs ].x, sizes[ lhs ].y );
+        const int rhsLongSide = std::max( sizes[ rhs ].x, sizes[ rhs ].y );
+        if( lhsLongSide != rhsLongSide )
+        {
+            return lhsLongSide > rhsLongSide;
+        }
+        return static_cast<long long>( sizes[ lhs ].x ) * sizes[ lhs ].y >
+               static_cast<long long>( sizes[ rhs ].x ) * sizes[ rhs ].y;
+    } );
+
+    std::vector<RectPacker> bins;
+    for( const size_t sizeIndex : order )
+    {
+        const IntVec2& size = sizes[ sizeIndex ];
+        if( size.x <= 0 || size.y <= 0 || size.x > binSize.x || size.y > binSize.y )
+        {
+            continue;
+        }
+
+        RectPlacement& placement = placements[ sizeIndex ];
+        for( size_t binIndex = 0; binIndex < bins.size(); ++binIndex )
+        {
+            if( bins[ binIndex ].Insert( size, placement.position ) )
+            {
+                placement.binIndex = static_cast<int>( binIndex );
+                break;
+            }
+        }
+
+        if( placement.binIndex < 0 )
+        {
+            bins.emplace_back( binSize );
+            bins.back().Insert( size, placement.position );
+            placement.binIndex = static_cast<int>( bins.size() - 1 );
+        }
+    }
+
+    return static_cast<int>( bins.size() );
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// MaxRects bin packer. Keeps every maximal free rectangle of the bin and places each new
+//  rectangle where it leaves the shortest leftover side. Rectangles are never rotated
+class RectPacker
+{
+public:
+    RectPacker() = default;
+    explicit RectPacker( const IntVec2& binSize );
+
+    void Reset( const IntVec2& binSize );
+
+    // position is the min corner. False when size fits nowhere, the packer is unchanged then
+    bool Insert( const IntVec2& size, OUT_PARAM IntVec2& position );
+
+    IntVec2 GetBinSize() const { return m_BinSize; }
+    // Used area over bin area
+    float GetOccupancy() const;
+
+private:
+    struct FreeRect
+    {
+        IntVec2 mins = IntVec2::ZERO;
+        IntVec2 maxs = IntVec2::ZERO;
+    };
+
+    IntVec2 m_BinSize = IntVec2::ZERO;
+    long long m_UsedArea = 0;
+    std::vector<FreeRect> m_FreeRects;
+
+    void SplitFreeRects( const FreeRect& usedRect );
+    void PruneFreeRects( size_t firstNewRect );
+};
+
+//-----------------------------------------------------------------------------
+struct RectPlacement
+{
+    int binIndex = -1;
+    IntVec2 position = IntVec2::ZERO;
+};
+
+// Packs every size into as few bins of binSize as it can, largest first. placements matches
+//  sizes by index, sizes that are empty or bigger than a bin keep binIndex -1. Returns the bins used
+int PackRects( const std::vector<IntVec2>& sizes, const IntVec2& binSize,
+               OUT_PARAM std::vector<RectPlacement>& placements );
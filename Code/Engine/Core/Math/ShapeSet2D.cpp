@@ -0,0 +1,908 @@
+#include "ShapeSet2D.hpp"
+
+#include "Engine/Core/Math/MathUtils.hpp"
+#include "Engine/Core/Math/SimdCommon.hpp"
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+#include "Engine/Core/Math/Primatives/Capsule2D.hpp"
+#include "Engine/Core/Math/Primatives/Disc.hpp"
+#include "Engine/Core/Math/Primatives/OBB2.hpp"
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+// Flat copies of one shape, the query side of every test. The set side is read straight from
+//  the arrays, one shape per lane
+namespace
+{
+struct DiscShape
+{
+    float centerX;
+    float centerY;
+    float radius;
+};
+
+struct AabbShape
+{
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+// j basis is ( -iBasisY, iBasisX )
+struct BoxShape
+{
+    float centerX;
+    float centerY;
+    float halfWidth;
+    float halfHeight;
+    float iBasisX;
+    float iBasisY;
+};
+
+struct CapsuleShape
+{
+    float startX;
+    float startY;
+    float endX;
+    float endY;
+    float radius;
+};
+}
+
+static DiscShape MakeShape( const Disc& disc )
+{
+    return DiscShape{ disc.center.x, disc.center.y, disc.radius };
+}
+
+static AabbShape MakeShape( const AABB2& box )
+{
+    return AabbShape{ box.mins.x, box.mins.y, box.maxs.x, box.maxs.y };
+}
+
+static BoxShape MakeShape( const OBB2& box )
+{
+    return BoxShape{ box.center.x, box.center.y, box.halfDimension.x, box.halfDimension.y, box.iBasis.x, box.iBasis.y };
+}
+
+static CapsuleShape MakeShape( const Capsule2D& capsule )
+{
+    return CapsuleShape{ capsule.bone.start.x, capsule.bone.start.y, capsule.bone.end.x, capsule.bone.end.y, capsule.radius };
+}
+
+static BoxShape MakeBoxShape( const AabbShape& box )
+{
+    return BoxShape{ ( box.minX + box.maxX ) * .5f, ( box.minY + box.maxY ) * .5f,
+                     ( box.maxX - box.minX ) * .5f, ( box.maxY - box.minY ) * .5f, 1.f, 0.f };
+}
+
+static DiscShape LoadShape( const DiscSet2D& set, const unsigned int index )
+{
+    return DiscShape{ set.GetCenterXs()[ index ], set.GetCenterYs()[ index ], set.GetRadii()[ index ] };
+}
+
+static AabbShape LoadShape( const AABB2Set& set, const unsigned int index )
+{
+    return AabbShape{ set.GetMinXs()[ index ], set.GetMinYs()[ index ], set.GetMaxXs()[ index ], set.GetMaxYs()[ index ] };
+}
+
+static BoxShape LoadShape( const OBB2Set& set, const unsigned int index )
+{
+    return BoxShape{ set.GetCenterXs()[ index ], set.GetCenterYs()[ index ], set.GetHalfWidths()[ index ],
+                     set.GetHalfHeights()[ index ], set.GetIBasisXs()[ index ], set.GetIBasisYs()[ index ] };
+}
+
+static CapsuleShape LoadShape( const Capsule2DSet& set, const unsigned int index )
+{
+    return CapsuleShape{ set.GetStartXs()[ index ], set.GetStartYs()[ index ], set.GetEndXs()[ index ],
+                         set.GetEndYs()[ index ], set.GetRadii()[ index ] };
+}
+
+//-----------------------------------------------------------------------------
+// Scalar distances, the SIMD versions below follow the same steps
+static float GetPointSegmentDistanceSquared( const float pointX, const float pointY, const float startX,
+                                             const float startY, const float endX, const float endY )
+{
+    const float boneX = endX - startX;
+    const float boneY = endY - startY;
+    const float lengthSquared = boneX * boneX + boneY * boneY;
+    const float along = lengthSquared > 0.f ? ( ( pointX - startX ) * boneX + ( pointY - startY ) * boneY ) / lengthSquared : 0.f;
+    const float fraction = ClampZeroToOne( along );
+    const float offsetX = startX + boneX * fraction - pointX;
+    const float offsetY = startY + boneY * fraction - pointY;
+    return offsetX * offsetX + offsetY * offsetY;
+}
+
+// Box centered on the origin and axis aligned, the point already in its frame
+static float GetLocalPointBoxDistanceSquared( const float localX, const float localY, const float halfWidth,
+                                              const float halfHeight )
+{
+    const float outsideX = fmaxf( fabsf( localX ) - halfWidth, 0.f );
+    const float outsideY = fmaxf( fabsf( localY ) - halfHeight, 0.f );
+    return outsideX * outsideX + outsideY * outsideY;
+}
+
+static void GetPointInBoxFrame( const float pointX, const float pointY, const BoxShape& box,
+                                OUT_PARAM float& localX, OUT_PARAM float& localY )
+{
+    const float relativeX = pointX - box.centerX;
+    const float relativeY = pointY - box.centerY;
+    localX = relativeX * box.iBasisX + relativeY * box.iBasisY;
+    localY = relativeY * box.iBasisX - relativeX * box.iBasisY;
+}
+
+static float GetPointBoxDistanceSquared( const float pointX, const float pointY, const BoxShape& box )
+{
+    float localX;
+    float localY;
+    GetPointInBoxFrame( pointX, pointY, box, localX, localY );
+    return GetLocalPointBoxDistanceSquared( localX, localY, box.halfWidth, box.halfHeight );
+}
+
+static float GetPointAabbDistanceSquared( const float pointX, const float pointY, const AabbShape& box )
+{
+    const float outsideX = fmaxf( fmaxf( box.minX - pointX, pointX - box.maxX ), 0.f );
+    const float outsideY = fmaxf( fmaxf( box.minY - pointY, pointY - box.maxY ), 0.f );
+    return outsideX * outsideX + outsideY * outsideY;
+}
+
+// Zero when they cross. Otherwise the closest pair of a convex box and a segment always includes
+//  a segment end or a box corner
+static float GetSegmentBoxDistanceSquared( const CapsuleShape& segment, const BoxShape& box )
+{
+    float startX;
+    float startY;
+    float endX;
+    float endY;
+    GetPointInBoxFrame( segment.startX, segment.startY, box, startX, startY );
+    GetPointInBoxFrame( segment.endX, segment.endY, box, endX, endY );
+
+    const float boneX = endX - startX;
+    const float boneY = endY - startY;
+    const bool isSeparatedX = fminf( startX, endX ) > box.halfWidth || fmaxf( startX, endX ) < -box.halfWidth;
+    const bool isSeparatedY = fminf( startY, endY ) > box.halfHeight || fmaxf( startY, endY ) < -box.halfHeight;
+    const bool isSeparatedNormal = fabsf( startX * boneY - startY * boneX ) > box.halfWidth * fabsf( boneY ) + box.halfHeight * fabsf( boneX );
+    if( !isSeparatedX && !isSeparatedY && !isSeparatedNormal )
+    {
+        return 0.f;
+    }
+
+    float distanceSquared = fminf( GetLocalPointBoxDistanceSquared( startX, startY, box.halfWidth, box.halfHeight ),
+                                   GetLocalPointBoxDistanceSquared( endX, endY, box.halfWidth, box.halfHeight ) );
+    distanceSquared = fminf( distanceSquared, GetPointSegmentDistanceSquared( box.halfWidth, box.halfHeight, startX, startY, endX, endY ) );
+    distanceSquared = fminf( distanceSquared, GetPointSegmentDistanceSquared( -box.halfWidth, box.halfHeight, startX, startY, endX, endY ) );
+    distanceSquared = fminf( distanceSquared, GetPointSegmentDistanceSquared( box.halfWidth, -box.halfHeight, startX, startY, endX, endY ) );
+    distanceSquared = fminf( distanceSquared, GetPointSegmentDistanceSquared( -box.halfWidth, -box.halfHeight, startX, startY, endX, endY ) );
+    return distanceSquared;
+}
+
+// Zero when they properly cross, otherwise the closest pair includes one of the four ends
+static float GetSegmentSegmentDistanceSquared( const CapsuleShape& first, const CapsuleShape& second )
+{
+    const float firstBoneX = first.endX - first.startX;
+    const float firstBoneY = first.endY - first.startY;
+    const float secondBoneX = second.endX - second.startX;
+    const float secondBoneY = second.endY - second.startY;
+    const float secondStartSide = firstBoneX * ( second.startY - first.startY ) - firstBoneY * ( second.startX - first.startX );
+    const float secondEndSide = firstBoneX * ( second.endY - first.startY ) - firstBoneY * ( second.endX - first.startX );
+    const float firstStartSide = secondBoneX * ( first.startY - second.startY ) - secondBoneY * ( first.startX - second.startX );
+    const float firstEndSide = secondBoneX * ( first.endY - second.startY ) - secondBoneY * ( first.endX - second.startX );
+    if( secondStartSide * secondEndSide < 0.f && firstStartSide * firstEndSide < 0.f )
+    {
+        return 0.f;
+    }
+
+    const float toFirst = fminf( GetPointSegmentDistanceSquared( second.startX, second.startY, first.startX, first.startY, first.endX, first.endY ),
+                                 GetPointSegmentDistanceSquared( second.endX, second.endY, first.startX, first.startY, first.endX, first.endY ) );
+    const float toSecond = fminf( GetPointSegmentDistanceSquared( first.startX, first.startY, second.startX, second.startY, second.endX, second.endY ),
+                                  GetPointSegmentDistanceSquared( first.endX, first.endY, second.startX, second.startY, second.endX, second.endY ) );
+    return fminf( toFirst, toSecond );
+}
+
+//-----------------------------------------------------------------------------
+// Scalar pair tests, query first
+static bool DoShapesOverlap( const DiscShape& query, const DiscShape& target )
+{
+    const float offsetX = target.centerX - query.centerX;
+    const float offsetY = target.centerY - query.centerY;
+    const float radii = query.radius + target.radius;
+    return offsetX * offsetX + offsetY * offsetY < radii * radii;
+}
+
+static bool DoShapesOverlap( const DiscShape& query, const AabbShape& target )
+{
+    return GetPointAabbDistanceSquared( query.centerX, query.centerY, target ) < query.radius * query.radius;
+}
+
+static bool DoShapesOverlap( const DiscShape& query, const BoxShape& target )
+{
+    return GetPointBoxDistanceSquared( query.centerX, query.centerY, target ) < query.radius * query.radius;
+}
+
+static bool DoShapesOverlap( const DiscShape& query, const CapsuleShape& target )
+{
+    const float radii = query.radius + target.radius;
+    return GetPointSegmentDistanceSquared( query.centerX, query.centerY, target.startX, target.startY,
+                                           target.endX, target.endY ) < radii * radii;
+}
+
+static bool DoShapesOverlap( const AabbShape& query, const DiscShape& target )
+{
+    return GetPointAabbDistanceSquared( target.centerX, target.centerY, query ) < target.radius * target.radius;
+}
+
+static bool DoShapesOverlap( const AabbShape& query, const AabbShape& target )
+{
+    return !( query.minX > target.maxX || query.maxX < target.minX || query.minY > target.maxY || query.maxY < target.minY );
+}
+
+static bool DoShapesOverlap( const BoxShape& query, const BoxShape& target )
+{
+    const float offsetX = target.centerX - query.centerX;
+    const float offsetY = target.centerY - query.centerY;
+
+    // Target axes measured on the query axes, cos and sin of the angle between them
+    const float cosine = fabsf( query.iBasisX * target.iBasisX + query.iBasisY * target.iBasisY );
+    const float sine = fabsf( query.iBasisX * target.iBasisY - query.iBasisY * target.iBasisX );
+
+    const float queryI = fabsf( offsetX * query.iBasisX + offsetY * query.iBasisY );
+    const float queryJ = fabsf( offsetY * query.iBasisX - offsetX * query.iBasisY );
+    const float targetI = fabsf( offsetX * target.iBasisX + offsetY * target.iBasisY );
+    const float targetJ = fabsf( offsetY * target.iBasisX - offsetX * target.iBasisY );
+    return !( queryI > query.halfWidth + target.halfWidth * cosine + target.halfHeight * sine ||
+              queryJ > query.halfHeight + target.halfWidth * sine + target.halfHeight * cosine ||
+              targetI > target.halfWidth + query.halfWidth * cosine + query.halfHeight * sine ||
+              targetJ > target.halfHeight + query.halfWidth * sine + query.halfHeight * cosine );
+}
+
+static bool DoShapesOverlap( const BoxShape& query, const DiscShape& target )
+{
+    return GetPointBoxDistanceSquared( target.centerX, target.centerY, query ) < target.radius * target.radius;
+}
+
+static bool DoShapesOverlap( const BoxShape& query, const AabbShape& target )
+{
+    return DoShapesOverlap( query, MakeBoxShape( target ) );
+}
+
+static bool DoShapesOverlap( const BoxShape& query, const CapsuleShape& target )
+{
+    return GetSegmentBoxDistanceSquared( target, query ) < target.radius * target.radius;
+}
+
+static bool DoShapesOverlap( const AabbShape& query, const BoxShape& target )
+{
+    return DoShapesOverlap( MakeBoxShape( query ), target );
+}
+
+static bool DoShapesOverlap( const AabbShape& query, const CapsuleShape& target )
+{
+    return DoShapesOverlap( MakeBoxShape( query ), target );
+}
+
+static bool DoShapesOverlap( const CapsuleShape& query, const DiscShape& target )
+{
+    return DoShapesOverlap( target, query );
+}
+
+static bool DoShapesOverlap( const CapsuleShape& query, const AabbShape& target )
+{
+    return GetSegmentBoxDistanceSquared( query, MakeBoxShape( target ) ) < query.radius * query.radius;
+}
+
+static bool DoShapesOverlap( const CapsuleShape& query, const BoxShape& target )
+{
+    return GetSegmentBoxDistanceSquared( query, target ) < query.radius * query.radius;
+}
+
+static bool DoShapesOverlap( const CapsuleShape& query, const CapsuleShape& target )
+{
+    const float radii = query.radius + target.radius;
+    return GetSegmentSegmentDistanceSquared( query, target ) < radii * radii;
+}
+
+//-----------------------------------------------------------------------------
+// Four shapes at a time, one per lane. Queries are broadcast to every lane
+#if defined(ENGINE_SIMD_SSE)
+namespace
+{
+struct DiscLanes
+{
+    __m128 centerX;
+    __m128 centerY;
+    __m128 radius;
+};
+
+struct AabbLanes
+{
+    __m128 minX;
+    __m128 minY;
+    __m128 maxX;
+    __m128 maxY;
+};
+
+struct BoxLanes
+{
+    __m128 centerX;
+    __m128 centerY;
+    __m128 halfWidth;
+    __m128 halfHeight;
+    __m128 iBasisX;
+    __m128 iBasisY;
+};
+
+struct CapsuleLanes
+{
+    __m128 startX;
+    __m128 startY;
+    __m128 endX;
+    __m128 endY;
+    __m128 radius;
+};
+}
+
+static DiscLanes Broadcast( const DiscShape& shape )
+{
+    return DiscLanes{ _mm_set1_ps( shape.centerX ), _mm_set1_ps( shape.centerY ), _mm_set1_ps( shape.radius ) };
+}
+
+static AabbLanes Broadcast( const AabbShape& shape )
+{
+    return AabbLanes{ _mm_set1_ps( shape.minX ), _mm_set1_ps( shape.minY ), _mm_set1_ps( shape.maxX ), _mm_set1_ps( shape.maxY ) };
+}
+
+static BoxLanes Broadcast( const BoxShape& shape )
+{
+    return BoxLanes{ _mm_set1_ps( shape.centerX ), _mm_set1_ps( shape.centerY ), _mm_set1_ps( shape.halfWidth ),
+                     _mm_set1_ps( shape.halfHeight ), _mm_set1_ps( shape.iBasisX ), _mm_set1_ps( shape.iBasisY ) };
+}
+
+static CapsuleLanes Broadcast( const CapsuleShape& shape )
+{
+    return CapsuleLanes{ _mm_set1_ps( shape.startX ), _mm_set1_ps( shape.startY ), _mm_set1_ps( shape.endX ),
+                         _mm_set1_ps( shape.endY ), _mm_set1_ps( shape.radius ) };
+}
+
+static DiscLanes LoadLanes( const DiscSet2D& set, const unsigned int index )
+{
+    return DiscLanes{ _mm_loadu_ps( set.GetCenterXs() + index ), _mm_loadu_ps( set.GetCenterYs() + index ),
+                      _mm_loadu_ps( set.GetRadii() + index ) };
+}
+
+static AabbLanes LoadLanes( const AABB2Set& set, const unsigned int index )
+{
+    return AabbLanes{ _mm_loadu_ps( set.GetMinXs() + index ), _mm_loadu_ps( set.GetMinYs() + index ),
+                      _mm_loadu_ps( set.GetMaxXs() + index ), _mm_loadu_ps( set.GetMaxYs() + index ) };
+}
+
+static BoxLanes LoadLanes( const OBB2Set& set, const unsigned int index )
+{
+    return BoxLanes{ _mm_loadu_ps( set.GetCenterXs() + index ), _mm_loadu_ps( set.GetCenterYs() + index ),
+                     _mm_loadu_ps( set.GetHalfWidths() + index ), _mm_loadu_ps( set.GetHalfHeights() + index ),
+                     _mm_loadu_ps( set.GetIBasisXs() + index ), _mm_loadu_ps( set.GetIBasisYs() + index ) };
+}
+
+static CapsuleLanes LoadLanes( const Capsule2DSet& set, const unsigned int index )
+{
+    return CapsuleLanes{ _mm_loadu_ps( set.GetStartXs() + index ), _mm_loadu_ps( set.GetStartYs() + index ),
+                         _mm_loadu_ps( set.GetEndXs() + index ), _mm_loadu_ps( set.GetEndYs() + index ),
+                         _mm_loadu_ps( set.GetRadii() + index ) };
+}
+
+static BoxLanes MakeBoxLanes( const AabbLanes& box )
+{
+    const __m128 half = _mm_set1_ps( .5f );
+    return BoxLanes{ _mm_mul_ps( _mm_add_ps( box.minX, box.maxX ), half ), _mm_mul_ps( _mm_add_ps( box.minY, box.maxY ), half ),
+                     _mm_mul_ps( _mm_sub_ps( box.maxX, box.minX ), half ), _mm_mul_ps( _mm_sub_ps( box.maxY, box.minY ), half ),
+                     _mm_set1_ps( 1.f ), _mm_setzero_ps() };
+}
+
+static __m128 Abs4( const __m128& value )
+{
+    return _mm_andnot_ps( _mm_set1_ps( -0.f ), value );
+}
+
+static __m128 LengthSquared4( const __m128& x, const __m128& y )
+{
+    return _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+}
+
+static __m128 GetPointSegmentDistanceSquared4( const __m128& pointX, const __m128& pointY, const __m128& startX,
+                                               const __m128& startY, const __m128& endX, const __m128& endY )
+{
+    const __m128 boneX = _mm_sub_ps( endX, startX );
+    const __m128 boneY = _mm_sub_ps( endY, startY );
+    const __m128 lengthSquared = LengthSquared4( boneX, boneY );
+    const __m128 projection = _mm_add_ps( _mm_mul_ps( _mm_sub_ps( pointX, startX ), boneX ),
+                                          _mm_mul_ps( _mm_sub_ps( pointY, startY ), boneY ) );
+    const __m128 hasLength = _mm_cmpgt_ps( lengthSquared, _mm_setzero_ps() );
+    const __m128 along = _mm_and_ps( hasLength, _mm_div_ps( projection, lengthSquared ) );
+    const __m128 fraction = _mm_max_ps( _mm_min_ps( along, _mm_set1_ps( 1.f ) ), _mm_setzero_ps() );
+    const __m128 offsetX = _mm_sub_ps( _mm_add_ps( startX, _mm_mul_ps( boneX, fraction ) ), pointX );
+    const __m128 offsetY = _mm_sub_ps( _mm_add_ps( startY, _mm_mul_ps( boneY, fraction ) ), pointY );
+    return LengthSquared4( offsetX, offsetY );
+}
+
+static __m128 GetLocalPointBoxDistanceSquared4( const __m128& localX, const __m128& localY, const __m128& halfWidth,
+                                                const __m128& halfHeight )
+{
+    const __m128 outsideX = _mm_max_ps( _mm_sub_ps( Abs4( localX ), halfWidth ), _mm_setzero_ps() );
+    const __m128 outsideY = _mm_max_ps( _mm_sub_ps( Abs4( localY ), halfHeight ), _mm_setzero_ps() );
+    return LengthSquared4( outsideX, outsideY );
+}
+
+static void GetPointInBoxFrame4( const __m128& pointX, const __m128& pointY, const BoxLanes& box,
+                                 OUT_PARAM __m128& localX, OUT_PARAM __m128& localY )
+{
+    const __m128 relativeX = _mm_sub_ps( pointX, box.centerX );
+    const __m128 relativeY = _mm_sub_ps( pointY, box.centerY );
+    localX = _mm_add_ps( _mm_mul_ps( relativeX, box.iBasisX ), _mm_mul_ps( relativeY, box.iBasisY ) );
+    localY = _mm_sub_ps( _mm_mul_ps( relativeY, box.iBasisX ), _mm_mul_ps( relativeX, box.iBasisY ) );
+}
+
+static __m128 GetPointBoxDistanceSquared4( const __m128& pointX, const __m128& pointY, const BoxLanes& box )
+{
+    __m128 localX;
+    __m128 localY;
+    GetPointInBoxFrame4( pointX, pointY, box, localX, localY );
+    return GetLocalPointBoxDistanceSquared4( localX, localY, box.halfWidth, box.halfHeight );
+}
+
+static __m128 GetPointAabbDistanceSquared4( const __m128& pointX, const __m128& pointY, const AabbLanes& box )
+{
+    const __m128 outsideX = _mm_max_ps( _mm_max_ps( _mm_sub_ps( box.minX, pointX ), _mm_sub_ps( pointX, box.maxX ) ), _mm_setzero_ps() );
+    const __m128 outsideY = _mm_max_ps( _mm_max_ps( _mm_sub_ps( box.minY, pointY ), _mm_sub_ps( pointY, box.maxY ) ), _mm_setzero_ps() );
+    return LengthSquared4( outsideX, outsideY );
+}
+
+static __m128 GetSegmentBoxDistanceSquared4( const CapsuleLanes& segment, const BoxLanes& box )
+{
+    __m128 startX;
+    __m128 startY;
+    __m128 endX;
+    __m128 endY;
+    GetPointInBoxFrame4( segment.startX, segment.startY, box, startX, startY );
+    GetPointInBoxFrame4( segment.endX, segment.endY, box, endX, endY );
+
+    const __m128 boneX = _mm_sub_ps( endX, startX );
+    const __m128 boneY = _mm_sub_ps( endY, startY );
+    const __m128 negativeHalfWidth = _mm_sub_ps( _mm_setzero_ps(), box.halfWidth );
+    const __m128 negativeHalfHeight = _mm_sub_ps( _mm_setzero_ps(), box.halfHeight );
+    const __m128 isSeparatedX = _mm_or_ps( _mm_cmpgt_ps( _mm_min_ps( startX, endX ), box.halfWidth ),
+                                           _mm_cmplt_ps( _mm_max_ps( startX, endX ), negativeHalfWidth ) );
+    const __m128 isSeparatedY = _mm_or_ps( _mm_cmpgt_ps( _mm_min_ps( startY, endY ), box.halfHeight ),
+                                           _mm_cmplt_ps( _mm_max_ps( startY, endY ), negativeHalfHeight ) );
+    const __m128 normalDistance = Abs4( _mm_sub_ps( _mm_mul_ps( startX, boneY ), _mm_mul_ps( startY, boneX ) ) );
+    const __m128 normalRadius = _mm_add_ps( _mm_mul_ps( box.halfWidth, Abs4( boneY ) ), _mm_mul_ps( box.halfHeight, Abs4( boneX ) ) );
+    const __m128 isSeparated = _mm_or_ps( _mm_or_ps( isSeparatedX, isSeparatedY ), _mm_cmpgt_ps( normalDistance, normalRadius ) );
+
+    __m128 distanceSquared = _mm_min_ps( GetLocalPointBoxDistanceSquared4( startX, startY, box.halfWidth, box.halfHeight ),
+                                         GetLocalPointBoxDistanceSquared4( endX, endY, box.halfWidth, box.halfHeight ) );
+    distanceSquared = _mm_min_ps( distanceSquared, GetPointSegmentDistanceSquared4( box.halfWidth, box.halfHeight, startX, startY, endX, endY ) );
+    distanceSquared = _mm_min_ps( distanceSquared, GetPointSegmentDistanceSquared4( negativeHalfWidth, box.halfHeight, startX, startY, endX, endY ) );
+    distanceSquared = _mm_min_ps( distanceSquared, GetPointSegmentDistanceSquared4( box.halfWidth, negativeHalfHeight, startX, startY, endX, endY ) );
+    distanceSquared = _mm_min_ps( distanceSquared, GetPointSegmentDistanceSquared4( negativeHalfWidth, negativeHalfHeight, startX, startY, endX, endY ) );
+    return _mm_and_ps( isSeparated, distanceSquared );
+}
+
+static __m128 GetSegmentSegmentDistanceSquared4( const CapsuleLanes& first, const CapsuleLanes& second )
+{
+    const __m128 firstBoneX = _mm_sub_ps( first.endX, first.startX );
+    const __m128 firstBoneY = _mm_sub_ps( first.endY, first.startY );
+    const __m128 secondBoneX = _mm_sub_ps( second.endX, second.startX );
+    const __m128 secondBoneY = _mm_sub_ps( second.endY, second.startY );
+    const __m128 secondStartSide = _mm_sub_ps( _mm_mul_ps( firstBoneX, _mm_sub_ps( second.startY, first.startY ) ),
+                                               _mm_mul_ps( firstBoneY, _mm_sub_ps( second.startX, first.startX ) ) );
+    const __m128 secondEndSide = _mm_sub_ps( _mm_mul_ps( firstBoneX, _mm_sub_ps( second.endY, first.startY ) ),
+                                             _mm_mul_ps( firstBoneY, _mm_sub_ps( second.endX, first.startX ) ) );
+    const __m128 firstStartSide = _mm_sub_ps( _mm_mul_ps( secondBoneX, _mm_sub_ps( first.startY, second.startY ) ),
+                                              _mm_mul_ps( secondBoneY, _mm_sub_ps( first.startX, second.startX ) ) );
+    const __m128 firstEndSide = _mm_sub_ps( _mm_mul_ps( secondBoneX, _mm_sub_ps( first.endY, second.startY ) ),
+                                            _mm_mul_ps( secondBoneY, _mm_sub_ps( first.endX, second.startX ) ) );
+    const __m128 isCrossing = _mm_and_ps( _mm_cmplt_ps( _mm_mul_ps( secondStartSide, secondEndSide ), _mm_setzero_ps() ),
+                                          _mm_cmplt_ps( _mm_mul_ps( firstStartSide, firstEndSide ), _mm_setzero_ps() ) );
+
+    const __m128 toFirst = _mm_min_ps( GetPointSegmentDistanceSquared4( second.startX, second.startY, first.startX, first.startY, first.endX, first.endY ),
+                                       GetPointSegmentDistanceSquared4( second.endX, second.endY, first.startX, first.startY, first.endX, first.endY ) );
+    const __m128 toSecond = _mm_min_ps( GetPointSegmentDistanceSquared4( first.startX, first.startY, second.startX, second.startY, second.endX, second.endY ),
+                                        GetPointSegmentDistanceSquared4( first.endX, first.endY, second.startX, second.startY, second.endX, second.endY ) );
+    return _mm_andnot_ps( isCrossing, _mm_min_ps( toFirst, toSecond ) );
+}
+
+//-----------------------------------------------------------------------------
+// Lane pair tests, all bits set in a lane that overlaps
+static __m128 DoShapesOverlap( const DiscLanes& query, const DiscLanes& target )
+{
+    const __m128 radii = _mm_add_ps( query.radius, target.radius );
+    const __m128 distanceSquared = LengthSquared4( _mm_sub_ps( target.centerX, query.centerX ), _mm_sub_ps( target.centerY, query.centerY ) );
+    return _mm_cmplt_ps( distanceSquared, _mm_mul_ps( radii, radii ) );
+}
+
+static __m128 DoShapesOverlap( const DiscLanes& query, const AabbLanes& target )
+{
+    return _mm_cmplt_ps( GetPointAabbDistanceSquared4( query.centerX, query.centerY, target ), _mm_mul_ps( query.radius, query.radius ) );
+}
+
+static __m128 DoShapesOverlap( const DiscLanes& query, const BoxLanes& target )
+{
+    return _mm_cmplt_ps( GetPointBoxDistanceSquared4( query.centerX, query.centerY, target ), _mm_mul_ps( query.radius, query.radius ) );
+}
+
+static __m128 DoShapesOverlap( const DiscLanes& query, const CapsuleLanes& target )
+{
+    const __m128 radii = _mm_add_ps( query.radius, target.radius );
+    const __m128 distanceSquared = GetPointSegmentDistanceSquared4( query.centerX, query.centerY, target.startX, target.startY,
+                                                                    target.endX, target.endY );
+    return _mm_cmplt_ps( distanceSquared, _mm_mul_ps( radii, radii ) );
+}
+
+static __m128 DoShapesOverlap( const AabbLanes& query, const DiscLanes& target )
+{
+    return _mm_cmplt_ps( GetPointAabbDistanceSquared4( target.centerX, target.centerY, query ), _mm_mul_ps( target.radius, target.radius ) );
+}
+
+static __m128 DoShapesOverlap( const AabbLanes& query, const AabbLanes& target )
+{
+    const __m128 isSeparated = _mm_or_ps( _mm_or_ps( _mm_cmpgt_ps( query.minX, target.maxX ), _mm_cmplt_ps( query.maxX, target.minX ) ),
+                                          _mm_or_ps( _mm_cmpgt_ps( query.minY, target.maxY ), _mm_cmplt_ps( query.maxY, target.minY ) ) );
+    return _mm_andnot_ps( isSeparated, _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+}
+
+static __m128 DoShapesOverlap( const BoxLanes& query, const BoxLanes& target )
+{
+    const __m128 offsetX = _mm_sub_ps( target.centerX, query.centerX );
+    const __m128 offsetY = _mm_sub_ps( target.centerY, query.centerY );
+    const __m128 cosine = Abs4( _mm_add_ps( _mm_mul_ps( query.iBasisX, target.iBasisX ), _mm_mul_ps( query.iBasisY, target.iBasisY ) ) );
+    const __m128 sine = Abs4( _mm_sub_ps( _mm_mul_ps( query.iBasisX, target.iBasisY ), _mm_mul_ps( query.iBasisY, target.iBasisX ) ) );
+
+    const __m128 queryI = Abs4( _mm_add_ps( _mm_mul_ps( offsetX, query.iBasisX ), _mm_mul_ps( offsetY, query.iBasisY ) ) );
+    const __m128 queryJ = Abs4( _mm_sub_ps( _mm_mul_ps( offsetY, query.iBasisX ), _mm_mul_ps( offsetX, query.iBasisY ) ) );
+    const __m128 targetI = Abs4( _mm_add_ps( _mm_mul_ps( offsetX, target.iBasisX ), _mm_mul_ps( offsetY, target.iBasisY ) ) );
+    const __m128 targetJ = Abs4( _mm_sub_ps( _mm_mul_ps( offsetY, target.iBasisX ), _mm_mul_ps( offsetX, target.iBasisY ) ) );
+
+    const __m128 queryIRadius = _mm_add_ps( _mm_add_ps( query.halfWidth, _mm_mul_ps( target.halfWidth, cosine ) ), _mm_mul_ps( target.halfHeight, sine ) );
+    const __m128 queryJRadius = _mm_add_ps( _mm_add_ps( query.halfHeight, _mm_mul_ps( target.halfWidth, sine ) ), _mm_mul_ps( target.halfHeight, cosine ) );
+    const __m128 targetIRadius = _mm_add_ps( _mm_add_ps( target.halfWidth, _mm_mul_ps( query.halfWidth, cosine ) ), _mm_mul_ps( query.halfHeight, sine ) );
+    const __m128 targetJRadius = _mm_add_ps( _mm_add_ps( target.halfHeight, _mm_mul_ps( query.halfWidth, sine ) ), _mm_mul_ps( query.halfHeight, cosine ) );
+    const __m128 isSeparated = _mm_or_ps( _mm_or_ps( _mm_cmpgt_ps( queryI, queryIRadius ), _mm_cmpgt_ps( queryJ, queryJRadius ) ),
+                                          _mm_or_ps( _mm_cmpgt_ps( targetI, targetIRadius ), _mm_cmpgt_ps( targetJ, targetJRadius ) ) );
+    return _mm_andnot_ps( isSeparated, _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) );
+}
+
+static __m128 DoShapesOverlap( const BoxLanes& query, const DiscLanes& target )
+{
+    return _mm_cmplt_ps( GetPointBoxDistanceSquared4( target.centerX, target.centerY, query ), _mm_mul_ps( target.radius, target.radius ) );
+}
+
+static __m128 DoShapesOverlap( const BoxLanes& query, const AabbLanes& target )
+{
+    return DoShapesOverlap( query, MakeBoxLanes( target ) );
+}
+
+static __m128 DoShapesOverlap( const BoxLanes& query, const CapsuleLanes& target )
+{
+    return _mm_cmplt_ps( GetSegmentBoxDistanceSquared4( target, query ), _mm_mul_ps( target.radius, target.radius ) );
+}
+
+static __m128 DoShapesOverlap( const AabbLanes& query, const BoxLanes& target )
+{
+    return DoShapesOverlap( MakeBoxLanes( query ), target );
+}
+
+static __m128 DoShapesOverlap( const AabbLanes& query, const CapsuleLanes& target )
+{
+    return DoShapesOverlap( MakeBoxLanes( query ), target );
+}
+
+static __m128 DoShapesOverlap( const CapsuleLanes& query, const DiscLanes& target )
+{
+    return DoShapesOverlap( target, query );
+}
+
+static __m128 DoShapesOverlap( const CapsuleLanes& query, const AabbLanes& target )
+{
+    return _mm_cmplt_ps( GetSegmentBoxDistanceSquared4( query, MakeBoxLanes( target ) ), _mm_mul_ps( query.radius, query.radius ) );
+}
+
+static __m128 DoShapesOverlap( const CapsuleLanes& query, const BoxLanes& target )
+{
+    return _mm_cmplt_ps( GetSegmentBoxDistanceSquared4( query, target ), _mm_mul_ps( query.radius, query.radius ) );
+}
+
+static __m128 DoShapesOverlap( const CapsuleLanes& query, const CapsuleLanes& target )
+{
+    const __m128 radii = _mm_add_ps( query.radius, target.radius );
+    return _mm_cmplt_ps( GetSegmentSegmentDistanceSquared4( query, target ), _mm_mul_ps( radii, radii ) );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+//-----------------------------------------------------------------------------
+template <typename ShapeSet, typename QueryShape>
+static void FillOverlapMask( const ShapeSet& set, const QueryShape& query, OUT_PARAM std::vector<unsigned int>& overlapMask )
+{
+    const unsigned int count = set.GetCount();
+    overlapMask.assign( ( count + 31 ) / 32, 0 );
+
+    // Groups of four start on a multiple of four, so their bits never straddle two words
+    unsigned int index = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const auto queryLanes = Broadcast( query );
+    for( ; index + 4 <= count; index += 4 )
+    {
+        const int laneBits = _mm_movemask_ps( DoShapesOverlap( queryLanes, LoadLanes( set, index ) ) );
+        overlapMask[ index >> 5 ] |= static_cast<unsigned int>( laneBits ) << ( index & 31 );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; index < count; ++index )
+    {
+        if( DoShapesOverlap( query, LoadShape( set, index ) ) )
+        {
+            overlapMask[ index >> 5 ] |= 1u << ( index & 31 );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+unsigned int DiscSet2D::Add( const Disc& disc )
+{
+    m_CenterX.push_back( disc.center.x );
+    m_CenterY.push_back( disc.center.y );
+    m_Radius.push_back( disc.radius );
+    return GetCount() - 1;
+}
+
+void DiscSet2D::Set( const unsigned int index, const Disc& disc )
+{
+    m_CenterX[ index ] = disc.center.x;
+    m_CenterY[ index ] = disc.center.y;
+    m_Radius[ index ] = disc.radius;
+}
+
+Disc DiscSet2D::Get( const unsigned int index ) const
+{
+    return Disc( Vec2( m_CenterX[ index ], m_CenterY[ index ] ), m_Radius[ index ] );
+}
+
+void DiscSet2D::Reserve( const unsigned int count )
+{
+    m_CenterX.reserve( count );
+    m_CenterY.reserve( count );
+    m_Radius.reserve( count );
+}
+
+void DiscSet2D::Clear()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_Radius.clear();
+}
+
+void DiscSet2D::QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void DiscSet2D::QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void DiscSet2D::QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void DiscSet2D::QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+//-----------------------------------------------------------------------------
+unsigned int AABB2Set::Add( const AABB2& box )
+{
+    m_MinX.push_back( box.mins.x );
+    m_MinY.push_back( box.mins.y );
+    m_MaxX.push_back( box.maxs.x );
+    m_MaxY.push_back( box.maxs.y );
+    return GetCount() - 1;
+}
+
+void AABB2Set::Set( const unsigned int index, const AABB2& box )
+{
+    m_MinX[ index ] = box.mins.x;
+    m_MinY[ index ] = box.mins.y;
+    m_MaxX[ index ] = box.maxs.x;
+    m_MaxY[ index ] = box.maxs.y;
+}
+
+AABB2 AABB2Set::Get( const unsigned int index ) const
+{
+    return AABB2( m_MinX[ index ], m_MinY[ index ], m_MaxX[ index ], m_MaxY[ index ] );
+}
+
+void AABB2Set::Reserve( const unsigned int count )
+{
+    m_MinX.reserve( count );
+    m_MinY.reserve( count );
+    m_MaxX.reserve( count );
+    m_MaxY.reserve( count );
+}
+
+void AABB2Set::Clear()
+{
+    m_MinX.clear();
+    m_MinY.clear();
+    m_MaxX.clear();
+    m_MaxY.clear();
+}
+
+void AABB2Set::QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void AABB2Set::QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void AABB2Set::QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void AABB2Set::QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+//-----------------------------------------------------------------------------
+unsigned int OBB2Set::Add( const OBB2& box )
+{
+    m_CenterX.push_back( box.center.x );
+    m_CenterY.push_back( box.center.y );
+    m_HalfWidth.push_back( box.halfDimension.x );
+    m_HalfHeight.push_back( box.halfDimension.y );
+    m_IBasisX.push_back( box.iBasis.x );
+    m_IBasisY.push_back( box.iBasis.y );
+    return GetCount() - 1;
+}
+
+void OBB2Set::Set( const unsigned int index, const OBB2& box )
+{
+    m_CenterX[ index ] = box.center.x;
+    m_CenterY[ index ] = box.center.y;
+    m_HalfWidth[ index ] = box.halfDimension.x;
+    m_HalfHeight[ index ] = box.halfDimension.y;
+    m_IBasisX[ index ] = box.iBasis.x;
+    m_IBasisY[ index ] = box.iBasis.y;
+}
+
+OBB2 OBB2Set::Get( const unsigned int index ) const
+{
+    return OBB2( Vec2( m_CenterX[ index ], m_CenterY[ index ] ),
+                 Vec2( m_HalfWidth[ index ] * 2.f, m_HalfHeight[ index ] * 2.f ),
+                 Vec2( m_IBasisX[ index ], m_IBasisY[ index ] ) );
+}
+
+void OBB2Set::Reserve( const unsigned int count )
+{
+    m_CenterX.reserve( count );
+    m_CenterY.reserve( count );
+    m_HalfWidth.reserve( count );
+    m_HalfHeight.reserve( count );
+    m_IBasisX.reserve( count );
+    m_IBasisY.reserve( count );
+}
+
+void OBB2Set::Clear()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_HalfWidth.clear();
+    m_HalfHeight.clear();
+    m_IBasisX.clear();
+    m_IBasisY.clear();
+}
+
+void OBB2Set::QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void OBB2Set::QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void OBB2Set::QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void OBB2Set::QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+//-----------------------------------------------------------------------------
+unsigned int Capsule2DSet::Add( const Capsule2D& capsule )
+{
+    m_StartX.push_back( capsule.bone.start.x );
+    m_StartY.push_back( capsule.bone.start.y );
+    m_EndX.push_back( capsule.bone.end.x );
+    m_EndY.push_back( capsule.bone.end.y );
+    m_Radius.push_back( capsule.radius );
+    return GetCount() - 1;
+}
+
+void Capsule2DSet::Set( const unsigned int index, const Capsule2D& capsule )
+{
+    m_StartX[ index ] = capsule.bone.start.x;
+    m_StartY[ index ] = capsule.bone.start.y;
+    m_EndX[ index ] = capsule.bone.end.x;
+    m_EndY[ index ] = capsule.bone.end.y;
+    m_Radius[ index ] = capsule.radius;
+}
+
+Capsule2D Capsule2DSet::Get( const unsigned int index ) const
+{
+    return Capsule2D( m_StartX[ index ], m_StartY[ index ], m_EndX[ index ], m_EndY[ index ], m_Radius[ index ] );
+}
+
+void Capsule2DSet::Reserve( const unsigned int count )
+{
+    m_StartX.reserve( count );
+    m_StartY.reserve( count );
+    m_EndX.reserve( count );
+    m_EndY.reserve( count );
+    m_Radius.reserve( count );
+}
+
+void Capsule2DSet::Clear()
+{
+    m_StartX.clear();
+    m_StartY.clear();
+    m_EndX.clear();
+    m_EndY.clear();
+    m_Radius.clear();
+}
+
+void Capsule2DSet::QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void Capsule2DSet::QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void Capsule2DSet::QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+void Capsule2DSet::QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const
+{
+    FillOverlapMask( *this, MakeShape( query ), overlapMask );
+}
+
+//-----------------------------------------------------------------------------
+void GetOverlapIndices( const std::vector<unsigned int>& overlapMask, OUT_PARAM std::vector<unsigned int>& overlapIndices )
+{
+    overlapIndices.clear();
+    for( size_t wordIndex = 0; wordIndex < overlapMask.size(); ++wordIndex )
+    {
+        // Shifting stops after the highest set bit, and empty words cost one compare
+        unsigned int word = overlapMask[ wordIndex ];
+        for( unsigned int bitIndex = 0; word != 0; ++bitIndex, word >>= 1 )
+        {
+            if( ( word & 1 ) != 0 )
+            {
+                overlapIndices.push_back( static_cast<unsigned int>( wordIndex * 32 ) + bitIndex );
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+struct AABB2;
+struct Capsule2D;
+struct Disc;
+struct OBB2;
+
+//-----------------------------------------------------------------------------
+// Many 2D shapes of one kind kept as structure of arrays, so one query shape is tested against
+//  four of them per SSE instruction. Every set answers disc, AABB2, OBB2 and capsule queries
+//  with a bit mask: bit ( i % 32 ) of word ( i / 32 ) is set when shape i overlaps the query.
+//
+// The tests are exact. Distance based pairs (anything with a disc or capsule) need the distance
+//  to be less than the radii, like DoDiscsOverlap, and box pairs count touching edges as
+//  overlapping, like DoAABB2sOverlap. Where MathUtils approximates a pair the results can
+//  differ near the edges
+class DiscSet2D
+{
+public:
+    unsigned int Add( const Disc& disc );
+    void Set( unsigned int index, const Disc& disc );
+    Disc Get( unsigned int index ) const;
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_Radius.size() ); }
+
+    void QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+
+    const float* GetCenterXs() const { return m_CenterX.data(); }
+    const float* GetCenterYs() const { return m_CenterY.data(); }
+    const float* GetRadii() const { return m_Radius.data(); }
+
+private:
+    std::vector<float> m_CenterX;
+    std::vector<float> m_CenterY;
+    std::vector<float> m_Radius;
+};
+
+class AABB2Set
+{
+public:
+    unsigned int Add( const AABB2& box );
+    void Set( unsigned int index, const AABB2& box );
+    AABB2 Get( unsigned int index ) const;
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_MinX.size() ); }
+
+    void QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+
+    const float* GetMinXs() const { return m_MinX.data(); }
+    const float* GetMinYs() const { return m_MinY.data(); }
+    const float* GetMaxXs() const { return m_MaxX.data(); }
+    const float* GetMaxYs() const { return m_MaxY.data(); }
+
+private:
+    std::vector<float> m_MinX;
+    std::vector<float> m_MinY;
+    std::vector<float> m_MaxX;
+    std::vector<float> m_MaxY;
+};
+
+class OBB2Set
+{
+public:
+    unsigned int Add( const OBB2& box );
+    void Set( unsigned int index, const OBB2& box );
+    OBB2 Get( unsigned int index ) const;
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_CenterX.size() ); }
+
+    void QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+
+    const float* GetCenterXs() const { return m_CenterX.data(); }
+    const float* GetCenterYs() const { return m_CenterY.data(); }
+    const float* GetHalfWidths() const { return m_HalfWidth.data(); }
+    const float* GetHalfHeights() const { return m_HalfHeight.data(); }
+    const float* GetIBasisXs() const { return m_IBasisX.data(); }
+    const float* GetIBasisYs() const { return m_IBasisY.data(); }
+
+private:
+    std::vector<float> m_CenterX;
+    std::vector<float> m_CenterY;
+    std::vector<float> m_HalfWidth;
+    std::vector<float> m_HalfHeight;
+    std::vector<float> m_IBasisX;
+    std::vector<float> m_IBasisY;
+};
+
+class Capsule2DSet
+{
+public:
+    unsigned int Add( const Capsule2D& capsule );
+    void Set( unsigned int index, const Capsule2D& capsule );
+    Capsule2D Get( unsigned int index ) const;
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_Radius.size() ); }
+
+    void QueryOverlaps( const Disc& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const AABB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const OBB2& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+    void QueryOverlaps( const Capsule2D& query, OUT_PARAM std::vector<unsigned int>& overlapMask ) const;
+
+    const float* GetStartXs() const { return m_StartX.data(); }
+    const float* GetStartYs() const { return m_StartY.data(); }
+    const float* GetEndXs() const { return m_EndX.data(); }
+    const float* GetEndYs() const { return m_EndY.data(); }
+    const float* GetRadii() const { return m_Radius.data(); }
+
+private:
+    std::vector<float> m_StartX;
+    std::vector<float> m_StartY;
+    std::vector<float> m_EndX;
+    std::vector<float> m_EndY;
+    std::vector<float> m_Radius;
+};
+
+//-----------------------------------------------------------------------------
+// Index of every set bit, in order
+void GetOverlapIndices( const std::vector<unsigned int>& overlapMask, OUT_PARAM std::vector<unsigned int>& overlapIndices );
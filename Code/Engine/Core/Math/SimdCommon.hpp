@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Game/EngineBuildPreferences.hpp"
+
+//-----------------------------------------------------------------------------
+// SSE2 is part of the x64 baseline so the SIMD paths are on by default. Define
+//  ENGINE_DISABLE_SIMD in EngineBuildPreferences.hpp to force the scalar paths
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define ENGINE_SIMD_SSE
+#include <emmintrin.h>
+#endif // !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(__SSE2__))
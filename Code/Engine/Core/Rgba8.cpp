@@ -26,7 +26,9 @@ Vec3 ConvertRgbToHSL( const Rgba8& rgba8 )
     float hue = 0.f;
     if( IsMostlyEqual( cMax, hsl.x ) )
     {
-        hue = 60.f * (static_cast<int>((hsl.y - hsl.z) / delta) % 6);
+        // Wrapped into [0, 6) without truncating, the fraction is the hue within the sector
+        const float sector = (hsl.y - hsl.z) / delta;
+        hue = 60.f * (sector < 0.f ? sector + 6.f : sector);
     }
     if( IsMostlyEqual( cMax, hsl.y ) )
     {
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Noise/RawNoise.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/Core/Math/Primatives/IntVec3.hpp"
+
+#include <utility>
+#include <vector>
+
+// Grid coordinate hash. Also works as the hasher for std::unordered_map
+struct IntVecHash
+{
+    size_t operator()( const IntVec2& key ) const { return RawNoise::GetNoiseUint( key.x, key.y ); }
+    size_t operator()( const IntVec3& key ) const { return RawNoise::GetNoiseUint( key.x, key.y, key.z ); }
+};
+
+//-----------------------------------------------------------------------------
+// Open addressing hash map for IntVec2 / IntVec3 keys. Linear probing over one array of slots,
+//  so a lookup is usually a single cache line instead of the node walk std::map does.
+//  Removal shifts the following slots back instead of leaving tombstones.
+//
+// Pointers into the map are invalidated by any insert that grows it and by Remove
+template <typename Key, typename Value>
+class IntVecHashMap
+{
+public:
+    IntVecHashMap() = default;
+    explicit IntVecHashMap( unsigned int initialCount );
+
+    Value* Find( const Key& key );
+    const Value* Find( const Key& key ) const;
+    bool Contains( const Key& key ) const { return Find( key ) != nullptr; }
+
+    // Default constructs the value if the key is new
+    Value& operator[]( const Key& key );
+    // Returns false and overwrites the value if the key was already there
+    bool Insert( const Key& key, const Value& value );
+    bool Remove( const Key& key );
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return m_Count; }
+    unsigned int GetCapacity() const { return static_cast<unsigned int>( m_Slots.size() ); }
+
+    // callback( const Key&, Value& ), in slot order
+    template <typename Callback>
+    void ForEach( Callback callback );
+    template <typename Callback>
+    void ForEach( Callback callback ) const;
+
+private:
+    struct Slot
+    {
+        Key key;
+        Value value;
+        bool isOccupied = false;
+    };
+
+    // Slot holding key, or the empty slot where it would go
+    unsigned int FindSlot( const Key& key ) const;
+    void Rehash( unsigned int newCapacity );
+
+    std::vector<Slot> m_Slots;
+    unsigned int m_Count = 0;
+};
+
+constexpr unsigned int INT_VEC_HASH_MAP_MIN_CAPACITY = 16;
+
+template <typename Key, typename Value>
+IntVecHashMap<Key, Value>::IntVecHashMap( const unsigned int initialCount )
+{
+    Reserve( initialCount );
+}
+
+template <typename Key, typename Value>
+Value* IntVecHashMap<Key, Value>::Find( const Key& key )
+{
+    if( m_Count == 0 )
+    {
+        return nullptr;
+    }
+
+    Slot& slot = m_Slots[ FindSlot( key ) ];
+    return slot.isOccupied ? &slot.value : nullptr;
+}
+
+template <typename Key, typename Value>
+const Value* IntVecHashMap<Key, Value>::Find( const Key& key ) const
+{
+    if( m_Count == 0 )
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = m_Slots[ FindSlot( key ) ];
+    return slot.isOccupied ? &slot.value : nullptr;
+}
+
+template <typename Key, typename Value>
+Value& IntVecHashMap<Key, Value>::operator[]( const Key& key )
+{
+    // Grow first so the slot found stays valid, load is kept at or under 3/4
+    if( ( m_Count + 1 ) * 4 > GetCapacity() * 3 )
+    {
+        Rehash( GetCapacity() == 0 ? INT_VEC_HASH_MAP_MIN_CAPACITY : GetCapacity() * 2 );
+    }
+
+    Slot& slot = m_Slots[ FindSlot( key ) ];
+    if( !slot.isOccupied )
+    {
+        slot.key = key;
+        slot.value = Value();
+        slot.isOccupied = true;
+        ++m_Count;
+    }
+    return slot.value;
+}
+
+template <typename Key, typename Value>
+bool IntVecHashMap<Key, Value>::Insert( const Key& key, const Value& value )
+{
+    const unsigned int countBefore = m_Count;
+    operator[]( key ) = value;
+    return m_Count != countBefore;
+}
+
+template <typename Key, typename Value>
+bool IntVecHashMap<Key, Value>::Remove( const Key& key )
+{
+    if( m_Count == 0 )
+    {
+        return false;
+    }
+
+    const unsigned int mask = GetCapacity() - 1;
+    unsigned int hole = FindSlot( key );
+    if( !m_Slots[ hole ].isOccupied )
+    {
+        return false;
+    }
+
+    // Pull back every following entry that would no longer be reachable past the hole
+    unsigned int next = ( hole + 1 ) & mask;
+    while( m_Slots[ next ].isOccupied )
+    {
+        const unsigned int home = static_cast<unsigned int>( IntVecHash()( m_Slots[ next ].key ) ) & mask;
+        const unsigned int distanceToHole = ( hole - home ) & mask;
+        const unsigned int distanceToNext = ( next - home ) & mask;
+        if( distanceToHole < distanceToNext )
+        {
+            m_Slots[ hole ] = m_Slots[ next ];
+            hole = next;
+        }
+        next = ( next + 1 ) & mask;
+    }
+
+    m_Slots[ hole ].isOccupied = false;
+    m_Slots[ hole ].value = Value();
+    --m_Count;
+    return true;
+}
+
+template <typename Key, typename Value>
+void IntVecHashMap<Key, Value>::Reserve( const unsigned int count )
+{
+    unsigned int capacity = INT_VEC_HASH_MAP_MIN_CAPACITY;
+    while( count * 4 > capacity * 3 )
+    {
+        capacity *= 2;
+    }
+
+    if( capacity > GetCapacity() )
+    {
+        Rehash( capacity );
+    }
+}
+
+template <typename Key, typename Value>
+void IntVecHashMap<Key, Value>::Clear()
+{
+    m_Slots.clear();
+    m_Count = 0;
+}
+
+template <typename Key, typename Value>
+template <typename Callback>
+void IntVecHashMap<Key, Value>::ForEach( Callback callback )
+{
+    for( Slot& slot : m_Slots )
+    {
+        if( slot.isOccupied )
+        {
+            callback( static_cast<const Key&>( slot.key ), slot.value );
+        }
+    }
+}
+
+template <typename Key, typename Value>
+template <typename Callback>
+void IntVecHashMap<Key, Value>::ForEach( Callback callback ) const
+{
+    for( const Slot& slot : m_Slots )
+    {
+        if( slot.isOccupied )
+        {
+            callback( slot.key, slot.value );
+        }
+    }
+}
+
+template <typename Key, typename Value>
+unsigned int IntVecHashMap<Key, Value>::FindSlot( const Key& key ) const
+{
+    // Capacity is a power of two and never full, so the probe always ends
+    const unsigned int mask = GetCapacity() - 1;
+    unsigned int index = static_cast<unsigned int>( IntVecHash()( key ) ) & mask;
+    while( m_Slots[ index ].isOccupied && m_Slots[ index ].key != key )
+    {
+        index = ( index + 1 ) & mask;
+    }
+    return index;
+}
+
+template <typename Key, typename Value>
+void IntVecHashMap<Key, Value>::Rehash( const unsigned int newCapacity )
+{
+    std::vector<Slot> oldSlots( newCapacity );
+    oldSlots.swap( m_Slots );
+
+    for( Slot& slot : oldSlots )
+    {
+        if( slot.isOccupied )
+        {
+            Slot& newSlot = m_Slots[ FindSlot( slot.key ) ];
+            newSlot.key = slot.key;
+            newSlot.value = std::move( slot.value );
+            newSlot.isOccupied = true;
+        }
+    }
+}
@@ -0,0 +1,475 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/STL/IntVecHashMap.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+#include <vector>
+
+constexpr unsigned int SPARSE_GRID_DEFAULT_MAX_FILL = 1u << 20;
+
+//-----------------------------------------------------------------------------
+// Unbounded 2D grid stored as dense square chunks of ( 1 << CHUNK_BITS ) cells a side, created on
+//  first write. Cells in missing chunks read as the default value. Chunk cells are row major and
+//  all chunks live in one array, so a row inside a chunk is contiguous.
+//
+// T can not be bool, std::vector<bool> has no contiguous storage. Use unsigned char instead
+template <typename T, int CHUNK_BITS = 4>
+class SparseGrid2D
+{
+    static_assert( !std::is_same<T, bool>::value, "SparseGrid2D: Use unsigned char instead of bool" );
+
+public:
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+    static constexpr int CHUNK_CELL_COUNT = CHUNK_SIZE * CHUNK_SIZE;
+
+    explicit SparseGrid2D( const T& defaultValue = T() );
+
+    const T& Get( const IntVec2& cell ) const;
+    // Creates the chunk if needed, references are invalidated by the next new chunk
+    T& GetOrCreate( const IntVec2& cell );
+    void Set( const IntVec2& cell, const T& value ) { GetOrCreate( cell ) = value; }
+
+    static IntVec2 GetChunkCoords( const IntVec2& cell );
+    // CHUNK_CELL_COUNT cells, row major, or nullptr if the chunk was never written
+    const T* FindChunk( const IntVec2& chunkCoords ) const;
+    T* FindChunk( const IntVec2& chunkCoords );
+
+    unsigned int GetChunkCount() const { return static_cast<unsigned int>( m_ChunkCoords.size() ); }
+    const T& GetDefaultValue() const { return m_DefaultValue; }
+    void Clear();
+
+    // callback( const IntVec2& chunkCoords, const T* cells )
+    template <typename Callback>
+    void ForEachChunk( Callback callback ) const;
+
+    //-----------------------------------------------------------------------------
+    // Queries
+    // Row major copy of [mins, maxs] inclusive, one lookup and one copy per chunk row run
+    void GetCells( const IntVec2& mins, const IntVec2& maxs, OUT_PARAM T* cells ) const;
+    // ( 2 * radius + 1 ) squared cells around center
+    void GetNeighborhood( const IntVec2& center, int radius, OUT_PARAM T* cells ) const;
+
+    // 4 connected scanline fill from start over cells where canFill( value ) is true. Whole rows
+    //  are taken at a time so the reads stay inside a chunk row. Stops after maxCells since missing
+    //  chunks may pass canFill forever. Returns the number of cells filled
+    template <typename Predicate>
+    unsigned int FloodFill( const IntVec2& start, Predicate canFill, OUT_PARAM std::vector<IntVec2>& filledCells,
+                            unsigned int maxCells = SPARSE_GRID_DEFAULT_MAX_FILL ) const;
+
+private:
+    static int GetLocalIndex( const IntVec2& cell ) { return ( ( cell.y & CHUNK_MASK ) << CHUNK_BITS ) + ( cell.x & CHUNK_MASK ); }
+
+    IntVecHashMap<IntVec2, unsigned int> m_ChunkIndices;
+    std::vector<IntVec2> m_ChunkCoords;
+    std::vector<T> m_Cells;
+    T m_DefaultValue;
+};
+
+//-----------------------------------------------------------------------------
+// Same as SparseGrid2D with cubic chunks, x major then y then z. Flood fill is 6 connected
+template <typename T, int CHUNK_BITS = 4>
+class SparseGrid3D
+{
+    static_assert( !std::is_same<T, bool>::value, "SparseGrid3D: Use unsigned char instead of bool" );
+
+public:
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr int CHUNK_MASK = CHUNK_SIZE - 1;
+    static constexpr int CHUNK_CELL_COUNT = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+    explicit SparseGrid3D( const T& defaultValue = T() );
+
+    const T& Get( const IntVec3& cell ) const;
+    T& GetOrCreate( const IntVec3& cell );
+    void Set( const IntVec3& cell, const T& value ) { GetOrCreate( cell ) = value; }
+
+    static IntVec3 GetChunkCoords( const IntVec3& cell );
+    const T* FindChunk( const IntVec3& chunkCoords ) const;
+    T* FindChunk( const IntVec3& chunkCoords );
+
+    unsigned int GetChunkCount() const { return static_cast<unsigned int>( m_ChunkCoords.size() ); }
+    const T& GetDefaultValue() const { return m_DefaultValue; }
+    void Clear();
+
+    template <typename Callback>
+    void ForEachChunk( Callback callback ) const;
+
+    //-----------------------------------------------------------------------------
+    // Queries
+    // x major copy of [mins, maxs] inclusive
+    void GetCells( const IntVec3& mins, const IntVec3& maxs, OUT_PARAM T* cells ) const;
+    void GetNeighborhood( const IntVec3& center, int radius, OUT_PARAM T* cells ) const;
+
+    template <typename Predicate>
+    unsigned int FloodFill( const IntVec3& start, Predicate canFill, OUT_PARAM std::vector<IntVec3>& filledCells,
+                            unsigned int maxCells = SPARSE_GRID_DEFAULT_MAX_FILL ) const;
+
+private:
+    static int GetLocalIndex( const IntVec3& cell )
+    {
+        return ( ( ( ( cell.z & CHUNK_MASK ) << CHUNK_BITS ) + ( cell.y & CHUNK_MASK ) ) << CHUNK_BITS ) + ( cell.x & CHUNK_MASK );
+    }
+
+    IntVecHashMap<IntVec3, unsigned int> m_ChunkIndices;
+    std::vector<IntVec3> m_ChunkCoords;
+    std::vector<T> m_Cells;
+    T m_DefaultValue;
+};
+
+//-----------------------------------------------------------------------------
+// SparseGrid2D
+//-----------------------------------------------------------------------------
+template <typename T, int CHUNK_BITS>
+SparseGrid2D<T, CHUNK_BITS>::SparseGrid2D( const T& defaultValue )
+    : m_DefaultValue( defaultValue )
+{
+}
+
+template <typename T, int CHUNK_BITS>
+const T& SparseGrid2D<T, CHUNK_BITS>::Get( const IntVec2& cell ) const
+{
+    const T* chunk = FindChunk( GetChunkCoords( cell ) );
+    return chunk == nullptr ? m_DefaultValue : chunk[ GetLocalIndex( cell ) ];
+}
+
+template <typename T, int CHUNK_BITS>
+T& SparseGrid2D<T, CHUNK_BITS>::GetOrCreate( const IntVec2& cell )
+{
+    const IntVec2 chunkCoords = GetChunkCoords( cell );
+    T* chunk = FindChunk( chunkCoords );
+    if( chunk == nullptr )
+    {
+        const unsigned int chunkIndex = GetChunkCount();
+        m_ChunkIndices.Insert( chunkCoords, chunkIndex );
+        m_ChunkCoords.push_back( chunkCoords );
+        m_Cells.resize( m_Cells.size() + CHUNK_CELL_COUNT, m_DefaultValue );
+        chunk = m_Cells.data() + chunkIndex * CHUNK_CELL_COUNT;
+    }
+    return chunk[ GetLocalIndex( cell ) ];
+}
+
+// Arithmetic shift, so negative cells round down into the chunk below
+template <typename T, int CHUNK_BITS>
+IntVec2 SparseGrid2D<T, CHUNK_BITS>::GetChunkCoords( const IntVec2& cell )
+{
+    return IntVec2( cell.x >> CHUNK_BITS, cell.y >> CHUNK_BITS );
+}
+
+template <typename T, int CHUNK_BITS>
+const T* SparseGrid2D<T, CHUNK_BITS>::FindChunk( const IntVec2& chunkCoords ) const
+{
+    const unsigned int* chunkIndex = m_ChunkIndices.Find( chunkCoords );
+    return chunkIndex == nullptr ? nullptr : m_Cells.data() + *chunkIndex * CHUNK_CELL_COUNT;
+}
+
+template <typename T, int CHUNK_BITS>
+T* SparseGrid2D<T, CHUNK_BITS>::FindChunk( const IntVec2& chunkCoords )
+{
+    const unsigned int* chunkIndex = m_ChunkIndices.Find( chunkCoords );
+    return chunkIndex == nullptr ? nullptr : m_Cells.data() + *chunkIndex * CHUNK_CELL_COUNT;
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid2D<T, CHUNK_BITS>::Clear()
+{
+    m_ChunkIndices.Clear();
+    m_ChunkCoords.clear();
+    m_Cells.clear();
+}
+
+template <typename T, int CHUNK_BITS>
+template <typename Callback>
+void SparseGrid2D<T, CHUNK_BITS>::ForEachChunk( Callback callback ) const
+{
+    for( unsigned int chunkIndex = 0; chunkIndex < GetChunkCount(); ++chunkIndex )
+    {
+        callback( m_ChunkCoords[ chunkIndex ], m_Cells.data() + chunkIndex * CHUNK_CELL_COUNT );
+    }
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid2D<T, CHUNK_BITS>::GetCells( const IntVec2& mins, const IntVec2& maxs, T* cells ) const
+{
+    const int width = maxs.x - mins.x + 1;
+    for( int cellY = mins.y; cellY <= maxs.y; ++cellY )
+    {
+        T* row = cells + ( cellY - mins.y ) * width;
+        for( int cellX = mins.x; cellX <= maxs.x; )
+        {
+            const int chunkX = cellX >> CHUNK_BITS;
+            const int runEnd = std::min( maxs.x, ( chunkX << CHUNK_BITS ) + CHUNK_MASK );
+            const int runLength = runEnd - cellX + 1;
+
+            const T* chunk = FindChunk( IntVec2( chunkX, cellY >> CHUNK_BITS ) );
+            if( chunk == nullptr )
+            {
+                std::fill( row + ( cellX - mins.x ), row + ( cellX - mins.x ) + runLength, m_DefaultValue );
+            }
+            else
+            {
+                const T* source = chunk + GetLocalIndex( IntVec2( cellX, cellY ) );
+                std::copy( source, source + runLength, row + ( cellX - mins.x ) );
+            }
+            cellX = runEnd + 1;
+        }
+    }
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid2D<T, CHUNK_BITS>::GetNeighborhood( const IntVec2& center, const int radius, T* cells ) const
+{
+    GetCells( center - IntVec2( radius, radius ), center + IntVec2( radius, radius ), cells );
+}
+
+template <typename T, int CHUNK_BITS>
+template <typename Predicate>
+unsigned int SparseGrid2D<T, CHUNK_BITS>::FloodFill( const IntVec2& start, Predicate canFill,
+                                                     std::vector<IntVec2>& filledCells,
+                                                     const unsigned int maxCells ) const
+{
+    filledCells.clear();
+    if( !canFill( Get( start ) ) )
+    {
+        return 0;
+    }
+
+    SparseGrid2D<unsigned char, CHUNK_BITS> visited( 0 );
+    std::vector<IntVec2> seeds;
+    seeds.push_back( start );
+
+    while( !seeds.empty() )
+    {
+        const IntVec2 seed = seeds.back();
+        seeds.pop_back();
+        if( visited.Get( seed ) != 0 )
+        {
+            continue;
+        }
+
+        // Runs are taken whole, so nothing next to an unvisited seed has been visited yet
+        // The run is capped too, an open edge of the grid would otherwise never end
+        const size_t cellsLeft = maxCells - filledCells.size();
+        const int runBudget = static_cast<int>( std::min<size_t>( cellsLeft, INT_MAX ) );
+        int left = seed.x;
+        while( seed.x - left + 1 < runBudget && canFill( Get( IntVec2( left - 1, seed.y ) ) ) )
+        {
+            --left;
+        }
+        int right = seed.x;
+        while( right - left + 1 < runBudget && canFill( Get( IntVec2( right + 1, seed.y ) ) ) )
+        {
+            ++right;
+        }
+
+        for( int cellX = left; cellX <= right; ++cellX )
+        {
+            visited.Set( IntVec2( cellX, seed.y ), 1 );
+            filledCells.emplace_back( cellX, seed.y );
+            if( filledCells.size() >= maxCells )
+            {
+                return static_cast<unsigned int>( filledCells.size() );
+            }
+        }
+
+        // One seed per open run in the rows above and below
+        for( int neighborY = seed.y - 1; neighborY <= seed.y + 1; neighborY += 2 )
+        {
+            bool isInRun = false;
+            for( int cellX = left; cellX <= right; ++cellX )
+            {
+                const IntVec2 cell( cellX, neighborY );
+                const bool isOpen = visited.Get( cell ) == 0 && canFill( Get( cell ) );
+                if( isOpen && !isInRun )
+                {
+                    seeds.push_back( cell );
+                }
+                isInRun = isOpen;
+            }
+        }
+    }
+
+    return static_cast<unsigned int>( filledCells.size() );
+}
+
+//-----------------------------------------------------------------------------
+// SparseGrid3D
+//-----------------------------------------------------------------------------
+template <typename T, int CHUNK_BITS>
+SparseGrid3D<T, CHUNK_BITS>::SparseGrid3D( const T& defaultValue )
+    : m_DefaultValue( defaultValue )
+{
+}
+
+template <typename T, int CHUNK_BITS>
+const T& SparseGrid3D<T, CHUNK_BITS>::Get( const IntVec3& cell ) const
+{
+    const T* chunk = FindChunk( GetChunkCoords( cell ) );
+    return chunk == nullptr ? m_DefaultValue : chunk[ GetLocalIndex( cell ) ];
+}
+
+template <typename T, int CHUNK_BITS>
+T& SparseGrid3D<T, CHUNK_BITS>::GetOrCreate( const IntVec3& cell )
+{
+    const IntVec3 chunkCoords = GetChunkCoords( cell );
+    T* chunk = FindChunk( chunkCoords );
+    if( chunk == nullptr )
+    {
+        const unsigned int chunkIndex = GetChunkCount();
+        m_ChunkIndices.Insert( chunkCoords, chunkIndex );
+        m_ChunkCoords.push_back( chunkCoords );
+        m_Cells.resize( m_Cells.size() + CHUNK_CELL_COUNT, m_DefaultValue );
+        chunk = m_Cells.data() + chunkIndex * CHUNK_CELL_COUNT;
+    }
+    return chunk[ GetLocalIndex( cell ) ];
+}
+
+template <typename T, int CHUNK_BITS>
+IntVec3 SparseGrid3D<T, CHUNK_BITS>::GetChunkCoords( const IntVec3& cell )
+{
+    return IntVec3( cell.x >> CHUNK_BITS, cell.y >> CHUNK_BITS, cell.z >> CHUNK_BITS );
+}
+
+template <typename T, int CHUNK_BITS>
+const T* SparseGrid3D<T, CHUNK_BITS>::FindChunk( const IntVec3& chunkCoords ) const
+{
+    const unsigned int* chunkIndex = m_ChunkIndices.Find( chunkCoords );
+    return chunkIndex == nullptr ? nullptr : m_Cells.data() + *chunkIndex * CHUNK_CELL_COUNT;
+}
+
+template <typename T, int CHUNK_BITS>
+T* SparseGrid3D<T, CHUNK_BITS>::FindChunk( const IntVec3& chunkCoords )
+{
+    const unsigned int* chunkIndex = m_ChunkIndices.Find( chunkCoords );
+    return chunkIndex == nullptr ? nullptr : m_Cells.data() + *chunkIndex * CHUNK_CELL_COUNT;
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid3D<T, CHUNK_BITS>::Clear()
+{
+    m_ChunkIndices.Clear();
+    m_ChunkCoords.clear();
+    m_Cells.clear();
+}
+
+template <typename T, int CHUNK_BITS>
+template <typename Callback>
+void SparseGrid3D<T, CHUNK_BITS>::ForEachChunk( Callback callback ) const
+{
+    for( unsigned int chunkIndex = 0; chunkIndex < GetChunkCount(); ++chunkIndex )
+    {
+        callback( m_ChunkCoords[ chunkIndex ], m_Cells.data() + chunkIndex * CHUNK_CELL_COUNT );
+    }
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid3D<T, CHUNK_BITS>::GetCells( const IntVec3& mins, const IntVec3& maxs, T* cells ) const
+{
+    const int width = maxs.x - mins.x + 1;
+    const int height = maxs.y - mins.y + 1;
+    for( int cellZ = mins.z; cellZ <= maxs.z; ++cellZ )
+    {
+        for( int cellY = mins.y; cellY <= maxs.y; ++cellY )
+        {
+            T* row = cells + ( ( cellZ - mins.z ) * height + ( cellY - mins.y ) ) * width;
+            for( int cellX = mins.x; cellX <= maxs.x; )
+            {
+                const int chunkX = cellX >> CHUNK_BITS;
+                const int runEnd = std::min( maxs.x, ( chunkX << CHUNK_BITS ) + CHUNK_MASK );
+                const int runLength = runEnd - cellX + 1;
+
+                const T* chunk = FindChunk( IntVec3( chunkX, cellY >> CHUNK_BITS, cellZ >> CHUNK_BITS ) );
+                if( chunk == nullptr )
+                {
+                    std::fill( row + ( cellX - mins.x ), row + ( cellX - mins.x ) + runLength, m_DefaultValue );
+                }
+                else
+                {
+                    const T* source = chunk + GetLocalIndex( IntVec3( cellX, cellY, cellZ ) );
+                    std::copy( source, source + runLength, row + ( cellX - mins.x ) );
+                }
+                cellX = runEnd + 1;
+            }
+        }
+    }
+}
+
+template <typename T, int CHUNK_BITS>
+void SparseGrid3D<T, CHUNK_BITS>::GetNeighborhood( const IntVec3& center, const int radius, T* cells ) const
+{
+    GetCells( center - IntVec3( radius, radius, radius ), center + IntVec3( radius, radius, radius ), cells );
+}
+
+template <typename T, int CHUNK_BITS>
+template <typename Predicate>
+unsigned int SparseGrid3D<T, CHUNK_BITS>::FloodFill( const IntVec3& start, Predicate canFill,
+                                                     std::vector<IntVec3>& filledCells,
+                                                     const unsigned int maxCells ) const
+{
+    filledCells.clear();
+    if( !canFill( Get( start ) ) )
+    {
+        return 0;
+    }
+
+    SparseGrid3D<unsigned char, CHUNK_BITS> visited( 0 );
+    std::vector<IntVec3> seeds;
+    seeds.push_back( start );
+
+    while( !seeds.empty() )
+    {
+        const IntVec3 seed = seeds.back();
+        seeds.pop_back();
+        if( visited.Get( seed ) != 0 )
+        {
+            continue;
+        }
+
+        // The run is capped too, an open edge of the grid would otherwise never end
+        const size_t cellsLeft = maxCells - filledCells.size();
+        const int runBudget = static_cast<int>( std::min<size_t>( cellsLeft, INT_MAX ) );
+        int left = seed.x;
+        while( seed.x - left + 1 < runBudget && canFill( Get( IntVec3( left - 1, seed.y, seed.z ) ) ) )
+        {
+            --left;
+        }
+        int right = seed.x;
+        while( right - left + 1 < runBudget && canFill( Get( IntVec3( right + 1, seed.y, seed.z ) ) ) )
+        {
+            ++right;
+        }
+
+        for( int cellX = left; cellX <= right; ++cellX )
+        {
+            visited.Set( IntVec3( cellX, seed.y, seed.z ), 1 );
+            filledCells.emplace_back( cellX, seed.y, seed.z );
+            if( filledCells.size() >= maxCells )
+            {
+                return static_cast<unsigned int>( filledCells.size() );
+            }
+        }
+
+        const IntVec3 neighborOffsets[ 4 ] = {
+            IntVec3( 0, -1, 0 ), IntVec3( 0, 1, 0 ), IntVec3( 0, 0, -1 ), IntVec3( 0, 0, 1 )
+        };
+        for( const IntVec3& offset : neighborOffsets )
+        {
+            bool isInRun = false;
+            for( int cellX = left; cellX <= right; ++cellX )
+            {
+                const IntVec3 cell( cellX, seed.y + offset.y, seed.z + offset.z );
+                const bool isOpen = visited.Get( cell ) == 0 && canFill( Get( cell ) );
+                if( isOpen && !isInRun )
+                {
+                    seeds.push_back( cell );
+                }
+                isInRun = isOpen;
+            }
+        }
+    }
+
+    return static_cast<unsigned int>( filledCells.size() );
+}
@@ -11,28 +11,47 @@ Transform::Transform( const Vec3& pos, const Vec3& scl, const Vec3& rotationOnAx
       , rotationAroundAxis( rotationOnAxis )
       , scale( scl )
 {
+    UpdateRotationCache();
 }
 
 Mat44 Transform::GetAsMatrix() const
 {
     GUARANTEE_RECOVERABLE( scale.x > 0 && scale.y > 0 && scale.z > 0, "Transform: Scale is zero" );
 
-    Mat44 transform = Mat44::CreateFromTranslation( position );
-    transform.PushMatrix( GetRotationMatrix( ) );
-    transform.PushMatrix( Mat44::CreateFromScale( scale ) );
-
-    return transform;
+    if( IsRotationCacheCurrent() )
+    {
+        return ComposeWithRotation( m_CachedRotation );
+    }
+    return ComposeWithRotation( Quaternion::CreateFromEulerDegrees( rotationAroundAxis ).GetAsMatrix() );
 }
 
 Mat44 Transform::GetAsMatrixWithCanonicalTransform() const
 {
     GUARANTEE_RECOVERABLE( scale.x > 0 && scale.y > 0 && scale.z > 0, "Transform: Scale is zero" );
 
-    Mat44 transform = Mat44::CreateFromTranslation( position );
-    transform.PushMatrix( GetRotationMatrix( true ) );
-    transform.PushMatrix( Mat44::CreateFromScale( scale ) );
+    // The canonical transform can be changed by the game, so it is applied on every call
+    Mat44 rotation = IsRotationCacheCurrent() ? m_CachedRotation
+                                              : Quaternion::CreateFromEulerDegrees( rotationAroundAxis ).GetAsMatrix();
+    rotation.PushMatrix( Engine::GetCanonicalTransform() );
+    return ComposeWithRotation( rotation );
+}
 
-    return transform;
+Quaternion Transform::GetOrientation() const
+{
+    if( IsRotationCacheCurrent() )
+    {
+        return m_CachedOrientation;
+    }
+    return Quaternion::CreateFromEulerDegrees( rotationAroundAxis );
+}
+
+STATIC Transform Transform::Interpolate( const Transform& from, const Transform& to, const float percentage )
+{
+    Transform result;
+    result.position = Vec3::Lerp( from.position, to.position, percentage );
+    result.scale = Vec3::Lerp( from.scale, to.scale, percentage );
+    result.SetOrientation( Quaternion::Slerp( from.GetOrientation(), to.GetOrientation(), percentage ) );
+    return result;
 }
 
 void Transform::SetRotationFromAxis( const Vec3& rotationOnAxis )
@@ -40,6 +59,7 @@ void Transform::SetRotationFromAxis( const Vec3& rotationOnAxis )
     rotationAroundAxis.x = rotationOnAxis.x;
     rotationAroundAxis.y = rotationOnAxis.y;
     rotationAroundAxis.z = rotationOnAxis.z;
+    UpdateRotationCache();
 }
 
 void Transform::AppendRotationFromAxis( const float xAxis, const float yAxis, const float zAxis )
@@ -47,6 +67,7 @@ void Transform::AppendRotationFromAxis( const float xAxis, const float yAxis, co
     rotationAroundAxis.x += xAxis;
     rotationAroundAxis.y += yAxis;
     rotationAroundAxis.z += zAxis;
+    UpdateRotationCache();
 }
 
 void Transform::AppendRotationFromAxis( const Vec3& deltaAxisRotation )
@@ -54,18 +75,64 @@ void Transform::AppendRotationFromAxis( const Vec3& deltaAxisRotation )
     rotationAroundAxis.x += deltaAxisRotation.x;
     rotationAroundAxis.y += deltaAxisRotation.y;
     rotationAroundAxis.z += deltaAxisRotation.z;
+    UpdateRotationCache();
 }
 
-Mat44 Transform::GetRotationMatrix( bool pushCanonical ) const
+void Transform::SetOrientation( const Quaternion& orientation )
 {
-    Mat44 rotationFinal = Mat44::CreateFromZRotationDegrees( rotationAroundAxis.z );
-    rotationFinal.PushMatrix( Mat44::CreateFromYRotationDegrees( rotationAroundAxis.y ) );
-    rotationFinal.PushMatrix( Mat44::CreateFromXRotationDegrees( rotationAroundAxis.x ) );
+    m_CachedOrientation = orientation.GetNormalized();
+    m_CachedRotation = m_CachedOrientation.GetAsMatrix();
+    rotationAroundAxis = m_CachedOrientation.GetEulerDegrees();
+    m_CachedRotationAroundAxis = rotationAroundAxis;
+}
 
-    if( pushCanonical )
+void Transform::AppendRotation( const Quaternion& deltaRotation )
+{
+    SetOrientation( deltaRotation * GetOrientation() );
+}
+
+void Transform::UpdateRotationCache()
+{
+    if( IsRotationCacheCurrent() )
     {
-        rotationFinal.PushMatrix( Engine::GetCanonicalTransform() );
+        return;
     }
 
-    return rotationFinal;
+    m_CachedOrientation = Quaternion::CreateFromEulerDegrees( rotationAroundAxis );
+    m_CachedRotation = m_CachedOrientation.GetAsMatrix();
+    m_CachedRotationAroundAxis = rotationAroundAxis;
+}
+
+bool Transform::IsRotationCacheCurrent() const
+{
+    return m_CachedRotationAroundAxis.x == rotationAroundAxis.x &&
+           m_CachedRotationAroundAxis.y == rotationAroundAxis.y &&
+           m_CachedRotationAroundAxis.z == rotationAroundAxis.z;
+}
+
+// Translation * rotation * scale without the two full multiplies. The rotation is a pure basis,
+//  so translation only adds to the last column and scale only scales the basis columns
+Mat44 Transform::ComposeWithRotation( const Mat44& rotation ) const
+{
+    Mat44 transform = rotation;
+    transform.Ix *= scale.x;
+    transform.Iy *= scale.x;
+    transform.Iz *= scale.x;
+    transform.Iw *= scale.x;
+
+    transform.Jx *= scale.y;
+    transform.Jy *= scale.y;
+    transform.Jz *= scale.y;
+    transform.Jw *= scale.y;
+
+    transform.Kx *= scale.z;
+    transform.Ky *= scale.z;
+    transform.Kz *= scale.z;
+    transform.Kw *= scale.z;
+
+    transform.Tx += position.x;
+    transform.Ty += position.y;
+    transform.Tz += position.z;
+
+    return transform;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math/Primatives/Mat44.hpp"
+#include "Math/Primatives/Quaternion.hpp"
 #include "Math/Primatives/Vec3.hpp"
 
 class InputSystem;
@@ -17,6 +18,10 @@ public:
 
     Mat44 GetAsMatrix() const;
     Mat44 GetAsMatrixWithCanonicalTransform() const;
+    Quaternion GetOrientation() const;
+
+    // Position and scale lerp, the rotation slerps
+    static Transform Interpolate( const Transform& from, const Transform& to, float percentage );
 
     //-----------------------------------------------------------------------------
     // Modifiers
@@ -24,7 +29,21 @@ public:
     void SetRotationFromAxis( const Vec3& rotationOnAxis );
     void AppendRotationFromAxis( float xAxis, float yAxis, float zAxis );
     void AppendRotationFromAxis( const Vec3& deltaAxisRotation );
+    // rotationAroundAxis is rewritten to match, and the quaternion is kept until it changes again
+    void SetOrientation( const Quaternion& orientation );
+    // Turns by deltaRotation in world space, after the current rotation
+    void AppendRotation( const Quaternion& deltaRotation );
 
 private:
-    Mat44 GetRotationMatrix( bool pushCanonical = false ) const;
+    void UpdateRotationCache();
+    bool IsRotationCacheCurrent() const;
+    Mat44 ComposeWithRotation( const Mat44& rotation ) const;
+
+    // The rotation goes through a quaternion and is only rebuilt by the modifiers, so a transform
+    //  that is queried every frame but only moves pays for a few multiplies. The getters never
+    //  write it and are safe to call from many threads. Writing rotationAroundAxis directly skips
+    //  the cache, and every read rebuilds the rotation until a modifier runs
+    Quaternion m_CachedOrientation;
+    Mat44 m_CachedRotation;
+    Vec3 m_CachedRotationAroundAxis = Vec3::ZERO;
 };
@@ -0,0 +1,409 @@
+#include "TransformHierarchy.hpp"
+
+#include "Engine/Event/JobSystem.hpp"
+
+constexpr unsigned int TRANSFORM_BATCH_SIZE = 1024;
+
+constexpr unsigned char TRANSFORM_DIRTY_LOCAL = static_cast<unsigned char>( BIT_FLAG<0> );
+constexpr unsigned char TRANSFORM_DIRTY_WORLD = static_cast<unsigned char>( BIT_FLAG<1> );
+
+constexpr unsigned int UNKNOWN_DEPTH = 0xffffffff;
+
+template <typename T>
+static void GatherInOrder( std::vector<T>& values, const std::vector<unsigned int>& newOrder )
+{
+    std::vector<T> ordered;
+    ordered.reserve( newOrder.size() );
+    for( const unsigned int oldIndex : newOrder )
+    {
+        ordered.push_back( values[ oldIndex ] );
+    }
+    values.swap( ordered );
+}
+
+//-----------------------------------------------------------------------------
+unsigned int TransformHierarchy::Create( const unsigned int parentHandle, const Transform& localTransform )
+{
+    unsigned int depth = 0;
+    unsigned int parentIndex = INVALID_TRANSFORM_HANDLE;
+    if( parentHandle != INVALID_TRANSFORM_HANDLE )
+    {
+        parentIndex = GetIndex( parentHandle );
+        depth = m_Depths[ parentIndex ] + 1;
+    }
+
+    unsigned int handle;
+    if( m_FreeHandles.empty() )
+    {
+        handle = static_cast<unsigned int>( m_HandleToIndex.size() );
+        m_HandleToIndex.push_back( INVALID_TRANSFORM_HANDLE );
+    }
+    else
+    {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+
+    // Appending keeps the order when the node lands on the last level or starts the next one
+    const unsigned int index = GetCount();
+    if( !m_IsOrderDirty )
+    {
+        if( index == 0 && depth == 0 )
+        {
+            m_LevelStarts = { 0, 1 };
+        }
+        else if( index > 0 && depth == m_Depths.back() )
+        {
+            ++m_LevelStarts.back();
+        }
+        else if( index > 0 && depth == m_Depths.back() + 1 )
+        {
+            m_LevelStarts.push_back( index + 1 );
+        }
+        else
+        {
+            m_IsOrderDirty = true;
+        }
+    }
+
+    m_HandleToIndex[ handle ] = index;
+    m_Handles.push_back( handle );
+    m_ParentHandles.push_back( parentHandle );
+    m_ParentIndices.push_back( parentIndex );
+    m_Depths.push_back( depth );
+    m_LocalTransforms.push_back( localTransform );
+    m_LocalMatrices.push_back( Mat44::IDENTITY );
+    m_WorldMatrices.push_back( Mat44::IDENTITY );
+    m_DirtyFlags.push_back( 0 );
+    MarkDirty( index, TRANSFORM_DIRTY_LOCAL | TRANSFORM_DIRTY_WORLD );
+
+    return handle;
+}
+
+void TransformHierarchy::Destroy( const unsigned int handle )
+{
+    if( m_IsOrderDirty )
+    {
+        SortByDepth();
+    }
+
+    // Children always come after their parent, so one pass finds the whole subtree
+    const unsigned int rootIndex = GetIndex( handle );
+    const unsigned int count = GetCount();
+    std::vector<unsigned char> isRemoved( count, 0 );
+    isRemoved[ rootIndex ] = 1;
+    for( unsigned int index = rootIndex + 1; index < count; ++index )
+    {
+        const unsigned int parentIndex = m_ParentIndices[ index ];
+        if( parentIndex != INVALID_TRANSFORM_HANDLE && isRemoved[ parentIndex ] )
+        {
+            isRemoved[ index ] = 1;
+        }
+    }
+
+    std::vector<unsigned int> newOrder;
+    newOrder.reserve( count );
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        if( isRemoved[ index ] )
+        {
+            m_HandleToIndex[ m_Handles[ index ] ] = INVALID_TRANSFORM_HANDLE;
+            m_FreeHandles.push_back( m_Handles[ index ] );
+        }
+        else
+        {
+            newOrder.push_back( index );
+        }
+    }
+
+    ApplyOrder( newOrder );
+    RebuildLevelStarts();
+}
+
+void TransformHierarchy::SetParent( const unsigned int handle, const unsigned int parentHandle )
+{
+    const unsigned int index = GetIndex( handle );
+    if( m_ParentHandles[ index ] == parentHandle )
+    {
+        return;
+    }
+
+    for( unsigned int ancestor = parentHandle; ancestor != INVALID_TRANSFORM_HANDLE;
+         ancestor = m_ParentHandles[ GetIndex( ancestor ) ] )
+    {
+        GUARANTEE_OR_DIE( ancestor != handle, "TransformHierarchy: A transform can not be parented under itself" );
+    }
+
+    m_ParentHandles[ index ] = parentHandle;
+    m_ParentIndices[ index ] = parentHandle == INVALID_TRANSFORM_HANDLE ? INVALID_TRANSFORM_HANDLE : GetIndex( parentHandle );
+    m_IsOrderDirty = true;
+    MarkDirty( index, TRANSFORM_DIRTY_WORLD );
+}
+
+bool TransformHierarchy::IsValid( const unsigned int handle ) const
+{
+    return handle < m_HandleToIndex.size() && m_HandleToIndex[ handle ] != INVALID_TRANSFORM_HANDLE;
+}
+
+unsigned int TransformHierarchy::GetParent( const unsigned int handle ) const
+{
+    return m_ParentHandles[ GetIndex( handle ) ];
+}
+
+void TransformHierarchy::Reserve( const unsigned int count )
+{
+    m_HandleToIndex.reserve( count );
+    m_Handles.reserve( count );
+    m_ParentHandles.reserve( count );
+    m_ParentIndices.reserve( count );
+    m_Depths.reserve( count );
+    m_LocalTransforms.reserve( count );
+    m_LocalMatrices.reserve( count );
+    m_WorldMatrices.reserve( count );
+    m_DirtyFlags.reserve( count );
+    m_WasWorldUpdated.reserve( count );
+}
+
+void TransformHierarchy::Clear()
+{
+    m_HandleToIndex.clear();
+    m_FreeHandles.clear();
+    m_Handles.clear();
+    m_ParentHandles.clear();
+    m_ParentIndices.clear();
+    m_Depths.clear();
+    m_LocalTransforms.clear();
+    m_LocalMatrices.clear();
+    m_WorldMatrices.clear();
+    m_DirtyFlags.clear();
+    m_WasWorldUpdated.clear();
+    m_LevelStarts.clear();
+    m_IsOrderDirty = false;
+    m_IsAnyNodeDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+void TransformHierarchy::SetLocalTransform( const unsigned int handle, const Transform& localTransform )
+{
+    const unsigned int index = GetIndex( handle );
+    m_LocalTransforms[ index ] = localTransform;
+    MarkDirty( index, TRANSFORM_DIRTY_LOCAL | TRANSFORM_DIRTY_WORLD );
+}
+
+const Transform& TransformHierarchy::GetLocalTransform( const unsigned int handle ) const
+{
+    return m_LocalTransforms[ GetIndex( handle ) ];
+}
+
+void TransformHierarchy::SetLocalMatrix( const unsigned int handle, const Mat44& localMatrix )
+{
+    const unsigned int index = GetIndex( handle );
+    m_LocalMatrices[ index ] = localMatrix;
+    m_DirtyFlags[ index ] &= static_cast<unsigned char>( ~TRANSFORM_DIRTY_LOCAL );
+    MarkDirty( index, TRANSFORM_DIRTY_WORLD );
+}
+
+const Mat44& TransformHierarchy::GetLocalMatrix( const unsigned int handle ) const
+{
+    return m_LocalMatrices[ GetIndex( handle ) ];
+}
+
+const Mat44& TransformHierarchy::GetWorldMatrix( const unsigned int handle ) const
+{
+    return m_WorldMatrices[ GetIndex( handle ) ];
+}
+
+//-----------------------------------------------------------------------------
+unsigned int TransformHierarchy::UpdateWorldMatrices( const bool useJobSystem )
+{
+    if( !m_IsAnyNodeDirty )
+    {
+        return 0;
+    }
+
+    if( m_IsOrderDirty )
+    {
+        SortByDepth();
+    }
+
+    m_WasWorldUpdated.resize( GetCount() );
+
+    // A level only reads the level above it, so the nodes of one level never wait on each other
+    const unsigned int levelCount = GetLevelCount();
+    for( unsigned int levelIndex = 0; levelIndex < levelCount; ++levelIndex )
+    {
+        const unsigned int levelStart = m_LevelStarts[ levelIndex ];
+        const unsigned int levelEnd = m_LevelStarts[ levelIndex + 1 ];
+        if( useJobSystem && levelEnd - levelStart > TRANSFORM_BATCH_SIZE )
+        {
+            JobSystem::INSTANCE().ParallelFor( levelEnd - levelStart, TRANSFORM_BATCH_SIZE,
+                                               [&]( const unsigned int startIndex, const unsigned int endIndex )
+                                               {
+                                                   UpdateWorldMatrixRange( levelStart + startIndex,
+                                                                           levelStart + endIndex );
+                                               } );
+        }
+        else
+        {
+            UpdateWorldMatrixRange( levelStart, levelEnd );
+        }
+    }
+
+    m_IsAnyNodeDirty = false;
+
+    unsigned int updatedCount = 0;
+    for( const unsigned char wasUpdated : m_WasWorldUpdated )
+    {
+        updatedCount += wasUpdated;
+    }
+    return updatedCount;
+}
+
+// Every parent in the range must already be up to date, which holds for any range inside one level
+void TransformHierarchy::UpdateWorldMatrixRange( const unsigned int startIndex, const unsigned int endIndex )
+{
+    for( unsigned int index = startIndex; index < endIndex; ++index )
+    {
+        const unsigned char dirtyFlags = m_DirtyFlags[ index ];
+        const unsigned int parentIndex = m_ParentIndices[ index ];
+        const bool isParentUpdated = parentIndex != INVALID_TRANSFORM_HANDLE && m_WasWorldUpdated[ parentIndex ];
+        if( dirtyFlags == 0 && !isParentUpdated )
+        {
+            m_WasWorldUpdated[ index ] = 0;
+            continue;
+        }
+
+        if( dirtyFlags & TRANSFORM_DIRTY_LOCAL )
+        {
+            m_LocalMatrices[ index ] = m_LocalTransforms[ index ].GetAsMatrix();
+        }
+
+        if( parentIndex == INVALID_TRANSFORM_HANDLE )
+        {
+            m_WorldMatrices[ index ] = m_LocalMatrices[ index ];
+        }
+        else
+        {
+            Mat44 worldMatrix = m_WorldMatrices[ parentIndex ];
+            worldMatrix.PushMatrix( m_LocalMatrices[ index ] );
+            m_WorldMatrices[ index ] = worldMatrix;
+        }
+
+        m_DirtyFlags[ index ] = 0;
+        m_WasWorldUpdated[ index ] = 1;
+    }
+}
+
+unsigned int TransformHierarchy::GetLevelCount() const
+{
+    return m_LevelStarts.empty() ? 0 : static_cast<unsigned int>( m_LevelStarts.size() ) - 1;
+}
+
+//-----------------------------------------------------------------------------
+unsigned int TransformHierarchy::GetIndex( const unsigned int handle ) const
+{
+    GUARANTEE_OR_DIE( IsValid( handle ), "TransformHierarchy: Invalid transform handle" );
+    return m_HandleToIndex[ handle ];
+}
+
+void TransformHierarchy::MarkDirty( const unsigned int index, const unsigned char dirtyFlags )
+{
+    m_DirtyFlags[ index ] |= dirtyFlags;
+    m_IsAnyNodeDirty = true;
+}
+
+// Depths are found by walking up to the nearest node with a known depth, then a stable counting
+//  sort keeps siblings in the order they were created
+void TransformHierarchy::SortByDepth()
+{
+    const unsigned int count = GetCount();
+    std::vector<unsigned int> depths( count, UNKNOWN_DEPTH );
+    std::vector<unsigned int> unresolved;
+    unsigned int deepest = 0;
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        unsigned int walkIndex = index;
+        while( depths[ walkIndex ] == UNKNOWN_DEPTH && m_ParentHandles[ walkIndex ] != INVALID_TRANSFORM_HANDLE )
+        {
+            unresolved.push_back( walkIndex );
+            walkIndex = m_HandleToIndex[ m_ParentHandles[ walkIndex ] ];
+        }
+        if( depths[ walkIndex ] == UNKNOWN_DEPTH )
+        {
+            depths[ walkIndex ] = 0;
+        }
+
+        unsigned int depth = depths[ walkIndex ];
+        while( !unresolved.empty() )
+        {
+            depths[ unresolved.back() ] = ++depth;
+            unresolved.pop_back();
+        }
+        deepest = depths[ index ] > deepest ? depths[ index ] : deepest;
+    }
+
+    std::vector<unsigned int> levelOffsets( count > 0 ? deepest + 2 : 0, 0 );
+    for( const unsigned int depth : depths )
+    {
+        ++levelOffsets[ depth + 1 ];
+    }
+    for( size_t levelIndex = 1; levelIndex < levelOffsets.size(); ++levelIndex )
+    {
+        levelOffsets[ levelIndex ] += levelOffsets[ levelIndex - 1 ];
+    }
+
+    std::vector<unsigned int> newOrder( count );
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        newOrder[ levelOffsets[ depths[ index ] ]++ ] = index;
+    }
+
+    m_Depths.swap( depths );
+    ApplyOrder( newOrder );
+    RebuildLevelStarts();
+    m_IsOrderDirty = false;
+}
+
+// newOrder[ i ] is the old index of the node that ends up at i. Nodes left out are dropped
+void TransformHierarchy::ApplyOrder( const std::vector<unsigned int>& newOrder )
+{
+    GatherInOrder( m_Handles, newOrder );
+    GatherInOrder( m_ParentHandles, newOrder );
+    GatherInOrder( m_Depths, newOrder );
+    GatherInOrder( m_LocalTransforms, newOrder );
+    GatherInOrder( m_LocalMatrices, newOrder );
+    GatherInOrder( m_WorldMatrices, newOrder );
+    GatherInOrder( m_DirtyFlags, newOrder );
+
+    const unsigned int count = GetCount();
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        m_HandleToIndex[ m_Handles[ index ] ] = index;
+    }
+
+    m_ParentIndices.resize( count );
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        const unsigned int parentHandle = m_ParentHandles[ index ];
+        m_ParentIndices[ index ] = parentHandle == INVALID_TRANSFORM_HANDLE ? INVALID_TRANSFORM_HANDLE : m_HandleToIndex[ parentHandle ];
+    }
+
+    m_WasWorldUpdated.resize( count );
+}
+
+void TransformHierarchy::RebuildLevelStarts()
+{
+    m_LevelStarts.clear();
+    const unsigned int count = GetCount();
+    for( unsigned int index = 0; index < count; ++index )
+    {
+        if( index == 0 || m_Depths[ index ] != m_Depths[ index - 1 ] )
+        {
+            m_LevelStarts.push_back( index );
+        }
+    }
+    if( count > 0 )
+    {
+        m_LevelStarts.push_back( count );
+    }
+}
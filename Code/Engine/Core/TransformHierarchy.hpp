@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Transform.hpp"
+
+#include <vector>
+
+constexpr unsigned int INVALID_TRANSFORM_HANDLE = 0xffffffff;
+
+//-----------------------------------------------------------------------------
+// Parent / child transforms kept as structure of arrays sorted by depth, so every parent sits
+//  before its children and each depth level is one contiguous range. Local and world matrices
+//  are cached; changing a local transform only marks the node dirty and UpdateWorldMatrices
+//  rebuilds the dirty nodes and their descendants, one level at a time.
+//
+// Handles stay the same for the life of a node, indices into the arrays do not
+class TransformHierarchy
+{
+public:
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    unsigned int Create( unsigned int parentHandle = INVALID_TRANSFORM_HANDLE,
+                         const Transform& localTransform = Transform() );
+    // Destroys the node and everything under it
+    void Destroy( unsigned int handle );
+    // Keeps the local transform, so the node moves with its new parent
+    void SetParent( unsigned int handle, unsigned int parentHandle );
+
+    bool IsValid( unsigned int handle ) const;
+    unsigned int GetParent( unsigned int handle ) const;
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_Handles.size() ); }
+
+    //-----------------------------------------------------------------------------
+    // Local space
+    void SetLocalTransform( unsigned int handle, const Transform& localTransform );
+    const Transform& GetLocalTransform( unsigned int handle ) const;
+    // Overrides the matrix built from the local transform until the next SetLocalTransform
+    void SetLocalMatrix( unsigned int handle, const Mat44& localMatrix );
+    const Mat44& GetLocalMatrix( unsigned int handle ) const;
+
+    //-----------------------------------------------------------------------------
+    // World space, as of the last UpdateWorldMatrices
+    const Mat44& GetWorldMatrix( unsigned int handle ) const;
+
+    // Rebuilds the local matrix of every changed node and the world matrix of every changed node
+    //  and its descendants. Levels run in order and the nodes of a level are split across the
+    //  JobSystem when useJobSystem is set. Returns how many world matrices changed
+    unsigned int UpdateWorldMatrices( bool useJobSystem = true );
+    void UpdateWorldMatrixRange( unsigned int startIndex, unsigned int endIndex );
+
+    // Depth order, valid after UpdateWorldMatrices until the next Create, SetParent or Destroy
+    const unsigned int* GetHandles() const { return m_Handles.data(); }
+    const Mat44* GetWorldMatrices() const { return m_WorldMatrices.data(); }
+    unsigned int GetLevelCount() const;
+
+private:
+    // Indexed by handle
+    std::vector<unsigned int> m_HandleToIndex;
+    std::vector<unsigned int> m_FreeHandles;
+
+    // Indexed by depth order
+    std::vector<unsigned int> m_Handles;
+    std::vector<unsigned int> m_ParentHandles;
+    std::vector<unsigned int> m_ParentIndices;
+    std::vector<unsigned int> m_Depths;
+    std::vector<Transform> m_LocalTransforms;
+    std::vector<Mat44> m_LocalMatrices;
+    std::vector<Mat44> m_WorldMatrices;
+    std::vector<unsigned char> m_DirtyFlags;
+    std::vector<unsigned char> m_WasWorldUpdated;
+
+    // First index of every level, plus one past the last node
+    std::vector<unsigned int> m_LevelStarts;
+    bool m_IsOrderDirty = false;
+    bool m_IsAnyNodeDirty = false;
+
+    unsigned int GetIndex( unsigned int handle ) const;
+    void MarkDirty( unsigned int index, unsigned char dirtyFlags );
+    void SortByDepth();
+    void ApplyOrder( const std::vector<unsigned int>& newOrder );
+    void RebuildLevelStarts();
+};
@@ -0,0 +1,520 @@
+#include "PixelUtils.hpp"
+
+#include "Engine/Core/Math/SimdCommon.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+constexpr int KAISER_TAP_COUNT = 6;
+constexpr int LINEAR_TO_SRGB_BUCKETS = 1024;
+
+static unsigned char PremultiplyChannel( const unsigned char channel, const unsigned char alpha )
+{
+    // Exact round( channel * alpha / 255 ) without a divide
+    const unsigned int product = static_cast<unsigned int>( channel ) * alpha + 128;
+    return static_cast<unsigned char>( ( product + ( product >> 8 ) ) >> 8 );
+}
+
+static unsigned char AverageChannels( const unsigned char a, const unsigned char b,
+                                      const unsigned char c, const unsigned char d )
+{
+    return static_cast<unsigned char>( ( a + b + c + d + 2 ) >> 2 );
+}
+
+//-----------------------------------------------------------------------------
+struct SrgbTables
+{
+    float toLinear[ 256 ];
+    // Plain code / 255 for data that is not sRGB encoded
+    float toUnorm[ 256 ];
+    // Linear value halfway between each code and the next, found from a bucket's first code
+    float thresholds[ 255 ];
+    unsigned char bucketStart[ LINEAR_TO_SRGB_BUCKETS + 1 ];
+
+    static float DecodeSrgb( const float srgb )
+    {
+        return srgb <= .04045f ? srgb / 12.92f : powf( ( srgb + .055f ) / 1.055f, 2.4f );
+    }
+
+    SrgbTables()
+    {
+        for( int code = 0; code < 256; ++code )
+        {
+            toLinear[ code ] = DecodeSrgb( static_cast<float>( code ) / 255.f );
+            toUnorm[ code ] = static_cast<float>( code ) / 255.f;
+        }
+        for( int code = 0; code < 255; ++code )
+        {
+            thresholds[ code ] = DecodeSrgb( ( static_cast<float>( code ) + .5f ) / 255.f );
+        }
+
+        int code = 0;
+        for( int bucket = 0; bucket <= LINEAR_TO_SRGB_BUCKETS; ++bucket )
+        {
+            const float bucketStartValue = static_cast<float>( bucket ) / LINEAR_TO_SRGB_BUCKETS;
+            while( code < 255 && bucketStartValue >= thresholds[ code ] ) { ++code; }
+            bucketStart[ bucket ] = static_cast<unsigned char>( code );
+        }
+    }
+};
+
+static const SrgbTables& GetSrgbTables()
+{
+    static const SrgbTables s_Tables;
+    return s_Tables;
+}
+
+// Kaiser windowed sinc for a 2:1 reduction, taps at -2.5 to 2.5 texels from the destination center
+struct KaiserWeights
+{
+    float weights[ KAISER_TAP_COUNT ];
+
+    static double BesselI0( const double x )
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for( int k = 1; k < 32; ++k )
+        {
+            term *= ( x / ( 2.0 * k ) ) * ( x / ( 2.0 * k ) );
+            sum += term;
+        }
+        return sum;
+    }
+
+    KaiserWeights()
+    {
+        constexpr double PI = 3.14159265358979323846;
+        constexpr double ALPHA = 4.0;
+        constexpr double HALF_WIDTH = 3.0;
+
+        double total = 0.0;
+        double rawWeights[ KAISER_TAP_COUNT ];
+        for( int tap = 0; tap < KAISER_TAP_COUNT; ++tap )
+        {
+            const double offset = tap - 2.5;
+            const double sincX = PI * offset * .5;
+            const double sinc = sin( sincX ) / sincX;
+            const double window = offset / HALF_WIDTH;
+            rawWeights[ tap ] = sinc * BesselI0( ALPHA * sqrt( 1.0 - window * window ) ) / BesselI0( ALPHA );
+            total += rawWeights[ tap ];
+        }
+        for( int tap = 0; tap < KAISER_TAP_COUNT; ++tap )
+        {
+            weights[ tap ] = static_cast<float>( rawWeights[ tap ] / total );
+        }
+    }
+};
+
+static const KaiserWeights& GetKaiserWeights()
+{
+    static const KaiserWeights s_Weights;
+    return s_Weights;
+}
+
+static int ClampTexelIndex( const int index, const int count )
+{
+    return index < 0 ? 0 : ( index >= count ? count - 1 : index );
+}
+
+static unsigned char RoundToByte( const float value )
+{
+    const float rounded = value + .5f;
+    return static_cast<unsigned char>( rounded <= 0.f ? 0.f : ( rounded >= 255.f ? 255.f : rounded ) );
+}
+
+#if defined(ENGINE_SIMD_SSE)
+static __m128i LoadTexels( const Rgba8* texels )
+{
+    return _mm_loadu_si128( reinterpret_cast<const __m128i*>( texels ) );
+}
+
+static void StoreTexels( Rgba8* texels, const __m128i value )
+{
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( texels ), value );
+}
+
+static __m128i ReverseTexels( const __m128i texels )
+{
+    return _mm_shuffle_epi32( texels, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+}
+
+static void TransposeTexels( __m128i& row0, __m128i& row1, __m128i& row2, __m128i& row3 )
+{
+    const __m128i low01 = _mm_unpacklo_epi32( row0, row1 );
+    const __m128i low23 = _mm_unpacklo_epi32( row2, row3 );
+    const __m128i high01 = _mm_unpackhi_epi32( row0, row1 );
+    const __m128i high23 = _mm_unpackhi_epi32( row2, row3 );
+    row0 = _mm_unpacklo_epi64( low01, low23 );
+    row1 = _mm_unpackhi_epi64( low01, low23 );
+    row2 = _mm_unpacklo_epi64( high01, high23 );
+    row3 = _mm_unpackhi_epi64( high01, high23 );
+}
+
+// Two texels of 16 bit channels, color channels times alpha / 255
+static __m128i PremultiplyWide( const __m128i texels, const __m128i alphaLanes, const __m128i channelMax )
+{
+    __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( texels, 0xff ), 0xff );
+    alpha = _mm_or_si128( _mm_andnot_si128( alphaLanes, alpha ), _mm_and_si128( alphaLanes, channelMax ) );
+
+    __m128i product = _mm_add_epi16( _mm_mullo_epi16( texels, alpha ), _mm_set1_epi16( 128 ) );
+    product = _mm_add_epi16( product, _mm_srli_epi16( product, 8 ) );
+    return _mm_srli_epi16( product, 8 );
+}
+
+// Four texels from each row down to two, as 16 bit channels
+static __m128i DownsampleWide( const Rgba8* row0, const Rgba8* row1 )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i top = LoadTexels( row0 );
+    const __m128i bottom = LoadTexels( row1 );
+
+    const __m128i low = _mm_add_epi16( _mm_unpacklo_epi8( top, zero ), _mm_unpacklo_epi8( bottom, zero ) );
+    const __m128i high = _mm_add_epi16( _mm_unpackhi_epi8( top, zero ), _mm_unpackhi_epi8( bottom, zero ) );
+    const __m128i lowSum = _mm_add_epi16( low, _mm_srli_si128( low, 8 ) );
+    const __m128i highSum = _mm_add_epi16( high, _mm_srli_si128( high, 8 ) );
+
+    const __m128i sum = _mm_add_epi16( _mm_unpacklo_epi64( lowSum, highSum ), _mm_set1_epi16( 2 ) );
+    return _mm_srli_epi16( sum, 2 );
+}
+#endif // defined(ENGINE_SIMD_SSE)
+
+//-----------------------------------------------------------------------------
+void ExpandTexelsToRgba( const unsigned char* source, const int numComponents, Rgba8* destination, const size_t texelCount )
+{
+    switch( numComponents )
+    {
+        case 1:
+            for( size_t texelIndex = 0; texelIndex < texelCount; ++texelIndex )
+            {
+                const unsigned char grey = source[ texelIndex ];
+                destination[ texelIndex ] = Rgba8( grey, grey, grey, 255 );
+            }
+            break;
+        case 2:
+            for( size_t texelIndex = 0; texelIndex < texelCount; ++texelIndex )
+            {
+                const unsigned char grey = source[ texelIndex * 2 ];
+                destination[ texelIndex ] = Rgba8( grey, grey, grey, source[ texelIndex * 2 + 1 ] );
+            }
+            break;
+        case 3:
+            ExpandRgbToRgba( source, destination, texelCount );
+            break;
+        default:
+            memcpy( static_cast<void*>( destination ), source, texelCount * sizeof( Rgba8 ) );
+            break;
+    }
+}
+
+void ExpandRgbToRgba( const unsigned char* rgb, Rgba8* destination, const size_t texelCount )
+{
+    size_t texelIndex = 0;
+#if defined(ENGINE_SIMD_SSE)
+    // Four texels per 16 byte load, which reads past them so the last few go through the scalar loop
+    const __m128i alpha = _mm_set1_epi32( static_cast<int>( 0xff000000 ) );
+    for( ; texelIndex + 6 <= texelCount; texelIndex += 4 )
+    {
+        const __m128i packed = _mm_loadu_si128( reinterpret_cast<const __m128i*>( rgb + texelIndex * 3 ) );
+        const __m128i texels01 = _mm_unpacklo_epi32( packed, _mm_srli_si128( packed, 3 ) );
+        const __m128i texels23 = _mm_unpacklo_epi32( _mm_srli_si128( packed, 6 ), _mm_srli_si128( packed, 9 ) );
+        StoreTexels( destination + texelIndex, _mm_or_si128( _mm_unpacklo_epi64( texels01, texels23 ), alpha ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; texelIndex < texelCount; ++texelIndex )
+    {
+        const unsigned char* texel = rgb + texelIndex * 3;
+        destination[ texelIndex ] = Rgba8( texel[ 0 ], texel[ 1 ], texel[ 2 ], 255 );
+    }
+}
+
+void MirrorTexelRow( const Rgba8* source, Rgba8* destination, const size_t texelCount )
+{
+    size_t texelIndex = 0;
+#if defined(ENGINE_SIMD_SSE)
+    for( ; texelIndex + 4 <= texelCount; texelIndex += 4 )
+    {
+        StoreTexels( destination + texelIndex, ReverseTexels( LoadTexels( source + texelCount - 4 - texelIndex ) ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; texelIndex < texelCount; ++texelIndex )
+    {
+        destination[ texelIndex ] = source[ texelCount - 1 - texelIndex ];
+    }
+}
+
+void RotateTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination,
+                   const int orthogonalRotation, const bool mirrored )
+{
+    const int width = sourceDimensions.x;
+    const int height = sourceDimensions.y;
+    const int rotation = ( orthogonalRotation % 360 + 360 ) % 360;
+
+    // 0 and 180 only flip rows and columns
+    if( rotation == 0 || rotation == 180 )
+    {
+        const bool flipX = ( rotation == 180 ) != mirrored;
+        const bool flipY = rotation == 180;
+        for( int rowIndex = 0; rowIndex < height; ++rowIndex )
+        {
+            const Rgba8* sourceRow = source + static_cast<size_t>( flipY ? height - 1 - rowIndex : rowIndex ) * width;
+            Rgba8* destinationRow = destination + static_cast<size_t>( rowIndex ) * width;
+            if( flipX )
+            {
+                MirrorTexelRow( sourceRow, destinationRow, width );
+            }
+            else
+            {
+                memcpy( static_cast<void*>( destinationRow ), sourceRow, width * sizeof( Rgba8 ) );
+            }
+        }
+        return;
+    }
+
+    // 90 and 270 transpose, destination (x, y) reads source ( sourceX( y ), sourceY( x ) )
+    const bool flipSourceX = ( rotation == 270 ) != mirrored;
+    const bool flipSourceY = rotation == 90;
+    const int destinationWidth = height;
+    const int destinationHeight = width;
+    const auto getSourceX = [&]( const int destinationY ) { return flipSourceX ? width - 1 - destinationY : destinationY; };
+    const auto getSourceY = [&]( const int destinationX ) { return flipSourceY ? height - 1 - destinationX : destinationX; };
+
+    const auto copyTexel = [&]( const int destinationX, const int destinationY )
+    {
+        destination[ static_cast<size_t>( destinationY ) * destinationWidth + destinationX ] =
+            source[ static_cast<size_t>( getSourceY( destinationX ) ) * width + getSourceX( destinationY ) ];
+    };
+
+    int blockedHeight = 0;
+    int blockedWidth = 0;
+#if defined(ENGINE_SIMD_SSE)
+    // 4x4 blocks, four source rows loaded and transposed into four destination rows. Blocks are
+    //  walked in tiles so the source lines a tile reads are still cached for its next blocks
+    constexpr int TRANSPOSE_TILE_SIZE = 32;
+    blockedHeight = destinationHeight & ~3;
+    blockedWidth = destinationWidth & ~3;
+    for( int tileY = 0; tileY < blockedHeight; tileY += TRANSPOSE_TILE_SIZE )
+    {
+        const int tileEndY = tileY + TRANSPOSE_TILE_SIZE < blockedHeight ? tileY + TRANSPOSE_TILE_SIZE : blockedHeight;
+        for( int tileX = 0; tileX < blockedWidth; tileX += TRANSPOSE_TILE_SIZE )
+        {
+            const int tileEndX = tileX + TRANSPOSE_TILE_SIZE < blockedWidth ? tileX + TRANSPOSE_TILE_SIZE : blockedWidth;
+            for( int destinationY = tileY; destinationY < tileEndY; destinationY += 4 )
+            {
+                const int firstSourceX = flipSourceX ? width - 4 - destinationY : destinationY;
+                for( int destinationX = tileX; destinationX < tileEndX; destinationX += 4 )
+                {
+                    __m128i rows[ 4 ];
+                    for( int rowIndex = 0; rowIndex < 4; ++rowIndex )
+                    {
+                        const size_t sourceRowStart = static_cast<size_t>( getSourceY( destinationX + rowIndex ) ) * width;
+                        rows[ rowIndex ] = LoadTexels( source + sourceRowStart + firstSourceX );
+                        if( flipSourceX ) { rows[ rowIndex ] = ReverseTexels( rows[ rowIndex ] ); }
+                    }
+
+                    TransposeTexels( rows[ 0 ], rows[ 1 ], rows[ 2 ], rows[ 3 ] );
+                    for( int rowIndex = 0; rowIndex < 4; ++rowIndex )
+                    {
+                        const size_t destinationRowStart = static_cast<size_t>( destinationY + rowIndex ) * destinationWidth;
+                        StoreTexels( destination + destinationRowStart + destinationX, rows[ rowIndex ] );
+                    }
+                }
+            }
+        }
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    // Whatever the blocks did not cover, the right edge and then the bottom rows
+    for( int destinationY = 0; destinationY < blockedHeight; ++destinationY )
+    {
+        for( int destinationX = blockedWidth; destinationX < destinationWidth; ++destinationX )
+        {
+            copyTexel( destinationX, destinationY );
+        }
+    }
+    for( int destinationY = blockedHeight; destinationY < destinationHeight; ++destinationY )
+    {
+        for( int destinationX = 0; destinationX < destinationWidth; ++destinationX )
+        {
+            copyTexel( destinationX, destinationY );
+        }
+    }
+}
+
+void PremultiplyAlpha( Rgba8* texels, const size_t texelCount )
+{
+    size_t texelIndex = 0;
+#if defined(ENGINE_SIMD_SSE)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaLanes = _mm_set_epi16( -1, 0, 0, 0, -1, 0, 0, 0 );
+    const __m128i channelMax = _mm_set1_epi16( 255 );
+    for( ; texelIndex + 4 <= texelCount; texelIndex += 4 )
+    {
+        const __m128i packed = LoadTexels( texels + texelIndex );
+        const __m128i low = PremultiplyWide( _mm_unpacklo_epi8( packed, zero ), alphaLanes, channelMax );
+        const __m128i high = PremultiplyWide( _mm_unpackhi_epi8( packed, zero ), alphaLanes, channelMax );
+        StoreTexels( texels + texelIndex, _mm_packus_epi16( low, high ) );
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    for( ; texelIndex < texelCount; ++texelIndex )
+    {
+        Rgba8& texel = texels[ texelIndex ];
+        texel.r = PremultiplyChannel( texel.r, texel.a );
+        texel.g = PremultiplyChannel( texel.g, texel.a );
+        texel.b = PremultiplyChannel( texel.b, texel.a );
+    }
+}
+
+IntVec2 GetDownsampledDimensions( const IntVec2& sourceDimensions )
+{
+    return IntVec2( sourceDimensions.x > 1 ? sourceDimensions.x / 2 : 1,
+                    sourceDimensions.y > 1 ? sourceDimensions.y / 2 : 1 );
+}
+
+void DownsampleTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination )
+{
+    const IntVec2 destinationDimensions = GetDownsampledDimensions( sourceDimensions );
+    const int sourceWidth = sourceDimensions.x;
+
+    for( int destinationY = 0; destinationY < destinationDimensions.y; ++destinationY )
+    {
+        const int sourceY = destinationY * 2;
+        const int nextSourceY = sourceY + 1 < sourceDimensions.y ? sourceY + 1 : sourceY;
+        const Rgba8* row0 = source + static_cast<size_t>( sourceY ) * sourceWidth;
+        const Rgba8* row1 = source + static_cast<size_t>( nextSourceY ) * sourceWidth;
+        Rgba8* destinationRow = destination + static_cast<size_t>( destinationY ) * destinationDimensions.x;
+
+        int destinationX = 0;
+#if defined(ENGINE_SIMD_SSE)
+        if( sourceWidth > 1 )
+        {
+            for( ; destinationX + 4 <= destinationDimensions.x; destinationX += 4 )
+            {
+                const int sourceX = destinationX * 2;
+                const __m128i texels01 = DownsampleWide( row0 + sourceX, row1 + sourceX );
+                const __m128i texels23 = DownsampleWide( row0 + sourceX + 4, row1 + sourceX + 4 );
+                StoreTexels( destinationRow + destinationX, _mm_packus_epi16( texels01, texels23 ) );
+            }
+        }
+#endif // defined(ENGINE_SIMD_SSE)
+
+        for( ; destinationX < destinationDimensions.x; ++destinationX )
+        {
+            const int sourceX = destinationX * 2;
+            const int nextSourceX = sourceX + 1 < sourceWidth ? sourceX + 1 : sourceX;
+            const Rgba8& a = row0[ sourceX ];
+            const Rgba8& b = row0[ nextSourceX ];
+            const Rgba8& c = row1[ sourceX ];
+            const Rgba8& d = row1[ nextSourceX ];
+            destinationRow[ destinationX ] = Rgba8( AverageChannels( a.r, b.r, c.r, d.r ),
+                                                    AverageChannels( a.g, b.g, c.g, d.g ),
+                                                    AverageChannels( a.b, b.b, c.b, d.b ),
+                                                    AverageChannels( a.a, b.a, c.a, d.a ) );
+        }
+    }
+}
+
+float ConvertSrgbToLinear( const unsigned char srgb )
+{
+    return GetSrgbTables().toLinear[ srgb ];
+}
+
+unsigned char ConvertLinearToSrgb( const float linear )
+{
+    if( !( linear > 0.f ) ) { return 0; }
+    if( linear >= 1.f ) { return 255; }
+
+    const SrgbTables& tables = GetSrgbTables();
+    int code = tables.bucketStart[ static_cast<int>( linear * LINEAR_TO_SRGB_BUCKETS ) ];
+    while( code < 255 && linear >= tables.thresholds[ code ] ) { ++code; }
+    return static_cast<unsigned char>( code );
+}
+
+void DownsampleTexelsFiltered( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination,
+                               const MipFilter filter, const bool isSrgb, const int startRow, const int endRow )
+{
+    const IntVec2 destinationDimensions = GetDownsampledDimensions( sourceDimensions );
+    const int sourceWidth = sourceDimensions.x;
+    const SrgbTables& tables = GetSrgbTables();
+    const float* toLinear = isSrgb ? tables.toLinear : tables.toUnorm;
+    const auto encodeColor = [isSrgb]( const float value )
+    {
+        return isSrgb ? ConvertLinearToSrgb( value ) : RoundToByte( value * 255.f );
+    };
+
+    if( filter == MipFilter::BOX )
+    {
+        for( int destinationY = startRow; destinationY < endRow; ++destinationY )
+        {
+            const Rgba8* row0 = source + static_cast<size_t>( destinationY * 2 ) * sourceWidth;
+            const Rgba8* row1 = source + static_cast<size_t>( ClampTexelIndex( destinationY * 2 + 1, sourceDimensions.y ) ) * sourceWidth;
+            Rgba8* destinationRow = destination + static_cast<size_t>( destinationY ) * destinationDimensions.x;
+            for( int destinationX = 0; destinationX < destinationDimensions.x; ++destinationX )
+            {
+                const int sourceX = destinationX * 2;
+                const int nextSourceX = ClampTexelIndex( sourceX + 1, sourceWidth );
+                const Rgba8* quad[ 4 ] = { &row0[ sourceX ], &row0[ nextSourceX ], &row1[ sourceX ], &row1[ nextSourceX ] };
+
+                float color[ 3 ] = {};
+                int alpha = 0;
+                for( const Rgba8* texel : quad )
+                {
+                    color[ 0 ] += toLinear[ texel->r ];
+                    color[ 1 ] += toLinear[ texel->g ];
+                    color[ 2 ] += toLinear[ texel->b ];
+                    alpha += texel->a;
+                }
+                destinationRow[ destinationX ] = Rgba8( encodeColor( color[ 0 ] * .25f ),
+                                                        encodeColor( color[ 1 ] * .25f ),
+                                                        encodeColor( color[ 2 ] * .25f ),
+                                                        static_cast<unsigned char>( ( alpha + 2 ) >> 2 ) );
+            }
+        }
+        return;
+    }
+
+    // Separable, each destination row filters its six source rows into one linear row first
+    const float* weights = GetKaiserWeights().weights;
+    std::vector<float> filteredRow( static_cast<size_t>( sourceWidth ) * 4 );
+    for( int destinationY = startRow; destinationY < endRow; ++destinationY )
+    {
+        std::fill( filteredRow.begin(), filteredRow.end(), 0.f );
+        for( int tap = 0; tap < KAISER_TAP_COUNT; ++tap )
+        {
+            const int sourceY = ClampTexelIndex( destinationY * 2 + tap - 2, sourceDimensions.y );
+            const Rgba8* sourceRow = source + static_cast<size_t>( sourceY ) * sourceWidth;
+            const float weight = weights[ tap ];
+            for( int sourceX = 0; sourceX < sourceWidth; ++sourceX )
+            {
+                float* filtered = &filteredRow[ static_cast<size_t>( sourceX ) * 4 ];
+                filtered[ 0 ] += weight * toLinear[ sourceRow[ sourceX ].r ];
+                filtered[ 1 ] += weight * toLinear[ sourceRow[ sourceX ].g ];
+                filtered[ 2 ] += weight * toLinear[ sourceRow[ sourceX ].b ];
+                filtered[ 3 ] += weight * static_cast<float>( sourceRow[ sourceX ].a );
+            }
+        }
+
+        Rgba8* destinationRow = destination + static_cast<size_t>( destinationY ) * destinationDimensions.x;
+        for( int destinationX = 0; destinationX < destinationDimensions.x; ++destinationX )
+        {
+            float color[ 4 ] = {};
+            for( int tap = 0; tap < KAISER_TAP_COUNT; ++tap )
+            {
+                const int sourceX = ClampTexelIndex( destinationX * 2 + tap - 2, sourceWidth );
+                const float* filtered = &filteredRow[ static_cast<size_t>( sourceX ) * 4 ];
+                for( int channel = 0; channel < 4; ++channel )
+                {
+                    color[ channel ] += weights[ tap ] * filtered[ channel ];
+                }
+            }
+            destinationRow[ destinationX ] = Rgba8( encodeColor( color[ 0 ] ),
+                                                    encodeColor( color[ 1 ] ),
+                                                    encodeColor( color[ 2 ] ),
+                                                    RoundToByte( color[ 3 ] ) );
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+
+#include <cstddef>
+
+enum class MipFilter : unsigned int
+{
+    BOX,
+    KAISER,     // Windowed sinc over 6x6 texels, sharper mips with less aliasing than the box
+};
+
+//-----------------------------------------------------------------------------
+// Kernels over tightly packed RGBA8 texels, rows bottom to top as Image stores them. SSE2 when
+//  ENGINE_SIMD_SSE is on, scalar otherwise. Source and destination never overlap unless a
+//  function works in place
+
+// Decoded rows with 1 (grey), 2 (grey, alpha), 3 (RGB) or 4 components to RGBA. Missing alpha is 255
+void ExpandTexelsToRgba( const unsigned char* source, int numComponents, Rgba8* destination, size_t texelCount );
+void ExpandRgbToRgba( const unsigned char* rgb, Rgba8* destination, size_t texelCount );
+
+// destination[ i ] = source[ texelCount - 1 - i ]
+void MirrorTexelRow( const Rgba8* source, Rgba8* destination, size_t texelCount );
+
+// Same orientations as the Image rotation constructor. destination holds the rotated dimensions,
+//  swapped for 90 and 270
+void RotateTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination,
+                   int orthogonalRotation, bool mirrored );
+
+// In place, color channels scaled by alpha / 255 with rounding
+void PremultiplyAlpha( Rgba8* texels, size_t texelCount );
+
+// 2x2 box filter down to half size, rounded. Odd edges are dropped and a side of 1 stays 1, the
+//  same sizes the GPU gives each mip
+IntVec2 GetDownsampledDimensions( const IntVec2& sourceDimensions );
+void DownsampleTexels( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination );
+
+// sRGB encoded channels to and from linear light, both exact to the nearest code
+float ConvertSrgbToLinear( unsigned char srgb );
+unsigned char ConvertLinearToSrgb( float linear );
+
+// DownsampleTexels with a choice of filter. With isSrgb, color is filtered in linear light and
+//  alpha as stored. Only writes destination rows [startRow, endRow) so one mip can be split
+//  across threads
+void DownsampleTexelsFiltered( const Rgba8* source, const IntVec2& sourceDimensions, Rgba8* destination,
+                               MipFilter filter, bool isSrgb, int startRow, int endRow );
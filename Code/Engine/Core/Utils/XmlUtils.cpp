@@ -8,6 +8,25 @@
 #include "Engine/Core/Math/Primatives/Vec2.hpp"
 #include "Engine/Core/Math/Range/IntRange.hpp"
 #include "Engine/Core/Math/Range/FloatRange.hpp"
+#include "Engine/IO/FileUtils.hpp"
+
+bool LoadXmlFromBuffer( XmlDocument& document, const BufferView& xmlData )
+{
+    return document.Parse( xmlData.GetChars(), xmlData.size ) == tinyxml2::XML_SUCCESS;
+}
+
+bool LoadXmlFromFile( XmlDocument& document, const std::string& fileName )
+{
+    // Parsed straight from the mapping, tinyxml2 keeps its own copy so the file can close after
+    const MappedFile xmlFile( fileName );
+    if( !xmlFile.IsOpen() )
+    {
+        document.Clear();
+        return false;
+    }
+
+    return LoadXmlFromBuffer( document, xmlFile.GetView() );
+}
 
 bool ParseXmlAttribute( const XmlElement& element, const char* attributeName, bool defaultValue )
 {
@@ -8,6 +8,7 @@
 #include <vector>
 
 struct AABB2;
+struct BufferView;
 struct IntVec2;
 struct Rgba8;
 struct Vec2;
@@ -22,6 +23,11 @@ typedef tinyxml2::XMLElement XmlElement;
 // Using TinyXML2 for XML parsing. Refers to tinyxml2::XMLAttribute
 typedef tinyxml2::XMLAttribute XmlAttribute;
 
+//-----------------------------------------------------------------------------
+// Loading. The view does not need to be null terminated
+bool LoadXmlFromBuffer( XmlDocument& document, const BufferView& xmlData );
+bool LoadXmlFromFile( XmlDocument& document, const std::string& fileName );
+
 //-----------------------------------------------------------------------------
 // Primitive types
 bool ParseXmlAttribute( const XmlElement& element,
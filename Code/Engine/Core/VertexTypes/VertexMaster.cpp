@@ -3,6 +3,8 @@
 
 #include "Engine/Core/Engine.hpp"
 #include "Engine/Core/Transform.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
 
 VertexMaster::VertexMaster( const Vec2& pos, const Rgba8& col, const Vec2& uvs )
     : VertexMaster( Vec3(pos), col, uvs )
@@ -32,32 +34,50 @@ bool VertexMaster::IsMostlyEqual( const VertexMaster& rhs, const float epsilon )
         this->bitangent.IsMostlyEqual( rhs.bitangent, epsilon ) && this->normal.IsMostlyEqual( rhs.normal, epsilon );
 }
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes, const Mat44& transform )
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes, const Mat44& transform )
 {
-    for( VertexMaster& vertex : vertexes )
+    if( vertexes.empty() )
     {
-        vertex.position = transform.TransformPosition(vertex.position);
+        return;
     }
+
+    transform.TransformPositionsStrided( &vertexes.front().position, vertexes.size(), sizeof( VertexType ) );
 }
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes, const Vec3& transform, const Vec3& rotation, const Vec3& scale )
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes, const Vec3& transform, const Vec3& rotation, const Vec3& scale )
 {
     Mat44 matrixTransform = Transform( transform, scale, rotation ).GetAsMatrixWithCanonicalTransform();
     matrixTransform.PushMatrix( Engine::GetCanonicalTransformInverse() );
     TransformVertexArray( vertexes, matrixTransform );
 }
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes, const Vec2& transform, const float rotation, const Vec2& scale )
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes, const Vec2& transform, const float rotation, const Vec2& scale )
 {
     TransformVertexArray( vertexes, Vec3( transform ), Vec3( 0.f, 0.f, rotation ), Vec3( scale, 1.f ) );
 }
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes, const Vec3& transform, const Vec3& rotation, float scale )
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes, const Vec3& transform, const Vec3& rotation, float scale )
 {
     TransformVertexArray( vertexes, transform, rotation, Vec3( scale ) );
 }
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes, const Vec2& transform, const float rotation, float scale )
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes, const Vec2& transform, const float rotation, float scale )
 {
     TransformVertexArray( vertexes, transform, rotation, Vec2( scale ) );
 }
+
+#define INSTANTIATE_TRANSFORM_VERTEX_ARRAY( VertexType )                                                                     \
+    template void TransformVertexArray( std::vector<VertexType>&, const Mat44& );                                          \
+    template void TransformVertexArray( std::vector<VertexType>&, const Vec3&, const Vec3&, const Vec3& );                 \
+    template void TransformVertexArray( std::vector<VertexType>&, const Vec2&, float, const Vec2& );                       \
+    template void TransformVertexArray( std::vector<VertexType>&, const Vec3&, const Vec3&, float );                       \
+    template void TransformVertexArray( std::vector<VertexType>&, const Vec2&, float, float );
+
+INSTANTIATE_TRANSFORM_VERTEX_ARRAY( VertexMaster )
+INSTANTIATE_TRANSFORM_VERTEX_ARRAY( Vertex_PCU )
+INSTANTIATE_TRANSFORM_VERTEX_ARRAY( Vertex_PCUTBN )
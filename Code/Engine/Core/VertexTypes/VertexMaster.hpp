@@ -27,25 +27,31 @@ public:
     bool IsMostlyEqual( const VertexMaster& rhs, float epsilon = 1e-7f ) const;
 };
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes,
+// Instantiated for VertexMaster, Vertex_PCU, and Vertex_PCUTBN
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes,
                            const Mat44& transform );
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes,
                            const Vec3& transform,
                            const Vec3& rotation,
                            const Vec3& scale );
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes,
                            const Vec2& transform,
                            float rotation,
                            const Vec2& scale );
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes,
                            const Vec3& transform,
                            const Vec3& rotation,
                            float scale );
 
-void TransformVertexArray( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void TransformVertexArray( std::vector<VertexType>& vertexes,
                            const Vec2& transform,
                            float rotation,
                            float scale );
@@ -4,17 +4,40 @@
 
 //-------------------------------------------------------------------------------
 Vertex_PCU::Vertex_PCU()
-    : VertexMaster()
 {
 }
 
 Vertex_PCU::Vertex_PCU( const VertexMaster& copyFromMaster )
-    : VertexMaster( copyFromMaster )
+    : position( copyFromMaster.position )
+      , color( copyFromMaster.color )
+      , uv( copyFromMaster.uv )
 {
 }
 
+Vertex_PCU::Vertex_PCU( const Vec2& pos, const Rgba8& col, const Vec2& uvs )
+    : Vertex_PCU( Vec3( pos ), col, uvs )
+{
+}
+
+Vertex_PCU::Vertex_PCU( const Vec3& pos, const Rgba8& col, const Vec2& uvs )
+    : position( pos )
+      , color( col )
+      , uv( uvs )
+{
+}
+
+Vertex_PCU::Vertex_PCU( const Vec3& pos, const Rgba8& col, const Vec2& uvs, const Vec3& tang,
+                        const Vec3& bitang, const Vec3& norm )
+    : Vertex_PCU( pos, col, uvs )
+{
+    UNUSED( tang );
+    UNUSED( bitang );
+    UNUSED( norm );
+}
+
 STATIC void Vertex_PCU::ConvertFromMaster( std::vector<Vertex_PCU>& output, const std::vector<VertexMaster>& input )
 {
+    output.reserve( output.size() + input.size() );
     for( const VertexMaster& master : input )
     {
         output.emplace_back( master );
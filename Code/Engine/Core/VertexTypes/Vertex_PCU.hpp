@@ -5,13 +5,27 @@
 
 #include <vector>
 
-struct Vertex_PCU: public VertexMaster
+// Tightly packed position, color, uv vertex. Does not derive from VertexMaster so
+//  2D and UI geometry can be written straight into the 24 byte GPU layout
+struct Vertex_PCU
 {
+    Vec3 position;
+    Rgba8 color;
+    Vec2 uv;
 
 public:
     Vertex_PCU();
     Vertex_PCU( const VertexMaster& copyFromMaster );
+    explicit Vertex_PCU( const Vec2& pos, const Rgba8& col, const Vec2& uvs = Vec2::ZERO );
+    explicit Vertex_PCU( const Vec3& pos, const Rgba8& col, const Vec2& uvs = Vec2::ZERO );
+
+    // Matches the VertexMaster constructor so templated builders can emit either type,
+    //  tangent, bitangent, and normal are dropped
+    explicit Vertex_PCU( const Vec3& pos, const Rgba8& col, const Vec2& uvs, const Vec3& tang,
+                         const Vec3& bitang, const Vec3& norm );
 
     static void ConvertFromMaster( std::vector<Vertex_PCU>& output, const std::vector<VertexMaster>& input );
     static BufferAttribute LAYOUT[];
-};
\ No newline at end of file
+};
+
+static_assert( sizeof( Vertex_PCU ) == 24, "Vertex_PCU must stay tightly packed" );
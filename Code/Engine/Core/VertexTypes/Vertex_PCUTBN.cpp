@@ -14,6 +14,7 @@ Vertex_PCUTBN::Vertex_PCUTBN( const VertexMaster& copyFromMaster )
 
 STATIC void Vertex_PCUTBN::ConvertFromMaster( std::vector<Vertex_PCUTBN>& output, const std::vector<VertexMaster>& input )
 {
+    output.reserve( output.size() + input.size() );
     for( const VertexMaster& copy : input )
     {
         output.emplace_back( copy );
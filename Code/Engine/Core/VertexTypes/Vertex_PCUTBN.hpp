@@ -9,6 +9,8 @@ struct Vertex_PCUTBN: public VertexMaster
 {
 
 public:
+    using VertexMaster::VertexMaster;
+
     Vertex_PCUTBN();
     Vertex_PCUTBN( const VertexMaster& copyFromMaster );
 
@@ -2,12 +2,11 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 
-STATIC unsigned int Job::s_NextJobIndex = 0;
+STATIC std::atomic<unsigned int> Job::s_NextJobIndex = 0;
 
 Job::Job()
 {
-    m_JobIndex = s_NextJobIndex;
-    s_NextJobIndex++;
+    m_JobIndex = s_NextJobIndex++;
 }
 
 unsigned int Job::GetJobIndex() const
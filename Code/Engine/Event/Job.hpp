@@ -1,5 +1,12 @@
 #pragma once
 
+#include <atomic>
+
+// Untracked jobs never reach the completed list, so no Claim or Finish call can see or delete
+//  them. The worker calls Callback as soon as Execute returns and never touches the job again,
+//  the owner waits on whatever Callback signals and then frees it
+constexpr unsigned int JOB_FLAG_UNTRACKED = 1u << 0;
+
 class Job
 {
     friend class JobSystem;
@@ -15,7 +22,7 @@ protected:
     virtual void Callback() = 0;
 
 private:
-    static unsigned int s_NextJobIndex;
+    static std::atomic<unsigned int> s_NextJobIndex;
 
     unsigned int m_JobIndex = 0;
     unsigned int m_JobType = 0;
@@ -36,6 +36,7 @@ void JobSystem::Shutdown()
         delete thread;
         thread = nullptr;
     }
+    m_Threads.clear();
 }
 
 void JobSystem::AddWorkerThreads( const unsigned int numberToAdd )
@@ -59,6 +60,29 @@ unsigned int JobSystem::ScheduleJob( Job& newJob )
     return newJob.m_JobIndex;
 }
 
+unsigned int JobSystem::ScheduleUntrackedJob( Job& newJob )
+{
+    newJob.m_JobFlags |= JOB_FLAG_UNTRACKED;
+    return ScheduleJob( newJob );
+}
+
+bool JobSystem::UnscheduleJob( const Job& job )
+{
+    bool wasQueued = false;
+    m_QueuedJobMutex.lock();
+    for( std::deque<Job*>::iterator queued = m_QueuedJobList.begin(); queued != m_QueuedJobList.end(); ++queued )
+    {
+        if( *queued == &job )
+        {
+            m_QueuedJobList.erase( queued );
+            wasQueued = true;
+            break;
+        }
+    }
+    m_QueuedJobMutex.unlock();
+    return wasQueued;
+}
+
 void JobSystem::ClaimJob( unsigned int jobIndex, bool deleteAfter )
 {
     m_CompletedJobMutex.lock();
@@ -74,6 +98,7 @@ void JobSystem::ClaimJob( unsigned int jobIndex, bool deleteAfter )
             job = nullptr;
         }
     }
+    m_CompletedJobMutex.unlock();
 }
 
 void JobSystem::ClaimJobs( unsigned int jobType, bool deleteAfter )
@@ -91,7 +116,7 @@ void JobSystem::ClaimJobs( unsigned int jobType, bool deleteAfter )
             job = nullptr;
         }
     }
-
+    m_CompletedJobMutex.unlock();
 }
 
 void JobSystem::ClaimAllJobs( bool deleteAfter )
@@ -161,7 +186,7 @@ void JobSystem::FinishJobs( const unsigned int jobType, const bool deleteAfter )
     m_CompletedJobMutex.lock();
     for( Job*& job : m_CompletedJobList )
     {
-        if( job && job->m_JobIndex == jobType )
+        if( job && job->m_JobType == jobType )
         {
             job->Callback();
             if( deleteAfter )
@@ -202,6 +227,122 @@ void JobSystem::FinishAllJobs( const bool deleteAfter )
     m_CompletedJobMutex.unlock();
 }
 
+//-----------------------------------------------------------------------------
+// Parallel For
+class ParallelForJob: public Job
+{
+public:
+    ParallelForJob( std::atomic<unsigned int>& nextBatch, std::atomic<unsigned int>& runningHelpers,
+                    unsigned int count, unsigned int batchSize,
+                    const std::function<void( unsigned int, unsigned int )>& batchFunction )
+        : m_NextBatch( nextBatch )
+        , m_RunningHelpers( runningHelpers )
+        , m_Count( count )
+        , m_BatchSize( batchSize )
+        , m_BatchFunction( batchFunction )
+    {
+    }
+
+    static void RunBatches( std::atomic<unsigned int>& nextBatch, const unsigned int count,
+                            const unsigned int batchSize,
+                            const std::function<void( unsigned int, unsigned int )>& batchFunction )
+    {
+        const unsigned int numBatches = (count + batchSize - 1) / batchSize;
+        for( unsigned int batch = nextBatch++; batch < numBatches; batch = nextBatch++ )
+        {
+            const unsigned int start = batch * batchSize;
+            const unsigned int end = start + batchSize < count ? start + batchSize : count;
+            batchFunction( start, end );
+        }
+    }
+
+protected:
+    void Execute() override { RunBatches( m_NextBatch, m_Count, m_BatchSize, m_BatchFunction ); }
+    // Last touch of the job by the worker, the caller may free it right after
+    void Callback() override { --m_RunningHelpers; }
+
+private:
+    std::atomic<unsigned int>& m_NextBatch;
+    std::atomic<unsigned int>& m_RunningHelpers;
+    unsigned int m_Count = 0;
+    unsigned int m_BatchSize = 0;
+    const std::function<void( unsigned int, unsigned int )>& m_BatchFunction;
+};
+
+void JobSystem::ParallelFor( const unsigned int count, unsigned int batchSize,
+                             const std::function<void( unsigned int, unsigned int )>& batchFunction )
+{
+    if( count == 0 )
+    {
+        return;
+    }
+    if( batchSize == 0 )
+    {
+        batchSize = count;
+    }
+
+    std::atomic<unsigned int> nextBatch = 0;
+    const unsigned int numBatches = (count + batchSize - 1) / batchSize;
+
+    // The calling thread takes a share of the batches, so only ask for helpers for the rest
+    unsigned int numHelpers = numBatches - 1;
+    if( numHelpers > GetNumWorkerThreads() )
+    {
+        numHelpers = GetNumWorkerThreads();
+    }
+
+    // Helpers are untracked, so a Claim or Finish on another thread can never delete one out
+    //  from under this frame. Queued directly instead of through ScheduleJob to skip the per
+    //  job console log
+    std::atomic<unsigned int> runningHelpers = numHelpers;
+    std::vector<Job*> helpers;
+    helpers.reserve( numHelpers );
+    if( numHelpers > 0 )
+    {
+        m_QueuedJobMutex.lock();
+        for( unsigned int helperIndex = 0; helperIndex < numHelpers; ++helperIndex )
+        {
+            Job* helper = new ParallelForJob( nextBatch, runningHelpers, count, batchSize, batchFunction );
+            helper->m_JobFlags |= JOB_FLAG_UNTRACKED;
+            helpers.push_back( helper );
+            m_QueuedJobList.push_back( helper );
+        }
+        m_QueuedJobMutex.unlock();
+    }
+
+    ParallelForJob::RunBatches( nextBatch, count, batchSize, batchFunction );
+
+    // Helpers that were never picked up have nothing left to do
+    if( numHelpers > 0 )
+    {
+        m_QueuedJobMutex.lock();
+        for( const Job* helper : helpers )
+        {
+            for( std::deque<Job*>::iterator queued = m_QueuedJobList.begin(); queued != m_QueuedJobList.end(); ++queued )
+            {
+                if( *queued == helper )
+                {
+                    m_QueuedJobList.erase( queued );
+                    --runningHelpers;
+                    break;
+                }
+            }
+        }
+        m_QueuedJobMutex.unlock();
+    }
+
+    // The rest reference this stack frame, so wait for them before returning
+    while( runningHelpers > 0 )
+    {
+        std::this_thread::yield();
+    }
+
+    for( Job* helper : helpers )
+    {
+        delete helper;
+    }
+}
+
 bool JobSystem::IsJobPresent( unsigned int jobIndex ) const
 {
     return IsJobQueued( jobIndex ) || IsJobActive( jobIndex ) || IsJobComplete( jobIndex );
@@ -528,13 +669,26 @@ void JobSystem::JobSearchThreadEntry()
         {
             Job* chosenJob = m_QueuedJobList.front();
             m_QueuedJobList.pop_front();
-            m_QueuedJobMutex.unlock();
 
+            // Move lists while the job is still visible in the previous one so IsJobPresent
+            //  never misses a job in flight
             AddJobToActiveList( chosenJob );
+            m_QueuedJobMutex.unlock();
+
+            // Read before Execute, an untracked job can be freed as soon as it signals
+            const bool isUntracked = ( chosenJob->m_JobFlags & JOB_FLAG_UNTRACKED ) != 0;
             chosenJob->Execute();
-            RemoveJobFromActiveList( chosenJob );
 
-            AddJobToCompletedList( chosenJob );
+            if( isUntracked )
+            {
+                RemoveJobFromActiveList( chosenJob );
+                chosenJob->Callback();
+            }
+            else
+            {
+                AddJobToCompletedList( chosenJob );
+                RemoveJobFromActiveList( chosenJob );
+            }
         }
         else
         {
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -23,6 +24,10 @@ public:
     void AddWorkerThreads( unsigned int numberToAdd );
 
     unsigned int ScheduleJob( Job& newJob );
+    // Queued with JOB_FLAG_UNTRACKED, so the caller keeps ownership and Callback runs on the worker
+    unsigned int ScheduleUntrackedJob( Job& newJob );
+    // Takes a job back out of the queue if no worker picked it up yet. False once it is running
+    bool UnscheduleJob( const Job& job );
 
     void ClaimJob( unsigned int jobIndex, bool deleteAfter = true );
     void ClaimJobs( unsigned int jobType, bool deleteAfter = true );
@@ -32,6 +37,13 @@ public:
     void FinishJobs( unsigned int jobType, bool deleteAfter = true );
     void FinishAllJobs( bool deleteAfter = true );
 
+    // Splits [0, count) into batches of batchSize and hands them to the worker threads. The
+    //  calling thread pulls batches as well, so this works with no workers and only returns once
+    //  every batch has run. batchFunction receives [startIndex, endIndex)
+    void ParallelFor( unsigned int count, unsigned int batchSize,
+                      const std::function<void( unsigned int, unsigned int )>& batchFunction );
+    unsigned int GetNumWorkerThreads() const { return static_cast<unsigned int>( m_Threads.size() ); }
+
     // Status Queries
     bool IsJobPresent( unsigned int jobIndex ) const;
     bool IsJobQueued( unsigned int jobIndex ) const;
@@ -0,0 +1,201 @@
+#include "BlockCompression.hpp"
+
+#include <cstring>
+#include <vector>
+
+constexpr size_t MIN_MATCH_LENGTH = 4;
+// Same end of block rules as LZ4, the last match starts at least this far from the end and the last
+//  bytes are always literals
+constexpr size_t MATCH_SEARCH_END = 12;
+constexpr size_t LAST_LITERALS = 5;
+constexpr size_t MAX_MATCH_OFFSET = 65535;
+
+constexpr unsigned int HASH_TABLE_BITS = 14;
+constexpr unsigned int HASH_TABLE_SIZE = 1u << HASH_TABLE_BITS;
+
+static unsigned int ReadUint32( const unsigned char* bytes )
+{
+    unsigned int value;
+    memcpy( &value, bytes, sizeof( value ) );
+    return value;
+}
+
+static unsigned int HashSequence( const unsigned int sequence )
+{
+    return ( sequence * 2654435761u ) >> ( 32 - HASH_TABLE_BITS );
+}
+
+// Lengths of 15 and over continue in extra bytes of 255 until one is smaller
+static unsigned char* WriteLengthExtra( unsigned char* output, size_t length )
+{
+    while( length >= 255 )
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<unsigned char>( length );
+    return output;
+}
+
+static bool ReadLengthExtra( const unsigned char*& input, const unsigned char* inputEnd, size_t& length )
+{
+    unsigned char extra;
+    do
+    {
+        if( input >= inputEnd ) { return false; }
+        extra = *input++;
+        length += extra;
+    } while( extra == 255 );
+    return true;
+}
+
+// Worst case size of one sequence, token, length bytes for both lengths, literals and the offset
+static size_t GetSequenceBound( const size_t literalLength )
+{
+    return 1 + literalLength / 255 + 1 + literalLength + 2 + 1;
+}
+
+//-----------------------------------------------------------------------------
+size_t GetCompressBlockBound( const size_t sourceSize )
+{
+    return sourceSize + sourceSize / 255 + 16;
+}
+
+size_t CompressBlock( const void* source, const size_t sourceSize, void* destination, const size_t destinationCapacity )
+{
+    const unsigned char* input = static_cast<const unsigned char*>( source );
+    unsigned char* output = static_cast<unsigned char*>( destination );
+    unsigned char* const outputEnd = output + destinationCapacity;
+
+    size_t anchor = 0;
+    if( sourceSize > MATCH_SEARCH_END )
+    {
+        // Positions are stored plus one so zero means empty
+        std::vector<unsigned int> hashTable( HASH_TABLE_SIZE, 0 );
+
+        const size_t matchSearchEnd = sourceSize - MATCH_SEARCH_END;
+        const size_t matchEnd = sourceSize - LAST_LITERALS;
+        size_t position = 0;
+        while( position < matchSearchEnd )
+        {
+            const unsigned int sequence = ReadUint32( input + position );
+            unsigned int& slot = hashTable[ HashSequence( sequence ) ];
+            const size_t candidate = slot;
+            slot = static_cast<unsigned int>( position + 1 );
+
+            if( candidate == 0 || position - ( candidate - 1 ) > MAX_MATCH_OFFSET ||
+                ReadUint32( input + candidate - 1 ) != sequence )
+            {
+                // Step further through data that is not matching, as LZ4 does
+                position += 1 + ( ( position - anchor ) >> 6 );
+                continue;
+            }
+
+            size_t matchStart = candidate - 1;
+            size_t matchLength = MIN_MATCH_LENGTH;
+            while( position + matchLength < matchEnd && input[ matchStart + matchLength ] == input[ position + matchLength ] )
+            {
+                ++matchLength;
+            }
+
+            const size_t literalLength = position - anchor;
+            if( static_cast<size_t>( outputEnd - output ) < GetSequenceBound( literalLength ) + matchLength / 255 )
+            {
+                return 0;
+            }
+
+            const size_t matchExtra = matchLength - MIN_MATCH_LENGTH;
+            unsigned char* token = output++;
+            *token = static_cast<unsigned char>( ( literalLength < 15 ? literalLength : 15 ) << 4 );
+            if( literalLength >= 15 ) { output = WriteLengthExtra( output, literalLength - 15 ); }
+            memcpy( output, input + anchor, literalLength );
+            output += literalLength;
+
+            const size_t offset = position - matchStart;
+            *output++ = static_cast<unsigned char>( offset & 0xff );
+            *output++ = static_cast<unsigned char>( offset >> 8 );
+
+            *token |= static_cast<unsigned char>( matchExtra < 15 ? matchExtra : 15 );
+            if( matchExtra >= 15 ) { output = WriteLengthExtra( output, matchExtra - 15 ); }
+
+            position += matchLength;
+            anchor = position;
+
+            // Seed the table inside the match so the next search has something to find
+            if( position - 2 < matchSearchEnd )
+            {
+                hashTable[ HashSequence( ReadUint32( input + position - 2 ) ) ] = static_cast<unsigned int>( position - 2 + 1 );
+            }
+        }
+    }
+
+    // Whatever is left goes out as literals with no match
+    const size_t literalLength = sourceSize - anchor;
+    if( static_cast<size_t>( outputEnd - output ) < GetSequenceBound( literalLength ) )
+    {
+        return 0;
+    }
+
+    unsigned char* token = output++;
+    *token = static_cast<unsigned char>( ( literalLength < 15 ? literalLength : 15 ) << 4 );
+    if( literalLength >= 15 ) { output = WriteLengthExtra( output, literalLength - 15 ); }
+    if( literalLength > 0 ) { memcpy( output, input + anchor, literalLength ); }
+    output += literalLength;
+
+    return static_cast<size_t>( output - static_cast<unsigned char*>( destination ) );
+}
+
+bool DecompressBlock( const void* source, const size_t sourceSize, void* destination, const size_t destinationSize )
+{
+    const unsigned char* input = static_cast<const unsigned char*>( source );
+    const unsigned char* const inputEnd = input + sourceSize;
+    unsigned char* const outputStart = static_cast<unsigned char*>( destination );
+    unsigned char* output = outputStart;
+    unsigned char* const outputEnd = outputStart + destinationSize;
+
+    while( input < inputEnd )
+    {
+        const unsigned char token = *input++;
+
+        size_t literalLength = token >> 4;
+        if( literalLength == 15 && !ReadLengthExtra( input, inputEnd, literalLength ) ) { return false; }
+        if( literalLength > static_cast<size_t>( inputEnd - input ) ||
+            literalLength > static_cast<size_t>( outputEnd - output ) )
+        {
+            return false;
+        }
+        if( literalLength > 0 ) { memcpy( output, input, literalLength ); }
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence is only literals
+        if( input == inputEnd ) { break; }
+
+        if( inputEnd - input < 2 ) { return false; }
+        const size_t offset = static_cast<size_t>( input[ 0 ] ) | ( static_cast<size_t>( input[ 1 ] ) << 8 );
+        input += 2;
+        if( offset == 0 || offset > static_cast<size_t>( output - outputStart ) ) { return false; }
+
+        size_t matchLength = token & 15;
+        if( matchLength == 15 && !ReadLengthExtra( input, inputEnd, matchLength ) ) { return false; }
+        matchLength += MIN_MATCH_LENGTH;
+        if( matchLength > static_cast<size_t>( outputEnd - output ) ) { return false; }
+
+        // Matches may overlap what they write, then they repeat the last offset bytes
+        const unsigned char* match = output - offset;
+        if( offset >= matchLength )
+        {
+            memcpy( output, match, matchLength );
+            output += matchLength;
+        }
+        else
+        {
+            for( size_t byteIndex = 0; byteIndex < matchLength; ++byteIndex )
+            {
+                *output++ = *match++;
+            }
+        }
+    }
+
+    return output == outputEnd;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+// LZ4 style block compression. Each block is a run of sequences, a token with the literal and match
+//  lengths, the literals, then a 16 bit offset back into the output. Fast to decode and needs no
+//  state between blocks
+
+// Largest compressed size of sourceSize bytes, the size to give CompressBlock to never fail
+size_t GetCompressBlockBound( size_t sourceSize );
+
+// Returns the compressed size, or 0 if it did not fit in destinationCapacity
+size_t CompressBlock( const void* source, size_t sourceSize, void* destination, size_t destinationCapacity );
+
+// True only if the block is well formed and fills exactly destinationSize bytes. Safe on corrupt data
+bool DecompressBlock( const void* source, size_t sourceSize, void* destination, size_t destinationSize );
@@ -0,0 +1,246 @@
+#include "CookedMeshUtils.hpp"
+
+#include "Engine/IO/ObjFileUtils.hpp"
+#include "Engine/Renderer/Mesh/MeshSimplifier.hpp"
+
+#include <cstring>
+
+// Every section starts on this boundary so the mapped arrays are aligned for the vertex types
+constexpr size_t COOKED_MESH_SECTION_ALIGNMENT = 16;
+
+constexpr char COOKED_MESH_MAGIC[ 4 ] = { 'S', 'D', 'M', 'H' };
+
+struct CookedMeshHeader
+{
+    char magic[ 4 ] = {};
+    unsigned int version = 0;
+    unsigned long long sourceHash = 0;
+
+    unsigned int vertexStride = 0;
+    unsigned int vertexCount = 0;
+    unsigned int indexCount = 0;
+    unsigned int lodCount = 0;
+
+    unsigned long long vertexOffset = 0;
+    unsigned long long indexOffset = 0;
+    unsigned long long lodOffset = 0;
+    unsigned long long fileSize = 0;
+};
+
+static size_t AlignSectionOffset( const size_t offset )
+{
+    return ( offset + COOKED_MESH_SECTION_ALIGNMENT - 1 ) & ~( COOKED_MESH_SECTION_ALIGNMENT - 1 );
+}
+
+std::string GetCookedMeshFileName( const std::string& sourceFileName )
+{
+    return sourceFileName + ".mesh";
+}
+
+unsigned long long GetCookedMeshSourceHash( const void* sourceData, const size_t sourceDataSize,
+                                            const MeshLoadOptions& meshLoadOptions )
+{
+    // Options are hashed field by field so struct padding never leaks into the hash.
+    //  parseInParallel and useCookedMesh do not change the output and are left out
+    const Mat44& transform = meshLoadOptions.transform;
+    const float optionValues[] = {
+        transform.Ix, transform.Iy, transform.Iz, transform.Iw,
+        transform.Jx, transform.Jy, transform.Jz, transform.Jw,
+        transform.Kx, transform.Ky, transform.Kz, transform.Kw,
+        transform.Tx, transform.Ty, transform.Tz, transform.Tw,
+        meshLoadOptions.lodReduction,
+    };
+    const unsigned int optionFlags[] = {
+        COOKED_MESH_VERSION,
+        meshLoadOptions.invertV,
+        meshLoadOptions.calculateNormals,
+        meshLoadOptions.calculateTangents,
+        meshLoadOptions.approximateTangents,
+        meshLoadOptions.flipWindingOrder,
+        meshLoadOptions.clean,
+        meshLoadOptions.optimizeVertexCache,
+        meshLoadOptions.lodCount,
+    };
+
+    unsigned long long hash = GetBufferHash( optionValues, sizeof( optionValues ) );
+    hash = GetBufferHash( optionFlags, sizeof( optionFlags ), hash );
+    return GetBufferHash( sourceData, sourceDataSize, hash );
+}
+
+bool WriteCookedMesh( const std::string& fileName, const unsigned long long sourceHash,
+                      const std::vector<Vertex_PCUTBN>& vertexes,
+                      const std::vector<unsigned int>& indexes, const std::vector<MeshLod>& lods )
+{
+    CookedMeshHeader header;
+    memcpy( header.magic, COOKED_MESH_MAGIC, sizeof( header.magic ) );
+    header.version = COOKED_MESH_VERSION;
+    header.sourceHash = sourceHash;
+    header.vertexStride = sizeof( Vertex_PCUTBN );
+    header.vertexCount = static_cast<unsigned int>( vertexes.size() );
+    header.indexCount = static_cast<unsigned int>( indexes.size() );
+    header.lodCount = static_cast<unsigned int>( lods.size() );
+
+    header.vertexOffset = AlignSectionOffset( sizeof( CookedMeshHeader ) );
+    header.indexOffset = AlignSectionOffset( header.vertexOffset + vertexes.size() * sizeof( Vertex_PCUTBN ) );
+    header.lodOffset = AlignSectionOffset( header.indexOffset + indexes.size() * sizeof( unsigned int ) );
+    header.fileSize = header.lodOffset + lods.size() * sizeof( MeshLod );
+
+    // Built in memory and written at once, a partially written file fails the size check on load
+    std::vector<unsigned char> file( static_cast<size_t>( header.fileSize ), 0 );
+    memcpy( file.data(), &header, sizeof( CookedMeshHeader ) );
+    if( !vertexes.empty() )
+    {
+        memcpy( &file[ static_cast<size_t>( header.vertexOffset ) ], vertexes.data(), vertexes.size() * sizeof( Vertex_PCUTBN ) );
+    }
+    if( !indexes.empty() )
+    {
+        memcpy( &file[ static_cast<size_t>( header.indexOffset ) ], indexes.data(), indexes.size() * sizeof( unsigned int ) );
+    }
+    if( !lods.empty() )
+    {
+        memcpy( &file[ static_cast<size_t>( header.lodOffset ) ], lods.data(), lods.size() * sizeof( MeshLod ) );
+    }
+
+    return FileWriteFromBuffer( fileName, file.data(), file.size() );
+}
+
+bool LoadMeshDataFromFile( const std::string& fileName, const MeshLoadOptions& meshLoadOptions,
+                           OUT_PARAM MeshData& meshData )
+{
+    meshData.cookedMesh.Close();
+    meshData.vertexes.clear();
+    meshData.indexes.clear();
+    meshData.lods.clear();
+
+    MappedFile objFile( fileName );
+    const std::string cookedFileName = GetCookedMeshFileName( fileName );
+    unsigned long long sourceHash = 0;
+    if( meshLoadOptions.useCookedMesh && objFile.IsOpen() )
+    {
+        sourceHash = GetCookedMeshSourceHash( objFile.GetData(), objFile.GetSize(), meshLoadOptions );
+    }
+
+    // Shipped builds may only have the cooked file, then it is used as is
+    if( meshLoadOptions.useCookedMesh )
+    {
+        CookedMesh& cookedMesh = meshData.cookedMesh;
+        if( cookedMesh.Open( cookedFileName ) &&
+            ( !objFile.IsOpen() || cookedMesh.GetSourceHash() == sourceHash ) )
+        {
+            return true;
+        }
+        cookedMesh.Close();
+    }
+
+    if( !objFile.IsOpen() )
+    {
+        return false;
+    }
+
+    std::vector<VertexMaster> vertexMaster;
+    ParseObjBuffer( objFile.GetView(), vertexMaster, meshData.indexes, meshLoadOptions );
+    Vertex_PCUTBN::ConvertFromMaster( meshData.vertexes, vertexMaster );
+
+    if( meshLoadOptions.lodCount > 1 && !meshData.indexes.empty() )
+    {
+        std::vector<std::vector<unsigned int>> lodIndexes;
+        std::vector<float> lodErrors;
+        GenerateMeshLods( vertexMaster, meshData.indexes, meshLoadOptions.lodCount, meshLoadOptions.lodReduction,
+                          lodIndexes, lodErrors );
+
+        // Same layout GPUMesh::UpdateLods gives the index buffer
+        meshData.indexes.clear();
+        for( size_t lodIndex = 0; lodIndex < lodIndexes.size(); ++lodIndex )
+        {
+            MeshLod lod;
+            lod.indexStart = static_cast<unsigned int>( meshData.indexes.size() );
+            lod.indexCount = static_cast<unsigned int>( lodIndexes[ lodIndex ].size() );
+            lod.error = lodErrors[ lodIndex ];
+            meshData.lods.push_back( lod );
+
+            meshData.indexes.insert( meshData.indexes.end(), lodIndexes[ lodIndex ].begin(), lodIndexes[ lodIndex ].end() );
+        }
+    }
+
+    if( meshLoadOptions.useCookedMesh )
+    {
+        WriteCookedMesh( cookedFileName, sourceHash, meshData.vertexes, meshData.indexes, meshData.lods );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CookedMesh::Open( const std::string& fileName )
+{
+    Close();
+
+    if( !m_File.Open( fileName ) || m_File.GetSize() < sizeof( CookedMeshHeader ) )
+    {
+        Close();
+        return false;
+    }
+
+    const unsigned char* data = m_File.GetData();
+    const CookedMeshHeader& header = *reinterpret_cast<const CookedMeshHeader*>( data );
+    const unsigned long long fileSize = m_File.GetSize();
+
+    const bool isCurrentVersion = memcmp( header.magic, COOKED_MESH_MAGIC, sizeof( header.magic ) ) == 0 &&
+                                  header.version == COOKED_MESH_VERSION &&
+                                  header.vertexStride == sizeof( Vertex_PCUTBN );
+
+    // Every section has to fit in the file
+    const bool isComplete = header.fileSize == fileSize &&
+                            header.vertexOffset + header.vertexCount * sizeof( Vertex_PCUTBN ) <= fileSize &&
+                            header.indexOffset + header.indexCount * sizeof( unsigned int ) <= fileSize &&
+                            header.lodOffset + header.lodCount * sizeof( MeshLod ) <= fileSize;
+    if( !isCurrentVersion || !isComplete )
+    {
+        Close();
+        return false;
+    }
+
+    // A corrupt range or index would read past the buffers on the GPU, reject it so it is recooked
+    const unsigned int* indexes = reinterpret_cast<const unsigned int*>( data + header.indexOffset );
+    for( unsigned int index = 0; index < header.indexCount; ++index )
+    {
+        if( indexes[ index ] >= header.vertexCount )
+        {
+            Close();
+            return false;
+        }
+    }
+
+    const MeshLod* lods = reinterpret_cast<const MeshLod*>( data + header.lodOffset );
+    for( unsigned int lodIndex = 0; lodIndex < header.lodCount; ++lodIndex )
+    {
+        const MeshLod& lod = lods[ lodIndex ];
+        if( static_cast<unsigned long long>( lod.indexStart ) + lod.indexCount > header.indexCount )
+        {
+            Close();
+            return false;
+        }
+    }
+
+    m_SourceHash = header.sourceHash;
+    m_Vertexes = reinterpret_cast<const Vertex_PCUTBN*>( data + header.vertexOffset );
+    m_VertexCount = header.vertexCount;
+    m_Indexes = indexes;
+    m_IndexCount = header.indexCount;
+    m_Lods = lods;
+    m_LodCount = header.lodCount;
+    return true;
+}
+
+void CookedMesh::Close()
+{
+    m_File.Close();
+
+    m_SourceHash = 0;
+    m_Vertexes = nullptr;
+    m_VertexCount = 0;
+    m_Indexes = nullptr;
+    m_IndexCount = 0;
+    m_Lods = nullptr;
+    m_LodCount = 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
+#include "Engine/IO/FileUtils.hpp"
+#include "Engine/Renderer/GPUMesh.hpp"
+
+#include <string>
+#include <vector>
+
+struct MeshLoadOptions;
+
+// Bump whenever the layout of the cooked file or Vertex_PCUTBN changes, old files are recooked
+constexpr unsigned int COOKED_MESH_VERSION = 1;
+
+// Cooked meshes sit next to their source, "Data/Models/Ship.obj" cooks to "Data/Models/Ship.obj.mesh"
+std::string GetCookedMeshFileName( const std::string& sourceFileName );
+
+// Identifies both the source bytes and every load option that changes the cooked output
+unsigned long long GetCookedMeshSourceHash( const void* sourceData, size_t sourceDataSize,
+                                            const MeshLoadOptions& meshLoadOptions );
+
+bool WriteCookedMesh( const std::string& fileName, unsigned long long sourceHash,
+                      const std::vector<Vertex_PCUTBN>& vertexes,
+                      const std::vector<unsigned int>& indexes, const std::vector<MeshLod>& lods );
+
+//-----------------------------------------------------------------------------
+// Maps a cooked mesh and points straight into it, nothing is parsed or copied. The pointers are
+//  only valid while the CookedMesh is open
+class CookedMesh
+{
+public:
+    CookedMesh() = default;
+    ~CookedMesh() = default;
+
+    // Fails for missing, truncated or out of date files, and for LOD ranges or indexes that
+    //  point outside the file's own buffers
+    bool Open( const std::string& fileName );
+    void Close();
+
+    bool IsOpen() const { return m_Vertexes != nullptr; }
+    unsigned long long GetSourceHash() const { return m_SourceHash; }
+
+    const Vertex_PCUTBN* GetVertexes() const { return m_Vertexes; }
+    unsigned int GetVertexCount() const { return m_VertexCount; }
+    const unsigned int* GetIndexes() const { return m_Indexes; }
+    unsigned int GetIndexCount() const { return m_IndexCount; }
+    const MeshLod* GetLods() const { return m_Lods; }
+    unsigned int GetLodCount() const { return m_LodCount; }
+
+private:
+    MappedFile m_File;
+
+    unsigned long long m_SourceHash = 0;
+    const Vertex_PCUTBN* m_Vertexes = nullptr;
+    unsigned int m_VertexCount = 0;
+    const unsigned int* m_Indexes = nullptr;
+    unsigned int m_IndexCount = 0;
+    const MeshLod* m_Lods = nullptr;
+    unsigned int m_LodCount = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Everything a GPUMesh uploads for a file. LODs sit back to back in indexes. A current cooked
+//  mesh stays open in cookedMesh and is uploaded straight from the mapping, the vectors are only
+//  filled when the OBJ had to be parsed
+struct MeshData
+{
+    CookedMesh cookedMesh;
+    std::vector<Vertex_PCUTBN> vertexes;
+    std::vector<unsigned int> indexes;
+    std::vector<MeshLod> lods;
+};
+
+// CPU half of GPUMesh::CreateFromFile. Uses the cooked mesh when it is current, otherwise parses
+//  the OBJ and cooks it. Never touches the device so it can run on a worker thread
+bool LoadMeshDataFromFile( const std::string& fileName, const MeshLoadOptions& meshLoadOptions,
+                           OUT_PARAM MeshData& meshData );
@@ -0,0 +1,337 @@
+#include "CookedTextureUtils.hpp"
+
+#include "Engine/Core/Image.hpp"
+#include "Engine/Event/JobSystem.hpp"
+#include "Engine/Renderer/TextureEncoder.hpp"
+
+#include <cstring>
+
+// Every mip starts on this boundary, the same as the cooked mesh sections
+constexpr size_t COOKED_TEXTURE_SECTION_ALIGNMENT = 16;
+// Roughly how much work each ParallelFor batch gets. Encoding a block costs far more than
+//  filtering a texel, so blocks are split much finer
+constexpr unsigned int COOK_TEXELS_PER_FILTER_BATCH = 1 << 16;
+constexpr unsigned int COOK_BLOCKS_PER_ENCODE_BATCH = 128;
+
+constexpr char COOKED_TEXTURE_MAGIC[ 4 ] = { 'S', 'D', 'T', 'X' };
+
+struct CookedTextureHeader
+{
+    char magic[ 4 ] = {};
+    unsigned int version = 0;
+    unsigned long long sourceHash = 0;
+
+    TextureFormat format = TextureFormat::RGBA8;
+    unsigned int mipStride = 0;
+    unsigned int mipCount = 0;
+    unsigned int reserved = 0;
+
+    unsigned long long mipOffset = 0;
+    unsigned long long dataOffset = 0;
+    unsigned long long dataSize = 0;
+    unsigned long long fileSize = 0;
+};
+
+typedef void ( *BlockEncodeFunction )( const Rgba8* texels, unsigned char* block );
+
+static size_t AlignSectionOffset( const size_t offset )
+{
+    return ( offset + COOKED_TEXTURE_SECTION_ALIGNMENT - 1 ) & ~( COOKED_TEXTURE_SECTION_ALIGNMENT - 1 );
+}
+
+static unsigned int GetRowsPerBatch( const unsigned int itemsPerBatch, const int rowWidth )
+{
+    const unsigned int rows = itemsPerBatch / static_cast<unsigned int>( rowWidth > 0 ? rowWidth : 1 );
+    return rows > 0 ? rows : 1;
+}
+
+static BlockEncodeFunction GetBlockEncodeFunction( const TextureFormat format )
+{
+    switch( format )
+    {
+        case TextureFormat::BC1: return EncodeBC1Block;
+        case TextureFormat::BC3: return EncodeBC3Block;
+        case TextureFormat::BC7: return EncodeBC7Block;
+        default: return nullptr;
+    }
+}
+
+// Texels past the edge of a small mip repeat the last row and column
+static void GatherBlock( const Rgba8* texels, const IntVec2& dimensions, const int blockX, const int blockY, Rgba8* block )
+{
+    for( int y = 0; y < TEXTURE_BLOCK_DIMENSION; ++y )
+    {
+        const int texelY = blockY * TEXTURE_BLOCK_DIMENSION + y < dimensions.y ? blockY * TEXTURE_BLOCK_DIMENSION + y : dimensions.y - 1;
+        for( int x = 0; x < TEXTURE_BLOCK_DIMENSION; ++x )
+        {
+            const int texelX = blockX * TEXTURE_BLOCK_DIMENSION + x < dimensions.x ? blockX * TEXTURE_BLOCK_DIMENSION + x : dimensions.x - 1;
+            block[ y * TEXTURE_BLOCK_DIMENSION + x ] = texels[ static_cast<size_t>( texelY ) * dimensions.x + texelX ];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+size_t GetTextureFormatBlockSize( const TextureFormat format )
+{
+    switch( format )
+    {
+        case TextureFormat::BC1: return BC1_BLOCK_SIZE;
+        case TextureFormat::BC3: return BC3_BLOCK_SIZE;
+        case TextureFormat::BC7: return BC7_BLOCK_SIZE;
+        default: return 0;
+    }
+}
+
+std::string GetCookedTextureFileName( const std::string& sourceFileName )
+{
+    return sourceFileName + ".tex";
+}
+
+unsigned long long GetCookedTextureSourceHash( const void* sourceData, const size_t sourceDataSize,
+                                               const TextureCookOptions& cookOptions )
+{
+    // Options are hashed field by field so struct padding never leaks into the hash.
+    //  useCookedTexture does not change the output and is left out
+    const unsigned int optionFlags[] = {
+        COOKED_TEXTURE_VERSION,
+        static_cast<unsigned int>( cookOptions.format ),
+        static_cast<unsigned int>( cookOptions.mipFilter ),
+        cookOptions.generateMips,
+        cookOptions.isSrgb,
+        cookOptions.flipV,
+    };
+
+    const unsigned long long hash = GetBufferHash( optionFlags, sizeof( optionFlags ) );
+    return GetBufferHash( sourceData, sourceDataSize, hash );
+}
+
+bool CookTextureData( const Rgba8* texels, const IntVec2& dimensions, const TextureCookOptions& cookOptions,
+                      OUT_PARAM TextureData& textureData )
+{
+    textureData = TextureData();
+    if( texels == nullptr || dimensions.x <= 0 || dimensions.y <= 0 )
+    {
+        return false;
+    }
+
+    const bool fitsBlocks = dimensions.x % TEXTURE_BLOCK_DIMENSION == 0 && dimensions.y % TEXTURE_BLOCK_DIMENSION == 0;
+    textureData.format = fitsBlocks ? cookOptions.format : TextureFormat::RGBA8;
+
+    JobSystem& jobSystem = JobSystem::INSTANCE();
+
+    // Each level is filtered from the one before it, the rows of a level in parallel
+    std::vector<std::vector<Rgba8>> mipTexels;
+    std::vector<IntVec2> mipDimensions;
+    mipTexels.emplace_back( texels, texels + static_cast<size_t>( dimensions.x ) * dimensions.y );
+    mipDimensions.push_back( dimensions );
+    while( cookOptions.generateMips && ( mipDimensions.back().x > 1 || mipDimensions.back().y > 1 ) )
+    {
+        const IntVec2 sourceDimensions = mipDimensions.back();
+        const IntVec2 mipSize = GetDownsampledDimensions( sourceDimensions );
+        std::vector<Rgba8> mip( static_cast<size_t>( mipSize.x ) * mipSize.y );
+
+        const Rgba8* source = mipTexels.back().data();
+        jobSystem.ParallelFor( static_cast<unsigned int>( mipSize.y ), GetRowsPerBatch( COOK_TEXELS_PER_FILTER_BATCH, mipSize.x ),
+                               [&]( const unsigned int startRow, const unsigned int endRow )
+                               {
+                                   DownsampleTexelsFiltered( source, sourceDimensions, mip.data(), cookOptions.mipFilter,
+                                                             cookOptions.isSrgb, static_cast<int>( startRow ),
+                                                             static_cast<int>( endRow ) );
+                               } );
+
+        mipTexels.push_back( std::move( mip ) );
+        mipDimensions.push_back( mipSize );
+    }
+
+    // Lay the levels out back to back before encoding so every level writes in place
+    const size_t blockSize = GetTextureFormatBlockSize( textureData.format );
+    size_t dataSize = 0;
+    for( const IntVec2& mipSize : mipDimensions )
+    {
+        TextureMip mip;
+        mip.dimensions = mipSize;
+        if( blockSize > 0 )
+        {
+            const size_t blocksWide = ( mipSize.x + TEXTURE_BLOCK_DIMENSION - 1 ) / TEXTURE_BLOCK_DIMENSION;
+            const size_t blocksHigh = ( mipSize.y + TEXTURE_BLOCK_DIMENSION - 1 ) / TEXTURE_BLOCK_DIMENSION;
+            mip.rowPitch = static_cast<unsigned int>( blocksWide * blockSize );
+            mip.dataSize = blocksHigh * mip.rowPitch;
+        }
+        else
+        {
+            mip.rowPitch = static_cast<unsigned int>( mipSize.x * sizeof( Rgba8 ) );
+            mip.dataSize = static_cast<unsigned long long>( mipSize.y ) * mip.rowPitch;
+        }
+        mip.dataOffset = dataSize;
+        dataSize = AlignSectionOffset( static_cast<size_t>( dataSize + mip.dataSize ) );
+        textureData.mips.push_back( mip );
+    }
+    textureData.data.resize( dataSize );
+
+    const BlockEncodeFunction encodeBlock = GetBlockEncodeFunction( textureData.format );
+    for( size_t mipIndex = 0; mipIndex < textureData.mips.size(); ++mipIndex )
+    {
+        const TextureMip& mip = textureData.mips[ mipIndex ];
+        const Rgba8* mipSource = mipTexels[ mipIndex ].data();
+        unsigned char* mipData = &textureData.data[ static_cast<size_t>( mip.dataOffset ) ];
+        if( encodeBlock == nullptr )
+        {
+            memcpy( mipData, mipSource, static_cast<size_t>( mip.dataSize ) );
+            continue;
+        }
+
+        const int blocksWide = ( mip.dimensions.x + TEXTURE_BLOCK_DIMENSION - 1 ) / TEXTURE_BLOCK_DIMENSION;
+        const int blocksHigh = ( mip.dimensions.y + TEXTURE_BLOCK_DIMENSION - 1 ) / TEXTURE_BLOCK_DIMENSION;
+        const unsigned int blockRowsPerBatch = GetRowsPerBatch( COOK_BLOCKS_PER_ENCODE_BATCH, blocksWide );
+        jobSystem.ParallelFor( static_cast<unsigned int>( blocksHigh ), blockRowsPerBatch,
+                               [&]( const unsigned int startBlockRow, const unsigned int endBlockRow )
+                               {
+                                   Rgba8 blockTexels[ TEXTURE_BLOCK_TEXEL_COUNT ];
+                                   for( unsigned int blockY = startBlockRow; blockY < endBlockRow; ++blockY )
+                                   {
+                                       unsigned char* blockRow = mipData + blockY * mip.rowPitch;
+                                       for( int blockX = 0; blockX < blocksWide; ++blockX )
+                                       {
+                                           GatherBlock( mipSource, mip.dimensions, blockX, static_cast<int>( blockY ), blockTexels );
+                                           encodeBlock( blockTexels, blockRow + blockX * blockSize );
+                                       }
+                                   }
+                               } );
+    }
+
+    return true;
+}
+
+bool WriteCookedTexture( const std::string& fileName, const unsigned long long sourceHash, const TextureData& textureData )
+{
+    CookedTextureHeader header;
+    memcpy( header.magic, COOKED_TEXTURE_MAGIC, sizeof( header.magic ) );
+    header.version = COOKED_TEXTURE_VERSION;
+    header.sourceHash = sourceHash;
+    header.format = textureData.format;
+    header.mipStride = sizeof( TextureMip );
+    header.mipCount = static_cast<unsigned int>( textureData.mips.size() );
+
+    header.mipOffset = AlignSectionOffset( sizeof( CookedTextureHeader ) );
+    header.dataOffset = AlignSectionOffset( static_cast<size_t>( header.mipOffset + textureData.mips.size() * sizeof( TextureMip ) ) );
+    header.dataSize = textureData.data.size();
+    header.fileSize = header.dataOffset + header.dataSize;
+
+    // Built in memory and written at once, a partially written file fails the size check on load
+    std::vector<unsigned char> file( static_cast<size_t>( header.fileSize ), 0 );
+    memcpy( file.data(), &header, sizeof( CookedTextureHeader ) );
+    if( !textureData.mips.empty() )
+    {
+        memcpy( &file[ static_cast<size_t>( header.mipOffset ) ], textureData.mips.data(), textureData.mips.size() * sizeof( TextureMip ) );
+    }
+    if( !textureData.data.empty() )
+    {
+        memcpy( &file[ static_cast<size_t>( header.dataOffset ) ], textureData.data.data(), textureData.data.size() );
+    }
+
+    return FileWriteFromBuffer( fileName, file.data(), file.size() );
+}
+
+bool LoadTextureDataFromFile( const std::string& fileName, const TextureCookOptions& cookOptions,
+                              OUT_PARAM TextureData& textureData )
+{
+    textureData = TextureData();
+
+    MappedFile sourceFile( fileName );
+    const std::string cookedFileName = GetCookedTextureFileName( fileName );
+    unsigned long long sourceHash = 0;
+    if( cookOptions.useCookedTexture && sourceFile.IsOpen() )
+    {
+        sourceHash = GetCookedTextureSourceHash( sourceFile.GetData(), sourceFile.GetSize(), cookOptions );
+    }
+
+    // Shipped builds may only have the cooked file, then it is used as is
+    if( cookOptions.useCookedTexture )
+    {
+        CookedTexture cookedTexture;
+        if( cookedTexture.Open( cookedFileName ) &&
+            ( !sourceFile.IsOpen() || cookedTexture.GetSourceHash() == sourceHash ) )
+        {
+            textureData.format = cookedTexture.GetFormat();
+            textureData.mips.assign( cookedTexture.GetMips(), cookedTexture.GetMips() + cookedTexture.GetMipCount() );
+            textureData.data.assign( cookedTexture.GetData(), cookedTexture.GetData() + cookedTexture.GetDataSize() );
+            return true;
+        }
+    }
+
+    if( !sourceFile.IsOpen() )
+    {
+        return false;
+    }
+
+    IntVec2 dimensions;
+    std::vector<Rgba8> texels;
+    if( !Image::DecodeFromMemory( sourceFile.GetView(), cookOptions.flipV, dimensions, texels ) ||
+        !CookTextureData( texels.data(), dimensions, cookOptions, textureData ) )
+    {
+        return false;
+    }
+
+    if( cookOptions.useCookedTexture )
+    {
+        WriteCookedTexture( cookedFileName, sourceHash, textureData );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CookedTexture::Open( const std::string& fileName )
+{
+    Close();
+
+    if( !m_File.Open( fileName ) || m_File.GetSize() < sizeof( CookedTextureHeader ) )
+    {
+        Close();
+        return false;
+    }
+
+    const unsigned char* data = m_File.GetData();
+    const CookedTextureHeader& header = *reinterpret_cast<const CookedTextureHeader*>( data );
+    const unsigned long long fileSize = m_File.GetSize();
+
+    const bool isCurrentVersion = memcmp( header.magic, COOKED_TEXTURE_MAGIC, sizeof( header.magic ) ) == 0 &&
+                                  header.version == COOKED_TEXTURE_VERSION &&
+                                  header.mipStride == sizeof( TextureMip ) &&
+                                  header.format <= TextureFormat::BC7;
+
+    // Every section, and every mip inside the data, has to fit in the file
+    bool isComplete = header.mipCount > 0 && header.fileSize == fileSize &&
+                      header.mipOffset + header.mipCount * sizeof( TextureMip ) <= fileSize &&
+                      header.dataOffset + header.dataSize <= fileSize;
+    const TextureMip* mips = reinterpret_cast<const TextureMip*>( data + header.mipOffset );
+    for( unsigned int mipIndex = 0; isComplete && mipIndex < header.mipCount; ++mipIndex )
+    {
+        isComplete = mips[ mipIndex ].dataOffset + mips[ mipIndex ].dataSize <= header.dataSize;
+    }
+    if( !isCurrentVersion || !isComplete )
+    {
+        Close();
+        return false;
+    }
+
+    m_SourceHash = header.sourceHash;
+    m_Format = header.format;
+    m_Mips = mips;
+    m_MipCount = header.mipCount;
+    m_Data = data + header.dataOffset;
+    m_DataSize = static_cast<size_t>( header.dataSize );
+    return true;
+}
+
+void CookedTexture::Close()
+{
+    m_File.Close();
+
+    m_SourceHash = 0;
+    m_Format = TextureFormat::RGBA8;
+    m_Mips = nullptr;
+    m_MipCount = 0;
+    m_Data = nullptr;
+    m_DataSize = 0;
+}
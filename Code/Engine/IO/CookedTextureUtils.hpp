@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/Core/Utils/PixelUtils.hpp"
+#include "Engine/IO/FileUtils.hpp"
+
+#include <string>
+#include <vector>
+
+// Bump whenever the layout of the cooked file or the encoders change, old files are recooked
+constexpr unsigned int COOKED_TEXTURE_VERSION = 1;
+
+enum class TextureFormat : unsigned int
+{
+    RGBA8,
+    BC1,    // Opaque color, 4 bits per texel
+    BC3,    // Color and smooth alpha, 8 bits per texel
+    BC7,    // Color and alpha at higher quality, 8 bits per texel
+};
+
+struct TextureCookOptions
+{
+    // Block formats need both sides to be a multiple of 4, other sizes cook to RGBA8
+    TextureFormat format = TextureFormat::BC7;
+    MipFilter mipFilter = MipFilter::KAISER;
+    bool generateMips = true;
+    // Color is sRGB encoded so mips are filtered in linear light. Off for normal maps and masks
+    bool isSrgb = true;
+    bool flipV = false;
+    // Read and write the cooked file next to the source
+    bool useCookedTexture = true;
+};
+
+// Stored as is in the cooked file. dataOffset is from the start of the texture data
+struct TextureMip
+{
+    IntVec2 dimensions = IntVec2::ZERO;
+    unsigned int rowPitch = 0;
+    unsigned int reserved = 0;
+    unsigned long long dataOffset = 0;
+    unsigned long long dataSize = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Everything a Texture uploads, mips largest first
+struct TextureData
+{
+    TextureFormat format = TextureFormat::RGBA8;
+    std::vector<TextureMip> mips;
+    std::vector<unsigned char> data;
+};
+
+// Bytes per 4x4 block, 0 for formats that are not block compressed
+size_t GetTextureFormatBlockSize( TextureFormat format );
+
+// Cooked textures sit next to their source, "Data/Images/Ship.png" cooks to "Data/Images/Ship.png.tex"
+std::string GetCookedTextureFileName( const std::string& sourceFileName );
+
+// Identifies both the source bytes and every option that changes the cooked output
+unsigned long long GetCookedTextureSourceHash( const void* sourceData, size_t sourceDataSize,
+                                               const TextureCookOptions& cookOptions );
+
+// Builds the mip chain and encodes every level. Mips and blocks are split across the JobSystem
+//  workers, and the calling thread helps
+bool CookTextureData( const Rgba8* texels, const IntVec2& dimensions, const TextureCookOptions& cookOptions,
+                      OUT_PARAM TextureData& textureData );
+
+bool WriteCookedTexture( const std::string& fileName, unsigned long long sourceHash, const TextureData& textureData );
+
+// CPU half of Texture::CreateFromFile with cook options. Uses the cooked texture when it is
+//  current, otherwise decodes the source and cooks it. Never touches the device
+bool LoadTextureDataFromFile( const std::string& fileName, const TextureCookOptions& cookOptions,
+                              OUT_PARAM TextureData& textureData );
+
+//-----------------------------------------------------------------------------
+// Maps a cooked texture and points straight into it. The pointers are only valid while the
+//  CookedTexture is open
+class CookedTexture
+{
+public:
+    CookedTexture() = default;
+    ~CookedTexture() = default;
+
+    // Fails for missing, truncated or out of date files
+    bool Open( const std::string& fileName );
+    void Close();
+
+    bool IsOpen() const { return m_Mips != nullptr; }
+    unsigned long long GetSourceHash() const { return m_SourceHash; }
+    TextureFormat GetFormat() const { return m_Format; }
+
+    const TextureMip* GetMips() const { return m_Mips; }
+    unsigned int GetMipCount() const { return m_MipCount; }
+    const unsigned char* GetData() const { return m_Data; }
+    size_t GetDataSize() const { return m_DataSize; }
+
+private:
+    MappedFile m_File;
+
+    unsigned long long m_SourceHash = 0;
+    TextureFormat m_Format = TextureFormat::RGBA8;
+    const TextureMip* m_Mips = nullptr;
+    unsigned int m_MipCount = 0;
+    const unsigned char* m_Data = nullptr;
+    size_t m_DataSize = 0;
+};
@@ -1,10 +1,86 @@
 #include "FileUtils.hpp"
 
+#include "Engine/Event/JobSystem.hpp"
+#include "Engine/IO/PackFile.hpp"
+
+#include <algorithm>
 #include <cstdio>
-#include <fstream>
+#include <cstring>
 
+#if defined(_WIN32)
 #include <io.h>
 
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static FILE* OpenFile( const std::string& fileName, const char* mode )
+{
+    FILE* file = nullptr;
+#if defined(_WIN32)
+    fopen_s( &file, fileName.c_str(), mode );
+#else
+    file = fopen( fileName.c_str(), mode );
+#endif
+    return file;
+}
+
+// 0 if the size can not be found, files over 2GB need the 64 bit seek
+static size_t GetOpenFileSize( FILE* file )
+{
+#if defined(_WIN32)
+    _fseeki64( file, 0, SEEK_END );
+    const long long fileSize = _ftelli64( file );
+    _fseeki64( file, 0, SEEK_SET );
+#else
+    fseeko( file, 0, SEEK_END );
+    const long long fileSize = ftello( file );
+    fseeko( file, 0, SEEK_SET );
+#endif
+    return fileSize > 0 ? static_cast<size_t>( fileSize ) : 0;
+}
+
+static std::vector<PackFile*> s_MountedPackFiles;
+// Debug builds let edited loose files win over their packed copies, release builds go to the
+//  packs first so packed files never cost a disk open
+#if defined(_DEBUG)
+static bool s_LooseFilesOverridePacks = true;
+#else
+static bool s_LooseFilesOverridePacks = false;
+#endif
+
+static const PackFile* FindPackedFile( const std::string& fileName, OUT_PARAM const PackEntry*& entry )
+{
+    for( auto packIter = s_MountedPackFiles.rbegin(); packIter != s_MountedPackFiles.rend(); ++packIter )
+    {
+        entry = ( *packIter )->FindEntry( fileName );
+        if( entry != nullptr ) { return *packIter; }
+    }
+    entry = nullptr;
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+BufferView::BufferView( const void* viewData, const size_t viewSize )
+    : data( static_cast<const unsigned char*>( viewData ) )
+      , size( viewSize )
+{
+}
+
+BufferView BufferView::GetSubView( size_t offset, size_t subSize ) const
+{
+    if( offset > size ) { offset = size; }
+    if( subSize > size - offset ) { subSize = size - offset; }
+    return BufferView( data + offset, subSize );
+}
+
 Strings GetAllFilesNamesInFolder( const char* folderPath, const char* filePattern )
 {
     return GetAllFilesNamesInFolder( std::string( folderPath), std::string(filePattern) );
@@ -23,22 +99,57 @@ Strings GetAllFilesNamesInFolder( const std::string& folderPath, const char* fil
 Strings GetAllFilesNamesInFolder( const std::string& folderPath, const std::string& filePattern )
 {
     Strings fileNames;
+    for( auto packIter = s_MountedPackFiles.rbegin(); packIter != s_MountedPackFiles.rend(); ++packIter )
+    {
+        ( *packIter )->GetFileNamesInFolder( folderPath, filePattern, fileNames );
+    }
+
+    // Loose files outside every pack are still readable either way, so they are always listed
+    const size_t packedFileCount = fileNames.size();
+    const auto addLooseFileName = [&]( const std::string& fileName )
+    {
+        const std::string normalized = NormalizePackPath( fileName );
+        const auto packedEnd = fileNames.begin() + packedFileCount;
+        const bool isPacked = std::any_of( fileNames.begin(), packedEnd, [&]( const std::string& packedName )
+        {
+            return NormalizePackPath( packedName ) == normalized;
+        } );
+        if( !isPacked ) { fileNames.push_back( fileName ); }
+    };
+
     std::string folder = folderPath;
     if( folder.at(folder.size() - 1 ) != '/' )
     {
         folder += "/";
     }
     const std::string pattern = filePattern.empty() ? "*" : filePattern;
+#if defined(_WIN32)
     const std::string fileNamePattern = folder + pattern;
+#endif
 
+#if defined(_WIN32)
     _finddata_t fileInfo;
     const intptr_t searchHandle = _findfirst( fileNamePattern.c_str(), &fileInfo );
     while( searchHandle != -1 )
     {
-        fileNames.push_back( fileInfo.name );
+        addLooseFileName( fileInfo.name );
         const int errorCode = _findnext( searchHandle, &fileInfo );
         if( errorCode != 0 ) { break; }
     }
+    if( searchHandle != -1 ) { _findclose( searchHandle ); }
+#else
+    DIR* directory = opendir( folder.c_str() );
+    if( directory == nullptr ) { return fileNames; }
+
+    for( const dirent* entry = readdir( directory ); entry != nullptr; entry = readdir( directory ) )
+    {
+        if( fnmatch( pattern.c_str(), entry->d_name, 0 ) == 0 )
+        {
+            addLooseFileName( entry->d_name );
+        }
+    }
+    closedir( directory );
+#endif
 
     return fileNames;
 }
@@ -54,47 +165,447 @@ std::string TrimFileExtension( const std::string& filePath )
 
 void FileReadToVector( const std::string& fileName, OUT_PARAM Strings& fileData )
 {
-    std::ifstream fileStream( fileName, std::ios::in );
-
-    GUARANTEE_OR_DIE( fileStream.is_open(), Stringf("FileUtils - Failed to open file %s", fileName.c_str() ) );
+    MappedFile file( fileName );
+    GUARANTEE_OR_DIE( file.IsOpen(), Stringf("FileUtils - Failed to open file %s", fileName.c_str() ) );
 
-    std::string fileLine;
-    while( std::getline( fileStream, fileLine) )
+    const char* cursor = file.GetView().GetChars();
+    const char* fileEnd = cursor + file.GetSize();
+    while( cursor < fileEnd )
     {
-        if( !fileLine.empty() )
+        const char* lineEnd = static_cast<const char*>( memchr( cursor, '\n', fileEnd - cursor ) );
+        if( lineEnd == nullptr ) { lineEnd = fileEnd; }
+
+        const char* nextLine = lineEnd + ( lineEnd < fileEnd ? 1 : 0 );
+        if( lineEnd > cursor && lineEnd[ -1 ] == '\r' ) { --lineEnd; }
+        if( lineEnd > cursor )
         {
-            fileData.push_back( fileLine );
+            fileData.emplace_back( cursor, lineEnd );
         }
+        cursor = nextLine;
     }
-
-    fileStream.close();
 }
 
 void* FileReadToNewBuffer( const std::string& fileName, OUT_PARAM size_t* outSize = nullptr )
 {
-    FILE* file;
-    fopen_s( &file, fileName.c_str(), "r" );
-    if ( file == nullptr ) { return nullptr; }
+    MappedFile file( fileName );
+    if ( !file.IsOpen() ) { return nullptr; }
+
+    const size_t fileSize = file.GetSize();
 
-    //Get the size
-    fseek( file, 0, SEEK_END );
-    const long fileSize = ftell( file ) + 1;
+    unsigned char* buffer = new unsigned char[ fileSize + 1 ];
+    if( fileSize > 0 ) { memcpy( buffer, file.GetData(), fileSize ); }
+    buffer[ fileSize ] = '\0';
 
-    unsigned char* buffer = new unsigned char[ fileSize ];
-    size_t bytesRead = 0;
-    if ( buffer != nullptr )
+    if ( outSize != nullptr )
     {
-        fseek( file, 0, SEEK_SET );
-        bytesRead = fread( buffer, 1, fileSize, file );
-        buffer[ bytesRead ] = '\0';
+        *outSize = fileSize;
     }
 
-    if ( outSize != nullptr )
+    return buffer;
+}
+
+bool FileReadToBuffer( const std::string& fileName, OUT_PARAM std::vector<unsigned char>& fileData )
+{
+    fileData.clear();
+
+    // Packed files are copied or unpacked straight out of the pack
+    const PackEntry* entry = nullptr;
+    const PackFile* packFile = FindPackedFile( fileName, entry );
+    FILE* file = nullptr;
+    if( packFile != nullptr && s_LooseFilesOverridePacks ) { file = OpenFile( fileName, "rb" ); }
+    if( file == nullptr && packFile != nullptr ) { return packFile->ReadEntry( *entry, fileData ); }
+    if( file == nullptr ) { file = OpenFile( fileName, "rb" ); }
+    if( file == nullptr ) { return false; }
+
+    fileData.resize( GetOpenFileSize( file ) );
+    const size_t bytesRead = fileData.empty() ? 0 : fread( fileData.data(), 1, fileData.size(), file );
+    fclose( file );
+
+    const bool succeeded = bytesRead == fileData.size();
+    fileData.resize( bytesRead );
+    return succeeded;
+}
+
+//-----------------------------------------------------------------------------
+class FileReadJob : public Job
+{
+public:
+    FileReadJob( const std::string& fileName, const FileReadCallback& onRead )
+        : m_FileName( fileName )
+          , m_OnRead( onRead )
+    {
+    }
+
+    void Run()
     {
-        *outSize = bytesRead;
+        Execute();
+        Callback();
     }
 
+protected:
+    void Execute() override
+    {
+        m_Succeeded = FileReadToBuffer( m_FileName, m_FileData );
+    }
+
+    void Callback() override
+    {
+        m_OnRead( m_FileName, BufferView( m_FileData.data(), m_FileData.size() ), m_Succeeded );
+    }
+
+private:
+    std::string m_FileName;
+    FileReadCallback m_OnRead;
+
+    std::vector<unsigned char> m_FileData;
+    bool m_Succeeded = false;
+};
+
+unsigned int FileReadAsync( const std::string& fileName, const FileReadCallback& onRead )
+{
+    FileReadJob* job = new FileReadJob( fileName, onRead );
+    const unsigned int jobIndex = job->GetJobIndex();
+
+    JobSystem& jobSystem = JobSystem::INSTANCE();
+    if( jobSystem.GetNumWorkerThreads() == 0 )
+    {
+        job->Run();
+        delete job;
+        return jobIndex;
+    }
+
+    return jobSystem.ScheduleJob( *job );
+}
+
+bool MountPackFile( const std::string& packFileName )
+{
+    PackFile* packFile = new PackFile();
+    if( !packFile->Open( packFileName ) )
+    {
+        delete packFile;
+        return false;
+    }
+
+    s_MountedPackFiles.push_back( packFile );
+    return true;
+}
+
+void UnmountAllPackFiles()
+{
+    for( PackFile* packFile : s_MountedPackFiles )
+    {
+        delete packFile;
+    }
+    s_MountedPackFiles.clear();
+}
+
+void SetLooseFilesOverridePacks( const bool looseFilesOverride )
+{
+    s_LooseFilesOverridePacks = looseFilesOverride;
+}
+
+bool DoLooseFilesOverridePacks()
+{
+    return s_LooseFilesOverridePacks;
+}
+
+bool FileWriteFromBuffer( const std::string& fileName, const void* data, const size_t dataSize )
+{
+    FILE* file = OpenFile( fileName, "wb" );
+    if( file == nullptr ) { return false; }
+
+    const size_t bytesWritten = fwrite( data, 1, dataSize, file );
     fclose( file );
 
-    return buffer;
+    return bytesWritten == dataSize;
+}
+
+unsigned long long GetBufferHash( const void* data, const size_t dataSize, const unsigned long long seed )
+{
+    constexpr unsigned long long HASH_MULTIPLIER = 0x9E3779B97F4A7C15ull;
+    constexpr unsigned long long HASH_MIX = 0xBF58476D1CE4E5B9ull;
+
+    const unsigned char* bytes = static_cast<const unsigned char*>( data );
+    unsigned long long hash = seed ^ ( dataSize * HASH_MULTIPLIER );
+
+    // Eight bytes at a time, memcpy keeps unaligned reads legal
+    size_t byteIndex = 0;
+    for( ; byteIndex + 8 <= dataSize; byteIndex += 8 )
+    {
+        unsigned long long word;
+        memcpy( &word, bytes + byteIndex, 8 );
+        hash = ( hash ^ ( word * HASH_MULTIPLIER ) ) * HASH_MIX;
+        hash ^= hash >> 31;
+    }
+
+    unsigned long long tail = 0;
+    memcpy( &tail, bytes + byteIndex, dataSize - byteIndex );
+    hash = ( hash ^ ( tail * HASH_MULTIPLIER ) ) * HASH_MIX;
+
+    hash ^= hash >> 30;
+    hash *= HASH_MIX;
+    hash ^= hash >> 27;
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+MappedFile::MappedFile( const std::string& fileName )
+{
+    Open( fileName );
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open( const std::string& fileName )
+{
+    if( s_MountedPackFiles.empty() ) { return OpenFromDisk( fileName ); }
+
+    if( s_LooseFilesOverridePacks )
+    {
+        return OpenFromDisk( fileName ) || OpenFromPack( fileName );
+    }
+    return OpenFromPack( fileName ) || OpenFromDisk( fileName );
+}
+
+bool MappedFile::OpenFromPack( const std::string& fileName )
+{
+    Close();
+
+    const PackEntry* entry = nullptr;
+    const PackFile* packFile = FindPackedFile( fileName, entry );
+    if( packFile == nullptr ) { return false; }
+
+    if( entry->IsCompressed() )
+    {
+        if( !packFile->ReadEntry( *entry, m_UnpackedData ) ) { return false; }
+        m_Data = m_UnpackedData.data();
+        m_Size = m_UnpackedData.size();
+    }
+    else
+    {
+        const BufferView storedView = packFile->GetStoredView( *entry );
+        m_Data = storedView.data;
+        m_Size = storedView.size;
+    }
+
+    m_IsOpen = true;
+    return true;
+}
+
+bool MappedFile::OpenFromDisk( const std::string& fileName )
+{
+    Close();
+
+#if defined(_WIN32)
+    const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if( file == INVALID_HANDLE_VALUE ) { return false; }
+
+    LARGE_INTEGER fileSize;
+    if( !GetFileSizeEx( file, &fileSize ) )
+    {
+        CloseHandle( file );
+        return false;
+    }
+
+    m_FileHandle = file;
+    m_Size = static_cast<size_t>( fileSize.QuadPart );
+    m_IsOpen = true;
+
+    // Empty files can not be mapped, they stay open with no data
+    if( m_Size == 0 ) { return true; }
+
+    m_MappingHandle = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( m_MappingHandle != nullptr )
+    {
+        m_Data = static_cast<const unsigned char*>( MapViewOfFile( m_MappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+    }
+#else
+    const int file = open( fileName.c_str(), O_RDONLY );
+    if( file < 0 ) { return false; }
+
+    struct stat fileInfo;
+    if( fstat( file, &fileInfo ) != 0 || !S_ISREG( fileInfo.st_mode ) )
+    {
+        close( file );
+        return false;
+    }
+
+    m_Size = static_cast<size_t>( fileInfo.st_size );
+    m_IsOpen = true;
+
+    // Empty files can not be mapped, they stay open with no data
+    if( m_Size == 0 )
+    {
+        close( file );
+        return true;
+    }
+
+    // The mapping keeps its own reference to the file, so the descriptor is not needed after this
+    void* mapping = mmap( nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0 );
+    close( file );
+    if( mapping != MAP_FAILED )
+    {
+        madvise( mapping, m_Size, MADV_SEQUENTIAL );
+        m_Data = static_cast<const unsigned char*>( mapping );
+    }
+#endif
+
+    if( m_Data == nullptr )
+    {
+        Close();
+        return false;
+    }
+
+    m_IsMapped = true;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    // Views into a pack or unpacked data, nothing of ours is mapped
+    if( !m_IsMapped )
+    {
+        m_Data = nullptr;
+        std::vector<unsigned char>().swap( m_UnpackedData );
+    }
+
+#if defined(_WIN32)
+    if( m_Data != nullptr )
+    {
+        UnmapViewOfFile( m_Data );
+        m_Data = nullptr;
+    }
+
+    if( m_MappingHandle != nullptr )
+    {
+        CloseHandle( m_MappingHandle );
+        m_MappingHandle = nullptr;
+    }
+
+    if( m_FileHandle != nullptr )
+    {
+        CloseHandle( m_FileHandle );
+        m_FileHandle = nullptr;
+    }
+#else
+    if( m_Data != nullptr )
+    {
+        munmap( const_cast<unsigned char*>( m_Data ), m_Size );
+        m_Data = nullptr;
+    }
+#endif
+
+    m_Size = 0;
+    m_IsOpen = false;
+    m_IsMapped = false;
+}
+
+//-----------------------------------------------------------------------------
+FileChunkReader::FileChunkReader( const size_t chunkSize )
+    : m_Buffer( chunkSize > 0 ? chunkSize : 1 )
+{
+}
+
+FileChunkReader::~FileChunkReader()
+{
+    Close();
+}
+
+bool FileChunkReader::Open( const std::string& fileName )
+{
+    Close();
+
+    const bool isLooseFirst = s_LooseFilesOverridePacks || s_MountedPackFiles.empty();
+    if( isLooseFirst ) { m_File = OpenFile( fileName, "rb" ); }
+    if( m_File == nullptr && m_PackedFile.OpenFromPack( fileName ) )
+    {
+        m_FileSize = m_PackedFile.GetSize();
+        return true;
+    }
+    if( m_File == nullptr && !isLooseFirst ) { m_File = OpenFile( fileName, "rb" ); }
+    if( m_File == nullptr ) { return false; }
+
+    m_FileSize = GetOpenFileSize( m_File );
+    return true;
+}
+
+void FileChunkReader::Close()
+{
+    if( m_File != nullptr )
+    {
+        fclose( m_File );
+        m_File = nullptr;
+    }
+    m_PackedFile.Close();
+
+    m_FileSize = 0;
+    m_BytesRead = 0;
+    m_CarryStart = 0;
+    m_CarrySize = 0;
+}
+
+bool FileChunkReader::ReadChunk( OUT_PARAM BufferView& chunk )
+{
+    const size_t filled = FillBuffer();
+    chunk = BufferView( m_Buffer.data(), filled );
+    m_BytesRead += filled;
+    return filled > 0;
+}
+
+bool FileChunkReader::ReadLines( OUT_PARAM BufferView& lines )
+{
+    const size_t filled = FillBuffer();
+
+    // Everything left is the last line, and a line that fills the buffer has to be split
+    size_t viewSize = filled;
+    if( m_BytesRead + filled < m_FileSize )
+    {
+        for( size_t byteIndex = filled; byteIndex > 0; --byteIndex )
+        {
+            if( m_Buffer[ byteIndex - 1 ] == '\n' )
+            {
+                viewSize = byteIndex;
+                break;
+            }
+        }
+    }
+
+    m_CarryStart = viewSize;
+    m_CarrySize = filled - viewSize;
+
+    lines = BufferView( m_Buffer.data(), viewSize );
+    m_BytesRead += viewSize;
+    return viewSize > 0;
+}
+
+size_t FileChunkReader::FillBuffer()
+{
+    if( !IsOpen() ) { return 0; }
+
+    // Bytes carried over from the last ReadLines go to the front
+    if( m_CarrySize > 0 )
+    {
+        memmove( m_Buffer.data(), m_Buffer.data() + m_CarryStart, m_CarrySize );
+    }
+    const size_t carried = m_CarrySize;
+    m_CarryStart = 0;
+    m_CarrySize = 0;
+
+    size_t bytesRead;
+    if( m_PackedFile.IsOpen() )
+    {
+        // Everything handed out or carried has been consumed from the file
+        const BufferView packedView = m_PackedFile.GetView( m_BytesRead + carried, m_Buffer.size() - carried );
+        if( !packedView.IsEmpty() ) { memcpy( m_Buffer.data() + carried, packedView.data, packedView.size ); }
+        bytesRead = packedView.size;
+    }
+    else
+    {
+        bytesRead = fread( m_Buffer.data() + carried, 1, m_Buffer.size() - carried, m_File );
+    }
+    return carried + bytesRead;
 }
@@ -3,7 +3,27 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Utils/StringUtils.hpp"
 
+#include <cstdio>
+#include <functional>
 #include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Non owning, read only view of bytes. Loaders take these so a mapped file, a chunk of a stream and
+//  a buffer already in memory all load the same way
+struct BufferView
+{
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+    BufferView() = default;
+    BufferView( const void* viewData, size_t viewSize );
+
+    bool IsEmpty() const { return size == 0; }
+    const char* GetChars() const { return reinterpret_cast<const char*>( data ); }
+    // Clamped to the end of this view
+    BufferView GetSubView( size_t offset, size_t subSize ) const;
+};
 
 Strings GetAllFilesNamesInFolder( const char* folderPath, const char* filePattern );
 Strings GetAllFilesNamesInFolder( const char* folderPath, const std::string& filePattern );
@@ -12,6 +32,115 @@ Strings GetAllFilesNamesInFolder( const std::string& folderPath, const std::stri
 
 std::string TrimFileExtension( const std::string& filePath );
 
+// Every non empty line, without line endings
 void FileReadToVector( const std::string& fileName, OUT_PARAM Strings& fileData );
 
+// Binary read into a new[] buffer. The buffer holds one extra '\0' past outSize so text can be
+//  used as a C string
 void* FileReadToNewBuffer( const std::string& fileName, OUT_PARAM size_t* outSize );
+bool FileReadToBuffer( const std::string& fileName, OUT_PARAM std::vector<unsigned char>& fileData );
+
+// Called on the thread that claims the read's job. fileData is freed once it returns
+typedef std::function<void( const std::string& fileName, BufferView fileData, bool succeeded )> FileReadCallback;
+// Reads the whole file on a JobSystem worker. onRead runs when the returned job is claimed with
+//  ClaimJob or FinishJob. With no workers the read and onRead happen before this returns
+unsigned int FileReadAsync( const std::string& fileName, const FileReadCallback& onRead );
+
+bool FileWriteFromBuffer( const std::string& fileName, const void* data, size_t dataSize );
+
+// 64 bit hash of a buffer's contents, used to tell if cooked data is still built from its source
+unsigned long long GetBufferHash( const void* data, size_t dataSize, unsigned long long seed = 0 );
+
+//-----------------------------------------------------------------------------
+// Pack files, see PackFile.hpp. Once mounted every read above, MappedFile and FileChunkReader find
+//  packed files by the path they were packed under, and the last pack mounted is searched first.
+//  Mount during startup before other threads read files, and only unmount once nothing holds a
+//  view into a pack. Shader #includes are still read from disk by the compiler
+bool MountPackFile( const std::string& packFileName );
+void UnmountAllPackFiles();
+// On by default in debug builds so edited loose files win over their packed copies, off in release
+//  so packed files never cost a disk open. Files in no pack are read from disk either way, and
+//  folder listings hold the packed files plus every loose file not in a pack
+void SetLooseFilesOverridePacks( bool looseFilesOverride );
+bool DoLooseFilesOverridePacks();
+
+//-----------------------------------------------------------------------------
+// Read only view of a whole file mapped into memory. Pages are read from disk as they are touched.
+//  Uncompressed packed files are viewed inside the pack's mapping, compressed ones are unpacked
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile( const std::string& fileName );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& copy ) = delete;
+    MappedFile& operator=( const MappedFile& copy ) = delete;
+
+    // Loose file or mounted pack, whichever DoLooseFilesOverridePacks puts first
+    bool Open( const std::string& fileName );
+    bool OpenFromDisk( const std::string& fileName );
+    bool OpenFromPack( const std::string& fileName );
+    void Close();
+
+    bool IsOpen() const { return m_IsOpen; }
+    const unsigned char* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+
+    // Views are valid until the file is closed
+    BufferView GetView() const { return BufferView( m_Data, m_Size ); }
+    BufferView GetView( size_t offset, size_t size ) const { return GetView().GetSubView( offset, size ); }
+
+private:
+    bool m_IsOpen = false;
+    void* m_FileHandle = nullptr;
+    void* m_MappingHandle = nullptr;
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+
+    // Set when m_Data is our own mapping rather than a view into a pack
+    bool m_IsMapped = false;
+    std::vector<unsigned char> m_UnpackedData;
+};
+
+//-----------------------------------------------------------------------------
+// Streams a file through one fixed size buffer, for files too big to hold or map at once. A chunk
+//  is only valid until the next read
+class FileChunkReader
+{
+public:
+    explicit FileChunkReader( size_t chunkSize = 1 << 20 );
+    ~FileChunkReader();
+
+    FileChunkReader( const FileChunkReader& copy ) = delete;
+    FileChunkReader& operator=( const FileChunkReader& copy ) = delete;
+
+    bool Open( const std::string& fileName );
+    void Close();
+
+    bool IsOpen() const { return m_File != nullptr || m_PackedFile.IsOpen(); }
+    size_t GetFileSize() const { return m_FileSize; }
+    // Bytes handed out so far
+    size_t GetBytesRead() const { return m_BytesRead; }
+    bool IsAtEnd() const { return m_BytesRead == m_FileSize; }
+
+    // Up to chunkSize bytes. False once the whole file has been read
+    bool ReadChunk( OUT_PARAM BufferView& chunk );
+    // Same, but chunks end after their last '\n' and the partial line is carried into the next read,
+    //  so text formats can parse each chunk on its own. Lines longer than chunkSize come out split
+    bool ReadLines( OUT_PARAM BufferView& lines );
+
+private:
+    FILE* m_File = nullptr;
+    // Packed files are already in memory and get copied out of here instead
+    MappedFile m_PackedFile;
+    std::vector<unsigned char> m_Buffer;
+    size_t m_FileSize = 0;
+    size_t m_BytesRead = 0;
+
+    // Bytes of the buffer past the last view that have been read from disk but not handed out
+    size_t m_CarryStart = 0;
+    size_t m_CarrySize = 0;
+
+    size_t FillBuffer();
+};
@@ -1,277 +1,482 @@
 #include "ObjFileUtils.hpp"
 
-#include "Engine/Core/Utils/StringUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Event/JobSystem.hpp"
 #include "Engine/Renderer/Mesh/MeshUtils.hpp"
 
-
 #include "FileUtils.hpp"
 
-enum class ObjLineType
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+// Pieces smaller than this are not worth handing to another thread
+constexpr size_t OBJ_MIN_PARALLEL_CHUNK_BYTES = 1u << 20u;
+
+// Rough bytes per line, only used to reserve the chunk arrays up front
+constexpr size_t OBJ_ESTIMATED_BYTES_PER_LINE = 32u;
+
+enum ObjRelativeIndexBit : unsigned char
 {
-    VERTEX,
-    NORMAL,
-    TEXTURE,
-    FACE,
+    OBJ_RELATIVE_NONE_BIT = 0u,
+    OBJ_RELATIVE_VERTEX_BIT = BIT_FLAG<0>,
+    OBJ_RELATIVE_UV_BIT = BIT_FLAG<1>,
+    OBJ_RELATIVE_NORMAL_BIT = BIT_FLAG<2>,
+};
 
-    MATERIAL,
-    OBJECT,
-    GROUP,
+// Zero based indexes, -1 when the corner does not reference the attribute. Negative OBJ indexes
+//  count back from the attributes read so far, those are stored relative to the start of their
+//  chunk and flagged so they can be offset once every chunk has been read
+struct ObjCorner
+{
+    int vertex = -1;
+    int uv = -1;
+    int normal = -1;
+    unsigned char relativeBits = OBJ_RELATIVE_NONE_BIT;
+};
 
-    SKIP,
+struct ObjChunk
+{
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    std::vector<Vec3> positions;
+    std::vector<Vec3> normals;
+    std::vector<Vec2> uvs;
+
+    std::vector<ObjCorner> corners;
+    std::vector<unsigned int> faceCornerCounts;
+
+    // Filled once every chunk has been read
+    unsigned int firstPosition = 0;
+    unsigned int firstNormal = 0;
+    unsigned int firstUv = 0;
+    size_t firstVertex = 0;
 };
 
-static bool IsComment( const std::string& fileLine )
+//-----------------------------------------------------------------------------
+// Tokenizing
+static bool IsObjWhitespace( const char character )
 {
-    const char firstCharacter = GetFirstNonWhitespaceCharacter( fileLine );
-    return firstCharacter == '#';
+    return character == ' ' || character == '\t' || character == '\r' || character == '\v' ||
+           character == '\f';
 }
 
-static ObjLineType GetLineType( const std::string& lineBeginning )
+static std::string_view GetNextToken( const char*& cursor, const char* lineEnd )
 {
-    if ( lineBeginning == "v" )
-    {
-        return ObjLineType::VERTEX;
-    }
-    if ( lineBeginning == "vn" )
+    while( cursor < lineEnd && IsObjWhitespace( *cursor ) )
     {
-        return ObjLineType::NORMAL;
+        ++cursor;
     }
-    if ( lineBeginning == "vt" )
-    {
-        return ObjLineType::TEXTURE;
-    }
-    if ( lineBeginning == "f" )
-    {
-        return ObjLineType::FACE;
-    }
-    if ( lineBeginning == "mtllib" )
+
+    const char* tokenStart = cursor;
+    while( cursor < lineEnd && !IsObjWhitespace( *cursor ) )
     {
-        return ObjLineType::MATERIAL;
+        ++cursor;
     }
-    if ( lineBeginning == "o" )
+
+    return std::string_view( tokenStart, cursor - tokenStart );
+}
+
+static float ParseFloat( const std::string_view& token )
+{
+    const char* first = token.data();
+    const char* last = first + token.size();
+    if( first < last && *first == '+' )
     {
-        return ObjLineType::OBJECT;
+        ++first;
     }
-    if ( lineBeginning == "g" )
+
+    float value = 0.f;
+    const std::from_chars_result result = std::from_chars( first, last, value );
+    if( result.ec != std::errc() )
     {
-        return ObjLineType::GROUP;
+        return 0.f;
     }
-
-    return ObjLineType::SKIP;
+    return value;
 }
 
-static void ParseVec3( const Strings& line, OUT_PARAM std::vector<Vec3>& vector )
+static Vec3 ParseVec3( const char*& cursor, const char* lineEnd )
 {
-    float x = ConvertFromString( line[ 1 ], 0.f );
-    float y = ConvertFromString( line[ 2 ], 0.f );
-    float z = ConvertFromString( line[ 3 ], 0.f );
-
-    vector.emplace_back( x, y, z );
+    const float x = ParseFloat( GetNextToken( cursor, lineEnd ) );
+    const float y = ParseFloat( GetNextToken( cursor, lineEnd ) );
+    const float z = ParseFloat( GetNextToken( cursor, lineEnd ) );
+    return Vec3( x, y, z );
 }
 
-static void ParseVec2( const Strings& line, OUT_PARAM std::vector<Vec2>& vector )
+static Vec2 ParseVec2( const char*& cursor, const char* lineEnd )
 {
-    float x = ConvertFromString( line[ 1 ], 0.f );
-    float y = ConvertFromString( line[ 2 ], 0.f );
-
-    vector.emplace_back( x, y );
+    const float x = ParseFloat( GetNextToken( cursor, lineEnd ) );
+    const float y = ParseFloat( GetNextToken( cursor, lineEnd ) );
+    return Vec2( x, y );
 }
 
-static VertexMaster MakeVertexMasterFromFaceSplit( const Strings& faceSplit,
-                                                   const std::vector<Vec3>& objVertexes,
-                                                   const std::vector<Vec2>& objUvs,
-                                                   const MeshLoadOptions& loadOptions )
+// Parses one index of a face corner and advances past it. Returns false for a missing index
+static bool ParseFaceIndex( const char*& cursor, const char* tokenEnd, const size_t countSoFar,
+                            OUT_PARAM int& index, OUT_PARAM bool& isRelative )
 {
-    const size_t vertexIndex = ConvertFromString( faceSplit[ 0 ], 0u ) - 1u;
-    const size_t uvIndex = ConvertFromString( faceSplit[ 1 ], 0u ) - 1u;
-
-    Vec2 uv = objUvs.at( uvIndex );
-    if( loadOptions.invertV )
+    int objIndex = 0;
+    const std::from_chars_result result = std::from_chars( cursor, tokenEnd, objIndex );
+    if( result.ec != std::errc() )
     {
-        uv.y = 1 - uv.y;
+        return false;
     }
+    cursor = result.ptr;
 
+    GUARANTEE_OR_DIE( objIndex != 0, "ObjFileUtils - Face index of 0 is not valid, OBJ is 1 based" );
 
-    return VertexMaster( loadOptions.transform.TransformPosition( objVertexes.at( vertexIndex ) ), 
-                         Rgba8::WHITE, uv, Vec3::ONE, Vec3::ONE, Vec3::ONE );
+    isRelative = objIndex < 0;
+    index = isRelative ? static_cast<int>( countSoFar ) + objIndex : objIndex - 1;
+    return true;
 }
 
-static VertexMaster MakeVertexMasterFromFaceSplit( const Strings& faceSplit,
-                                                   const std::vector<Vec3>& objVertexes,
-                                                   const std::vector<Vec3>& objNormals,
-                                                   const std::vector<Vec2>& objUvs,
-                                                   const MeshLoadOptions& loadOptions )
+// Faces are v, v/vt, v//vn or v/vt/vn
+static ObjCorner ParseFaceCorner( const std::string_view& token, const ObjChunk& chunk )
 {
-    const size_t vertexIndex = ConvertFromString( faceSplit[ 0 ], 0u ) - 1u;
-    const size_t uvIndex = ConvertFromString( faceSplit[ 1 ], 0u ) - 1u;
-    const size_t normalIndex = ConvertFromString( faceSplit[ 2 ], 0u ) - 1u;
+    ObjCorner corner;
+    const char* cursor = token.data();
+    const char* tokenEnd = cursor + token.size();
 
-    Vec2 uv = objUvs.at( uvIndex );
-    if ( loadOptions.invertV )
+    bool isRelative = false;
+    if( ParseFaceIndex( cursor, tokenEnd, chunk.positions.size(), corner.vertex, isRelative ) &&
+        isRelative )
     {
-        uv.y = 1 - uv.y;
+        corner.relativeBits |= OBJ_RELATIVE_VERTEX_BIT;
     }
 
-    return VertexMaster( loadOptions.transform.TransformPosition( objVertexes.at( vertexIndex ) ),
-                         Rgba8::WHITE, uv, Vec3::ONE, Vec3::ONE,
-                         loadOptions.transform.TransformVector( objNormals.at( normalIndex ) ).GetNormalized() );
+    if( cursor < tokenEnd && *cursor == '/' )
+    {
+        ++cursor;
+        if( ParseFaceIndex( cursor, tokenEnd, chunk.uvs.size(), corner.uv, isRelative ) &&
+            isRelative )
+        {
+            corner.relativeBits |= OBJ_RELATIVE_UV_BIT;
+        }
+    }
+
+    if( cursor < tokenEnd && *cursor == '/' )
+    {
+        ++cursor;
+        if( ParseFaceIndex( cursor, tokenEnd, chunk.normals.size(), corner.normal, isRelative ) &&
+            isRelative )
+        {
+            corner.relativeBits |= OBJ_RELATIVE_NORMAL_BIT;
+        }
+    }
+
+    return corner;
 }
 
-static void ParseFaceCalculateNormals( OUT_PARAM std::vector<VertexMaster>& vertexes,
-                                       const Strings& line,
-                                       const std::vector<Vec3>& objVertexes,
-                                       const std::vector<Vec2>& objUvs,
-                                       const MeshLoadOptions& meshLoadOptions )
+//-----------------------------------------------------------------------------
+// Parsing
+static void ParseChunk( ObjChunk& chunk )
 {
-    Strings pointOneSplit = SplitStringOnDelimiter( line[ 1 ], '/' );
-    VertexMaster pointOne = MakeVertexMasterFromFaceSplit( pointOneSplit, objVertexes, objUvs, 
-                                                           meshLoadOptions );
+    const size_t estimatedLines = ( chunk.end - chunk.begin ) / OBJ_ESTIMATED_BYTES_PER_LINE;
+    chunk.positions.reserve( estimatedLines / 4 );
+    chunk.corners.reserve( estimatedLines );
+    chunk.faceCornerCounts.reserve( estimatedLines / 2 );
 
-    Vec3 normal = Vec3::ONE;
-    bool firstRun = true;
-    for ( size_t index = 2; index < line.size() - 1; ++index )
+    const char* lineStart = chunk.begin;
+    while( lineStart < chunk.end )
     {
-        Strings pointTwoSplit = SplitStringOnDelimiter( line[ index ], '/' );
-        Strings pointThreeSplit = SplitStringOnDelimiter( line[ index + 1 ], '/' );
-
-        VertexMaster pointTwo = MakeVertexMasterFromFaceSplit( pointTwoSplit, objVertexes, objUvs,
-                                                               meshLoadOptions );
-        VertexMaster pointThree = MakeVertexMasterFromFaceSplit( pointThreeSplit, objVertexes, objUvs, 
-                                                                 meshLoadOptions );
-
-        if( firstRun )
+        const char* lineEnd = static_cast<const char*>( std::memchr( lineStart, '\n',
+                                                                     chunk.end - lineStart ) );
+        if( lineEnd == nullptr )
         {
-            // Calculate normal for this face
-            const Vec3 pointOneToTwo = pointTwo.position - pointOne.position;
-            const Vec3 pointOneToThree = pointThree.position - pointOne.position;
-            normal = pointOneToTwo.GetCross( pointOneToThree ).GetNormalized();
+            lineEnd = chunk.end;
         }
 
-        // Push back the cornerstone point
-        pointOne.normal = normal;
-        vertexes.push_back( pointOne );
+        const char* cursor = lineStart;
+        lineStart = lineEnd + 1;
 
-        // Always push back the third point
-        pointTwo.normal = normal;
-        pointThree.normal = normal;
-
-        // Flip the winding order if requested
-        if( meshLoadOptions.flipWindingOrder )
+        const std::string_view lineType = GetNextToken( cursor, lineEnd );
+        if( lineType == "v" )
         {
-            vertexes.push_back( pointThree );
-            vertexes.push_back( pointTwo );
+            chunk.positions.push_back( ParseVec3( cursor, lineEnd ) );
         }
-        else
+        else if( lineType == "vn" )
+        {
+            chunk.normals.push_back( ParseVec3( cursor, lineEnd ) );
+        }
+        else if( lineType == "vt" )
+        {
+            chunk.uvs.push_back( ParseVec2( cursor, lineEnd ) );
+        }
+        else if( lineType == "f" )
         {
-            vertexes.push_back( pointTwo );
-            vertexes.push_back( pointThree );
+            unsigned int cornerCount = 0;
+            for( std::string_view token = GetNextToken( cursor, lineEnd ); !token.empty();
+                 token = GetNextToken( cursor, lineEnd ) )
+            {
+                chunk.corners.push_back( ParseFaceCorner( token, chunk ) );
+                ++cornerCount;
+            }
+            chunk.faceCornerCounts.push_back( cornerCount );
         }
 
-        firstRun = false;
+        // Comments, mtllib, o, g, usemtl, s and blank lines are skipped
     }
 }
 
-static void ParseFaceGivenNormals( OUT_PARAM std::vector<VertexMaster>& vertexes,
-                                   const Strings& line,
-                                   const std::vector<Vec3>& objVertexes,
-                                   const std::vector<Vec3>& objNormals,
-                                   const std::vector<Vec2>& objUvs,
-                                   const MeshLoadOptions& meshLoadOptions )
+// Returns a zero based index into the whole file's attribute array
+static int ResolveIndex( const int index, const bool isRelative, const unsigned int chunkFirst,
+                         const size_t totalCount )
+{
+    const int resolved = isRelative ? index + static_cast<int>( chunkFirst ) : index;
+    GUARANTEE_OR_DIE( resolved >= 0 && static_cast<size_t>( resolved ) < totalCount,
+                      "ObjFileUtils - Face references an attribute that does not exist" );
+    return resolved;
+}
+
+static bool HasNormal( const ObjCorner& corner )
+{
+    return corner.normal >= 0 || corner.relativeBits & OBJ_RELATIVE_NORMAL_BIT;
+}
+
+static VertexMaster MakeVertexMaster( const ObjCorner& corner, const ObjChunk& chunk,
+                                      const std::vector<Vec3>& positions,
+                                      const std::vector<Vec3>& normals,
+                                      const std::vector<Vec2>& uvs,
+                                      const MeshLoadOptions& meshLoadOptions )
 {
-    Strings pointOneSplit = SplitStringOnDelimiter( line[ 1 ], '/' );
-    VertexMaster pointOne = MakeVertexMasterFromFaceSplit( pointOneSplit, objVertexes, objNormals,
-                                                           objUvs, meshLoadOptions );
+    VertexMaster vertex( Vec3::ZERO, Rgba8::WHITE, Vec2::ZERO, Vec3::ONE, Vec3::ONE, Vec3::ONE );
 
-    for ( size_t index = 2; index < line.size() - 1; ++index )
+    const int vertexIndex = ResolveIndex( corner.vertex,
+                                          corner.relativeBits & OBJ_RELATIVE_VERTEX_BIT,
+                                          chunk.firstPosition, positions.size() );
+    vertex.position = positions[ vertexIndex ];
+
+    if( corner.uv >= 0 || corner.relativeBits & OBJ_RELATIVE_UV_BIT )
     {
-        Strings pointTwoSplit = SplitStringOnDelimiter( line[ index ], '/' );
-        Strings pointThreeSplit = SplitStringOnDelimiter( line[ index + 1 ], '/' );
+        const int uvIndex = ResolveIndex( corner.uv, corner.relativeBits & OBJ_RELATIVE_UV_BIT,
+                                          chunk.firstUv, uvs.size() );
+        vertex.uv = uvs[ uvIndex ];
+        if( meshLoadOptions.invertV )
+        {
+            vertex.uv.y = 1 - vertex.uv.y;
+        }
+    }
 
-        VertexMaster pointTwo = MakeVertexMasterFromFaceSplit(
-            pointTwoSplit, objVertexes, objNormals, objUvs, meshLoadOptions );
-        VertexMaster pointThree = MakeVertexMasterFromFaceSplit(
-            pointThreeSplit, objVertexes, objNormals, objUvs, meshLoadOptions );
+    if( !meshLoadOptions.calculateNormals && HasNormal( corner ) )
+    {
+        const int normalIndex = ResolveIndex( corner.normal,
+                                              corner.relativeBits & OBJ_RELATIVE_NORMAL_BIT,
+                                              chunk.firstNormal, normals.size() );
+        vertex.normal = normals[ normalIndex ];
+    }
 
-        // Push back the cornerstone point
-        vertexes.push_back( pointOne );
+    return vertex;
+}
 
-        // Flit the winding order if requested
-        if ( meshLoadOptions.flipWindingOrder )
+// Fans each face from its first corner. Positions and normals are already transformed
+static void BuildChunkTriangles( const ObjChunk& chunk, const std::vector<Vec3>& positions,
+                                 const std::vector<Vec3>& normals, const std::vector<Vec2>& uvs,
+                                 const MeshLoadOptions& meshLoadOptions,
+                                 OUT_PARAM VertexMaster* vertexes )
+{
+    VertexMaster* output = vertexes + chunk.firstVertex;
+    const ObjCorner* faceCorners = chunk.corners.data();
+
+    for( const unsigned int cornerCount : chunk.faceCornerCounts )
+    {
+        const ObjCorner* corners = faceCorners;
+        faceCorners += cornerCount;
+        if( cornerCount < 3 ) { continue; }
+
+        // Faces without normals get a flat one even when the file's normals are used
+        const bool calculateNormal = meshLoadOptions.calculateNormals || !HasNormal( corners[ 0 ] );
+
+        VertexMaster pointOne = MakeVertexMaster( corners[ 0 ], chunk, positions, normals, uvs,
+                                                  meshLoadOptions );
+        for( unsigned int cornerIndex = 1; cornerIndex < cornerCount - 1; ++cornerIndex )
         {
-            vertexes.push_back( pointThree );
-            vertexes.push_back( pointTwo );
+            VertexMaster pointTwo = MakeVertexMaster( corners[ cornerIndex ], chunk, positions,
+                                                      normals, uvs, meshLoadOptions );
+            VertexMaster pointThree = MakeVertexMaster( corners[ cornerIndex + 1 ], chunk,
+                                                        positions, normals, uvs, meshLoadOptions );
+
+            // Every triangle of the face shares the normal of the first one
+            if( calculateNormal )
+            {
+                if( cornerIndex == 1 )
+                {
+                    const Vec3 pointOneToTwo = pointTwo.position - pointOne.position;
+                    const Vec3 pointOneToThree = pointThree.position - pointOne.position;
+                    pointOne.normal = pointOneToTwo.GetCross( pointOneToThree ).GetNormalized();
+                }
+                pointTwo.normal = pointOne.normal;
+                pointThree.normal = pointOne.normal;
+            }
+
+            *output++ = pointOne;
+
+            // Flip the winding order if requested
+            if( meshLoadOptions.flipWindingOrder )
+            {
+                *output++ = pointThree;
+                *output++ = pointTwo;
+            }
+            else
+            {
+                *output++ = pointTwo;
+                *output++ = pointThree;
+            }
         }
-        else
+    }
+}
+
+static size_t GetChunkVertexCount( const ObjChunk& chunk )
+{
+    size_t vertexCount = 0;
+    for( const unsigned int cornerCount : chunk.faceCornerCounts )
+    {
+        if( cornerCount >= 3 )
         {
-            vertexes.push_back( pointTwo );
-            vertexes.push_back( pointThree );
+            vertexCount += ( cornerCount - 2 ) * 3;
         }
     }
+    return vertexCount;
 }
 
-static void ParseFace( OUT_PARAM std::vector<VertexMaster>& vertexes, const Strings& line,
-                       const std::vector<Vec3>& objVertexes, const std::vector<Vec3>& objNormals,
-                       const std::vector<Vec2>& objUvs,
-                       const MeshLoadOptions& meshLoadOptions )
+static void SplitIntoChunks( const char* objData, const size_t objDataSize,
+                             const unsigned int chunkCount, OUT_PARAM std::vector<ObjChunk>& chunks )
 {
+    chunks.resize( chunkCount );
 
-    if ( meshLoadOptions.calculateNormals )
+    const char* dataEnd = objData + objDataSize;
+    const char* chunkBegin = objData;
+    for( unsigned int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex )
     {
-        ParseFaceCalculateNormals( vertexes, line, objVertexes, objUvs, meshLoadOptions );
+        const char* chunkEnd = dataEnd;
+        if( chunkIndex + 1 < chunkCount )
+        {
+            // Split after the newline following the even split point so no line is cut
+            chunkEnd = objData + ( objDataSize / chunkCount ) * ( chunkIndex + 1 );
+            chunkEnd = chunkEnd < chunkBegin ? chunkBegin : chunkEnd;
+            const void* newLine = std::memchr( chunkEnd, '\n', dataEnd - chunkEnd );
+            chunkEnd = newLine == nullptr ? dataEnd : static_cast<const char*>( newLine ) + 1;
+        }
+
+        chunks[ chunkIndex ].begin = chunkBegin;
+        chunks[ chunkIndex ].end = chunkEnd;
+        chunkBegin = chunkEnd;
     }
-    else
+}
+
+static void GatherAttributes( const ObjChunk& chunk, const MeshLoadOptions& meshLoadOptions,
+                              OUT_PARAM std::vector<Vec3>& positions,
+                              OUT_PARAM std::vector<Vec3>& normals,
+                              OUT_PARAM std::vector<Vec2>& uvs )
+{
+    Vec3* chunkPositions = positions.data() + chunk.firstPosition;
+    for( const Vec3& position : chunk.positions )
     {
-        ParseFaceGivenNormals( vertexes, line, objVertexes, objNormals, objUvs,
-                               meshLoadOptions );
+        *chunkPositions++ = meshLoadOptions.transform.TransformPosition( position );
     }
+
+    if( !meshLoadOptions.calculateNormals )
+    {
+        Vec3* chunkNormals = normals.data() + chunk.firstNormal;
+        for( const Vec3& normal : chunk.normals )
+        {
+            *chunkNormals++ = meshLoadOptions.transform.TransformVector( normal ).GetNormalized();
+        }
+    }
+
+    std::copy( chunk.uvs.begin(), chunk.uvs.end(), uvs.begin() + chunk.firstUv );
 }
 
-static void ParseObjFile( const Strings& objFile, OUT_PARAM std::vector<VertexMaster>& vertexes,
-                          OUT_PARAM std::vector<unsigned int>& indexes,
-                          const MeshLoadOptions& meshLoadOptions )
+void ParseObjBuffer( const char* objData, const size_t objDataSize,
+                     OUT_PARAM std::vector<VertexMaster>& vertexes,
+                     OUT_PARAM std::vector<unsigned int>& indexes,
+                     const MeshLoadOptions& meshLoadOptions )
 {
-    std::vector<Vec3> objVertexes;
-    std::vector<Vec3> objNormals;
-    std::vector<Vec2> objUvs;
+    JobSystem& jobSystem = JobSystem::INSTANCE();
 
-    for ( const std::string& fileLine : objFile )
+    unsigned int chunkCount = 1;
+    if( meshLoadOptions.parseInParallel )
     {
-        if ( IsComment( fileLine ) ) { continue; }
-
-        Strings splitLine = SplitStringOnDelimiter( fileLine, ' ' );
-        const ObjLineType type = GetLineType( splitLine[ 0 ] );
+        const size_t maxChunks = objDataSize / OBJ_MIN_PARALLEL_CHUNK_BYTES;
+        chunkCount = static_cast<unsigned int>( std::min<size_t>( jobSystem.GetNumWorkerThreads() + 1,
+                                                                  maxChunks ) );
+        chunkCount = chunkCount == 0 ? 1 : chunkCount;
+    }
 
-        switch ( type )
+    // Read each chunk into its own attribute and face arrays
+    std::vector<ObjChunk> chunks;
+    SplitIntoChunks( objData, objDataSize, chunkCount, chunks );
+    const auto forEachChunk = [&]( const std::function<void( ObjChunk& )>& function )
+    {
+        if( chunkCount == 1 )
         {
-        case ObjLineType::VERTEX:
-            ParseVec3( splitLine, objVertexes );
-            break;
-        case ObjLineType::NORMAL:
-            ParseVec3( splitLine, objNormals );
-            break;
-        case ObjLineType::TEXTURE:
-            ParseVec2( splitLine, objUvs );
-            break;
-        case ObjLineType::FACE:
-            ParseFace( vertexes, splitLine, objVertexes, objNormals, objUvs, 
-                       meshLoadOptions );
-            break;
-
-        case ObjLineType::SKIP: // Explicit Fallthrough
-        default:
-            break;
+            function( chunks[ 0 ] );
+            return;
         }
+
+        jobSystem.ParallelFor( chunkCount, 1,
+                               [&]( const unsigned int startIndex, const unsigned int endIndex )
+                               {
+                                   for( unsigned int index = startIndex; index < endIndex; ++index )
+                                   {
+                                       function( chunks[ index ] );
+                                   }
+                               } );
+    };
+    forEachChunk( ParseChunk );
+
+    // Place each chunk in the whole file's arrays
+    size_t positionCount = 0;
+    size_t normalCount = 0;
+    size_t uvCount = 0;
+    size_t vertexCount = 0;
+    for( ObjChunk& chunk : chunks )
+    {
+        chunk.firstPosition = static_cast<unsigned int>( positionCount );
+        chunk.firstNormal = static_cast<unsigned int>( normalCount );
+        chunk.firstUv = static_cast<unsigned int>( uvCount );
+        chunk.firstVertex = vertexes.size() + vertexCount;
+
+        positionCount += chunk.positions.size();
+        normalCount += chunk.normals.size();
+        uvCount += chunk.uvs.size();
+        vertexCount += GetChunkVertexCount( chunk );
     }
 
+    // Transforming each attribute once instead of once per face corner gives the same results
+    std::vector<Vec3> positions( positionCount );
+    std::vector<Vec3> normals( meshLoadOptions.calculateNormals ? 0 : normalCount );
+    std::vector<Vec2> uvs( uvCount );
+    forEachChunk( [&]( ObjChunk& chunk )
+    {
+        GatherAttributes( chunk, meshLoadOptions, positions, normals, uvs );
+    } );
+
+    vertexes.resize( vertexes.size() + vertexCount );
+    forEachChunk( [&]( ObjChunk& chunk )
+    {
+        BuildChunkTriangles( chunk, positions, normals, uvs, meshLoadOptions, vertexes.data() );
+    } );
+
     if( meshLoadOptions.calculateTangents )
     {
-        MikkTangentCalculation( vertexes );
+        if( meshLoadOptions.approximateTangents )
+        {
+            ApproximateTangentCalculation( vertexes );
+        }
+        else
+        {
+            MikkTangentCalculation( vertexes );
+        }
     }
 
-
     if( meshLoadOptions.clean )
     {
         CleanMesh( vertexes, indexes );
+        if( meshLoadOptions.optimizeVertexCache )
+        {
+            OptimizeVertexCache( indexes, vertexes.size() );
+        }
     }
     else
     {
@@ -283,8 +488,15 @@ void LoadFromObjFile( const std::string& fileName, OUT_PARAM std::vector<VertexM
                       OUT_PARAM std::vector<unsigned int>& indexes,
                       const MeshLoadOptions& meshLoadOptions )
 {
-    Strings file;
-    FileReadToVector( fileName, file );
+    const MappedFile objFile( fileName );
+    GUARANTEE_OR_DIE( objFile.IsOpen(), Stringf( "ObjFileUtils - Failed to open file %s", fileName.c_str() ) );
 
-    ParseObjFile( file, vertexes, indexes, meshLoadOptions );
+    ParseObjBuffer( objFile.GetView(), vertexes, indexes, meshLoadOptions );
+}
+
+void ParseObjBuffer( const BufferView& objData, OUT_PARAM std::vector<VertexMaster>& vertexes,
+                     OUT_PARAM std::vector<unsigned int>& indexes,
+                     const MeshLoadOptions& meshLoadOptions )
+{
+    ParseObjBuffer( objData.GetChars(), objData.size, vertexes, indexes, meshLoadOptions );
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Core/Math/Primatives/Mat44.hpp"
 #include "Engine/Core/VertexTypes/VertexMaster.hpp"
+#include "Engine/IO/FileUtils.hpp"
 
 struct MeshLoadOptions
 {
@@ -9,11 +10,35 @@ struct MeshLoadOptions
     bool invertV = false;
     bool calculateNormals = true;
     bool calculateTangents = true;
+    // Cheaper per vertex tangents for meshes that do not need to match MikkTSpace baked normal maps
+    bool approximateTangents = false;
 
     bool flipWindingOrder = false;
     bool clean = false;
+    // Reorder the cleaned triangles for the post transform vertex cache
+    bool optimizeVertexCache = true;
+
+    // Total LODs to generate, including the full mesh. Each targets lodReduction of the
+    //  previous LOD's triangles. Needs clean, unwelded triangles have no vertexes that can move
+    unsigned int lodCount = 1;
+    float lodReduction = .5f;
+
+    // Split large files at line boundaries and parse the pieces on the JobSystem
+    bool parseInParallel = true;
+
+    // GPUMesh::CreateFromFile loads the cooked binary next to the OBJ when it was built from the same
+    //  file and options, and writes one after parsing when it was not
+    bool useCookedMesh = true;
 };
 
 void LoadFromObjFile( const std::string& fileName, std::vector<VertexMaster>& vertexes, 
                       std::vector<unsigned int>& indexes, 
                       const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
+
+// Parses OBJ text already in memory, the buffer does not need to be null terminated
+void ParseObjBuffer( const char* objData, size_t objDataSize, std::vector<VertexMaster>& vertexes,
+                     std::vector<unsigned int>& indexes,
+                     const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
+void ParseObjBuffer( const BufferView& objData, std::vector<VertexMaster>& vertexes,
+                     std::vector<unsigned int>& indexes,
+                     const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
@@ -0,0 +1,326 @@
+#include "PackFile.hpp"
+
+#include "Engine/IO/BlockCompression.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+constexpr char PACK_FILE_MAGIC[ 4 ] = { 'S', 'D', 'P', 'K' };
+constexpr size_t PACK_DATA_ALIGNMENT = 16;
+
+struct PackFileHeader
+{
+    char magic[ 4 ] = { PACK_FILE_MAGIC[ 0 ], PACK_FILE_MAGIC[ 1 ], PACK_FILE_MAGIC[ 2 ], PACK_FILE_MAGIC[ 3 ] };
+    unsigned int version = PACK_FILE_VERSION;
+    unsigned int entryCount = 0;
+    unsigned int entrySize = sizeof( PackEntry );
+    unsigned long long entriesOffset = 0;
+    unsigned long long namesOffset = 0;
+    unsigned long long namesSize = 0;
+    unsigned long long fileSize = 0;
+};
+
+static size_t AlignPackOffset( const size_t offset )
+{
+    return ( offset + PACK_DATA_ALIGNMENT - 1 ) & ~( PACK_DATA_ALIGNMENT - 1 );
+}
+
+static char ToLowerAscii( const char character )
+{
+    return character >= 'A' && character <= 'Z' ? static_cast<char>( character - 'A' + 'a' ) : character;
+}
+
+// '*' is any run of characters and '?' any one character, case is ignored like the Windows listing
+static bool DoesFileNameMatchPattern( const char* fileName, const char* pattern )
+{
+    const char* starPattern = nullptr;
+    const char* starFileName = nullptr;
+    while( *fileName != '\0' )
+    {
+        if( *pattern == '*' )
+        {
+            starPattern = ++pattern;
+            starFileName = fileName;
+        }
+        else if( *pattern == '?' || ToLowerAscii( *pattern ) == ToLowerAscii( *fileName ) )
+        {
+            ++pattern;
+            ++fileName;
+        }
+        else if( starPattern != nullptr )
+        {
+            pattern = starPattern;
+            fileName = ++starFileName;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while( *pattern == '*' ) { ++pattern; }
+    return *pattern == '\0';
+}
+
+//-----------------------------------------------------------------------------
+std::string NormalizePackPath( const std::string& filePath )
+{
+    std::string normalized;
+    normalized.reserve( filePath.size() );
+    for( const char character : filePath )
+    {
+        normalized.push_back( character == '\\' ? '/' : ToLowerAscii( character ) );
+    }
+
+    while( normalized.compare( 0, 2, "./" ) == 0 )
+    {
+        normalized.erase( 0, 2 );
+    }
+    return normalized;
+}
+
+unsigned long long GetPackPathHash( const std::string& filePath )
+{
+    const std::string normalized = NormalizePackPath( filePath );
+    return GetBufferHash( normalized.data(), normalized.size() );
+}
+
+bool WritePackFile( const std::string& packFileName, const Strings& fileNames, const bool compress )
+{
+    struct PendingEntry
+    {
+        PackEntry entry;
+        std::string name;
+        std::vector<unsigned char> storedData;
+    };
+
+    std::vector<PendingEntry> pendingEntries;
+    pendingEntries.reserve( fileNames.size() );
+
+    size_t namesSize = 0;
+    for( const std::string& fileName : fileNames )
+    {
+        // Straight from disk, a pack is never built out of another pack
+        MappedFile sourceFile;
+        if( !sourceFile.OpenFromDisk( fileName ) ) { return false; }
+
+        PendingEntry pending;
+        pending.name = fileName;
+        pending.entry.nameHash = GetPackPathHash( fileName );
+        pending.entry.size = sourceFile.GetSize();
+        pending.entry.nameOffset = static_cast<unsigned int>( namesSize );
+        pending.entry.nameLength = static_cast<unsigned int>( fileName.size() );
+        namesSize += fileName.size();
+
+        const BufferView source = sourceFile.GetView();
+        if( compress && !source.IsEmpty() )
+        {
+            pending.storedData.resize( GetCompressBlockBound( source.size ) );
+            const size_t compressedSize = CompressBlock( source.data, source.size, pending.storedData.data(),
+                                                         source.size - source.size / 8 );
+            if( compressedSize > 0 )
+            {
+                pending.storedData.resize( compressedSize );
+                pending.entry.flags |= PACK_ENTRY_COMPRESSED_BIT;
+            }
+        }
+        if( !pending.entry.IsCompressed() )
+        {
+            pending.storedData.assign( source.data, source.data + source.size );
+        }
+        pending.entry.storedSize = pending.storedData.size();
+
+        pendingEntries.push_back( std::move( pending ) );
+    }
+
+    std::sort( pendingEntries.begin(), pendingEntries.end(),
+               []( const PendingEntry& lhs, const PendingEntry& rhs )
+               {
+                   return lhs.entry.nameHash < rhs.entry.nameHash;
+               } );
+
+    // Two names for one file would make lookups depend on sort order
+    for( size_t entryIndex = 1; entryIndex < pendingEntries.size(); ++entryIndex )
+    {
+        const PendingEntry& previous = pendingEntries[ entryIndex - 1 ];
+        const PendingEntry& current = pendingEntries[ entryIndex ];
+        if( previous.entry.nameHash == current.entry.nameHash &&
+            NormalizePackPath( previous.name ) == NormalizePackPath( current.name ) )
+        {
+            return false;
+        }
+    }
+
+    PackFileHeader header;
+    header.entryCount = static_cast<unsigned int>( pendingEntries.size() );
+    header.entriesOffset = AlignPackOffset( sizeof( PackFileHeader ) );
+    header.namesOffset = header.entriesOffset + pendingEntries.size() * sizeof( PackEntry );
+    header.namesSize = namesSize;
+
+    size_t dataOffset = AlignPackOffset( static_cast<size_t>( header.namesOffset + namesSize ) );
+    for( PendingEntry& pending : pendingEntries )
+    {
+        pending.entry.dataOffset = dataOffset;
+        dataOffset = AlignPackOffset( dataOffset + pending.storedData.size() );
+    }
+    header.fileSize = dataOffset;
+
+    std::vector<unsigned char> packData( dataOffset, 0 );
+    memcpy( packData.data(), &header, sizeof( header ) );
+    for( size_t entryIndex = 0; entryIndex < pendingEntries.size(); ++entryIndex )
+    {
+        const PendingEntry& pending = pendingEntries[ entryIndex ];
+        memcpy( &packData[ header.entriesOffset + entryIndex * sizeof( PackEntry ) ], &pending.entry, sizeof( PackEntry ) );
+        memcpy( &packData[ header.namesOffset + pending.entry.nameOffset ], pending.name.data(), pending.name.size() );
+        if( !pending.storedData.empty() )
+        {
+            memcpy( &packData[ pending.entry.dataOffset ], pending.storedData.data(), pending.storedData.size() );
+        }
+    }
+
+    return FileWriteFromBuffer( packFileName, packData.data(), packData.size() );
+}
+
+//-----------------------------------------------------------------------------
+bool PackFile::Open( const std::string& packFileName )
+{
+    Close();
+
+    if( !m_File.OpenFromDisk( packFileName ) ) { return false; }
+
+    const BufferView packView = m_File.GetView();
+    PackFileHeader header;
+    if( packView.size < sizeof( header ) )
+    {
+        Close();
+        return false;
+    }
+    memcpy( &header, packView.data, sizeof( header ) );
+
+    const unsigned long long entriesEnd = header.entriesOffset +
+                                          static_cast<unsigned long long>( header.entryCount ) * sizeof( PackEntry );
+    if( memcmp( header.magic, PACK_FILE_MAGIC, sizeof( PACK_FILE_MAGIC ) ) != 0 ||
+        header.version != PACK_FILE_VERSION || header.entrySize != sizeof( PackEntry ) ||
+        header.fileSize != packView.size || header.entriesOffset % alignof( PackEntry ) != 0 ||
+        entriesEnd > header.namesOffset || header.namesOffset + header.namesSize > packView.size )
+    {
+        Close();
+        return false;
+    }
+
+    const PackEntry* entries = reinterpret_cast<const PackEntry*>( packView.data + header.entriesOffset );
+    for( unsigned int entryIndex = 0; entryIndex < header.entryCount; ++entryIndex )
+    {
+        const PackEntry& entry = entries[ entryIndex ];
+        const bool isSorted = entryIndex == 0 || entries[ entryIndex - 1 ].nameHash <= entry.nameHash;
+        if( !isSorted || entry.dataOffset > packView.size || entry.storedSize > packView.size - entry.dataOffset ||
+            static_cast<unsigned long long>( entry.nameOffset ) + entry.nameLength > header.namesSize ||
+            ( !entry.IsCompressed() && entry.storedSize != entry.size ) )
+        {
+            Close();
+            return false;
+        }
+    }
+
+    m_FileName = packFileName;
+    m_Entries = entries;
+    m_EntryCount = header.entryCount;
+    m_Names = packView.GetChars() + header.namesOffset;
+    m_NamesSize = static_cast<size_t>( header.namesSize );
+    return true;
+}
+
+void PackFile::Close()
+{
+    m_File.Close();
+    m_FileName.clear();
+    m_Entries = nullptr;
+    m_EntryCount = 0;
+    m_Names = nullptr;
+    m_NamesSize = 0;
+}
+
+const PackEntry* PackFile::FindEntry( const std::string& filePath ) const
+{
+    if( !IsOpen() ) { return nullptr; }
+
+    const std::string normalized = NormalizePackPath( filePath );
+    const unsigned long long nameHash = GetBufferHash( normalized.data(), normalized.size() );
+
+    const PackEntry* entriesEnd = m_Entries + m_EntryCount;
+    const PackEntry* entry = std::lower_bound( m_Entries, entriesEnd, nameHash,
+                                               []( const PackEntry& lhs, const unsigned long long hash )
+                                               {
+                                                   return lhs.nameHash < hash;
+                                               } );
+    for( ; entry != entriesEnd && entry->nameHash == nameHash; ++entry )
+    {
+        if( NormalizePackPath( GetEntryName( *entry ) ) == normalized )
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+std::string PackFile::GetEntryName( const PackEntry& entry ) const
+{
+    return std::string( m_Names + entry.nameOffset, entry.nameLength );
+}
+
+BufferView PackFile::GetStoredView( const PackEntry& entry ) const
+{
+    return m_File.GetView( static_cast<size_t>( entry.dataOffset ), static_cast<size_t>( entry.storedSize ) );
+}
+
+bool PackFile::ReadEntry( const PackEntry& entry, OUT_PARAM std::vector<unsigned char>& fileData ) const
+{
+    const BufferView storedView = GetStoredView( entry );
+    if( !entry.IsCompressed() )
+    {
+        fileData.assign( storedView.data, storedView.data + storedView.size );
+        return true;
+    }
+
+    fileData.resize( static_cast<size_t>( entry.size ) );
+    if( !DecompressBlock( storedView.data, storedView.size, fileData.data(), fileData.size() ) )
+    {
+        fileData.clear();
+        return false;
+    }
+    return true;
+}
+
+void PackFile::GetFileNamesInFolder( const std::string& folderPath, const std::string& filePattern,
+                                     OUT_PARAM Strings& fileNames ) const
+{
+    std::string folder = NormalizePackPath( folderPath );
+    if( !folder.empty() && folder.back() != '/' ) { folder += "/"; }
+    const std::string pattern = filePattern.empty() ? "*" : filePattern;
+
+    for( unsigned int entryIndex = 0; entryIndex < m_EntryCount; ++entryIndex )
+    {
+        const std::string entryName = GetEntryName( m_Entries[ entryIndex ] );
+        const std::string normalized = NormalizePackPath( entryName );
+        if( normalized.compare( 0, folder.size(), folder ) != 0 ) { continue; }
+
+        // Only files directly in the folder, the same as the disk listing
+        const size_t fileNameStart = folder.size();
+        if( normalized.find( '/', fileNameStart ) != std::string::npos ) { continue; }
+
+        const size_t separator = entryName.find_last_of( "/\\" );
+        const std::string fileName = separator == std::string::npos ? entryName : entryName.substr( separator + 1 );
+        if( !DoesFileNameMatchPattern( fileName.c_str(), pattern.c_str() ) ) { continue; }
+
+        const std::string normalizedFileName = NormalizePackPath( fileName );
+        const bool isListed = std::any_of( fileNames.begin(), fileNames.end(),
+                                           [&]( const std::string& listed )
+                                           {
+                                               return NormalizePackPath( listed ) == normalizedFileName;
+                                           } );
+        if( !isListed )
+        {
+            fileNames.push_back( fileName );
+        }
+    }
+}
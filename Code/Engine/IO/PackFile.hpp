@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Utils/StringUtils.hpp"
+#include "Engine/IO/FileUtils.hpp"
+
+#include <string>
+#include <vector>
+
+// Bump whenever the layout of a pack changes, old packs then fail to mount
+constexpr unsigned int PACK_FILE_VERSION = 1;
+
+// Pack lookups ignore case and take either slash, "Data\Shaders\Lit.hlsl" finds "data/shaders/lit.hlsl"
+std::string NormalizePackPath( const std::string& filePath );
+unsigned long long GetPackPathHash( const std::string& filePath );
+
+// Stores every file under the path it is given. With compress, entries that shrink by at least an
+//  eighth are stored compressed
+bool WritePackFile( const std::string& packFileName, const Strings& fileNames, bool compress = true );
+
+enum PackEntryFlags : unsigned int
+{
+    PACK_ENTRY_NONE_BIT = 0u,
+    PACK_ENTRY_COMPRESSED_BIT = BIT_FLAG<0>,
+};
+
+// Index entry, stored as is in the pack. The index is sorted by nameHash
+struct PackEntry
+{
+    unsigned long long nameHash = 0;
+    unsigned long long dataOffset = 0;
+    unsigned long long storedSize = 0;
+    unsigned long long size = 0;
+    unsigned int nameOffset = 0;
+    unsigned int nameLength = 0;
+    unsigned int flags = PACK_ENTRY_NONE_BIT;
+    unsigned int reserved = 0;
+
+    bool IsCompressed() const { return ( flags & PACK_ENTRY_COMPRESSED_BIT ) != 0; }
+};
+
+//-----------------------------------------------------------------------------
+// Read only archive. The whole pack is mapped once and lookups only touch the index
+class PackFile
+{
+public:
+    PackFile() = default;
+    ~PackFile() = default;
+
+    PackFile( const PackFile& copy ) = delete;
+    PackFile& operator=( const PackFile& copy ) = delete;
+
+    // Fails for missing, truncated or out of date packs
+    bool Open( const std::string& packFileName );
+    void Close();
+
+    bool IsOpen() const { return m_Entries != nullptr; }
+    const std::string& GetFileName() const { return m_FileName; }
+    unsigned int GetEntryCount() const { return m_EntryCount; }
+    const PackEntry* GetEntries() const { return m_Entries; }
+
+    const PackEntry* FindEntry( const std::string& filePath ) const;
+    // The path the entry was packed under
+    std::string GetEntryName( const PackEntry& entry ) const;
+
+    // Bytes as stored, which is the file itself for uncompressed entries
+    BufferView GetStoredView( const PackEntry& entry ) const;
+    bool ReadEntry( const PackEntry& entry, OUT_PARAM std::vector<unsigned char>& fileData ) const;
+
+    // Adds the entries directly inside folderPath whose names match filePattern ('*' and '?'), as
+    //  GetAllFilesNamesInFolder returns them. Names already in fileNames are skipped
+    void GetFileNamesInFolder( const std::string& folderPath, const std::string& filePattern,
+                               OUT_PARAM Strings& fileNames ) const;
+
+private:
+    MappedFile m_File;
+    std::string m_FileName;
+
+    const PackEntry* m_Entries = nullptr;
+    unsigned int m_EntryCount = 0;
+    const char* m_Names = nullptr;
+    size_t m_NamesSize = 0;
+};
@@ -39,7 +39,7 @@ bool DiscCollider2D::Contains( const Vec2& point ) const
 
 void DiscCollider2D::DebugRender( RenderContext* ctx, const Rgba8& borderColor, const Rgba8& fillColor ) const
 {
-    std::vector<VertexMaster> discVisual;
+    std::vector<Vertex_PCU> discVisual;
     Disc worldDisc = m_LocalDisc;
     worldDisc.center += m_WorldPosition;
     const Vec2 radiusLine = Vec2( m_LocalDisc.radius * cosf( m_Rigidbody->GetAngleRadians() ),
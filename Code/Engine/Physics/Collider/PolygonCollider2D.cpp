@@ -2,6 +2,7 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
+#include "Engine/Core/Math/PolygonUtils.hpp"
 #include "Engine/Core/Math/Primatives/LineSeg2D.hpp"
 #include "Engine/Physics/Collider/DiscCollider2D.hpp"
 #include "Engine/Physics/Rigidbody2D.hpp"
@@ -86,7 +87,7 @@ bool PolygonCollider2D::Contains( const Vec2& point ) const
 void PolygonCollider2D::DebugRender( RenderContext* ctx, const Rgba8& borderColor,
                                      const Rgba8& fillColor ) const
 {
-    std::vector<VertexMaster> polygonVisual;
+    std::vector<Vertex_PCU> polygonVisual;
 
     const std::vector<Vec2> m_WorldPoints = GetPoints();
 
@@ -99,7 +100,7 @@ void PolygonCollider2D::DebugRender( RenderContext* ctx, const Rgba8& borderColo
 
 float PolygonCollider2D::CalculateMoment( float mass ) const
 {
-    return mass * m_MasslessMoment;
+    return mass * m_Shape->masslessMoment;
 }
 
 Vec2 PolygonCollider2D::GetSupportPoint( const Vec2& direction ) const
@@ -108,7 +109,7 @@ Vec2 PolygonCollider2D::GetSupportPoint( const Vec2& direction ) const
     Vec2 furthestPoint;
     float furthestPointDot = 0.f;   // Don't need to worry about negatives
 
-    for( const Vec2& point: m_LocalPoints )
+    for( const Vec2& point: m_Shape->localPoints )
     {
         const Vec2 translated = localToWorld.TransformVector( point );
         const float dot = Vec2::Dot( direction, translated );
@@ -147,7 +148,7 @@ std::vector<Vec2> PolygonCollider2D::GetPoints() const
     Mat44 localToWorld = Mat44::CreateFromZRotationDegrees( m_Rigidbody->GetAngleDegrees() );
     localToWorld.SetTranslation( m_WorldPosition );
     std::vector<Vec2> points;
-    for ( const Vec2& point : m_LocalPoints )
+    for ( const Vec2& point : m_Shape->localPoints )
     {
         points.push_back( localToWorld.TransformPosition(point) );
     }
@@ -160,31 +161,36 @@ Disc PolygonCollider2D::GetWorldBounds() const
     Mat44 localToWorld = Mat44::CreateFromZRotationDegrees( m_Rigidbody->GetAngleDegrees() );
     localToWorld.SetTranslation( m_WorldPosition );
     Disc worldBounds;
-    worldBounds.center = localToWorld.TransformPosition(m_LocalBounds.center);
-    worldBounds.radius = m_LocalBounds.radius;
+    worldBounds.center = localToWorld.TransformPosition(m_Shape->localBounds.center);
+    worldBounds.radius = m_Shape->localBounds.radius;
     return worldBounds;
 }
 
-PolygonCollider2D::PolygonCollider2D( Physics2D* physicsWorld, const std::vector<Vec2>& points, bool isCloud )
+PolygonCollider2D::PolygonCollider2D( Physics2D* physicsWorld, const PolygonShape2D* shape )
     : Collider2D( physicsWorld )
+    , m_Shape( shape )
 {
     m_Type = COLLIDER_POLYGON;
+    m_WorldPosition = shape->centerOfMass;
+}
 
+STATIC void PolygonCollider2D::BuildShape( PolygonShape2D& shape, const std::vector<Vec2>& points, const bool isCloud )
+{
     if ( isCloud )
     {
-        BuildFromCloud( points );
+        BuildFromCloud( shape, points );
     }
     else
     {
-        BuildFromInOrder( points );
+        BuildFromInOrder( shape, points );
     }
 
-    FindCenterOfMassAndMoment();
-    LocalizePoints();
-    CalculateLocalBounds();
+    FindCenterOfMassAndMoment( shape );
+    LocalizePoints( shape );
+    CalculateLocalBounds( shape );
 }
 
-void PolygonCollider2D::BuildFromInOrder( const std::vector<Vec2>& points )
+STATIC void PolygonCollider2D::BuildFromInOrder( PolygonShape2D& shape, const std::vector<Vec2>& points )
 {
     Vec2 lastPoint;
     for ( size_t currentPointIndex = 0; currentPointIndex < points.size() - 1; ++currentPointIndex )
@@ -194,7 +200,7 @@ void PolygonCollider2D::BuildFromInOrder( const std::vector<Vec2>& points )
 
         if ( currentPointIndex == 0 )
         {
-            m_LocalPoints.push_back( startPoint );
+            shape.localPoints.push_back( startPoint );
         }
         else
         {
@@ -203,50 +209,19 @@ void PolygonCollider2D::BuildFromInOrder( const std::vector<Vec2>& points )
                 isValid,
                 "PolygonCollider2D: Points are not in counter-clockwise order. Failed to create polygon" );
         }
-        m_LocalPoints.push_back( endPoint );
+        shape.localPoints.push_back( endPoint );
         lastPoint = startPoint;
     }
 }
 
-void PolygonCollider2D::BuildFromCloud( const std::vector<Vec2>& points )
+STATIC void PolygonCollider2D::BuildFromCloud( PolygonShape2D& shape, const std::vector<Vec2>& points )
 {
-    // Gift Wrapping Algorithm
-    //  Find the left most point
-    Vec2 pointOnHull = points.at( 0 );
-    for ( const Vec2& testPoint : points )
-    {
-        if ( pointOnHull.x > testPoint.x )
-
-        {
-            pointOnHull = testPoint;
-        }
-    }
-
-    int currentConvexHullPoint = 0;
-    Vec2 endpoint = points.at( 0 );
-    do
-    {
-        m_LocalPoints.push_back( pointOnHull );
-
-        for ( const Vec2& nextPotentialEndpoint : points )
-        {
-            if ( endpoint == pointOnHull ||
-                PointOnNegativeSide(
-                    LineSeg2D( m_LocalPoints.at( currentConvexHullPoint ), endpoint ),
-                    nextPotentialEndpoint, true ) )
-            {
-                endpoint = nextPotentialEndpoint;
-            }
-        }
-        currentConvexHullPoint++;
-        pointOnHull = endpoint;
-    }
-    while ( endpoint != m_LocalPoints.at( 0 ) );
+    GetConvexHull2D( points, shape.localPoints );
 }
 
-void PolygonCollider2D::FindCenterOfMassAndMoment()
+STATIC void PolygonCollider2D::FindCenterOfMassAndMoment( PolygonShape2D& shape )
 {
-    const int triangleCount = static_cast<int>(m_LocalPoints.size()) - 2;
+    const int triangleCount = static_cast<int>(shape.localPoints.size()) - 2;
     GUARANTEE_OR_DIE( triangleCount > 0, "There must be one or more triangles" );
 
     float* triangleAreas = new float[ triangleCount ];
@@ -255,14 +230,14 @@ void PolygonCollider2D::FindCenterOfMassAndMoment()
     float totalArea = 0.f;
 
     constexpr float third = 1.f / 3.f;
-    const Vec2& zeroPoint = m_LocalPoints.at( 0 );
-    for ( size_t triangulationIndex = 1; triangulationIndex < m_LocalPoints.size() - 1; ++
+    const Vec2& zeroPoint = shape.localPoints.at( 0 );
+    for ( size_t triangulationIndex = 1; triangulationIndex < shape.localPoints.size() - 1; ++
           triangulationIndex )
     {
-        Vec2 u = m_LocalPoints.at( triangulationIndex );
-        Vec2 v = m_LocalPoints.at( triangulationIndex + 1 );
+        Vec2 u = shape.localPoints.at( triangulationIndex );
+        Vec2 v = shape.localPoints.at( triangulationIndex + 1 );
         const Vec2 triangleCenter = (zeroPoint + u + v) * third;
-        m_LocalTriangleCenters.push_back( triangleCenter );
+        shape.localTriangleCenters.push_back( triangleCenter );
         u = u - zeroPoint;
         v = v - zeroPoint;
 
@@ -279,51 +254,51 @@ void PolygonCollider2D::FindCenterOfMassAndMoment()
         triangleAreas[ triangulationIndex - 1 ] = area;
         triangleMoments[ triangulationIndex - 1 ] = moment;
 
-        m_WorldPosition += triangleCenter * area;
+        shape.centerOfMass += triangleCenter * area;
 
         totalArea += area;
     }
 
-    m_WorldPosition /= totalArea;
+    shape.centerOfMass /= totalArea;
 
-    for ( int triangleIndex = 0; triangleIndex < m_LocalTriangleCenters.size(); ++triangleIndex )
+    for ( int triangleIndex = 0; triangleIndex < shape.localTriangleCenters.size(); ++triangleIndex )
     {
         // Localizes the triangle centers
-        Vec2& triangleCenter = m_LocalTriangleCenters.at( triangleIndex );
-        triangleCenter -= m_WorldPosition;
+        Vec2& triangleCenter = shape.localTriangleCenters.at( triangleIndex );
+        triangleCenter -= shape.centerOfMass;
 
         // Calculate the moment based on area
         const float parrallelAxis = triangleAreas[ triangleIndex ] * Vec2::Dot( triangleCenter, triangleCenter );
-        m_MasslessMoment += triangleMoments[ triangleIndex ] + parrallelAxis;
+        shape.masslessMoment += triangleMoments[ triangleIndex ] + parrallelAxis;
     }
-    m_MasslessMoment /= totalArea;
+    shape.masslessMoment /= totalArea;
 
     delete[] triangleAreas;
     delete[] triangleMoments;
 }
 
-void PolygonCollider2D::LocalizePoints()
+STATIC void PolygonCollider2D::LocalizePoints( PolygonShape2D& shape )
 {
-    for( Vec2& localPoint : m_LocalPoints )
+    for( Vec2& localPoint : shape.localPoints )
     {
-        localPoint -= m_WorldPosition;
+        localPoint -= shape.centerOfMass;
     }
 }
 
-void PolygonCollider2D::CalculateLocalBounds()
+STATIC void PolygonCollider2D::CalculateLocalBounds( PolygonShape2D& shape )
 {
-    Disc smallestTightlyBound = Disc( m_LocalPoints.at( 0 ), m_LocalPoints.at( 1 ) );
+    Disc smallestTightlyBound = Disc( shape.localPoints.at( 0 ), shape.localPoints.at( 1 ) );
     bool isSmallestValid = false;
 
-    const size_t numberOfPoints = m_LocalPoints.size();
+    const size_t numberOfPoints = shape.localPoints.size();
     for ( size_t pointOneIndex = 0; pointOneIndex < numberOfPoints; ++pointOneIndex )
     {
-        const Vec2& pointOne = m_LocalPoints.at( pointOneIndex );
+        const Vec2& pointOne = shape.localPoints.at( pointOneIndex );
 
         for ( size_t pointTwoIndex = pointOneIndex + 1; pointTwoIndex < numberOfPoints; ++pointTwoIndex
         )
         {
-            const Vec2& pointTwo = m_LocalPoints.at( pointTwoIndex );
+            const Vec2& pointTwo = shape.localPoints.at( pointTwoIndex );
             Disc twoPointDisc( pointOne, pointTwo );
             bool isTwoPointDiscValid = true;
 
@@ -335,7 +310,7 @@ void PolygonCollider2D::CalculateLocalBounds()
                     continue;
                 }
 
-                const Vec2& pointFour = m_LocalPoints.at( pointFourIndex );
+                const Vec2& pointFour = shape.localPoints.at( pointFourIndex );
                 if ( !twoPointDisc.IsPointInside( pointFour ) )
                 {
                     isTwoPointDiscValid = false;
@@ -346,7 +321,7 @@ void PolygonCollider2D::CalculateLocalBounds()
             for ( size_t pointThreeIndex = pointTwoIndex + 1; pointThreeIndex < numberOfPoints; ++
                   pointThreeIndex )
             {
-                const Vec2& pointThree = m_LocalPoints.at( pointThreeIndex );
+                const Vec2& pointThree = shape.localPoints.at( pointThreeIndex );
                 Disc threePointDisc( pointOne, pointTwo, pointThree );
                 bool isThreePointDiscValid = true;
 
@@ -364,7 +339,7 @@ void PolygonCollider2D::CalculateLocalBounds()
                     {
                         continue;
                     }
-                    const Vec2& pointFour = m_LocalPoints.at( pointFourIndex );
+                    const Vec2& pointFour = shape.localPoints.at( pointFourIndex );
                     if ( !threePointDisc.IsPointInside( pointFour ) )
                     {
                         isThreePointDiscValid = false;
@@ -402,7 +377,7 @@ void PolygonCollider2D::CalculateLocalBounds()
         }
     }
 
-    m_LocalBounds = smallestTightlyBound;
+    shape.localBounds = smallestTightlyBound;
 }
 
 STATIC bool PolygonCollider2D::PointOnNegativeSide( const LineSeg2D& lineSeg, const Vec2& testPoint,
@@ -430,11 +405,11 @@ STATIC bool PolygonCollider2D::PointOnNegativeSide( const LineSeg2D& lineSeg, co
 
 Vec2 PolygonCollider2D::GetDirectionMostPoint( int direction ) const
 {
-    Vec2 directionMostPoint = m_LocalPoints.at( 0 );
+    Vec2 directionMostPoint = m_Shape->localPoints.at( 0 );
 
     if( direction == 0 ) // Test right most
     {
-        for ( const Vec2& testPoint : m_LocalPoints )
+        for ( const Vec2& testPoint : m_Shape->localPoints )
         {
             if (directionMostPoint.x < testPoint.x ) 
             {
@@ -445,7 +420,7 @@ Vec2 PolygonCollider2D::GetDirectionMostPoint( int direction ) const
     }
     else if ( direction == 1 ) // Test top most
     {
-        for ( const Vec2& testPoint : m_LocalPoints )
+        for ( const Vec2& testPoint : m_Shape->localPoints )
         {
             if ( directionMostPoint.y < testPoint.y ) 
             {
@@ -455,7 +430,7 @@ Vec2 PolygonCollider2D::GetDirectionMostPoint( int direction ) const
     }
     else if ( direction == 2 ) // Test left most
     {
-        for ( const Vec2& testPoint : m_LocalPoints )
+        for ( const Vec2& testPoint : m_Shape->localPoints )
         {
             if ( directionMostPoint.x > testPoint.x ) 
             {
@@ -465,7 +440,7 @@ Vec2 PolygonCollider2D::GetDirectionMostPoint( int direction ) const
     }
     else if ( direction == 3 ) // Test bottom most
     {
-        for ( const Vec2& testPoint : m_LocalPoints )
+        for ( const Vec2& testPoint : m_Shape->localPoints )
         {
             if ( directionMostPoint.y > testPoint.y ) 
             {
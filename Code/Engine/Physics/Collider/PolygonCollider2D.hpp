@@ -9,6 +9,24 @@
 // Engine Predefines
 struct LineSeg2D;
 
+//-----------------------------------------------------------------------------
+// The part of a polygon collider that does not depend on where it is. Physics2D builds one per
+//  distinct point list and every collider made from those points shares it
+struct PolygonShape2D
+{
+    std::vector<Vec2> localPoints;
+    std::vector<Vec2> localTriangleCenters;
+    Disc localBounds;
+    Vec2 centerOfMass;      // Local points are relative to this
+    float masslessMoment = 0.f;
+
+    // What the shape was built from, to tell apart point lists with the same hash
+    std::vector<Vec2> sourcePoints;
+    unsigned int sourceHash = 0;
+    bool isCloud = true;
+    int referenceCount = 0;
+};
+
 class PolygonCollider2D: public Collider2D
 {
     friend class Physics2D;
@@ -30,14 +48,13 @@ public:
     std::vector<Vec2> GetPoints() const override;
     Disc GetWorldBounds() const override;
 
-    std::vector<Vec2> m_LocalTriangleCenters;
+    const std::vector<Vec2>& GetLocalTriangleCenters() const { return m_Shape->localTriangleCenters; }
+
 private:
-    std::vector<float> m_TriangleMoments; 
-    std::vector<Vec2> m_LocalPoints;
-    Disc m_LocalBounds;
-    float m_MasslessMoment = 0.f;
+    const PolygonShape2D* m_Shape = nullptr;
 
-    PolygonCollider2D( Physics2D* physicsWorld, const std::vector<Vec2>& points, bool isCloud = true );
+    // Shapes come from Physics2D::AcquirePolygonShape
+    PolygonCollider2D( Physics2D* physicsWorld, const PolygonShape2D* shape );
 
     // Clarification on `isPositiveProjectionNegative`
     //  Should points further from the start then the end of the LineSeg be classified as 
@@ -45,11 +62,12 @@ private:
     static bool PointOnNegativeSide( const LineSeg2D& lineSeg, const Vec2& testPoint,
                                      bool isPositiveProjectionNegative = false );
 
-    void BuildFromInOrder( const std::vector<Vec2>& points );
-    void BuildFromCloud( const std::vector<Vec2>& points );
-    void FindCenterOfMassAndMoment();
-    void LocalizePoints();
-    void CalculateLocalBounds();
+    static void BuildShape( PolygonShape2D& shape, const std::vector<Vec2>& points, bool isCloud );
+    static void BuildFromInOrder( PolygonShape2D& shape, const std::vector<Vec2>& points );
+    static void BuildFromCloud( PolygonShape2D& shape, const std::vector<Vec2>& points );
+    static void FindCenterOfMassAndMoment( PolygonShape2D& shape );
+    static void LocalizePoints( PolygonShape2D& shape );
+    static void CalculateLocalBounds( PolygonShape2D& shape );
 
     Vec2 GetDirectionMostPoint( int direction ) const;
 };
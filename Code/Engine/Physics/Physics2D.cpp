@@ -10,6 +10,9 @@
 #include "Engine/Physics/Collider/PolygonCollider2D.hpp"
 
 #include <cmath>
+#include <cstring>
+#include "Engine/Core/Math/PolygonUtils.hpp"
+#include "Engine/Core/Math/Noise/RawNoise.hpp"
 #include "Engine/Core/Time/Clock.hpp"
 #include "Engine/Renderer/DebugRenderer.hpp"
 
@@ -171,11 +174,27 @@ DiscCollider2D* Physics2D::CreateDiscCollider( const Disc& localDisc )
 
 PolygonCollider2D* Physics2D::CreatePolygonCollider( const std::vector<Vec2>& points, bool isCloud )
 {
-    PolygonCollider2D* collider = new PolygonCollider2D(this, points, isCloud );
+    PolygonCollider2D* collider = new PolygonCollider2D(this, AcquirePolygonShape( points, isCloud ) );
     m_Colliders.push_back( collider );
     return collider;
 }
 
+void Physics2D::CreateCompoundPolygonCollider( const std::vector<Vec2>& outline,
+                                               OUT_PARAM std::vector<PolygonCollider2D*>& pieces,
+                                               const float concavityToleranceDegrees )
+{
+    std::vector<std::vector<Vec2>> convexPieces;
+    DecomposeIntoConvexPolygons2D( outline, convexPieces, concavityToleranceDegrees );
+
+    // Pieces past the tolerance are a little concave, building them as clouds takes their hulls
+    pieces.clear();
+    pieces.reserve( convexPieces.size() );
+    for( const std::vector<Vec2>& convexPiece : convexPieces )
+    {
+        pieces.push_back( CreatePolygonCollider( convexPiece, true ) );
+    }
+}
+
 void Physics2D::DestroyCollider( Collider2D* collider )
 {
     if ( collider == nullptr ) { return; }
@@ -585,9 +604,70 @@ void Physics2D::DestroyRequestedCollider2Ds()
         {
             if ( currCollider->m_DestroyRequested )
             {
+                if ( currCollider->m_Type == COLLIDER_POLYGON )
+                {
+                    ReleasePolygonShape( static_cast<PolygonCollider2D*>( currCollider )->m_Shape );
+                }
                 delete *currPosition;
                 *currPosition = nullptr;
             }
         }
     }
 }
+
+const PolygonShape2D* Physics2D::AcquirePolygonShape( const std::vector<Vec2>& points, const bool isCloud )
+{
+    unsigned int hash = RawNoise::GetNoiseUint( static_cast<int>( points.size() ), isCloud ? 1u : 0u );
+    for( const Vec2& point : points )
+    {
+        int bitsX;
+        int bitsY;
+        memcpy( &bitsX, &point.x, sizeof( int ) );
+        memcpy( &bitsY, &point.y, sizeof( int ) );
+        hash = RawNoise::GetNoiseUint( bitsX, bitsY, hash );
+    }
+
+    std::vector<PolygonShape2D*>& bucket = m_PolygonShapes[ hash ];
+    for( PolygonShape2D* shape : bucket )
+    {
+        if( shape->isCloud == isCloud && shape->sourcePoints == points )
+        {
+            ++shape->referenceCount;
+            return shape;
+        }
+    }
+
+    PolygonShape2D* shape = new PolygonShape2D();
+    PolygonCollider2D::BuildShape( *shape, points, isCloud );
+    shape->sourcePoints = points;
+    shape->sourceHash = hash;
+    shape->isCloud = isCloud;
+    shape->referenceCount = 1;
+    bucket.push_back( shape );
+    return shape;
+}
+
+void Physics2D::ReleasePolygonShape( const PolygonShape2D* shape )
+{
+    if( shape == nullptr ) { return; }
+
+    const unsigned int hash = shape->sourceHash;
+    std::vector<PolygonShape2D*>& bucket = m_PolygonShapes[ hash ];
+    for( size_t shapeIndex = 0; shapeIndex < bucket.size(); ++shapeIndex )
+    {
+        PolygonShape2D* cachedShape = bucket[ shapeIndex ];
+        if( cachedShape == shape )
+        {
+            if( --cachedShape->referenceCount == 0 )
+            {
+                delete cachedShape;
+                bucket.erase( bucket.begin() + shapeIndex );
+                if( bucket.empty() )
+                {
+                    m_PolygonShapes.erase( hash );
+                }
+            }
+            return;
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <vector>
 #include "Engine/Core/Math/Primatives/IntVec2.hpp"
 
@@ -15,6 +16,7 @@ class Rigidbody2D;
 class Collider2D;
 class DiscCollider2D;
 class PolygonCollider2D;
+struct PolygonShape2D;
 
 struct CollisionIdentifier
 {
@@ -44,7 +46,14 @@ public:
     void DestroyRigidbody( Rigidbody2D* rb );
 
     DiscCollider2D* CreateDiscCollider( const Disc& localDisc );
+    // Colliders made from the same points share one shape, so only the first pays for the hull
     PolygonCollider2D* CreatePolygonCollider( const std::vector<Vec2>& points, bool isCloud = true );
+    // One convex collider per piece of a concave outline, see DecomposeIntoConvexPolygons2D.
+    //  A rigidbody holds a single collider, so give every piece its own rigidbody placed at the
+    //  piece's GetWorldPosition to keep it where the outline put it
+    void CreateCompoundPolygonCollider( const std::vector<Vec2>& outline,
+                                        OUT_PARAM std::vector<PolygonCollider2D*>& pieces,
+                                        float concavityToleranceDegrees = 0.f );
     void DestroyCollider( Collider2D* collider );
 
     void EnableLayerInteraction( unsigned int layer1, unsigned int layer2 );
@@ -61,6 +70,10 @@ private:
     std::vector<Collision2D> m_StepCollisions;
     std::vector<Collision2D> m_LastFrameCollisions;
 
+    // Polygon shapes by the hash of the points they were built from. Freed by the last collider
+    //  using them
+    std::map<unsigned int, std::vector<PolygonShape2D*>> m_PolygonShapes;
+
     unsigned int m_StepIndex = 0;
     std::vector<CollisionIdentifier> m_LastStepCollisions;
 
@@ -85,4 +98,7 @@ private:
 
     void DestroyRequestedRigidBodies();
     void DestroyRequestedCollider2Ds();
+
+    const PolygonShape2D* AcquirePolygonShape( const std::vector<Vec2>& points, bool isCloud );
+    void ReleasePolygonShape( const PolygonShape2D* shape );
 };
\ No newline at end of file
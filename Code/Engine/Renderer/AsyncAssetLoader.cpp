@@ -0,0 +1,480 @@
+#include "AsyncAssetLoader.hpp"
+
+#include "Engine/Console/Console.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Event/JobSystem.hpp"
+#include "Engine/IO/CookedMeshUtils.hpp"
+#include "Engine/Renderer/Fonts/BitmapFont.hpp"
+#include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Shaders/ShaderProgram.hpp"
+#include "Engine/Renderer/Texture.hpp"
+
+//-----------------------------------------------------------------------------
+void AsyncAssetJob::Execute()
+{
+    m_IsDecoded = Decode();
+}
+
+// Worker thread, last touch of the job before the loader takes it back
+void AsyncAssetJob::Callback()
+{
+    m_IsFinished = true;
+}
+
+void AsyncAssetJob::Complete()
+{
+    if( m_IsDecoded && !m_Loader->IsShuttingDown() )
+    {
+        Upload( m_Loader->GetRenderContext() );
+    }
+    else
+    {
+        Discard();
+    }
+}
+
+//-----------------------------------------------------------------------------
+class AsyncTextureJob : public AsyncAssetJob
+{
+public:
+    AsyncTextureJob( AsyncAssetLoader* loader, AsyncAsset<Texture>* handle, const bool flipV )
+        : AsyncAssetJob( loader )
+          , m_Handle( handle )
+          , m_FlipV( flipV )
+    {
+    }
+
+    bool Decode() override
+    {
+        if( !Image::DecodeFromFile( m_Handle->GetFilePath(), m_FlipV, m_Size, m_Texels ) )
+        {
+            return false;
+        }
+
+        AsyncAssetLoader::MarkDecoded( *m_Handle );
+        return true;
+    }
+
+    void Upload( RenderContext* context ) override
+    {
+        Texture* texture = Texture::CreateFromColorArray( context, m_Texels.data(), m_Size );
+        AsyncAssetLoader::MarkReady( *m_Handle, m_Loader->AddLoadedTexture( m_Handle->GetFilePath(), texture ) );
+    }
+
+    void Discard() override
+    {
+        if( m_Loader->IsShuttingDown() )
+        {
+            AsyncAssetLoader::MarkFailed( *m_Handle );
+            return;
+        }
+
+#if !defined(ENGINE_DISABLE_CONSOLE)
+        g_Console->Log( LOG_ERROR, Stringf( "AsyncAssetLoader - Failed to load %s. Using builtin error texture", m_Handle->GetFilePath().c_str() ) );
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+
+        Texture* errorTexture = m_Loader->GetErrorTexture();
+        AsyncAssetLoader::MarkReady( *m_Handle, m_Loader->AddLoadedTexture( m_Handle->GetFilePath(), errorTexture ) );
+    }
+
+private:
+    AsyncAsset<Texture>* m_Handle = nullptr;
+    bool m_FlipV = false;
+
+    IntVec2 m_Size;
+    std::vector<Rgba8> m_Texels;
+};
+
+//-----------------------------------------------------------------------------
+class AsyncShaderProgramJob : public AsyncAssetJob
+{
+public:
+    AsyncShaderProgramJob( AsyncAssetLoader* loader, AsyncAsset<ShaderProgram>* handle )
+        : AsyncAssetJob( loader )
+          , m_Handle( handle )
+          , m_ShaderProgram( new ShaderProgram( loader->GetRenderContext() ) )
+    {
+    }
+
+    ~AsyncShaderProgramJob()
+    {
+        delete m_ShaderProgram;
+        m_ShaderProgram = nullptr;
+    }
+
+    bool Decode() override
+    {
+        if( !m_ShaderProgram->CompileFromFile( m_Handle->GetFilePath() ) )
+        {
+            return false;
+        }
+
+        AsyncAssetLoader::MarkDecoded( *m_Handle );
+        return true;
+    }
+
+    void Upload( RenderContext* context ) override
+    {
+        UNUSED( context );
+        m_ShaderProgram->CreateFromByteCode();
+
+        ShaderProgram* shaderProgram = m_ShaderProgram;
+        m_ShaderProgram = nullptr;
+        AsyncAssetLoader::MarkReady( *m_Handle, m_Loader->AddLoadedShaderProgram( m_Handle->GetFilePath(), shaderProgram ) );
+    }
+
+    void Discard() override
+    {
+#if !defined(ENGINE_DISABLE_CONSOLE)
+        if( !m_Loader->IsShuttingDown() )
+        {
+            g_Console->Log( LOG_ERROR, Stringf( "AsyncAssetLoader - Failed to load shader program %s", m_Handle->GetFilePath().c_str() ) );
+        }
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+
+        AsyncAssetLoader::MarkFailed( *m_Handle );
+    }
+
+private:
+    AsyncAsset<ShaderProgram>* m_Handle = nullptr;
+    ShaderProgram* m_ShaderProgram = nullptr;
+};
+
+//-----------------------------------------------------------------------------
+class AsyncMeshJob : public AsyncAssetJob
+{
+public:
+    AsyncMeshJob( AsyncAssetLoader* loader, AsyncAsset<GPUMesh>* handle, const MeshLoadOptions& meshLoadOptions )
+        : AsyncAssetJob( loader )
+          , m_Handle( handle )
+          , m_MeshLoadOptions( meshLoadOptions )
+    {
+    }
+
+    bool Decode() override
+    {
+        if( !LoadMeshDataFromFile( m_Handle->GetFilePath(), m_MeshLoadOptions, m_MeshData ) )
+        {
+            return false;
+        }
+
+        AsyncAssetLoader::MarkDecoded( *m_Handle );
+        return true;
+    }
+
+    void Upload( RenderContext* context ) override
+    {
+        AsyncAssetLoader::MarkReady( *m_Handle, GPUMesh::CreateFromMeshData( context, m_MeshData ) );
+    }
+
+    void Discard() override
+    {
+#if !defined(ENGINE_DISABLE_CONSOLE)
+        if( !m_Loader->IsShuttingDown() )
+        {
+            g_Console->Log( LOG_ERROR, Stringf( "AsyncAssetLoader - Failed to load mesh %s", m_Handle->GetFilePath().c_str() ) );
+        }
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+
+        AsyncAssetLoader::MarkFailed( *m_Handle );
+    }
+
+private:
+    AsyncAsset<GPUMesh>* m_Handle = nullptr;
+    MeshLoadOptions m_MeshLoadOptions;
+    MeshData m_MeshData;
+};
+
+//-----------------------------------------------------------------------------
+template <typename AssetType>
+STATIC void AsyncAssetLoader::MarkReady( AsyncAsset<AssetType>& handle, AssetType* asset )
+{
+    handle.m_Asset = asset;
+    handle.m_State = AsyncAssetState::READY;
+}
+
+AsyncAssetLoader::AsyncAssetLoader( RenderContext* context )
+    : m_Context( context )
+{
+}
+
+AsyncAssetLoader::~AsyncAssetLoader()
+{
+    Shutdown();
+}
+
+AsyncAsset<Texture>* AsyncAssetLoader::CreateOrGetTexture( const std::string& filePath, const bool flipV )
+{
+    if( m_Textures.find( filePath ) != m_Textures.cend() )
+    {
+        return m_Textures.at( filePath );
+    }
+
+    AsyncAsset<Texture>* handle = new AsyncAsset<Texture>( filePath );
+    m_Textures[ filePath ] = handle;
+
+    if( m_Context->m_LoadedTextures.find( filePath ) != m_Context->m_LoadedTextures.cend() )
+    {
+        MarkReady( *handle, m_Context->m_LoadedTextures.at( filePath ) );
+        return handle;
+    }
+
+    QueueJob( new AsyncTextureJob( this, handle, flipV ) );
+    return handle;
+}
+
+AsyncAsset<ShaderProgram>* AsyncAssetLoader::CreateOrGetShaderProgram( const std::string& filePath )
+{
+    if( m_ShaderPrograms.find( filePath ) != m_ShaderPrograms.cend() )
+    {
+        return m_ShaderPrograms.at( filePath );
+    }
+
+    AsyncAsset<ShaderProgram>* handle = new AsyncAsset<ShaderProgram>( filePath );
+    m_ShaderPrograms[ filePath ] = handle;
+
+    if( m_Context->m_LoadedShaderPrograms.find( filePath ) != m_Context->m_LoadedShaderPrograms.cend() )
+    {
+        MarkReady( *handle, m_Context->m_LoadedShaderPrograms.at( filePath ) );
+        return handle;
+    }
+
+    QueueJob( new AsyncShaderProgramJob( this, handle ) );
+    return handle;
+}
+
+AsyncAsset<BitmapFont>* AsyncAssetLoader::CreateOrGetBitmapFont( const std::string& filePath )
+{
+    if( m_BitmapFonts.find( filePath ) != m_BitmapFonts.cend() )
+    {
+        return m_BitmapFonts.at( filePath );
+    }
+
+    AsyncAsset<BitmapFont>* handle = new AsyncAsset<BitmapFont>( filePath );
+    m_BitmapFonts[ filePath ] = handle;
+
+    if( m_Context->m_LoadedBitmapFonts.find( filePath ) != m_Context->m_LoadedBitmapFonts.cend() )
+    {
+        MarkReady( *handle, m_Context->m_LoadedBitmapFonts.at( filePath ) );
+        return handle;
+    }
+
+    // Fonts are only a texture plus a fixed glyph grid, so the font waits on its texture and is
+    //  built once that is ready
+    PendingFont pendingFont;
+    pendingFont.font = handle;
+    pendingFont.texture = CreateOrGetTexture( filePath + ".png" );
+    m_PendingFonts.push_back( pendingFont );
+    return handle;
+}
+
+AsyncAsset<GPUMesh>* AsyncAssetLoader::CreateMesh( const std::string& fileName, const MeshLoadOptions& meshLoadOptions )
+{
+    AsyncAsset<GPUMesh>* handle = new AsyncAsset<GPUMesh>( fileName );
+    m_Meshes.push_back( handle );
+
+    QueueJob( new AsyncMeshJob( this, handle, meshLoadOptions ) );
+    return handle;
+}
+
+//-----------------------------------------------------------------------------
+void AsyncAssetLoader::Update( const double budgetSeconds )
+{
+    const double startSeconds = GetCurrentTimeSeconds();
+    bool hasFinishedAny = false;
+
+    size_t pendingIndex = 0;
+    while( pendingIndex < m_PendingJobs.size() )
+    {
+        if( hasFinishedAny && GetCurrentTimeSeconds() - startSeconds >= budgetSeconds )
+        {
+            break;
+        }
+
+        if( TryFinishJob( m_PendingJobs[ pendingIndex ] ) )
+        {
+            m_PendingJobs.erase( m_PendingJobs.begin() + pendingIndex );
+            hasFinishedAny = true;
+        }
+        else
+        {
+            ++pendingIndex;
+        }
+    }
+
+    UpdateFonts();
+}
+
+void AsyncAssetLoader::FinishAll()
+{
+    for( const PendingJob& pendingJob : m_PendingJobs )
+    {
+        FinishJob( pendingJob );
+    }
+    m_PendingJobs.clear();
+
+    UpdateFonts();
+}
+
+void AsyncAssetLoader::Shutdown()
+{
+    // Decodes still running reference the handles, so wait on them before anything is freed
+    m_IsShuttingDown = true;
+    FinishAll();
+
+    for( std::pair<const std::string, AsyncAsset<Texture>*>& texture : m_Textures )
+    {
+        delete texture.second;
+    }
+    m_Textures.clear();
+
+    for( std::pair<const std::string, AsyncAsset<ShaderProgram>*>& shaderProgram : m_ShaderPrograms )
+    {
+        delete shaderProgram.second;
+    }
+    m_ShaderPrograms.clear();
+
+    for( std::pair<const std::string, AsyncAsset<BitmapFont>*>& bitmapFont : m_BitmapFonts )
+    {
+        delete bitmapFont.second;
+    }
+    m_BitmapFonts.clear();
+
+    for( AsyncAsset<GPUMesh>*& mesh : m_Meshes )
+    {
+        delete mesh;
+        mesh = nullptr;
+    }
+    m_Meshes.clear();
+}
+
+//-----------------------------------------------------------------------------
+void AsyncAssetLoader::QueueJob( AsyncAssetJob* job )
+{
+    PendingJob pendingJob;
+    pendingJob.job = job;
+
+    // Without workers nothing would ever pick the job up, Update decodes it instead
+    JobSystem& jobSystem = JobSystem::INSTANCE();
+    if( jobSystem.GetNumWorkerThreads() > 0 )
+    {
+        jobSystem.ScheduleUntrackedJob( *job );
+        pendingJob.isScheduled = true;
+    }
+
+    m_PendingJobs.push_back( pendingJob );
+}
+
+bool AsyncAssetLoader::TryFinishJob( const PendingJob& pendingJob )
+{
+    if( pendingJob.isScheduled && !pendingJob.job->IsFinished() )
+    {
+        return false;
+    }
+
+    FinishJob( pendingJob );
+    return true;
+}
+
+void AsyncAssetLoader::FinishJob( const PendingJob& pendingJob )
+{
+    AsyncAssetJob* job = pendingJob.job;
+
+    // Still queued means no worker will get to it soon, or at all once the JobSystem shut down
+    const bool isOnWorker = pendingJob.isScheduled && !JobSystem::INSTANCE().UnscheduleJob( *job );
+    if( isOnWorker )
+    {
+        while( !job->IsFinished() )
+        {
+            std::this_thread::yield();
+        }
+    }
+    else
+    {
+        job->Execute();
+    }
+
+    job->Complete();
+    delete job;
+}
+
+void AsyncAssetLoader::UpdateFonts()
+{
+    size_t pendingIndex = 0;
+    while( pendingIndex < m_PendingFonts.size() )
+    {
+        const PendingFont& pendingFont = m_PendingFonts[ pendingIndex ];
+        if( !pendingFont.texture->IsDone() )
+        {
+            ++pendingIndex;
+            continue;
+        }
+
+        if( pendingFont.texture->IsReady() )
+        {
+            const std::string& textureFilePath = pendingFont.texture->GetFilePath();
+            BitmapFont* bitmapFont = new BitmapFont( textureFilePath.c_str(), pendingFont.texture->Get() );
+            MarkReady( *pendingFont.font, AddLoadedBitmapFont( pendingFont.font->GetFilePath(), bitmapFont ) );
+        }
+        else
+        {
+            MarkFailed( *pendingFont.font );
+        }
+
+        m_PendingFonts.erase( m_PendingFonts.begin() + pendingIndex );
+    }
+}
+
+//-----------------------------------------------------------------------------
+Texture* AsyncAssetLoader::GetErrorTexture() const
+{
+    Texture* errorTexture = m_Context->m_LoadedTextures.at( "ERROR_TEXTURE" );
+    GUARANTEE_OR_DIE( errorTexture, "AsyncAssetLoader - Builtin error texture does not exist" );
+    return errorTexture;
+}
+
+Texture* AsyncAssetLoader::AddLoadedTexture( const std::string& filePath, Texture* texture )
+{
+    std::map<const std::string, Texture*>& loadedTextures = m_Context->m_LoadedTextures;
+    if( loadedTextures.find( filePath ) != loadedTextures.cend() )
+    {
+        Texture* loadedTexture = loadedTextures.at( filePath );
+        if( texture != loadedTexture && texture != GetErrorTexture() )
+        {
+            delete texture;
+        }
+        return loadedTexture;
+    }
+
+    loadedTextures[ filePath ] = texture;
+    return texture;
+}
+
+ShaderProgram* AsyncAssetLoader::AddLoadedShaderProgram( const std::string& filePath, ShaderProgram* shaderProgram )
+{
+    std::map<const std::string, ShaderProgram*>& loadedShaderPrograms = m_Context->m_LoadedShaderPrograms;
+    if( loadedShaderPrograms.find( filePath ) != loadedShaderPrograms.cend() )
+    {
+        delete shaderProgram;
+        return loadedShaderPrograms.at( filePath );
+    }
+
+    loadedShaderPrograms[ filePath ] = shaderProgram;
+    return shaderProgram;
+}
+
+BitmapFont* AsyncAssetLoader::AddLoadedBitmapFont( const std::string& filePath, BitmapFont* bitmapFont )
+{
+    std::map<const std::string, BitmapFont*>& loadedBitmapFonts = m_Context->m_LoadedBitmapFonts;
+    if( loadedBitmapFonts.find( filePath ) != loadedBitmapFonts.cend() )
+    {
+        delete bitmapFont;
+        return loadedBitmapFonts.at( filePath );
+    }
+
+    loadedBitmapFonts[ filePath ] = bitmapFont;
+    return bitmapFont;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Engine/Event/Job.hpp"
+#include "Engine/IO/ObjFileUtils.hpp"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+class AsyncAssetLoader;
+class BitmapFont;
+class GPUMesh;
+class RenderContext;
+class ShaderProgram;
+class Texture;
+
+enum class AsyncAssetState : unsigned int
+{
+    DECODING,   // Queued or running on a worker thread
+    DECODED,    // Waiting for its upload on the render thread
+    READY,
+    FAILED,
+};
+
+//-----------------------------------------------------------------------------
+// Handle returned by the async loads. The loader owns it and it stays valid until the loader
+//  shuts down. Textures that fail to load are READY with the error texture, the same as the
+//  blocking loads
+template <typename AssetType>
+class AsyncAsset
+{
+    friend class AsyncAssetLoader;
+
+public:
+    explicit AsyncAsset( const std::string& filePath ) : m_FilePath( filePath ) {}
+
+    AsyncAssetState GetState() const { return m_State; }
+    bool IsReady() const { return m_State == AsyncAssetState::READY; }
+    bool IsDone() const { return m_State == AsyncAssetState::READY || m_State == AsyncAssetState::FAILED; }
+    const std::string& GetFilePath() const { return m_FilePath; }
+
+    // nullptr until READY. Meshes belong to the caller once READY, same as GPUMesh::CreateFromFile
+    AssetType* Get() const { return IsReady() ? m_Asset : nullptr; }
+
+private:
+    std::string m_FilePath;
+    std::atomic<AsyncAssetState> m_State = AsyncAssetState::DECODING;
+    AssetType* m_Asset = nullptr;
+};
+
+//-----------------------------------------------------------------------------
+// One load. Decode does the file read and CPU work on a worker, Upload creates the GPU side on the
+//  render thread from what Decode left behind. Scheduled untracked, so the loader owns the job and
+//  no Claim or Finish call on the JobSystem ever runs or frees it
+class AsyncAssetJob : public Job
+{
+    friend class AsyncAssetLoader;
+
+public:
+    explicit AsyncAssetJob( AsyncAssetLoader* loader ) : m_Loader( loader ) {}
+
+    // Worker thread. Needs no RenderContext so decoding works headless
+    virtual bool Decode() = 0;
+    // Render thread, only after Decode succeeded
+    virtual void Upload( RenderContext* context ) = 0;
+    // Render thread, when Decode failed or the loader shut down first
+    virtual void Discard() = 0;
+
+    bool IsDecoded() const { return m_IsDecoded; }
+    // Set by the worker once Decode returned, the job is the loader's again from then on
+    bool IsFinished() const { return m_IsFinished; }
+
+protected:
+    AsyncAssetLoader* m_Loader = nullptr;
+    bool m_IsDecoded = false;
+    std::atomic<bool> m_IsFinished = false;
+
+    void Execute() override;
+    void Callback() override;
+    // Render thread, Upload or Discard depending on how Decode went
+    void Complete();
+};
+
+//-----------------------------------------------------------------------------
+// Turns the blocking RenderContext loads into handles. Jobs run on the JobSystem workers, or inline
+//  during Update when there are none, and uploads are metered so a burst of loads cannot stall a
+//  frame
+class AsyncAssetLoader
+{
+    friend class AsyncAssetJob;
+    friend class AsyncTextureJob;
+    friend class AsyncShaderProgramJob;
+    friend class AsyncMeshJob;
+
+public:
+    explicit AsyncAssetLoader( RenderContext* context );
+    ~AsyncAssetLoader();
+
+    AsyncAsset<Texture>* CreateOrGetTexture( const std::string& filePath, bool flipV = false );
+    AsyncAsset<ShaderProgram>* CreateOrGetShaderProgram( const std::string& filePath );
+    AsyncAsset<BitmapFont>* CreateOrGetBitmapFont( const std::string& filePath );
+    AsyncAsset<GPUMesh>* CreateMesh( const std::string& fileName,
+                                     const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
+
+    // Render thread. Uploads finished decodes in request order until budgetSeconds is spent. At
+    //  least one upload happens per call so loads always make progress
+    void Update( double budgetSeconds );
+    // Blocks until every load is READY or FAILED. Loads no worker picked up yet are decoded on
+    //  this thread, so this also returns after JobSystem::Shutdown
+    void FinishAll();
+    // Waits for the workers and drops anything not uploaded yet. Either order with
+    //  JobSystem::Shutdown works, see FinishAll
+    void Shutdown();
+
+    size_t GetNumPendingLoads() const { return m_PendingJobs.size() + m_PendingFonts.size(); }
+
+    RenderContext* GetRenderContext() const { return m_Context; }
+    bool IsShuttingDown() const { return m_IsShuttingDown; }
+
+private:
+    struct PendingJob
+    {
+        AsyncAssetJob* job = nullptr;
+        bool isScheduled = false;
+    };
+
+    struct PendingFont
+    {
+        AsyncAsset<BitmapFont>* font = nullptr;
+        AsyncAsset<Texture>* texture = nullptr;
+    };
+
+    RenderContext* m_Context = nullptr;
+    bool m_IsShuttingDown = false;
+
+    std::vector<PendingJob> m_PendingJobs;
+    std::vector<PendingFont> m_PendingFonts;
+
+    std::map<std::string, AsyncAsset<Texture>*> m_Textures;
+    std::map<std::string, AsyncAsset<ShaderProgram>*> m_ShaderPrograms;
+    std::map<std::string, AsyncAsset<BitmapFont>*> m_BitmapFonts;
+    std::vector<AsyncAsset<GPUMesh>*> m_Meshes;
+
+    void QueueJob( AsyncAssetJob* job );
+    // Uploads and frees the job if its decode is done. Jobs never scheduled are decoded here first
+    bool TryFinishJob( const PendingJob& pendingJob );
+    void FinishJob( const PendingJob& pendingJob );
+    void UpdateFonts();
+
+    Texture* GetErrorTexture() const;
+    // A blocking load of the same file may have finished first, the cached asset wins
+    Texture* AddLoadedTexture( const std::string& filePath, Texture* texture );
+    ShaderProgram* AddLoadedShaderProgram( const std::string& filePath, ShaderProgram* shaderProgram );
+    BitmapFont* AddLoadedBitmapFont( const std::string& filePath, BitmapFont* bitmapFont );
+
+    template <typename AssetType>
+    static void MarkReady( AsyncAsset<AssetType>& handle, AssetType* asset );
+    template <typename AssetType>
+    static void MarkDecoded( AsyncAsset<AssetType>& handle ) { handle.m_State = AsyncAssetState::DECODED; }
+    template <typename AssetType>
+    static void MarkFailed( AsyncAsset<AssetType>& handle ) { handle.m_State = AsyncAssetState::FAILED; }
+};
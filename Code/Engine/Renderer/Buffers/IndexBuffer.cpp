@@ -56,6 +56,14 @@ void IndexBuffer::AppendLocalBuffer( const size_t amount, const size_t start )
     m_IsDirty = true;
 }
 
+void IndexBuffer::ClearLocalBuffer()
+{
+    m_LocalBuffer.clear();
+
+    m_LocalSize = 0U;
+    m_IsDirty = true;
+}
+
 void IndexBuffer::UpdateAndBind( unsigned int slot, unsigned int numBuffers, const unsigned int offset )
 {
     UNUSED( slot );
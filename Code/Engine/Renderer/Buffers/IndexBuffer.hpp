@@ -14,6 +14,8 @@ public:
     void AppendLocalBuffer( const std::vector<unsigned int>& indexes );
     void AppendLocalBuffer( const std::vector<unsigned int>& indexes, size_t start );
     void AppendLocalBuffer( size_t amount, size_t start );
+    // Drops every local index so the next append starts a fresh buffer
+    void ClearLocalBuffer();
 
 private:
     std::vector<unsigned int> m_LocalBuffer;
@@ -244,48 +244,34 @@ Vec2 Camera::GetScreenSpaceFromWorld( const Vec2& worldPosition ) const
 void Camera::Translate( const Vec3& deltaTranslation )
 {
     m_CameraModel.Translate( deltaTranslation );
+    ApplyPositionConstraints();
+}
 
-    if ( m_IsPositionallyConstrained )
-    {
-        m_CameraModel.position.x = Clamp( m_CameraModel.position.x, m_PositionConstraints.mins.x, m_PositionConstraints.maxs.x );
-        m_CameraModel.position.y = Clamp( m_CameraModel.position.y, m_PositionConstraints.mins.y, m_PositionConstraints.maxs.y );
-        m_CameraModel.position.z = Clamp( m_CameraModel.position.z, m_PositionConstraints.mins.z, m_PositionConstraints.maxs.z );
-    }
+// Moves relative to the heading only, so looking up or down does not change the height
+void Camera::TranslateFPS( const Vec3& deltaTranslation )
+{
+    const Quaternion heading = Quaternion::CreateFromAxisAngleDegrees( Vec3( 0.f, 0.f, 1.f ),
+                                                                       m_CameraModel.rotationAroundAxis.z );
+    Translate( heading.RotateVector( deltaTranslation ) );
 }
 
 void Camera::RotateCamera( const Vec3& rotationAroundAxis )
 {
     m_CameraModel.AppendRotationFromAxis( rotationAroundAxis );
+    ApplyRotationConstraints();
+}
 
-    if ( m_IsRotationallyConstrained )
-    {
-        if( m_LoopRotation[0] )
-        {
-            m_CameraModel.rotationAroundAxis.x = Wrap( m_CameraModel.rotationAroundAxis.x, m_RotationConstraints.mins.x, m_RotationConstraints.maxs.x );
-        }
-        else
-        {
-            m_CameraModel.rotationAroundAxis.x = Clamp( m_CameraModel.rotationAroundAxis.x, m_RotationConstraints.mins.x, m_RotationConstraints.maxs.x );
-        }
-
-        if( m_LoopRotation[1] )
-        {
-            m_CameraModel.rotationAroundAxis.y = Wrap( m_CameraModel.rotationAroundAxis.y, m_RotationConstraints.mins.y, m_RotationConstraints.maxs.y );
-        }
-        else
-        {
-            m_CameraModel.rotationAroundAxis.y = Clamp( m_CameraModel.rotationAroundAxis.y, m_RotationConstraints.mins.y, m_RotationConstraints.maxs.y );
-        }
+void Camera::SetOrientation( const Quaternion& orientation )
+{
+    m_CameraModel.SetOrientation( orientation );
+    ApplyRotationConstraints();
+}
 
-        if( m_LoopRotation[2] )
-        {
-            m_CameraModel.rotationAroundAxis.z = Wrap( m_CameraModel.rotationAroundAxis.z, m_RotationConstraints.mins.z, m_RotationConstraints.maxs.z );
-        }
-        else
-        {
-            m_CameraModel.rotationAroundAxis.z = Clamp( m_CameraModel.rotationAroundAxis.z, m_RotationConstraints.mins.z, m_RotationConstraints.maxs.z );
-        }
-    }
+void Camera::InterpolateCameraModel( const Transform& from, const Transform& to, const float percentage )
+{
+    m_CameraModel = Transform::Interpolate( from, to, percentage );
+    ApplyPositionConstraints();
+    ApplyRotationConstraints();
 }
 
 void Camera::FitCameraInAABB2( const AABB2& bounds )
@@ -421,3 +407,83 @@ CameraDataUBO Camera::GetCameraData() const
 
     return cameraData;
 }
+
+Mat44 Camera::GetWorldToClip() const
+{
+    Mat44 cameraView = m_CameraModel.GetAsMatrixWithCanonicalTransform();
+    cameraView.InvertOrthonormal();
+
+    Mat44 worldToClip = m_CameraToClip;
+    worldToClip.PushMatrix( cameraView );
+    return worldToClip;
+}
+
+Frustum Camera::GetFrustum() const
+{
+    return Frustum::CreateFromWorldToClip( GetWorldToClip() );
+}
+
+float Camera::GetProjectedSize( const Vec3& worldPosition, const float worldSize ) const
+{
+    const Vec4 clip = GetWorldToClip().TransformHomogeneous( Vec4( worldPosition, 1.f ) );
+
+    // At or behind the eye, treat it as filling the screen
+    if( clip.w <= 1e-4f )
+    {
+        return 1e30f;
+    }
+
+    const Texture* colorTarget = GetColorTarget();
+    const float targetHeight = colorTarget != nullptr ? colorTarget->GetHeight() : m_OutputSize.y;
+
+    // Clip space spans 2 units over the target height
+    return worldSize * fabsf( m_CameraToClip.Jy ) / clip.w * .5f * targetHeight;
+}
+
+void Camera::ApplyPositionConstraints()
+{
+    if ( m_IsPositionallyConstrained )
+    {
+        m_CameraModel.position.x = Clamp( m_CameraModel.position.x, m_PositionConstraints.mins.x, m_PositionConstraints.maxs.x );
+        m_CameraModel.position.y = Clamp( m_CameraModel.position.y, m_PositionConstraints.mins.y, m_PositionConstraints.maxs.y );
+        m_CameraModel.position.z = Clamp( m_CameraModel.position.z, m_PositionConstraints.mins.z, m_PositionConstraints.maxs.z );
+    }
+}
+
+void Camera::ApplyRotationConstraints()
+{
+    if ( m_IsRotationallyConstrained )
+    {
+        // Goes through the setter so the model's cached rotation stays current
+        Vec3 rotation = m_CameraModel.rotationAroundAxis;
+
+        if( m_LoopRotation[0] )
+        {
+            rotation.x = Wrap( rotation.x, m_RotationConstraints.mins.x, m_RotationConstraints.maxs.x );
+        }
+        else
+        {
+            rotation.x = Clamp( rotation.x, m_RotationConstraints.mins.x, m_RotationConstraints.maxs.x );
+        }
+
+        if( m_LoopRotation[1] )
+        {
+            rotation.y = Wrap( rotation.y, m_RotationConstraints.mins.y, m_RotationConstraints.maxs.y );
+        }
+        else
+        {
+            rotation.y = Clamp( rotation.y, m_RotationConstraints.mins.y, m_RotationConstraints.maxs.y );
+        }
+
+        if( m_LoopRotation[2] )
+        {
+            rotation.z = Wrap( rotation.z, m_RotationConstraints.mins.z, m_RotationConstraints.maxs.z );
+        }
+        else
+        {
+            rotation.z = Clamp( rotation.z, m_RotationConstraints.mins.z, m_RotationConstraints.maxs.z );
+        }
+
+        m_CameraModel.SetRotationFromAxis( rotation );
+    }
+}
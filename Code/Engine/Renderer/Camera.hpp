@@ -4,6 +4,7 @@
 #include "Engine/Core/Math/Primatives/Vec2.hpp"
 #include "Engine/Core/Math/Primatives/Vec3.hpp"
 #include "Engine/Core/Math/Primatives/AABB2.hpp"
+#include "Engine/Core/Math/Primatives/Frustum.hpp"
 #include "Engine/Core/Math/Primatives/Mat44.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Transform.hpp"
@@ -71,6 +72,11 @@ public:
     RenderContext* GetCameraContext() const { return m_Owner; }
     Mat44 GetCameraView() const { return m_CameraToClip; }
     Mat44 GetCameraModel() const { return m_CameraModel.GetAsMatrix(); }
+    Mat44 GetWorldToClip() const;
+    Frustum GetFrustum() const;
+
+    // Height in pixels of something worldSize tall at worldPosition, facing the camera
+    float GetProjectedSize( const Vec3& worldPosition, float worldSize ) const;
 
     AABB2 GetOrthoView( const float zDist = 0.f ) const;
     OutsideCameraView ArePointsOutside( const std::vector<Vec2>& points, float radius = 0.f );
@@ -98,6 +104,9 @@ public:
     void Translate( const Vec3& deltaTranslation );
     void TranslateFPS( const Vec3& deltaTranslation );
     void RotateCamera( const Vec3& rotationAroundAxis );
+    void SetOrientation( const Quaternion& orientation );
+    // Slerps the rotation, for cut scenes and camera blends. Constraints still apply
+    void InterpolateCameraModel( const Transform& from, const Transform& to, float percentage );
     void FitCameraInAABB2( const AABB2& bounds );
 
     void FullyConstrainCamera( bool constrain );
@@ -124,6 +133,9 @@ public:
 
     Transform m_CameraModel;
 private:
+    void ApplyPositionConstraints();
+    void ApplyRotationConstraints();
+
     Vec2 m_OutputSize;
 
     bool m_IsRotationallyConstrained = false;
@@ -0,0 +1,239 @@
+#include "CullingSet.hpp"
+
+#include "Engine/Core/Math/SimdCommon.hpp"
+#include "Engine/Core/Math/Primatives/AABB3.hpp"
+#include "Engine/Event/JobSystem.hpp"
+#include "Engine/Renderer/Culling/OcclusionBuffer.hpp"
+
+#include <cmath>
+
+// Multiple of 4 so every batch but the last stays on the SIMD path
+constexpr unsigned int CULLING_BATCH_SIZE = 4096;
+
+unsigned int CullingSet::AddSphere( const Vec3& center, const float radius )
+{
+    const unsigned int index = GetCount();
+    m_CenterX.push_back( 0.f );
+    m_CenterY.push_back( 0.f );
+    m_CenterZ.push_back( 0.f );
+    m_ExtentX.push_back( 0.f );
+    m_ExtentY.push_back( 0.f );
+    m_ExtentZ.push_back( 0.f );
+    m_Radius.push_back( 0.f );
+    SetSphere( index, center, radius );
+    return index;
+}
+
+unsigned int CullingSet::AddAABB( const AABB3& bounds )
+{
+    const unsigned int index = AddSphere( Vec3::ZERO, 0.f );
+    SetAABB( index, bounds );
+    return index;
+}
+
+void CullingSet::SetSphere( const unsigned int index, const Vec3& center, const float radius )
+{
+    m_CenterX[ index ] = center.x;
+    m_CenterY[ index ] = center.y;
+    m_CenterZ[ index ] = center.z;
+    m_ExtentX[ index ] = radius;
+    m_ExtentY[ index ] = radius;
+    m_ExtentZ[ index ] = radius;
+    m_Radius[ index ] = radius;
+}
+
+void CullingSet::SetAABB( const unsigned int index, const AABB3& bounds )
+{
+    const Vec3 center = bounds.GetCenter();
+    const Vec3 halfExtents = bounds.GetDimensions() * .5f;
+    m_CenterX[ index ] = center.x;
+    m_CenterY[ index ] = center.y;
+    m_CenterZ[ index ] = center.z;
+    m_ExtentX[ index ] = halfExtents.x;
+    m_ExtentY[ index ] = halfExtents.y;
+    m_ExtentZ[ index ] = halfExtents.z;
+    m_Radius[ index ] = halfExtents.GetLength();
+}
+
+void CullingSet::Reserve( const unsigned int count )
+{
+    m_CenterX.reserve( count );
+    m_CenterY.reserve( count );
+    m_CenterZ.reserve( count );
+    m_ExtentX.reserve( count );
+    m_ExtentY.reserve( count );
+    m_ExtentZ.reserve( count );
+    m_Radius.reserve( count );
+}
+
+void CullingSet::Clear()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_CenterZ.clear();
+    m_ExtentX.clear();
+    m_ExtentY.clear();
+    m_ExtentZ.clear();
+    m_Radius.clear();
+}
+
+CullingStats CullingSet::Cull( const Frustum& frustum, std::vector<unsigned char>& visibility,
+                               const OcclusionBuffer* occlusion, const bool useJobSystem ) const
+{
+    const unsigned int count = GetCount();
+    visibility.resize( count );
+
+    if( useJobSystem )
+    {
+        unsigned char* visibilityData = visibility.data();
+        JobSystem::INSTANCE().ParallelFor( count, CULLING_BATCH_SIZE,
+                                           [&]( const unsigned int startIndex, const unsigned int endIndex )
+                                           {
+                                               CullRange( frustum, occlusion, startIndex, endIndex,
+                                                          visibilityData );
+                                           } );
+    }
+    else
+    {
+        CullRange( frustum, occlusion, 0, count, visibility.data() );
+    }
+
+    CullingStats stats;
+    stats.tested = count;
+    for( unsigned char& visible : visibility )
+    {
+        if( visible == CULL_RESULT_VISIBLE )
+        {
+            ++stats.visible;
+        }
+        else if( visible == CULL_RESULT_OCCLUDED )
+        {
+            ++stats.occlusionCulled;
+            visible = CULL_RESULT_CULLED;
+        }
+    }
+    stats.frustumCulled = count - stats.visible - stats.occlusionCulled;
+    return stats;
+}
+
+void CullingSet::CullRange( const Frustum& frustum, const OcclusionBuffer* occlusion,
+                            const unsigned int startIndex, const unsigned int endIndex,
+                            unsigned char* visibility ) const
+{
+    unsigned int index = startIndex;
+
+#if defined(ENGINE_SIMD_SSE)
+    __m128 planeX[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeY[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeZ[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeAbsX[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeAbsY[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeAbsZ[ FRUSTUM_PLANE_COUNT ];
+    __m128 planeDistance[ FRUSTUM_PLANE_COUNT ];
+    for( unsigned int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex )
+    {
+        const Plane3D& plane = frustum.planes[ planeIndex ];
+        planeX[ planeIndex ] = _mm_set1_ps( plane.normal.x );
+        planeY[ planeIndex ] = _mm_set1_ps( plane.normal.y );
+        planeZ[ planeIndex ] = _mm_set1_ps( plane.normal.z );
+        planeAbsX[ planeIndex ] = _mm_set1_ps( fabsf( plane.normal.x ) );
+        planeAbsY[ planeIndex ] = _mm_set1_ps( fabsf( plane.normal.y ) );
+        planeAbsZ[ planeIndex ] = _mm_set1_ps( fabsf( plane.normal.z ) );
+        planeDistance[ planeIndex ] = _mm_set1_ps( plane.distance );
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    for( ; index + 4 <= endIndex; index += 4 )
+    {
+        const __m128 centerX = _mm_loadu_ps( &m_CenterX[ index ] );
+        const __m128 centerY = _mm_loadu_ps( &m_CenterY[ index ] );
+        const __m128 centerZ = _mm_loadu_ps( &m_CenterZ[ index ] );
+        const __m128 extentX = _mm_loadu_ps( &m_ExtentX[ index ] );
+        const __m128 extentY = _mm_loadu_ps( &m_ExtentY[ index ] );
+        const __m128 extentZ = _mm_loadu_ps( &m_ExtentZ[ index ] );
+        const __m128 radius = _mm_loadu_ps( &m_Radius[ index ] );
+
+        __m128 outside = zero;
+        for( unsigned int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex )
+        {
+            __m128 distance = _mm_mul_ps( planeX[ planeIndex ], centerX );
+            distance = _mm_add_ps( distance, _mm_mul_ps( planeY[ planeIndex ], centerY ) );
+            distance = _mm_add_ps( distance, _mm_mul_ps( planeZ[ planeIndex ], centerZ ) );
+            distance = _mm_sub_ps( distance, planeDistance[ planeIndex ] );
+
+            __m128 boxRadius = _mm_mul_ps( planeAbsX[ planeIndex ], extentX );
+            boxRadius = _mm_add_ps( boxRadius, _mm_mul_ps( planeAbsY[ planeIndex ], extentY ) );
+            boxRadius = _mm_add_ps( boxRadius, _mm_mul_ps( planeAbsZ[ planeIndex ], extentZ ) );
+            const __m128 projectedRadius = _mm_min_ps( boxRadius, radius );
+
+            outside = _mm_or_ps( outside, _mm_cmplt_ps( distance, _mm_sub_ps( zero, projectedRadius ) ) );
+        }
+
+        const int outsideMask = _mm_movemask_ps( outside );
+        visibility[ index ] = (outsideMask & 1) ? 0 : 1;
+        visibility[ index + 1 ] = (outsideMask & 2) ? 0 : 1;
+        visibility[ index + 2 ] = (outsideMask & 4) ? 0 : 1;
+        visibility[ index + 3 ] = (outsideMask & 8) ? 0 : 1;
+    }
+#endif // defined(ENGINE_SIMD_SSE)
+
+    CullFrustumRangeScalar( frustum, index, endIndex, visibility );
+
+    if( occlusion == nullptr )
+    {
+        return;
+    }
+
+    for( index = startIndex; index < endIndex; ++index )
+    {
+        if( visibility[ index ] != CULL_RESULT_VISIBLE )
+        {
+            continue;
+        }
+
+        const Vec3 center( m_CenterX[ index ], m_CenterY[ index ], m_CenterZ[ index ] );
+        const Vec3 halfExtents( m_ExtentX[ index ], m_ExtentY[ index ], m_ExtentZ[ index ] );
+        if( occlusion->IsAABBOccluded( center, halfExtents ) )
+        {
+            visibility[ index ] = CULL_RESULT_OCCLUDED;
+        }
+    }
+}
+
+STATIC void CullingSet::GetVisibleIndices( const std::vector<unsigned char>& visibility,
+                                           std::vector<unsigned int>& visibleIndices )
+{
+    visibleIndices.clear();
+    for( size_t index = 0; index < visibility.size(); ++index )
+    {
+        if( visibility[ index ] == CULL_RESULT_VISIBLE )
+        {
+            visibleIndices.push_back( static_cast<unsigned int>( index ) );
+        }
+    }
+}
+
+void CullingSet::CullFrustumRangeScalar( const Frustum& frustum, const unsigned int startIndex,
+                                         const unsigned int endIndex, unsigned char* visibility ) const
+{
+    for( unsigned int index = startIndex; index < endIndex; ++index )
+    {
+        const Vec3 center( m_CenterX[ index ], m_CenterY[ index ], m_CenterZ[ index ] );
+        const Vec3 halfExtents( m_ExtentX[ index ], m_ExtentY[ index ], m_ExtentZ[ index ] );
+
+        bool isOutside = false;
+        for( const Plane3D& plane : frustum.planes )
+        {
+            const float boxRadius = fabsf( plane.normal.x ) * halfExtents.x +
+                                    fabsf( plane.normal.y ) * halfExtents.y +
+                                    fabsf( plane.normal.z ) * halfExtents.z;
+            const float projectedRadius = boxRadius < m_Radius[ index ] ? boxRadius : m_Radius[ index ];
+            if( plane.GetSignedDistance( center ) < -projectedRadius )
+            {
+                isOutside = true;
+                break;
+            }
+        }
+        visibility[ index ] = isOutside ? 0 : 1;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/Frustum.hpp"
+
+#include <vector>
+
+struct AABB3;
+class OcclusionBuffer;
+
+// Values CullRange writes. Cull folds OCCLUDED into CULLED, so its output is only ever 0 or 1
+constexpr unsigned char CULL_RESULT_CULLED = 0;
+constexpr unsigned char CULL_RESULT_VISIBLE = 1;
+constexpr unsigned char CULL_RESULT_OCCLUDED = 2;
+
+struct CullingStats
+{
+    unsigned int tested = 0;
+    unsigned int frustumCulled = 0;
+    unsigned int occlusionCulled = 0;
+    unsigned int visible = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Bounds for a batch of objects kept as structure of arrays so four objects are tested per
+//  SSE instruction. Every object stores a center, half extents and a radius; spheres get a cube
+//  around them and boxes get their bounding sphere, and the tighter of the two is used per plane.
+//  Nothing here touches the GPU, so it can be driven headless
+class CullingSet
+{
+public:
+    CullingSet() = default;
+    ~CullingSet() = default;
+
+    unsigned int AddSphere( const Vec3& center, float radius );
+    unsigned int AddAABB( const AABB3& bounds );
+    void SetSphere( unsigned int index, const Vec3& center, float radius );
+    void SetAABB( unsigned int index, const AABB3& bounds );
+
+    void Reserve( unsigned int count );
+    void Clear();
+    unsigned int GetCount() const { return static_cast<unsigned int>( m_Radius.size() ); }
+
+    // Writes 1 for every object inside the frustum (and not hidden in occlusion, when given) and 0
+    //  for the rest. visibility is resized to GetCount(). Batches run on the JobSystem when
+    //  useJobSystem is set
+    CullingStats Cull( const Frustum& frustum, OUT_PARAM std::vector<unsigned char>& visibility,
+                       const OcclusionBuffer* occlusion = nullptr, bool useJobSystem = true ) const;
+    // One batch of Cull, for callers running their own jobs. Unlike Cull this keeps the three
+    //  CULL_RESULT values, so objects rejected by occlusion read CULL_RESULT_OCCLUDED
+    void CullRange( const Frustum& frustum, const OcclusionBuffer* occlusion, unsigned int startIndex,
+                    unsigned int endIndex, OUT_PARAM unsigned char* visibility ) const;
+
+    // Accepts the output of either Cull or CullRange
+    static void GetVisibleIndices( const std::vector<unsigned char>& visibility,
+                                   OUT_PARAM std::vector<unsigned int>& visibleIndices );
+
+private:
+    std::vector<float> m_CenterX;
+    std::vector<float> m_CenterY;
+    std::vector<float> m_CenterZ;
+    std::vector<float> m_ExtentX;
+    std::vector<float> m_ExtentY;
+    std::vector<float> m_ExtentZ;
+    std::vector<float> m_Radius;
+
+    void CullFrustumRangeScalar( const Frustum& frustum, unsigned int startIndex, unsigned int endIndex,
+                                 OUT_PARAM unsigned char* visibility ) const;
+};
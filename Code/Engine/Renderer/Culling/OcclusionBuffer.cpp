@@ -0,0 +1,235 @@
+#include "OcclusionBuffer.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/Vec4.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Anything with a w below this is at or behind the eye and can not be projected safely
+constexpr float MIN_CLIP_W = .0001f;
+
+OcclusionBuffer::OcclusionBuffer( const IntVec2& resolution )
+    : m_Resolution( resolution )
+{
+    GUARANTEE_OR_DIE( resolution.x > 0 && resolution.y > 0,
+                      "OcclusionBuffer::OcclusionBuffer - Resolution must be positive" );
+
+    IntVec2 levelSize = resolution;
+    while( true )
+    {
+        m_LevelSizes.push_back( levelSize );
+        m_Levels.emplace_back( static_cast<size_t>( levelSize.x ) * levelSize.y, 1.f );
+        if( levelSize.x == 1 && levelSize.y == 1 )
+        {
+            break;
+        }
+        levelSize = IntVec2( (levelSize.x + 1) / 2, (levelSize.y + 1) / 2 );
+    }
+}
+
+void OcclusionBuffer::BeginFrame( const Mat44& worldToClip )
+{
+    m_WorldToClip = worldToClip;
+    m_IsHierarchyBuilt = false;
+    std::fill( m_Levels[ 0 ].begin(), m_Levels[ 0 ].end(), 1.f );
+}
+
+void OcclusionBuffer::RasterizeOccluder( const std::vector<Vec3>& positions,
+                                         const std::vector<unsigned int>& indices,
+                                         const Mat44& modelToWorld )
+{
+    Mat44 modelToClip = m_WorldToClip;
+    modelToClip.PushMatrix( modelToWorld );
+
+    const float halfWidth = static_cast<float>( m_Resolution.x ) * .5f;
+    const float halfHeight = static_cast<float>( m_Resolution.y ) * .5f;
+
+    // Project every vertex once, w <= 0 marks vertexes that can not be used
+    std::vector<Vec4> screenPositions;
+    screenPositions.reserve( positions.size() );
+    for( const Vec3& position : positions )
+    {
+        const Vec4 clip = modelToClip.TransformHomogeneous( Vec4( position, 1.f ) );
+        if( clip.w < MIN_CLIP_W || clip.z < 0.f )
+        {
+            screenPositions.push_back( Vec4::ZERO );
+            continue;
+        }
+
+        const float inverseW = 1.f / clip.w;
+        screenPositions.push_back( Vec4( (clip.x * inverseW + 1.f) * halfWidth,
+                                         (1.f - clip.y * inverseW) * halfHeight,
+                                         clip.z * inverseW,
+                                         clip.w ) );
+    }
+
+    for( size_t index = 0; index + 2 < indices.size(); index += 3 )
+    {
+        const Vec4& a = screenPositions[ indices[ index ] ];
+        const Vec4& b = screenPositions[ indices[ index + 1 ] ];
+        const Vec4& c = screenPositions[ indices[ index + 2 ] ];
+
+        // Clipping is skipped on purpose, a triangle crossing the near plane just does not occlude
+        if( a.w <= 0.f || b.w <= 0.f || c.w <= 0.f )
+        {
+            continue;
+        }
+        RasterizeTriangle( a.XYZ(), b.XYZ(), c.XYZ() );
+    }
+    m_IsHierarchyBuilt = false;
+}
+
+void OcclusionBuffer::BuildHierarchy()
+{
+    for( size_t level = 1; level < m_Levels.size(); ++level )
+    {
+        const IntVec2& sourceSize = m_LevelSizes[ level - 1 ];
+        const IntVec2& destSize = m_LevelSizes[ level ];
+        const std::vector<float>& source = m_Levels[ level - 1 ];
+        std::vector<float>& dest = m_Levels[ level ];
+
+        for( int y = 0; y < destSize.y; ++y )
+        {
+            const int sourceY0 = y * 2;
+            const int sourceY1 = std::min( sourceY0 + 1, sourceSize.y - 1 );
+            for( int x = 0; x < destSize.x; ++x )
+            {
+                const int sourceX0 = x * 2;
+                const int sourceX1 = std::min( sourceX0 + 1, sourceSize.x - 1 );
+
+                const float top = std::max( source[ sourceY0 * sourceSize.x + sourceX0 ],
+                                            source[ sourceY0 * sourceSize.x + sourceX1 ] );
+                const float bottom = std::max( source[ sourceY1 * sourceSize.x + sourceX0 ],
+                                               source[ sourceY1 * sourceSize.x + sourceX1 ] );
+                dest[ y * destSize.x + x ] = std::max( top, bottom );
+            }
+        }
+    }
+    m_IsHierarchyBuilt = true;
+}
+
+bool OcclusionBuffer::IsAABBOccluded( const Vec3& center, const Vec3& halfExtents ) const
+{
+    GUARANTEE_OR_DIE( m_IsHierarchyBuilt, "OcclusionBuffer::IsAABBOccluded - BuildHierarchy was not called" );
+
+    float minX = static_cast<float>( m_Resolution.x );
+    float minY = static_cast<float>( m_Resolution.y );
+    float maxX = 0.f;
+    float maxY = 0.f;
+    float nearestDepth = 1.f;
+
+    const float halfWidth = static_cast<float>( m_Resolution.x ) * .5f;
+    const float halfHeight = static_cast<float>( m_Resolution.y ) * .5f;
+    for( int corner = 0; corner < 8; ++corner )
+    {
+        const Vec3 position( center.x + ((corner & 1) ? halfExtents.x : -halfExtents.x),
+                             center.y + ((corner & 2) ? halfExtents.y : -halfExtents.y),
+                             center.z + ((corner & 4) ? halfExtents.z : -halfExtents.z) );
+        const Vec4 clip = m_WorldToClip.TransformHomogeneous( Vec4( position, 1.f ) );
+
+        // Crossing the near plane means the box surrounds the eye, never occlude it
+        if( clip.w < MIN_CLIP_W || clip.z < 0.f )
+        {
+            return false;
+        }
+
+        const float inverseW = 1.f / clip.w;
+        const float screenX = (clip.x * inverseW + 1.f) * halfWidth;
+        const float screenY = (1.f - clip.y * inverseW) * halfHeight;
+        minX = std::min( minX, screenX );
+        maxX = std::max( maxX, screenX );
+        minY = std::min( minY, screenY );
+        maxY = std::max( maxY, screenY );
+        nearestDepth = std::min( nearestDepth, clip.z * inverseW );
+    }
+
+    minX = std::max( minX, 0.f );
+    minY = std::max( minY, 0.f );
+    maxX = std::min( maxX, static_cast<float>( m_Resolution.x - 1 ) );
+    maxY = std::min( maxY, static_cast<float>( m_Resolution.y - 1 ) );
+    if( minX > maxX || minY > maxY )
+    {
+        // Entirely off screen, that is the frustum test's call
+        return false;
+    }
+
+    // Pick the level where the rectangle covers at most 2x2 texels
+    const float largestSpan = std::max( maxX - minX, maxY - minY );
+    unsigned int level = 0;
+    while( level + 1 < m_Levels.size() && largestSpan > static_cast<float>( 1 << level ) )
+    {
+        ++level;
+    }
+
+    const IntVec2& levelSize = m_LevelSizes[ level ];
+    const std::vector<float>& depths = m_Levels[ level ];
+    const int startX = static_cast<int>( minX ) >> level;
+    const int startY = static_cast<int>( minY ) >> level;
+    const int endX = std::min( static_cast<int>( maxX ) >> level, levelSize.x - 1 );
+    const int endY = std::min( static_cast<int>( maxY ) >> level, levelSize.y - 1 );
+    for( int y = startY; y <= endY; ++y )
+    {
+        for( int x = startX; x <= endX; ++x )
+        {
+            if( depths[ y * levelSize.x + x ] >= nearestDepth )
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+float OcclusionBuffer::GetDepth( const unsigned int level, const int x, const int y ) const
+{
+    const IntVec2& levelSize = m_LevelSizes[ level ];
+    return m_Levels[ level ][ y * levelSize.x + x ];
+}
+
+void OcclusionBuffer::RasterizeTriangle( const Vec3& screen0, const Vec3& screen1, const Vec3& screen2 )
+{
+    const float area = (screen1.x - screen0.x) * (screen2.y - screen0.y) -
+                       (screen1.y - screen0.y) * (screen2.x - screen0.x);
+    if( fabsf( area ) < 1e-8f )
+    {
+        return;
+    }
+
+    // Occluders are treated as double sided, so flip the edges to a consistent winding
+    const Vec3& v0 = screen0;
+    const Vec3& v1 = area > 0.f ? screen1 : screen2;
+    const Vec3& v2 = area > 0.f ? screen2 : screen1;
+    const float inverseArea = 1.f / fabsf( area );
+
+    const int startX = std::max( static_cast<int>( floorf( std::min( { v0.x, v1.x, v2.x } ) ) ), 0 );
+    const int startY = std::max( static_cast<int>( floorf( std::min( { v0.y, v1.y, v2.y } ) ) ), 0 );
+    const int endX = std::min( static_cast<int>( ceilf( std::max( { v0.x, v1.x, v2.x } ) ) ), m_Resolution.x - 1 );
+    const int endY = std::min( static_cast<int>( ceilf( std::max( { v0.y, v1.y, v2.y } ) ) ), m_Resolution.y - 1 );
+
+    std::vector<float>& depths = m_Levels[ 0 ];
+    for( int y = startY; y <= endY; ++y )
+    {
+        const float pixelY = static_cast<float>( y ) + .5f;
+        for( int x = startX; x <= endX; ++x )
+        {
+            const float pixelX = static_cast<float>( x ) + .5f;
+
+            // Edge functions double as unnormalized barycentric weights
+            const float weight0 = (v2.x - v1.x) * (pixelY - v1.y) - (v2.y - v1.y) * (pixelX - v1.x);
+            const float weight1 = (v0.x - v2.x) * (pixelY - v2.y) - (v0.y - v2.y) * (pixelX - v2.x);
+            const float weight2 = (v1.x - v0.x) * (pixelY - v0.y) - (v1.y - v0.y) * (pixelX - v0.x);
+            if( weight0 < 0.f || weight1 < 0.f || weight2 < 0.f )
+            {
+                continue;
+            }
+
+            const float depth = (weight0 * v0.z + weight1 * v1.z + weight2 * v2.z) * inverseArea;
+            float& stored = depths[ y * m_Resolution.x + x ];
+            if( depth < stored )
+            {
+                stored = depth;
+            }
+        }
+    }
+}
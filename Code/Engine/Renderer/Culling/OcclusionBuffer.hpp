@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/Core/Math/Primatives/Mat44.hpp"
+#include "Engine/Core/Math/Primatives/Vec3.hpp"
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Low resolution software depth buffer used to reject objects hidden behind occluders.
+//  Occluders are rasterized on the CPU, then a max depth pyramid (HiZ) is built so each
+//  test only has to read a handful of texels. Depth follows the D3D convention (0 near, 1 far)
+//
+//  Usage per frame:
+//      BeginFrame( camera.GetWorldToClip() );
+//      RasterizeOccluder( ... ) for each large, cheap occluder
+//      BuildHierarchy();
+//      IsAABBOccluded( ... ) from any thread
+class OcclusionBuffer
+{
+public:
+    explicit OcclusionBuffer( const IntVec2& resolution = IntVec2( 256, 128 ) );
+    ~OcclusionBuffer() = default;
+
+    void BeginFrame( const Mat44& worldToClip );
+    void RasterizeOccluder( const std::vector<Vec3>& positions, const std::vector<unsigned int>& indices,
+                            const Mat44& modelToWorld = Mat44::IDENTITY );
+    void BuildHierarchy();
+
+    bool IsAABBOccluded( const Vec3& center, const Vec3& halfExtents ) const;
+
+    IntVec2 GetResolution() const { return m_Resolution; }
+    unsigned int GetLevelCount() const { return static_cast<unsigned int>( m_Levels.size() ); }
+    float GetDepth( unsigned int level, int x, int y ) const;
+
+private:
+    IntVec2 m_Resolution;
+    Mat44 m_WorldToClip;
+    bool m_IsHierarchyBuilt = false;
+
+    // Level 0 is the full resolution depth, every level after stores the farthest depth of the
+    //  2x2 texels under it
+    std::vector<std::vector<float>> m_Levels;
+    std::vector<IntVec2> m_LevelSizes;
+
+    void RasterizeTriangle( const Vec3& screen0, const Vec3& screen1, const Vec3& screen2 );
+};
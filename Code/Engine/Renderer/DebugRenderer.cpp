@@ -1123,7 +1123,7 @@ DebugWorldPoint::DebugWorldPoint( const Vec3& position, const float size, const
 
 void DebugWorldPoint::RenderObject( RenderContext& ctx, const Camera& currentCamera )
 {
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     const Mat44 cameraRotation = currentCamera.GetCameraModel();
 
     const Rgba8 tint = Rgba8::LerpAsHSL( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
@@ -1154,7 +1154,7 @@ void DebugWorldRay::RenderObject( RenderContext& ctx, const Camera& currentCamer
                                          m_Duration->GetPercentage() );
     const Rgba8 endTint = Rgba8::Lerp( m_EndPointStartColor, m_EndPointEndColor,
                                        m_Duration->GetPercentage() );
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendRay( visual, m_LineSegment, startTint, endTint, m_Thickness );
 
     ctx.DrawVertexArray( visual );
@@ -1183,7 +1183,7 @@ void DebugWorldArrow::RenderObject( RenderContext& ctx, const Camera& currentCam
 
     const float thickness = m_LineSegment.GetLength() * ARROW_THICKNESS_TO_LENGTH;
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     std::vector<unsigned int> index;
     AppendArrow3D( visual, index, m_LineSegment, startTint, endTint, thickness );
 
@@ -1212,7 +1212,7 @@ void DebugWorldBasis::RenderObject( RenderContext& ctx, const Camera& currentCam
     const Vec3 position = m_Basis.GetTranslation3D();
     const float thickness = ARROW_THICKNESS_TO_LENGTH * 2.f;
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     std::vector<unsigned int> index;
     AppendArrow3D( visual, index, LineSeg3D( position, position + m_Basis.GetIBasis3D() ),
                    iBasisColor, thickness );
@@ -1279,7 +1279,7 @@ void DebugWorldText::RenderObject( RenderContext& ctx, const Camera& currentCame
 
     const Rgba8 tint = Rgba8::LerpAsHSL( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     DebugRenderer::m_DebugFont->AddVertsForText3D( visual, m_Text, m_Basis, m_Pivot, m_CellHeight,
                                                    tint, m_CellAspect );
 
@@ -1311,7 +1311,7 @@ void DebugBillboardText::RenderObject( RenderContext& ctx, const Camera& current
 
     const Rgba8 tint = Rgba8::LerpAsHSL( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     DebugRenderer::m_DebugFont->AddVertsForText3D( visual, m_Text, textBasis, m_Pivot, m_CellHeight,
                                                    tint, m_CellAspect );
 
@@ -1347,7 +1347,7 @@ void DebugScreenPoint::RenderObject( RenderContext& ctx, const IntVec2& screenSi
 
     const Rgba8 tint = Rgba8::LerpAsHSL( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendPlaneSegment( visual, Vec3( m_Position ), Vec3::I * m_Size, Vec3::J * m_Size, tint );
 
     ctx.DrawVertexArray( visual );
@@ -1374,7 +1374,7 @@ void DebugScreenLine::RenderObject( RenderContext& ctx, const IntVec2& screenSiz
     const Rgba8 endTint = Rgba8::LerpAsHSL( m_EndPointStartTint, m_StartPointEndTint,
                                        m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendLine( visual, m_LineSegment, startTint, endTint, m_Thickness );
 
     ctx.DrawVertexArray( visual );
@@ -1402,7 +1402,7 @@ void DebugScreenArrow::RenderObject( RenderContext& ctx, const IntVec2& screenSi
 
     const float thickness = m_LineSegment.GetLength() * ARROW_THICKNESS_TO_LENGTH;
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendArrow( visual, m_LineSegment, startTint, endTint, thickness );
 
     ctx.DrawVertexArray( visual );
@@ -1428,7 +1428,7 @@ void DebugScreenQuad::RenderObject( RenderContext& ctx, const IntVec2& screenSiz
     const Vec2 size = m_Bounds.GetDimensions();
     const Rgba8 tint = Rgba8::Lerp( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendPlaneSegment( visual, Vec3( centerPoint ), Vec3::I * size.x, Vec3::J * size.y, tint,
                         m_Uvs.mins, m_Uvs.maxs );
 
@@ -1464,7 +1464,7 @@ void DebugScreenTextObject::RenderObject( RenderContext& ctx, const IntVec2& scr
         cellHeight = screenSizef.y * DebugRenderer::m_ScreenFontHeightPercent;
     }
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     DebugRenderer::m_DebugFont->AddVertsForText( visual, m_Text, textPosition, m_Pivot, cellHeight,
                                                  tint, m_CellAspect );
 
@@ -1494,7 +1494,7 @@ void DebugScreenBasis::RenderObject( RenderContext& ctx, const IntVec2& screenSi
     const Vec3 position = Vec3(static_cast<Vec2>(screenSize) * m_OriginAndOffset.XY() + m_OriginAndOffset.ZW());
     const float thickness = ARROW_THICKNESS_TO_LENGTH * 4.f * m_Scale;
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     std::vector<unsigned int> index;
     AppendArrow3D( visual, index, LineSeg3D( position, position + m_Basis.GetIBasis3D() * m_Scale ),
                    iBasisColor, thickness );
@@ -1520,7 +1520,7 @@ void DebugWorldQuad::RenderObject( RenderContext& ctx, const Camera& currentCame
 
     const Rgba8 tint = Rgba8::LerpAsHSL( m_StartTint, m_EndTint, m_Duration->GetPercentage() );
 
-    std::vector<VertexMaster>visual;
+    std::vector<Vertex_PCU> visual;
     AppendPlaneSegment( visual, m_Basis, tint, m_Size, Vec2::ALIGN_CENTERED, m_Uvs.mins, m_Uvs.maxs );
 
     ctx.BindTexture( m_Texture );
@@ -1546,7 +1546,7 @@ void DebugWorldPlane::RenderObject( RenderContext& ctx, const Camera& currentCam
 
     const LineSeg3D arrow = LineSeg3D( cameraRotation.GetTranslation3D(),
                                        cameraRotation.GetTranslation3D() + Vec3( m_Plane.normal ) );
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     std::vector<unsigned int> indexes;
     AppendArrow3D( visual, indexes, arrow, arrowTint );
     ctx.DrawIndexed( visual, indexes );
@@ -20,7 +20,7 @@ void BitmapFont::Render( RenderContext& renderer,
                          const Rgba8& tint,
                          const float cellAspect ) const
 {
-    std::vector<VertexMaster> textVisual;
+    std::vector<Vertex_PCU> textVisual;
 
     AddVertsForText( textVisual, text, textMins, cellHeight, tint, cellAspect );
     renderer.BindTexture( &m_FontSheet.GetTexture() );
@@ -35,7 +35,7 @@ void BitmapFont::RenderInBox( RenderContext& renderer,
                               const Rgba8& tint,
                               const float cellAspect ) const
 {
-    std::vector<VertexMaster> textVisual;
+    std::vector<Vertex_PCU> textVisual;
 
     AddVertsForTextInBox( textVisual,
                           text,
@@ -49,7 +49,8 @@ void BitmapFont::RenderInBox( RenderContext& renderer,
     renderer.DrawVertexArray( textVisual );
 }
 
-void BitmapFont::AddVertsForText( std::vector<VertexMaster>& vertexArray, const std::string& text,
+template <typename VertexType>
+void BitmapFont::AddVertsForText( std::vector<VertexType>& vertexArray, const std::string& text,
                                   const Vec2& origin, const Vec2& pivot, const float cellHeight,
                                   const Rgba8& tint, const float cellAspect ) const
 {
@@ -87,7 +88,8 @@ void BitmapFont::AddVertsForText( std::vector<VertexMaster>& vertexArray, const
     }
 }
 
-void BitmapFont::AddVertsForText( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AddVertsForText( std::vector<VertexType>& vertexArray,
                                   const std::string& text,
                                   const Vec2& origin,
                                   const float cellHeight,
@@ -98,7 +100,8 @@ void BitmapFont::AddVertsForText( std::vector<VertexMaster>& vertexArray,
                      cellAspect );
 }
 
-void BitmapFont::AddVertsForText3D( std::vector<VertexMaster>& vertexArray, const std::string& text,
+template <typename VertexType>
+void BitmapFont::AddVertsForText3D( std::vector<VertexType>& vertexArray, const std::string& text,
                                     const Mat44& basis, const Vec2& pivot, const float cellHeight,
                                     const Rgba8& tint, const float cellAspect ) const
 {
@@ -121,7 +124,8 @@ void BitmapFont::AddVertsForText3D( std::vector<VertexMaster>& vertexArray, cons
     }
 }
 
-void BitmapFont::AddVertsForTextInBox( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AddVertsForTextInBox( std::vector<VertexType>& vertexArray,
                                        const std::string& text,
                                        const AABB2& box,
                                        const float cellHeight,
@@ -167,7 +171,8 @@ void BitmapFont::AddVertsForTextInBox( std::vector<VertexMaster>& vertexArray,
     }
 }
 
-void BitmapFont::AddVertsForMarkedTextInBox( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AddVertsForMarkedTextInBox( std::vector<VertexType>& vertexArray,
                                              const std::string& text, const AABB2& box,
                                              float cellHeight, const Vec2& alignment,
                                              const Rgba8 tint, float cellAspect ) const
@@ -194,7 +199,8 @@ void BitmapFont::AddVertsForMarkedTextInBox( std::vector<VertexMaster>& vertexAr
                            cellAspect );
 }
 
-void BitmapFont::AddVertsForMarkedText( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AddVertsForMarkedText( std::vector<VertexType>& vertexArray,
                                         const std::string& text,
                                         const Vec2& textMins, float cellHeight,
                                         const Rgba8& tint, float cellAspect ) const
@@ -289,7 +295,8 @@ BitmapFont::BitmapFont( const char* fontName, const Texture* fontTexture, float
 {
 }
 
-void BitmapFont::AppendCharacterToVector( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AppendCharacterToVector( std::vector<VertexType>& vertexArray,
                                           unsigned char character,
                                           const Vec2& characterBottomLeft,
                                           float cellHeight,
@@ -323,7 +330,8 @@ void BitmapFont::AppendCharacterToVector( std::vector<VertexMaster>& vertexArray
     AppendAABB2( vertexArray, characterBox, tint, uvMin, uvMax );
 }
 
-void BitmapFont::AppendCharacterToVector3D( std::vector<VertexMaster>& vertexArray,
+template <typename VertexType>
+void BitmapFont::AppendCharacterToVector3D( std::vector<VertexType>& vertexArray,
                                             const unsigned char character,
                                             const Mat44& basis, const float cellHeight,
                                             const Rgba8& tint,
@@ -365,3 +373,22 @@ void BitmapFont::AppendCharacterToVector3D( std::vector<VertexMaster>& vertexArr
     AppendPlaneSegment( vertexArray, basis, tint, Vec2( cellHeight * cellAspect, cellHeight ),
                         Vec2::ZERO, uvMin, uvMax );
 }
+
+//-----------------------------------------------------------------------------
+#define INSTANTIATE_BITMAP_FONT( VertexType )                                                                               \
+    template void BitmapFont::AddVertsForText( std::vector<VertexType>&, const std::string&, const Vec2&, const Vec2&,    \
+                                               float, const Rgba8&, float ) const;                                         \
+    template void BitmapFont::AddVertsForText( std::vector<VertexType>&, const std::string&, const Vec2&, float,          \
+                                               const Rgba8&, float ) const;                                                \
+    template void BitmapFont::AddVertsForText3D( std::vector<VertexType>&, const std::string&, const Mat44&, const Vec2&, \
+                                                 float, const Rgba8&, float ) const;                                       \
+    template void BitmapFont::AddVertsForTextInBox( std::vector<VertexType>&, const std::string&, const AABB2&, float,    \
+                                                    const Vec2&, const Rgba8&, float ) const;                              \
+    template void BitmapFont::AddVertsForMarkedTextInBox( std::vector<VertexType>&, const std::string&, const AABB2&,     \
+                                                          float, const Vec2&, Rgba8, float ) const;                        \
+    template void BitmapFont::AddVertsForMarkedText( std::vector<VertexType>&, const std::string&, const Vec2&, float,    \
+                                                     const Rgba8&, float ) const;
+
+INSTANTIATE_BITMAP_FONT( VertexMaster )
+INSTANTIATE_BITMAP_FONT( Vertex_PCU )
+INSTANTIATE_BITMAP_FONT( Vertex_PCUTBN )
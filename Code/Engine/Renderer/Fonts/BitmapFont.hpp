@@ -4,6 +4,7 @@
 
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
 
 #include "Engine/Renderer/Sprite/SpriteSheet.hpp"
 
@@ -16,6 +17,7 @@ constexpr int SPACE_PER_TAB = 4;
 
 class BitmapFont
 {
+    friend class AsyncAssetLoader;
     friend class RenderContext;
 public:
 
@@ -36,21 +38,25 @@ public:
                       const Rgba8& tint = Rgba8::WHITE,
                       float cellAspect = .56f ) const;
 
-    void AddVertsForText( std::vector<VertexMaster>& vertexArray,
+    // Vertex builders are instantiated for VertexMaster, Vertex_PCU, and Vertex_PCUTBN
+    template <typename VertexType>
+    void AddVertsForText( std::vector<VertexType>& vertexArray,
                           const std::string& text,
                           const Vec2& origin,
                           const Vec2& pivot,
                           float cellHeight,
                           const Rgba8& tint = Rgba8::WHITE,
                           float cellAspect = .56f ) const;
-    void AddVertsForText( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AddVertsForText( std::vector<VertexType>& vertexArray,
                           const std::string& text,
                           const Vec2& origin,
                           float cellHeight,
                           const Rgba8& tint = Rgba8::WHITE,
                           float cellAspect = .56f ) const;
 
-    void AddVertsForText3D( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AddVertsForText3D( std::vector<VertexType>& vertexArray,
                             const std::string& text,
                             const Mat44& basis,
                             const Vec2& pivot,
@@ -58,7 +64,8 @@ public:
                             const Rgba8& tint = Rgba8::WHITE,
                             float cellAspect = .56f ) const;
 
-    void AddVertsForTextInBox( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AddVertsForTextInBox( std::vector<VertexType>& vertexArray,
                                const std::string& text,
                                const AABB2& box,
                                float cellHeight,
@@ -66,7 +73,8 @@ public:
                                const Rgba8& tint = Rgba8::WHITE,
                                float cellAspect = .56f ) const;
 
-    void AddVertsForMarkedTextInBox( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AddVertsForMarkedTextInBox( std::vector<VertexType>& vertexArray,
                                      const std::string& text,
                                      const AABB2& box,
                                      float cellHeight,
@@ -74,7 +82,8 @@ public:
                                      Rgba8 tint = Rgba8::WHITE,
                                      float cellAspect = .56f ) const;
 
-    void AddVertsForMarkedText( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AddVertsForMarkedText( std::vector<VertexType>& vertexArray,
                                 const std::string& text,
                                 const Vec2& textMins,
                                 float cellHeight,
@@ -104,13 +113,15 @@ private:
                 const Texture* fontTexture,
                 float aspect = .56f );
 
-    void AppendCharacterToVector( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AppendCharacterToVector( std::vector<VertexType>& vertexArray,
                                   unsigned char character,
                                   const Vec2& characterBottomLeft,
                                   float cellHeight,
                                   const Rgba8& tint = Rgba8::WHITE,
                                   float cellAspect = 1.f ) const;
-    void AppendCharacterToVector3D( std::vector<VertexMaster>& vertexArray,
+    template <typename VertexType>
+    void AppendCharacterToVector3D( std::vector<VertexType>& vertexArray,
                                   unsigned char character,
                                   const Mat44& basis,
                                   float cellHeight,
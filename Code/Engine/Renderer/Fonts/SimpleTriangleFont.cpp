@@ -35,7 +35,8 @@ const char* g_triTextFontData[ TRITEXT_NUM_ROWS ] =
 
 
 //------------------------------------------------------------------------------------------------
-void AppendGlyphTriangles2D( std::vector<VertexMaster>& verts, char glyph, const Vec2& cellMins, const Vec2& pixelSize, const Rgba8& color )
+template <typename VertexType>
+static void AppendGlyphTriangles2D( std::vector<VertexType>& verts, char glyph, const Vec2& cellMins, const Vec2& pixelSize, const Rgba8& color )
 {
 	if( glyph < TRITEXT_FIRST_ASCII || glyph > TRITEXT_LAST_ASCII )
 		return;
@@ -65,14 +66,15 @@ void AppendGlyphTriangles2D( std::vector<VertexMaster>& verts, char glyph, const
 //------------------------------------------------------------------------------------------------
 void DrawTextTriangles2D( RenderContext& renderer, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect, float spacingFraction )
 {
-	std::vector<VertexMaster> verts;
+	std::vector<Vertex_PCU> verts;
 	AppendTextTriangles2D( verts, text, startMins, cellHeight, color, cellAspect, spacingFraction );
 	renderer.DrawVertexArray( verts );
 }
 
 
 //------------------------------------------------------------------------------------------------
-void AppendTextTriangles2D( std::vector<VertexMaster>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect, float spacingFraction )
+template <typename VertexType>
+void AppendTextTriangles2D( std::vector<VertexType>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect, float spacingFraction )
 {
 	size_t estimatedNumberOfNewVerts = text.length() * TRITEXT_PIX_WIDE * TRITEXT_PIX_HIGH * (6 / 2); // assumes (liberally) that fewer than half of a glyph's pixels are lit on average
 	verts.reserve( verts.size() + estimatedNumberOfNewVerts );
@@ -96,3 +98,6 @@ void AppendTextTriangles2D( std::vector<VertexMaster>& verts, const std::string&
 }
 
 
+//------------------------------------------------------------------------------------------------
+template void AppendTextTriangles2D( std::vector<VertexMaster>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect, float spacingFraction );
+template void AppendTextTriangles2D( std::vector<Vertex_PCU>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect, float spacingFraction );
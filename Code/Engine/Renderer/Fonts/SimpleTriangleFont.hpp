@@ -13,4 +13,6 @@ struct Vec2;
 
 //------------------------------------------------------------------------------------------------
 void DrawTextTriangles2D( RenderContext& renderer, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect = 0.56f, float spacingFraction = 0.2f );
-void AppendTextTriangles2D( std::vector<VertexMaster>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect = 0.56f, float spacingFraction = 0.2f );
+// Instantiated for VertexMaster and Vertex_PCU
+template <typename VertexType>
+void AppendTextTriangles2D( std::vector<VertexType>& verts, const std::string& text, const Vec2& startMins, float cellHeight, const Rgba8& color, float cellAspect = 0.56f, float spacingFraction = 0.2f );
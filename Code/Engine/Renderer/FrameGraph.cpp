@@ -0,0 +1,386 @@
+#include "FrameGraph.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+// Declaration
+FrameGraphResource FrameGraph::ImportTexture( const std::string& name, Texture* texture )
+{
+    ResourceNode resource;
+    resource.name = name;
+    resource.importedTexture = texture;
+    resource.isImported = true;
+    m_Resources.push_back( resource );
+    m_IsCompiled = false;
+    return static_cast<FrameGraphResource>( m_Resources.size() - 1 );
+}
+
+FrameGraphResource FrameGraph::CreateTransient( const std::string& name, const RenderTargetDescription& description )
+{
+    ResourceNode resource;
+    resource.name = name;
+    resource.description = description;
+    m_Resources.push_back( resource );
+    m_IsCompiled = false;
+    return static_cast<FrameGraphResource>( m_Resources.size() - 1 );
+}
+
+unsigned int FrameGraph::AddPass( const std::string& name, const std::vector<FrameGraphResource>& reads,
+                                  const std::vector<FrameGraphResource>& writes,
+                                  const FrameGraphExecuteFunction& execute, const bool hasSideEffects )
+{
+    PassNode pass;
+    pass.name = name;
+    pass.reads = reads;
+    pass.writes = writes;
+    pass.execute = execute;
+    pass.hasSideEffects = hasSideEffects;
+    m_Passes.push_back( pass );
+    m_IsCompiled = false;
+    return static_cast<unsigned int>( m_Passes.size() - 1 );
+}
+
+unsigned int FrameGraph::AddEffectPass( const std::string& name, const FrameGraphResource dst,
+                                        const FrameGraphResource src, ShaderProgram* shader )
+{
+    return AddPass( name, { src }, { dst },
+                    [dst, src, shader]( RenderContext& ctx, const FrameGraph& graph )
+                    {
+                        ctx.StartEffect( graph.GetTexture( dst ), graph.GetTexture( src ), shader );
+                        ctx.EndEffect();
+                    } );
+}
+
+unsigned int FrameGraph::AddEffectPass( const std::string& name, const FrameGraphResource dst,
+                                        const FrameGraphResource src, Material* material )
+{
+    return AddPass( name, { src }, { dst },
+                    [dst, src, material]( RenderContext& ctx, const FrameGraph& graph )
+                    {
+                        ctx.StartEffect( graph.GetTexture( dst ), graph.GetTexture( src ), material );
+                        ctx.EndEffect();
+                    } );
+}
+
+//-----------------------------------------------------------------------------
+// Compile
+void FrameGraph::Compile()
+{
+    BuildDependencies();
+    CullPasses();
+    SchedulePasses();
+    AliasTransients();
+    m_IsCompiled = true;
+}
+
+void FrameGraph::Execute( RenderContext& ctx )
+{
+    if( !m_IsCompiled )
+    {
+        Compile();
+    }
+
+    for( PhysicalTarget& target : m_PhysicalTargets )
+    {
+        target.texture = ctx.AcquireRenderTarget( target.description );
+    }
+
+    for( const unsigned int passIndex : m_ExecutionOrder )
+    {
+        const PassNode& pass = m_Passes[ passIndex ];
+        if( pass.execute )
+        {
+            pass.execute( ctx, *this );
+        }
+    }
+
+    for( PhysicalTarget& target : m_PhysicalTargets )
+    {
+        ctx.ReleaseRenderTarget( target.texture );
+        target.texture = nullptr;
+    }
+}
+
+void FrameGraph::Reset()
+{
+    m_Resources.clear();
+    m_Passes.clear();
+    m_ExecutionOrder.clear();
+    m_PhysicalTargets.clear();
+    m_IsCompiled = false;
+}
+
+Texture* FrameGraph::GetTexture( const FrameGraphResource resource ) const
+{
+    const ResourceNode& node = m_Resources[ resource ];
+    if( node.isImported )
+    {
+        return node.importedTexture;
+    }
+    if( node.physicalTarget == FRAME_GRAPH_INVALID )
+    {
+        return nullptr;
+    }
+    return m_PhysicalTargets[ node.physicalTarget ].texture;
+}
+
+void FrameGraph::BuildDependencies()
+{
+    // Walking in submission order, track who last wrote each resource and who read that version
+    std::vector<unsigned int> lastWriter( m_Resources.size(), FRAME_GRAPH_INVALID );
+    std::vector<std::vector<unsigned int>> readersSinceWrite( m_Resources.size() );
+
+    for( unsigned int passIndex = 0; passIndex < m_Passes.size(); ++passIndex )
+    {
+        PassNode& pass = m_Passes[ passIndex ];
+        pass.dataDependencies.clear();
+        pass.orderDependencies.clear();
+        pass.isCulled = false;
+
+        for( const FrameGraphResource read : pass.reads )
+        {
+            const ResourceNode& resource = m_Resources[ read ];
+            GUARANTEE_OR_DIE( resource.isImported || lastWriter[ read ] != FRAME_GRAPH_INVALID,
+                              Stringf( "FrameGraph::Compile - Pass %s reads transient %s before anything writes it",
+                                       pass.name.c_str(), resource.name.c_str() ) );
+            if( lastWriter[ read ] != FRAME_GRAPH_INVALID && lastWriter[ read ] != passIndex )
+            {
+                pass.dataDependencies.push_back( lastWriter[ read ] );
+            }
+        }
+
+        for( const FrameGraphResource write : pass.writes )
+        {
+            // Earlier contents may be partially kept, and earlier readers need the old contents
+            if( lastWriter[ write ] != FRAME_GRAPH_INVALID && lastWriter[ write ] != passIndex )
+            {
+                pass.dataDependencies.push_back( lastWriter[ write ] );
+            }
+            for( const unsigned int reader : readersSinceWrite[ write ] )
+            {
+                if( reader != passIndex )
+                {
+                    pass.orderDependencies.push_back( reader );
+                }
+            }
+        }
+
+        for( const FrameGraphResource read : pass.reads )
+        {
+            readersSinceWrite[ read ].push_back( passIndex );
+        }
+        for( const FrameGraphResource write : pass.writes )
+        {
+            lastWriter[ write ] = passIndex;
+            readersSinceWrite[ write ].clear();
+        }
+    }
+}
+
+void FrameGraph::CullPasses()
+{
+    std::vector<unsigned char> isNeeded( m_Passes.size(), 0 );
+    std::vector<unsigned int> openList;
+
+    for( unsigned int passIndex = 0; passIndex < m_Passes.size(); ++passIndex )
+    {
+        const PassNode& pass = m_Passes[ passIndex ];
+        bool writesImported = false;
+        for( const FrameGraphResource write : pass.writes )
+        {
+            writesImported = writesImported || m_Resources[ write ].isImported;
+        }
+
+        if( pass.hasSideEffects || writesImported )
+        {
+            isNeeded[ passIndex ] = 1;
+            openList.push_back( passIndex );
+        }
+    }
+
+    while( !openList.empty() )
+    {
+        const unsigned int passIndex = openList.back();
+        openList.pop_back();
+        for( const unsigned int dependency : m_Passes[ passIndex ].dataDependencies )
+        {
+            if( !isNeeded[ dependency ] )
+            {
+                isNeeded[ dependency ] = 1;
+                openList.push_back( dependency );
+            }
+        }
+    }
+
+    for( unsigned int passIndex = 0; passIndex < m_Passes.size(); ++passIndex )
+    {
+        m_Passes[ passIndex ].isCulled = !isNeeded[ passIndex ];
+    }
+}
+
+void FrameGraph::SchedulePasses()
+{
+    m_ExecutionOrder.clear();
+
+    std::vector<unsigned int> unmetDependencies( m_Passes.size(), 0 );
+    std::vector<std::vector<unsigned int>> dependents( m_Passes.size() );
+    std::vector<unsigned int> remainingUses( m_Resources.size(), 0 );
+
+    unsigned int survivingPasses = 0;
+    for( unsigned int passIndex = 0; passIndex < m_Passes.size(); ++passIndex )
+    {
+        const PassNode& pass = m_Passes[ passIndex ];
+        if( pass.isCulled )
+        {
+            continue;
+        }
+        ++survivingPasses;
+
+        for( const std::vector<unsigned int>* dependencies : { &pass.dataDependencies, &pass.orderDependencies } )
+        {
+            for( const unsigned int dependency : *dependencies )
+            {
+                if( !m_Passes[ dependency ].isCulled )
+                {
+                    ++unmetDependencies[ passIndex ];
+                    dependents[ dependency ].push_back( passIndex );
+                }
+            }
+        }
+        for( const FrameGraphResource read : pass.reads ) { ++remainingUses[ read ]; }
+        for( const FrameGraphResource write : pass.writes ) { ++remainingUses[ write ]; }
+    }
+
+    std::vector<unsigned int> readyPasses;
+    for( unsigned int passIndex = 0; passIndex < m_Passes.size(); ++passIndex )
+    {
+        if( !m_Passes[ passIndex ].isCulled && unmetDependencies[ passIndex ] == 0 )
+        {
+            readyPasses.push_back( passIndex );
+        }
+    }
+
+    // Resources a candidate pass would be the last user of, each once however often the pass lists it
+    std::vector<FrameGraphResource> lastUses;
+    while( !readyPasses.empty() )
+    {
+        // Prefer the ready pass that ends the most transient lifetimes, then submission order
+        size_t bestReady = 0;
+        int bestFreed = -1;
+        for( size_t readyIndex = 0; readyIndex < readyPasses.size(); ++readyIndex )
+        {
+            const PassNode& pass = m_Passes[ readyPasses[ readyIndex ] ];
+            lastUses.clear();
+            for( const std::vector<FrameGraphResource>* resources : { &pass.reads, &pass.writes } )
+            {
+                for( const FrameGraphResource resource : *resources )
+                {
+                    if( m_Resources[ resource ].isImported ||
+                        std::find( lastUses.begin(), lastUses.end(), resource ) != lastUses.end() )
+                    {
+                        continue;
+                    }
+
+                    const unsigned int usesByPass =
+                        static_cast<unsigned int>( std::count( pass.reads.begin(), pass.reads.end(), resource ) +
+                                                   std::count( pass.writes.begin(), pass.writes.end(), resource ) );
+                    if( remainingUses[ resource ] == usesByPass )
+                    {
+                        lastUses.push_back( resource );
+                    }
+                }
+            }
+            const int freed = static_cast<int>( lastUses.size() );
+            if( freed > bestFreed || (freed == bestFreed && readyPasses[ readyIndex ] < readyPasses[ bestReady ]) )
+            {
+                bestFreed = freed;
+                bestReady = readyIndex;
+            }
+        }
+
+        const unsigned int passIndex = readyPasses[ bestReady ];
+        readyPasses.erase( readyPasses.begin() + bestReady );
+        m_ExecutionOrder.push_back( passIndex );
+
+        const PassNode& pass = m_Passes[ passIndex ];
+        for( const FrameGraphResource read : pass.reads ) { --remainingUses[ read ]; }
+        for( const FrameGraphResource write : pass.writes ) { --remainingUses[ write ]; }
+
+        for( const unsigned int dependent : dependents[ passIndex ] )
+        {
+            if( --unmetDependencies[ dependent ] == 0 )
+            {
+                readyPasses.push_back( dependent );
+            }
+        }
+    }
+
+    GUARANTEE_OR_DIE( m_ExecutionOrder.size() == survivingPasses, "FrameGraph::Compile - Pass dependencies form a cycle" );
+}
+
+void FrameGraph::AliasTransients()
+{
+    for( ResourceNode& resource : m_Resources )
+    {
+        resource.physicalTarget = FRAME_GRAPH_INVALID;
+        resource.firstUse = FRAME_GRAPH_INVALID;
+        resource.lastUse = 0;
+    }
+
+    for( unsigned int orderIndex = 0; orderIndex < m_ExecutionOrder.size(); ++orderIndex )
+    {
+        const PassNode& pass = m_Passes[ m_ExecutionOrder[ orderIndex ] ];
+        for( const std::vector<FrameGraphResource>* resources : { &pass.reads, &pass.writes } )
+        {
+            for( const FrameGraphResource resourceIndex : *resources )
+            {
+                ResourceNode& resource = m_Resources[ resourceIndex ];
+                resource.firstUse = std::min( resource.firstUse, orderIndex );
+                resource.lastUse = std::max( resource.lastUse, orderIndex );
+            }
+        }
+    }
+
+    // Hand out physical targets in order of first use, reusing any whose last user already ran
+    std::vector<FrameGraphResource> transients;
+    for( FrameGraphResource resourceIndex = 0; resourceIndex < m_Resources.size(); ++resourceIndex )
+    {
+        const ResourceNode& resource = m_Resources[ resourceIndex ];
+        if( !resource.isImported && resource.firstUse != FRAME_GRAPH_INVALID )
+        {
+            transients.push_back( resourceIndex );
+        }
+    }
+    std::sort( transients.begin(), transients.end(), [this]( const FrameGraphResource lhs, const FrameGraphResource rhs )
+    {
+        return m_Resources[ lhs ].firstUse < m_Resources[ rhs ].firstUse;
+    } );
+
+    m_PhysicalTargets.clear();
+    for( const FrameGraphResource resourceIndex : transients )
+    {
+        ResourceNode& resource = m_Resources[ resourceIndex ];
+        for( unsigned int targetIndex = 0; targetIndex < m_PhysicalTargets.size(); ++targetIndex )
+        {
+            PhysicalTarget& target = m_PhysicalTargets[ targetIndex ];
+            if( target.description == resource.description && target.lastUse < resource.firstUse )
+            {
+                resource.physicalTarget = targetIndex;
+                target.lastUse = resource.lastUse;
+                break;
+            }
+        }
+
+        if( resource.physicalTarget == FRAME_GRAPH_INVALID )
+        {
+            PhysicalTarget target;
+            target.description = resource.description;
+            target.lastUse = resource.lastUse;
+            resource.physicalTarget = static_cast<unsigned int>( m_PhysicalTargets.size() );
+            m_PhysicalTargets.push_back( target );
+        }
+    }
+}
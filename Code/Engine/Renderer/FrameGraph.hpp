@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Engine/Renderer/RenderTargetPool.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class FrameGraph;
+class Material;
+class RenderContext;
+class ShaderProgram;
+class Texture;
+
+typedef unsigned int FrameGraphResource;
+typedef std::function<void( RenderContext& ctx, const FrameGraph& graph )> FrameGraphExecuteFunction;
+
+constexpr unsigned int FRAME_GRAPH_INVALID = ~0u;
+
+//-----------------------------------------------------------------------------
+// Declarative replacement for hand managed StartEffect/EndEffect chains. Every frame:
+//      1. Import the textures that live outside the graph (back buffer, camera targets)
+//      2. Create transients by description, the graph owns their lifetime
+//      3. Add passes with the resources they read and write
+//      4. Compile, then Execute
+//
+//  A read sees the most recent write submitted before it. Compile culls passes whose writes
+//  never reach an imported texture or a side effect pass, reorders the rest to end transient
+//  lifetimes early, and aliases transients with matching descriptions onto one physical target
+//  when their lifetimes do not overlap. Compile never touches the GPU
+class FrameGraph
+{
+public:
+    FrameGraph() = default;
+    ~FrameGraph() = default;
+
+    FrameGraphResource ImportTexture( const std::string& name, Texture* texture );
+    FrameGraphResource CreateTransient( const std::string& name, const RenderTargetDescription& description );
+
+    unsigned int AddPass( const std::string& name, const std::vector<FrameGraphResource>& reads,
+                          const std::vector<FrameGraphResource>& writes,
+                          const FrameGraphExecuteFunction& execute, bool hasSideEffects = false );
+    unsigned int AddEffectPass( const std::string& name, FrameGraphResource dst, FrameGraphResource src,
+                                ShaderProgram* shader );
+    unsigned int AddEffectPass( const std::string& name, FrameGraphResource dst, FrameGraphResource src,
+                                Material* material );
+
+    void Compile();
+    void Execute( RenderContext& ctx );
+    void Reset();
+
+    // Valid while executing
+    Texture* GetTexture( FrameGraphResource resource ) const;
+
+    //-------------------------------------------------------------------------
+    // Compiled Results
+    unsigned int GetPassCount() const { return static_cast<unsigned int>( m_Passes.size() ); }
+    bool IsPassCulled( unsigned int passIndex ) const { return m_Passes[ passIndex ].isCulled; }
+    const std::vector<unsigned int>& GetExecutionOrder() const { return m_ExecutionOrder; }
+    unsigned int GetPhysicalTarget( FrameGraphResource resource ) const { return m_Resources[ resource ].physicalTarget; }
+    unsigned int GetPhysicalTargetCount() const { return static_cast<unsigned int>( m_PhysicalTargets.size() ); }
+
+private:
+    struct ResourceNode
+    {
+        std::string name;
+        RenderTargetDescription description;
+        Texture* importedTexture = nullptr;
+        bool isImported = false;
+
+        unsigned int physicalTarget = FRAME_GRAPH_INVALID;
+        unsigned int firstUse = FRAME_GRAPH_INVALID;
+        unsigned int lastUse = 0;
+    };
+
+    struct PassNode
+    {
+        std::string name;
+        std::vector<FrameGraphResource> reads;
+        std::vector<FrameGraphResource> writes;
+        FrameGraphExecuteFunction execute;
+        bool hasSideEffects = false;
+
+        // Passes whose output this pass consumes, and passes that only have to run first
+        std::vector<unsigned int> dataDependencies;
+        std::vector<unsigned int> orderDependencies;
+        bool isCulled = false;
+    };
+
+    struct PhysicalTarget
+    {
+        RenderTargetDescription description;
+        unsigned int lastUse = 0;
+        Texture* texture = nullptr;
+    };
+
+    std::vector<ResourceNode> m_Resources;
+    std::vector<PassNode> m_Passes;
+    std::vector<unsigned int> m_ExecutionOrder;
+    std::vector<PhysicalTarget> m_PhysicalTargets;
+    bool m_IsCompiled = false;
+
+    void BuildDependencies();
+    void CullPasses();
+    void SchedulePasses();
+    void AliasTransients();
+};
@@ -1,5 +1,7 @@
 #include "GPUMesh.hpp"
 
+#include "Engine/Renderer/Camera.hpp"
+
 GPUMesh::GPUMesh( RenderContext* ctx )
     : m_Owner( ctx )
 {
@@ -61,3 +63,61 @@ void GPUMesh::UpdateVertexes( const Vertex_PCUTBN* vertexes, const unsigned int
     VertexBuffer<Vertex_PCUTBN>* test = VertexBuffer<Vertex_PCUTBN>::FromRenderBuffer( m_VertexBuffer );
     test->AppendLocalBuffer( vertexes, count );
 }
+
+void GPUMesh::UpdateLods( const std::vector<std::vector<unsigned int>>& lodIndexes,
+                          const std::vector<float>& lodErrors )
+{
+    GUARANTEE_OR_DIE( lodIndexes.size() == lodErrors.size(), "GPUMesh::UpdateLods - Every LOD needs an error" );
+
+    // Rebuilt from LOD 0 every call so a new chain never stacks on top of the old one
+    m_IndexBuffer->ClearLocalBuffer();
+    m_Lods.clear();
+    m_Lods.reserve( lodIndexes.size() );
+    for( size_t lodIndex = 0; lodIndex < lodIndexes.size(); ++lodIndex )
+    {
+        MeshLod lod;
+        lod.indexStart = static_cast<unsigned int>( GetIndexCount() );
+        lod.indexCount = static_cast<unsigned int>( lodIndexes[ lodIndex ].size() );
+        lod.error = lodErrors[ lodIndex ];
+        m_Lods.push_back( lod );
+
+        UpdateIndexes( lodIndexes[ lodIndex ] );
+    }
+}
+
+unsigned int GPUMesh::GetLodCount() const
+{
+    return m_Lods.empty() ? 1 : static_cast<unsigned int>( m_Lods.size() );
+}
+
+MeshLod GPUMesh::GetLod( const unsigned int lodIndex ) const
+{
+    // Meshes without a chain are a single LOD covering the whole buffer
+    if( m_Lods.empty() )
+    {
+        MeshLod wholeMesh;
+        wholeMesh.indexCount = static_cast<unsigned int>( GetIndexCount() );
+        return wholeMesh;
+    }
+
+    return m_Lods[ lodIndex < m_Lods.size() ? lodIndex : m_Lods.size() - 1 ];
+}
+
+unsigned int GPUMesh::SelectLod( const Camera& camera, const Vec3& worldCenter, const float worldScale,
+                                 const float maxPixelError ) const
+{
+    if( m_Lods.size() <= 1 )
+    {
+        return 0;
+    }
+
+    const float pixelsPerUnit = camera.GetProjectedSize( worldCenter, worldScale );
+    for( size_t lodIndex = m_Lods.size() - 1; lodIndex > 0; --lodIndex )
+    {
+        if( m_Lods[ lodIndex ].error * pixelsPerUnit <= maxPixelError )
+        {
+            return static_cast<unsigned int>( lodIndex );
+        }
+    }
+    return 0;
+}
@@ -6,7 +6,10 @@
 #include "Buffers/IndexBuffer.hpp"
 #include "Buffers/VertexBuffer.hpp"
 
+template <typename AssetType> class AsyncAsset;
+struct MeshData;
 struct MeshLoadOptions;
+class Camera;
 class RenderContext;
 class RenderBuffer;
 
@@ -15,6 +18,14 @@ typedef float(SurfaceFunction)( const Vec2& uv );
 
 struct BufferAttribute;
 
+// Range of the index buffer drawn for one level of detail. error is in mesh units
+struct MeshLod
+{
+    unsigned int indexStart = 0;
+    unsigned int indexCount = 0;
+    float error = 0.f;
+};
+
 //TODO: Template to support vertex_pcu and vertex_pcutbn
 class GPUMesh
 {
@@ -23,6 +34,10 @@ public:
     ~GPUMesh();
 
     static GPUMesh* CreateFromFile( RenderContext* ctx, const std::string& fileName, const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
+    // Parses or reads the cooked mesh on a worker and uploads during RenderContext::BeginFrame
+    static AsyncAsset<GPUMesh>* CreateFromFileAsync( RenderContext* ctx, const std::string& fileName, const MeshLoadOptions& meshLoadOptions = MeshLoadOptions() );
+    // GPU half of CreateFromFile, see LoadMeshDataFromFile
+    static GPUMesh* CreateFromMeshData( RenderContext* ctx, const MeshData& meshData );
 
     static GPUMesh* CreateCube( RenderContext* ctx, const Vec3& halfSize,
                                 const Rgba8& tint = Rgba8::WHITE );
@@ -50,9 +65,26 @@ public:
     void UpdateIndexes( const std::vector<unsigned int>& indexes );
     void UpdateIndexes( const unsigned int* indexes, unsigned int count );
 
+    //-------------------------------------------------------------------------
+    // Level of Detail
+    // Replaces the index buffer with every LOD back to back, LOD 0 being the base indexes.
+    //  All LODs index the same vertexes
+    void UpdateLods( const std::vector<std::vector<unsigned int>>& lodIndexes, const std::vector<float>& lodErrors );
+    // Ranges into indexes that are already in the index buffer
+    void SetLods( const std::vector<MeshLod>& lods ) { m_Lods = lods; }
+    const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+    unsigned int GetLodCount() const;
+    MeshLod GetLod( unsigned int lodIndex ) const;
+
+    // Coarsest LOD whose error covers at most maxPixelError pixels on camera's target when the
+    //  mesh is drawn at worldCenter with a uniform worldScale
+    unsigned int SelectLod( const Camera& camera, const Vec3& worldCenter, float worldScale = 1.f,
+                            float maxPixelError = 1.f ) const;
+
 private:
     RenderContext* m_Owner = nullptr;
     VertexBuffer<Vertex_PCUTBN>* m_VertexBuffer = nullptr;
     IndexBuffer* m_IndexBuffer = nullptr;
 
+    std::vector<MeshLod> m_Lods;
 };
\ No newline at end of file
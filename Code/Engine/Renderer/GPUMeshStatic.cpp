@@ -1,7 +1,10 @@
 #include "Engine/Core/Engine.hpp"
 #include "Engine/Core/Math/Primatives/LineSeg3D.hpp"
 #include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
+#include "Engine/IO/CookedMeshUtils.hpp"
 #include "Engine/IO/ObjFileUtils.hpp"
+#include "Engine/Renderer/AsyncAssetLoader.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
 
 
 #include "GPUMesh.hpp"
@@ -88,7 +91,8 @@ static float SurfaceFunctionZero( const Vec2& uv )
     return 0.f;
 }
 
-static void MakeSurface( std::vector<VertexMaster>& planeVertexes,
+template <typename VertexType>
+static void MakeSurface( std::vector<VertexType>& planeVertexes,
                          std::vector<unsigned int>& planeIndexes,
                          const Vec2& halfSize, const Vec2& splits,
                          const Rgba8& color,
@@ -158,7 +162,8 @@ static void MakeSurface( std::vector<VertexMaster>& planeVertexes,
     while ( ySteps <= splits.x + 1 );
 }
 
-static void MakeSphereUv( std::vector<VertexMaster>& planeVertexes,
+template <typename VertexType>
+static void MakeSphereUv( std::vector<VertexType>& planeVertexes,
                           std::vector<unsigned int>& planeIndexes,
                           const float radius, const Vec2& lines,
                           const Rgba8& color )
@@ -230,17 +235,35 @@ static void MakeSphereUv( std::vector<VertexMaster>& planeVertexes,
 STATIC GPUMesh* GPUMesh::CreateFromFile( RenderContext* ctx, const std::string& fileName, 
                                          const MeshLoadOptions& meshLoadOptions )
 {
-    GPUMesh* mesh = new GPUMesh( ctx );
-    std::vector<VertexMaster> vertexMaster;
-    std::vector<unsigned int> indexes;
+    MeshData meshData;
+    const bool loaded = LoadMeshDataFromFile( fileName, meshLoadOptions, meshData );
+    GUARANTEE_OR_DIE( loaded, Stringf( "GPUMesh::CreateFromFile - Failed to open file %s", fileName.c_str() ) );
 
-    LoadFromObjFile( fileName, vertexMaster, indexes, meshLoadOptions );
+    return CreateFromMeshData( ctx, meshData );
+}
 
-    std::vector<Vertex_PCUTBN> vertexPCUTBN;
-    Vertex_PCUTBN::ConvertFromMaster( vertexPCUTBN, vertexMaster );
-    mesh->UpdateVertexes( vertexPCUTBN );
-    mesh->UpdateIndexes( indexes );
+STATIC AsyncAsset<GPUMesh>* GPUMesh::CreateFromFileAsync( RenderContext* ctx, const std::string& fileName,
+                                                         const MeshLoadOptions& meshLoadOptions )
+{
+    return ctx->GetAsyncAssetLoader()->CreateMesh( fileName, meshLoadOptions );
+}
 
+STATIC GPUMesh* GPUMesh::CreateFromMeshData( RenderContext* ctx, const MeshData& meshData )
+{
+    GPUMesh* mesh = new GPUMesh( ctx );
+
+    const CookedMesh& cookedMesh = meshData.cookedMesh;
+    if( cookedMesh.IsOpen() )
+    {
+        mesh->UpdateVertexes( cookedMesh.GetVertexes(), cookedMesh.GetVertexCount() );
+        mesh->UpdateIndexes( cookedMesh.GetIndexes(), cookedMesh.GetIndexCount() );
+        mesh->SetLods( std::vector<MeshLod>( cookedMesh.GetLods(), cookedMesh.GetLods() + cookedMesh.GetLodCount() ) );
+        return mesh;
+    }
+
+    mesh->UpdateVertexes( meshData.vertexes );
+    mesh->UpdateIndexes( meshData.indexes );
+    mesh->SetLods( meshData.lods );
     return mesh;
 }
 
@@ -248,21 +271,19 @@ STATIC GPUMesh* GPUMesh::CreateFromFile( RenderContext* ctx, const std::string&
 STATIC GPUMesh* GPUMesh::CreateCube( RenderContext* ctx, const Vec3& halfSize, const Rgba8& tint )
 {
     GPUMesh* cube = new GPUMesh( ctx );
-    std::vector<VertexMaster> cubeVertexes;
+    std::vector<Vertex_PCUTBN> cubeVertexes;
+    cubeVertexes.reserve( sizeof( g_CubeVertexes ) / sizeof( g_CubeVertexes[ 0 ] ) );
 
-    for ( VertexMaster transform : g_CubeVertexes )
+    for ( const VertexMaster& cubeVertex : g_CubeVertexes )
     {
-        transform.position *= halfSize;
-        transform.color = tint;
-        cubeVertexes.push_back( transform );
+        Vertex_PCUTBN& vertex = cubeVertexes.emplace_back( cubeVertex );
+        vertex.position *= halfSize;
+        vertex.color = tint;
     }
 
     TransformVertexArray( cubeVertexes, Engine::GetCanonicalTransform() );
 
-    std::vector<Vertex_PCUTBN> pcutbnVertexes;
-    Vertex_PCUTBN::ConvertFromMaster( pcutbnVertexes, cubeVertexes );
-
-    cube->UpdateVertexes( pcutbnVertexes );
+    cube->UpdateVertexes( cubeVertexes );
     cube->UpdateIndexes( g_CubeIndexes, 36 );
 
     return cube;
@@ -274,8 +295,9 @@ STATIC GPUMesh* GPUMesh::CreateLine( RenderContext* ctx, const LineSeg3D& lineSe
 {
     GPUMesh* line = new GPUMesh( ctx );
 
-    std::vector<VertexMaster> lineVertexes;
+    std::vector<Vertex_PCUTBN> lineVertexes;
     std::vector<unsigned int> lineIndexes;
+    lineVertexes.reserve( 8 );
 
     const Vec3 displacement = lineSeg.end - lineSeg.start;
     const float lineRadius = thickness * .5f;
@@ -329,9 +351,7 @@ STATIC GPUMesh* GPUMesh::CreateLine( RenderContext* ctx, const LineSeg3D& lineSe
     lineIndexes.push_back( 7 );
     lineIndexes.push_back( 6 );
 
-    std::vector<Vertex_PCUTBN> templatedType;
-    Vertex_PCUTBN::ConvertFromMaster( templatedType, lineVertexes );
-    line->UpdateVertexes( templatedType );
+    line->UpdateVertexes( lineVertexes );
     line->UpdateIndexes( lineIndexes );
 
     return line;
@@ -342,14 +362,12 @@ STATIC GPUMesh* GPUMesh::CreatePlane( RenderContext* ctx, const Vec2& halfSize,
 {
     GPUMesh* plane = new GPUMesh( ctx );
 
-    std::vector<VertexMaster> planeVertexes;
+    std::vector<Vertex_PCUTBN> planeVertexes;
     std::vector<unsigned int> planeIndexes;
 
     MakeSurface( planeVertexes, planeIndexes, halfSize, splits, tint );
 
-    std::vector<Vertex_PCUTBN> templatedType;
-    Vertex_PCUTBN::ConvertFromMaster( templatedType, planeVertexes );
-    plane->UpdateVertexes( templatedType );
+    plane->UpdateVertexes( planeVertexes );
     plane->UpdateIndexes( planeIndexes );
 
     return plane;
@@ -362,14 +380,12 @@ STATIC GPUMesh* GPUMesh::CreatePlane( RenderContext* ctx,
 {
     GPUMesh* plane = new GPUMesh( ctx );
 
-    std::vector<VertexMaster> planeVertexes;
+    std::vector<Vertex_PCUTBN> planeVertexes;
     std::vector<unsigned int> planeIndexes;
 
     MakeSurface( planeVertexes, planeIndexes, halfSize, splits, tint, heightFunction );
 
-    std::vector<Vertex_PCUTBN> templatedType;
-    Vertex_PCUTBN::ConvertFromMaster( templatedType, planeVertexes );
-    plane->UpdateVertexes( templatedType );
+    plane->UpdateVertexes( planeVertexes );
     plane->UpdateIndexes( planeIndexes );
 
     return plane;
@@ -380,14 +396,12 @@ STATIC GPUMesh* GPUMesh::CreateSphereUv( RenderContext* ctx, const float radius,
 {
     GPUMesh* sphere = new GPUMesh( ctx );
 
-    std::vector<VertexMaster> sphereVertexes;
+    std::vector<Vertex_PCUTBN> sphereVertexes;
     std::vector<unsigned int> sphereIndexes;
 
     MakeSphereUv( sphereVertexes, sphereIndexes, radius, splits, tint );
 
-    std::vector<Vertex_PCUTBN> templatedType;
-    Vertex_PCUTBN::ConvertFromMaster( templatedType, sphereVertexes );
-    sphere->UpdateVertexes( templatedType );
+    sphere->UpdateVertexes( sphereVertexes );
     sphere->UpdateIndexes( sphereIndexes );
 
     return sphere;
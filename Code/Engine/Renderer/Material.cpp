@@ -67,7 +67,7 @@ Material::~Material()
 STATIC Material* Material::CreateFromFile( RenderContext* ctx, const std::string& fileName )
 {
     XmlDocument doc;
-    doc.LoadFile( fileName.c_str() );
+    LoadXmlFromFile( doc, fileName );
     return PopulateFromXmlElement( ctx, *doc.RootElement() );
 }
 
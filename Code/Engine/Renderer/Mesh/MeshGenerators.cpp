@@ -0,0 +1,698 @@
+#include "MeshGenerators.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+#include "Engine/Core/Math/Primatives/AABB3.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+#include "Engine/Core/Math/Primatives/IntVec3.hpp"
+#include "Engine/Core/Math/Primatives/LineSeg2D.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
+#include "Engine/Event/JobSystem.hpp"
+
+#include <algorithm>
+
+static constexpr unsigned int NO_VERTEX = 0xffffffff;
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// +++++                                     Marching Squares                                    +++++
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Corners go counter clockwise from x y, edge k runs from corner k to corner k + 1
+static constexpr int SQUARE_CORNER_OFFSETS[ 4 ][ 2 ] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+struct MarchingSquaresPoint
+{
+    // Grid point * 3, plus 0 for the corner, 1 for the crossing on its x edge, 2 on its y edge
+    unsigned int key = 0;
+    Vec2 gridPosition;
+    bool isLeavingInside = false;
+};
+
+// Walks the cell counter clockwise, keeping inside corners and edge crossings. Returns the count,
+//  at most 6. Crossings are placed from the lower grid point so both cells sharing an edge agree
+static int GetMarchingSquaresCell( const float* values, const int width, const int cellX, const int cellY,
+                                   const float isoLevel, MarchingSquaresPoint* points )
+{
+    float cornerValues[ 4 ];
+    bool isInside[ 4 ];
+    for( int corner = 0; corner < 4; ++corner )
+    {
+        cornerValues[ corner ] = values[ ( cellY + SQUARE_CORNER_OFFSETS[ corner ][ 1 ] ) * width +
+                                         cellX + SQUARE_CORNER_OFFSETS[ corner ][ 0 ] ];
+        isInside[ corner ] = cornerValues[ corner ] > isoLevel;
+    }
+
+    int pointCount = 0;
+    for( int corner = 0; corner < 4; ++corner )
+    {
+        const int cornerX = cellX + SQUARE_CORNER_OFFSETS[ corner ][ 0 ];
+        const int cornerY = cellY + SQUARE_CORNER_OFFSETS[ corner ][ 1 ];
+        if( isInside[ corner ] )
+        {
+            MarchingSquaresPoint& point = points[ pointCount++ ];
+            point.key = static_cast<unsigned int>( cornerY * width + cornerX ) * 3;
+            point.gridPosition = Vec2( static_cast<float>( cornerX ), static_cast<float>( cornerY ) );
+            point.isLeavingInside = false;
+        }
+
+        const int nextCorner = ( corner + 1 ) & 3;
+        if( isInside[ corner ] == isInside[ nextCorner ] )
+        {
+            continue;
+        }
+
+        const int nextX = cellX + SQUARE_CORNER_OFFSETS[ nextCorner ][ 0 ];
+        const int nextY = cellY + SQUARE_CORNER_OFFSETS[ nextCorner ][ 1 ];
+        const bool isForward = nextX + nextY > cornerX + cornerY;
+        const int lowX = isForward ? cornerX : nextX;
+        const int lowY = isForward ? cornerY : nextY;
+        const float lowValue = isForward ? cornerValues[ corner ] : cornerValues[ nextCorner ];
+        const float highValue = isForward ? cornerValues[ nextCorner ] : cornerValues[ corner ];
+        const float fraction = ( isoLevel - lowValue ) / ( highValue - lowValue );
+        const bool isXEdge = lowY == cornerY && lowY == nextY;
+
+        MarchingSquaresPoint& point = points[ pointCount++ ];
+        point.key = static_cast<unsigned int>( lowY * width + lowX ) * 3 + ( isXEdge ? 1 : 2 );
+        point.gridPosition = isXEdge ? Vec2( static_cast<float>( lowX ) + fraction, static_cast<float>( lowY ) )
+                                     : Vec2( static_cast<float>( lowX ), static_cast<float>( lowY ) + fraction );
+        point.isLeavingInside = isInside[ corner ];
+    }
+    return pointCount;
+}
+
+static Vec2 GetPointInBounds( const Vec2& gridPosition, const Vec2& gridToBounds, const AABB2& bounds )
+{
+    return Vec2( bounds.mins.x + gridPosition.x * gridToBounds.x, bounds.mins.y + gridPosition.y * gridToBounds.y );
+}
+
+void GetMarchingSquaresContour( const float* values, const IntVec2& dimensions, const float isoLevel,
+                                const AABB2& bounds, std::vector<LineSeg2D>& segments )
+{
+    GUARANTEE_OR_DIE( dimensions.x >= 2 && dimensions.y >= 2, "GetMarchingSquaresContour: Needs at least 2x2 samples" );
+
+    const Vec2 gridToBounds( ( bounds.maxs.x - bounds.mins.x ) / static_cast<float>( dimensions.x - 1 ),
+                             ( bounds.maxs.y - bounds.mins.y ) / static_cast<float>( dimensions.y - 1 ) );
+
+    MarchingSquaresPoint points[ 6 ];
+    MarchingSquaresPoint crossings[ 4 ];
+    for( int cellY = 0; cellY < dimensions.y - 1; ++cellY )
+    {
+        for( int cellX = 0; cellX < dimensions.x - 1; ++cellX )
+        {
+            const int pointCount = GetMarchingSquaresCell( values, dimensions.x, cellX, cellY, isoLevel, points );
+
+            int crossingCount = 0;
+            for( int pointIndex = 0; pointIndex < pointCount; ++pointIndex )
+            {
+                if( points[ pointIndex ].key % 3 != 0 )
+                {
+                    crossings[ crossingCount++ ] = points[ pointIndex ];
+                }
+            }
+
+            // Every crossing out of the inside is followed by the crossing back in, which cuts off
+            //  the outside corners between them and leaves the inside on the left
+            for( int crossing = 0; crossing < crossingCount; ++crossing )
+            {
+                if( crossings[ crossing ].isLeavingInside )
+                {
+                    const MarchingSquaresPoint& next = crossings[ ( crossing + 1 ) % crossingCount ];
+                    segments.emplace_back( GetPointInBounds( crossings[ crossing ].gridPosition, gridToBounds, bounds ),
+                                           GetPointInBounds( next.gridPosition, gridToBounds, bounds ) );
+                }
+            }
+        }
+    }
+}
+
+template <typename VertexType>
+void AppendMarchingSquares( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
+                            const float* values, const IntVec2& dimensions, const float isoLevel,
+                            const AABB2& bounds, const Rgba8& tint )
+{
+    GUARANTEE_OR_DIE( dimensions.x >= 2 && dimensions.y >= 2, "AppendMarchingSquares: Needs at least 2x2 samples" );
+
+    const Vec2 gridToBounds( ( bounds.maxs.x - bounds.mins.x ) / static_cast<float>( dimensions.x - 1 ),
+                             ( bounds.maxs.y - bounds.mins.y ) / static_cast<float>( dimensions.y - 1 ) );
+    const Vec2 gridToUv( 1.f / static_cast<float>( dimensions.x - 1 ), 1.f / static_cast<float>( dimensions.y - 1 ) );
+
+    std::vector<unsigned int> vertexByKey( static_cast<size_t>( dimensions.x ) * dimensions.y * 3, NO_VERTEX );
+    MarchingSquaresPoint points[ 6 ];
+    unsigned int polygon[ 6 ];
+    for( int cellY = 0; cellY < dimensions.y - 1; ++cellY )
+    {
+        for( int cellX = 0; cellX < dimensions.x - 1; ++cellX )
+        {
+            const int pointCount = GetMarchingSquaresCell( values, dimensions.x, cellX, cellY, isoLevel, points );
+            for( int pointIndex = 0; pointIndex < pointCount; ++pointIndex )
+            {
+                const MarchingSquaresPoint& point = points[ pointIndex ];
+                unsigned int& vertex = vertexByKey[ point.key ];
+                if( vertex == NO_VERTEX )
+                {
+                    vertex = static_cast<unsigned int>( vertexes.size() );
+                    vertexes.emplace_back( GetPointInBounds( point.gridPosition, gridToBounds, bounds ), tint,
+                                           Vec2( point.gridPosition.x * gridToUv.x, point.gridPosition.y * gridToUv.y ) );
+                }
+                polygon[ pointIndex ] = vertex;
+            }
+
+            // Every case cuts corners off a square, so the polygon is convex and a fan works
+            for( int pointIndex = 2; pointIndex < pointCount; ++pointIndex )
+            {
+                indexes.push_back( polygon[ 0 ] );
+                indexes.push_back( polygon[ pointIndex - 1 ] );
+                indexes.push_back( polygon[ pointIndex ] );
+            }
+        }
+    }
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// +++++                                      Volume Meshing                                     +++++
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+template <typename VertexType>
+struct MeshGeneratorChunk
+{
+    std::vector<VertexType> vertexes;
+    std::vector<unsigned int> indexes;
+};
+
+static IntVec3 GetChunkCounts( const IntVec3& cellCounts )
+{
+    return IntVec3( ( cellCounts.x + MESH_GENERATOR_CHUNK_SIZE - 1 ) / MESH_GENERATOR_CHUNK_SIZE,
+                    ( cellCounts.y + MESH_GENERATOR_CHUNK_SIZE - 1 ) / MESH_GENERATOR_CHUNK_SIZE,
+                    ( cellCounts.z + MESH_GENERATOR_CHUNK_SIZE - 1 ) / MESH_GENERATOR_CHUNK_SIZE );
+}
+
+// Runs meshChunk( chunkMins, chunkMaxs, chunk ) over every chunk of cellCounts, then appends the
+//  chunks in order
+template <typename VertexType, typename ChunkFunction>
+static void GenerateChunks( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
+                            const IntVec3& cellCounts, const bool useJobSystem, ChunkFunction meshChunk )
+{
+    const IntVec3 chunkCounts = GetChunkCounts( cellCounts );
+    const unsigned int chunkCount = static_cast<unsigned int>( chunkCounts.x * chunkCounts.y * chunkCounts.z );
+    std::vector<MeshGeneratorChunk<VertexType>> chunks( chunkCount );
+
+    const auto meshChunkRange = [&]( const unsigned int startChunk, const unsigned int endChunk )
+    {
+        for( unsigned int chunkIndex = startChunk; chunkIndex < endChunk; ++chunkIndex )
+        {
+            const int chunkX = static_cast<int>( chunkIndex ) % chunkCounts.x;
+            const int chunkY = ( static_cast<int>( chunkIndex ) / chunkCounts.x ) % chunkCounts.y;
+            const int chunkZ = static_cast<int>( chunkIndex ) / ( chunkCounts.x * chunkCounts.y );
+            const IntVec3 chunkMins( chunkX * MESH_GENERATOR_CHUNK_SIZE, chunkY * MESH_GENERATOR_CHUNK_SIZE,
+                                     chunkZ * MESH_GENERATOR_CHUNK_SIZE );
+            const IntVec3 chunkMaxs( std::min( chunkMins.x + MESH_GENERATOR_CHUNK_SIZE, cellCounts.x ),
+                                     std::min( chunkMins.y + MESH_GENERATOR_CHUNK_SIZE, cellCounts.y ),
+                                     std::min( chunkMins.z + MESH_GENERATOR_CHUNK_SIZE, cellCounts.z ) );
+            meshChunk( chunkMins, chunkMaxs, chunks[ chunkIndex ] );
+        }
+    };
+
+    if( useJobSystem && chunkCount > 1 )
+    {
+        JobSystem::INSTANCE().ParallelFor( chunkCount, 1, meshChunkRange );
+    }
+    else
+    {
+        meshChunkRange( 0, chunkCount );
+    }
+
+    size_t vertexCount = vertexes.size();
+    size_t indexCount = indexes.size();
+    for( const MeshGeneratorChunk<VertexType>& chunk : chunks )
+    {
+        vertexCount += chunk.vertexes.size();
+        indexCount += chunk.indexes.size();
+    }
+    vertexes.reserve( vertexCount );
+    indexes.reserve( indexCount );
+
+    for( const MeshGeneratorChunk<VertexType>& chunk : chunks )
+    {
+        const unsigned int firstVertex = static_cast<unsigned int>( vertexes.size() );
+        vertexes.insert( vertexes.end(), chunk.vertexes.begin(), chunk.vertexes.end() );
+        for( const unsigned int index : chunk.indexes )
+        {
+            indexes.push_back( firstVertex + index );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Marching cubes
+// Corner i sits at ( i & 1, i >> 1 & 1, i >> 2 & 1 ). Edges are grouped by axis, x edges first
+static constexpr int CUBE_EDGE_CORNERS[ 12 ][ 2 ] = {
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+    { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+};
+
+struct MarchingCubesTable
+{
+    unsigned char triangleCounts[ 256 ] = {};
+    // Cube edges, three per triangle. Twelve edges make at most ten triangles
+    unsigned char triangleEdges[ 256 ][ 30 ] = {};
+};
+
+// Built by tracing the surface around the cube instead of typed out. Each face cuts off its
+//  outside corners like marching squares does, so the inside stays connected across faces and a
+//  face always splits the same way from either side. The cut lines chain into loops around the
+//  cube that are fanned into triangles
+static MarchingCubesTable BuildMarchingCubesTable()
+{
+    int edgeBetween[ 8 ][ 8 ];
+    for( int cornerA = 0; cornerA < 8; ++cornerA )
+    {
+        for( int cornerB = 0; cornerB < 8; ++cornerB )
+        {
+            edgeBetween[ cornerA ][ cornerB ] = -1;
+        }
+    }
+    for( int edge = 0; edge < 12; ++edge )
+    {
+        edgeBetween[ CUBE_EDGE_CORNERS[ edge ][ 0 ] ][ CUBE_EDGE_CORNERS[ edge ][ 1 ] ] = edge;
+        edgeBetween[ CUBE_EDGE_CORNERS[ edge ][ 1 ] ][ CUBE_EDGE_CORNERS[ edge ][ 0 ] ] = edge;
+    }
+
+    // Counter clockwise seen from outside the cube
+    int faceCorners[ 6 ][ 4 ];
+    constexpr int FACE_WALK[ 4 ][ 2 ] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    for( int face = 0; face < 6; ++face )
+    {
+        const int axis = face >> 1;
+        const int side = face & 1;
+        const int uAxis = ( axis + 1 ) % 3;
+        const int vAxis = ( axis + 2 ) % 3;
+        for( int step = 0; step < 4; ++step )
+        {
+            const int walkStep = side == 1 ? step : 3 - step;
+            faceCorners[ face ][ step ] = ( side << axis ) | ( FACE_WALK[ walkStep ][ 0 ] << uAxis ) |
+                                          ( FACE_WALK[ walkStep ][ 1 ] << vAxis );
+        }
+    }
+
+    // Bit per face ( axis * 2 + side ) the edge lies on
+    int edgeFaces[ 12 ];
+    for( int edge = 0; edge < 12; ++edge )
+    {
+        const int axis = edge >> 2;
+        const int lowCorner = CUBE_EDGE_CORNERS[ edge ][ 0 ];
+        edgeFaces[ edge ] = 0;
+        for( int faceAxis = 0; faceAxis < 3; ++faceAxis )
+        {
+            if( faceAxis != axis )
+            {
+                edgeFaces[ edge ] |= 1 << ( faceAxis * 2 + ( lowCorner >> faceAxis & 1 ) );
+            }
+        }
+    }
+
+    MarchingCubesTable table;
+    for( int cubeCase = 0; cubeCase < 256; ++cubeCase )
+    {
+        int nextEdge[ 12 ];
+        std::fill( nextEdge, nextEdge + 12, -1 );
+        for( int face = 0; face < 6; ++face )
+        {
+            int crossingEdges[ 4 ];
+            bool isLeavingInside[ 4 ];
+            int crossingCount = 0;
+            for( int step = 0; step < 4; ++step )
+            {
+                const int corner = faceCorners[ face ][ step ];
+                const int nextCorner = faceCorners[ face ][ ( step + 1 ) & 3 ];
+                const bool isInside = ( cubeCase >> corner & 1 ) != 0;
+                if( isInside != ( ( cubeCase >> nextCorner & 1 ) != 0 ) )
+                {
+                    crossingEdges[ crossingCount ] = edgeBetween[ corner ][ nextCorner ];
+                    isLeavingInside[ crossingCount ] = isInside;
+                    ++crossingCount;
+                }
+            }
+            for( int crossing = 0; crossing < crossingCount; ++crossing )
+            {
+                if( isLeavingInside[ crossing ] )
+                {
+                    nextEdge[ crossingEdges[ crossing ] ] = crossingEdges[ ( crossing + 1 ) % crossingCount ];
+                }
+            }
+        }
+
+        bool isTraced[ 12 ] = {};
+        unsigned char& triangleCount = table.triangleCounts[ cubeCase ];
+        for( int startEdge = 0; startEdge < 12; ++startEdge )
+        {
+            if( nextEdge[ startEdge ] < 0 || isTraced[ startEdge ] )
+            {
+                continue;
+            }
+
+            int loop[ 12 ];
+            int loopLength = 0;
+            for( int edge = startEdge; !isTraced[ edge ]; edge = nextEdge[ edge ] )
+            {
+                isTraced[ edge ] = true;
+                loop[ loopLength++ ] = edge;
+            }
+
+            // A fan triangle with all three edges on one cube face would lie flat in it, and the
+            //  cube on the other side may put one there too. Fan from an edge that avoids that
+            int fanStart = 0;
+            for( int candidate = 0; candidate < loopLength; ++candidate )
+            {
+                bool isFlatFree = true;
+                for( int step = 1; step + 1 < loopLength && isFlatFree; ++step )
+                {
+                    const int edgeA = loop[ ( candidate + step ) % loopLength ];
+                    const int edgeB = loop[ ( candidate + step + 1 ) % loopLength ];
+                    isFlatFree = ( edgeFaces[ loop[ candidate ] ] & edgeFaces[ edgeA ] & edgeFaces[ edgeB ] ) == 0;
+                }
+                if( isFlatFree )
+                {
+                    fanStart = candidate;
+                    break;
+                }
+            }
+
+            // The loop runs clockwise seen from outside the surface, so the fan goes backwards
+            for( int step = 2; step < loopLength; ++step )
+            {
+                unsigned char* triangle = &table.triangleEdges[ cubeCase ][ triangleCount * 3 ];
+                triangle[ 0 ] = static_cast<unsigned char>( loop[ fanStart ] );
+                triangle[ 1 ] = static_cast<unsigned char>( loop[ ( fanStart + step ) % loopLength ] );
+                triangle[ 2 ] = static_cast<unsigned char>( loop[ ( fanStart + step - 1 ) % loopLength ] );
+                ++triangleCount;
+            }
+        }
+    }
+    return table;
+}
+
+struct MarchingCubesVolume
+{
+    const float* values = nullptr;
+    IntVec3 dimensions;
+    float isoLevel = 0.f;
+    Vec3 origin;
+    Vec3 cellSize;
+    Rgba8 tint;
+
+    float GetValue( const int x, const int y, const int z ) const
+    {
+        return values[ ( static_cast<size_t>( z ) * dimensions.y + y ) * dimensions.x + x ];
+    }
+};
+
+// Central differences, one sided on the volume's faces
+static Vec3 GetVolumeGradient( const MarchingCubesVolume& volume, const int x, const int y, const int z )
+{
+    const int lowX = x > 0 ? x - 1 : x;
+    const int highX = x < volume.dimensions.x - 1 ? x + 1 : x;
+    const int lowY = y > 0 ? y - 1 : y;
+    const int highY = y < volume.dimensions.y - 1 ? y + 1 : y;
+    const int lowZ = z > 0 ? z - 1 : z;
+    const int highZ = z < volume.dimensions.z - 1 ? z + 1 : z;
+    return Vec3( ( volume.GetValue( highX, y, z ) - volume.GetValue( lowX, y, z ) ) / ( static_cast<float>( highX - lowX ) * volume.cellSize.x ),
+                 ( volume.GetValue( x, highY, z ) - volume.GetValue( x, lowY, z ) ) / ( static_cast<float>( highY - lowY ) * volume.cellSize.y ),
+                 ( volume.GetValue( x, y, highZ ) - volume.GetValue( x, y, lowZ ) ) / ( static_cast<float>( highZ - lowZ ) * volume.cellSize.z ) );
+}
+
+template <typename VertexType>
+static void MarchCubesInChunk( const MarchingCubesVolume& volume, const MarchingCubesTable& table,
+                               const IntVec3& cellMins, const IntVec3& cellMaxs,
+                               MeshGeneratorChunk<VertexType>& chunk )
+{
+    // One slot per axis for every grid point of the chunk, edges belong to their lower point
+    const int pointsX = cellMaxs.x - cellMins.x + 1;
+    const int pointsY = cellMaxs.y - cellMins.y + 1;
+    const int pointsZ = cellMaxs.z - cellMins.z + 1;
+    std::vector<unsigned int> vertexByEdge( static_cast<size_t>( pointsX ) * pointsY * pointsZ * 3, NO_VERTEX );
+
+    const auto getEdgeVertex = [&]( const int x, const int y, const int z, const int axis ) -> unsigned int
+    {
+        unsigned int& vertex = vertexByEdge[ ( ( static_cast<size_t>( z - cellMins.z ) * pointsY + ( y - cellMins.y ) ) * pointsX +
+                                               ( x - cellMins.x ) ) * 3 + axis ];
+        if( vertex != NO_VERTEX )
+        {
+            return vertex;
+        }
+
+        const int highX = x + ( axis == 0 ? 1 : 0 );
+        const int highY = y + ( axis == 1 ? 1 : 0 );
+        const int highZ = z + ( axis == 2 ? 1 : 0 );
+        const float lowValue = volume.GetValue( x, y, z );
+        const float fraction = ( volume.isoLevel - lowValue ) / ( volume.GetValue( highX, highY, highZ ) - lowValue );
+
+        Vec3 gridPosition( static_cast<float>( x ), static_cast<float>( y ), static_cast<float>( z ) );
+        ( axis == 0 ? gridPosition.x : axis == 1 ? gridPosition.y : gridPosition.z ) += fraction;
+
+        const Vec3 lowGradient = GetVolumeGradient( volume, x, y, z );
+        const Vec3 highGradient = GetVolumeGradient( volume, highX, highY, highZ );
+        const Vec3 normal = -Vec3::Lerp( lowGradient, highGradient, fraction ).GetNormalized();
+
+        const Vec3 position = volume.origin + Vec3( gridPosition.x * volume.cellSize.x, gridPosition.y * volume.cellSize.y,
+                                                    gridPosition.z * volume.cellSize.z );
+        vertex = static_cast<unsigned int>( chunk.vertexes.size() );
+        chunk.vertexes.emplace_back( position, volume.tint, Vec2::ZERO, Vec3(), Vec3(), normal );
+        return vertex;
+    };
+
+    for( int z = cellMins.z; z < cellMaxs.z; ++z )
+    {
+        for( int y = cellMins.y; y < cellMaxs.y; ++y )
+        {
+            for( int x = cellMins.x; x < cellMaxs.x; ++x )
+            {
+                int cubeCase = 0;
+                for( int corner = 0; corner < 8; ++corner )
+                {
+                    if( volume.GetValue( x + ( corner & 1 ), y + ( corner >> 1 & 1 ), z + ( corner >> 2 & 1 ) ) > volume.isoLevel )
+                    {
+                        cubeCase |= 1 << corner;
+                    }
+                }
+
+                const unsigned char* triangleEdges = table.triangleEdges[ cubeCase ];
+                for( int corner = 0; corner < table.triangleCounts[ cubeCase ] * 3; ++corner )
+                {
+                    const int edge = triangleEdges[ corner ];
+                    const int lowCorner = CUBE_EDGE_CORNERS[ edge ][ 0 ];
+                    chunk.indexes.push_back( getEdgeVertex( x + ( lowCorner & 1 ), y + ( lowCorner >> 1 & 1 ),
+                                                            z + ( lowCorner >> 2 & 1 ), edge >> 2 ) );
+                }
+            }
+        }
+    }
+}
+
+template <typename VertexType>
+void AppendMarchingCubes( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
+                          const float* values, const IntVec3& dimensions, const float isoLevel,
+                          const AABB3& bounds, const Rgba8& tint, const bool useJobSystem )
+{
+    GUARANTEE_OR_DIE( dimensions.x >= 2 && dimensions.y >= 2 && dimensions.z >= 2,
+                      "AppendMarchingCubes: Needs at least 2x2x2 samples" );
+
+    static const MarchingCubesTable TABLE = BuildMarchingCubesTable();
+
+    MarchingCubesVolume volume;
+    volume.values = values;
+    volume.dimensions = dimensions;
+    volume.isoLevel = isoLevel;
+    volume.origin = bounds.mins;
+    volume.cellSize = Vec3( ( bounds.maxs.x - bounds.mins.x ) / static_cast<float>( dimensions.x - 1 ),
+                            ( bounds.maxs.y - bounds.mins.y ) / static_cast<float>( dimensions.y - 1 ),
+                            ( bounds.maxs.z - bounds.mins.z ) / static_cast<float>( dimensions.z - 1 ) );
+    volume.tint = tint;
+
+    GenerateChunks( vertexes, indexes, dimensions - IntVec3::ONE, useJobSystem,
+                    [&]( const IntVec3& cellMins, const IntVec3& cellMaxs, MeshGeneratorChunk<VertexType>& chunk )
+    {
+        MarchCubesInChunk( volume, TABLE, cellMins, cellMaxs, chunk );
+    } );
+}
+
+//-----------------------------------------------------------------------------
+// Greedy voxel meshing
+struct VoxelVolume
+{
+    const unsigned char* voxels = nullptr;
+    IntVec3 dimensions;
+    Vec3 origin;
+    float voxelSize = 1.f;
+    const Rgba8* blockColors = nullptr;
+
+    // Outside the volume is empty
+    unsigned char GetBlock( const int coords[ 3 ] ) const
+    {
+        if( coords[ 0 ] < 0 || coords[ 1 ] < 0 || coords[ 2 ] < 0 ||
+            coords[ 0 ] >= dimensions.x || coords[ 1 ] >= dimensions.y || coords[ 2 ] >= dimensions.z )
+        {
+            return 0;
+        }
+        return voxels[ ( static_cast<size_t>( coords[ 2 ] ) * dimensions.y + coords[ 1 ] ) * dimensions.x + coords[ 0 ] ];
+    }
+};
+
+template <typename VertexType>
+static void AppendVoxelQuad( const VoxelVolume& volume, MeshGeneratorChunk<VertexType>& chunk, const int axis,
+                             const int direction, const int planeCoords[ 3 ], const int width, const int height,
+                             const unsigned char block )
+{
+    const int uAxis = ( axis + 1 ) % 3;
+    const int vAxis = ( axis + 2 ) % 3;
+
+    // u cross v is +axis, so this order is counter clockwise from the +axis side
+    constexpr int QUAD_CORNERS[ 4 ][ 2 ] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    const Rgba8 tint = volume.blockColors == nullptr ? Rgba8::WHITE : volume.blockColors[ block ];
+    float normalCoords[ 3 ] = { 0.f, 0.f, 0.f };
+    normalCoords[ axis ] = static_cast<float>( direction );
+    const Vec3 normal( normalCoords[ 0 ], normalCoords[ 1 ], normalCoords[ 2 ] );
+
+    const unsigned int firstVertex = static_cast<unsigned int>( chunk.vertexes.size() );
+    for( int quadCorner = 0; quadCorner < 4; ++quadCorner )
+    {
+        const int corner = direction > 0 ? quadCorner : 3 - quadCorner;
+        int coords[ 3 ] = { planeCoords[ 0 ], planeCoords[ 1 ], planeCoords[ 2 ] };
+        coords[ uAxis ] += QUAD_CORNERS[ corner ][ 0 ] * width;
+        coords[ vAxis ] += QUAD_CORNERS[ corner ][ 1 ] * height;
+
+        const Vec3 position = volume.origin + Vec3( static_cast<float>( coords[ 0 ] ), static_cast<float>( coords[ 1 ] ),
+                                                    static_cast<float>( coords[ 2 ] ) ) * volume.voxelSize;
+        const Vec2 uv( static_cast<float>( coords[ uAxis ] ), static_cast<float>( coords[ vAxis ] ) );
+        chunk.vertexes.emplace_back( position, tint, uv, Vec3(), Vec3(), normal );
+    }
+
+    chunk.indexes.push_back( firstVertex );
+    chunk.indexes.push_back( firstVertex + 1 );
+    chunk.indexes.push_back( firstVertex + 2 );
+    chunk.indexes.push_back( firstVertex );
+    chunk.indexes.push_back( firstVertex + 2 );
+    chunk.indexes.push_back( firstVertex + 3 );
+}
+
+template <typename VertexType>
+static void GreedyMeshChunk( const VoxelVolume& volume, const IntVec3& chunkMins, const IntVec3& chunkMaxs,
+                             MeshGeneratorChunk<VertexType>& chunk )
+{
+    const int mins[ 3 ] = { chunkMins.x, chunkMins.y, chunkMins.z };
+    const int maxs[ 3 ] = { chunkMaxs.x, chunkMaxs.y, chunkMaxs.z };
+    unsigned char mask[ MESH_GENERATOR_CHUNK_SIZE * MESH_GENERATOR_CHUNK_SIZE ];
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        const int uAxis = ( axis + 1 ) % 3;
+        const int vAxis = ( axis + 2 ) % 3;
+        const int sizeU = maxs[ uAxis ] - mins[ uAxis ];
+        const int sizeV = maxs[ vAxis ] - mins[ vAxis ];
+
+        for( int direction = -1; direction <= 1; direction += 2 )
+        {
+            for( int slice = mins[ axis ]; slice < maxs[ axis ]; ++slice )
+            {
+                // Block id of every visible face in the slice, 0 for none
+                bool isAnyFaceVisible = false;
+                int coords[ 3 ];
+                int neighborCoords[ 3 ];
+                coords[ axis ] = slice;
+                neighborCoords[ axis ] = slice + direction;
+                for( int v = 0; v < sizeV; ++v )
+                {
+                    coords[ vAxis ] = neighborCoords[ vAxis ] = mins[ vAxis ] + v;
+                    for( int u = 0; u < sizeU; ++u )
+                    {
+                        coords[ uAxis ] = neighborCoords[ uAxis ] = mins[ uAxis ] + u;
+                        const unsigned char block = volume.GetBlock( coords );
+                        const bool isVisible = block != 0 && volume.GetBlock( neighborCoords ) == 0;
+                        mask[ v * sizeU + u ] = isVisible ? block : 0;
+                        isAnyFaceVisible |= isVisible;
+                    }
+                }
+                if( !isAnyFaceVisible )
+                {
+                    continue;
+                }
+
+                // Widest run first, then as many rows of that run as match
+                for( int v = 0; v < sizeV; ++v )
+                {
+                    for( int u = 0; u < sizeU; )
+                    {
+                        const unsigned char block = mask[ v * sizeU + u ];
+                        if( block == 0 )
+                        {
+                            ++u;
+                            continue;
+                        }
+
+                        int width = 1;
+                        while( u + width < sizeU && mask[ v * sizeU + u + width ] == block )
+                        {
+                            ++width;
+                        }
+
+                        int height = 1;
+                        for( ; v + height < sizeV; ++height )
+                        {
+                            const unsigned char* row = &mask[ ( v + height ) * sizeU + u ];
+                            if( std::count( row, row + width, block ) != width )
+                            {
+                                break;
+                            }
+                        }
+
+                        for( int clearV = v; clearV < v + height; ++clearV )
+                        {
+                            std::fill( &mask[ clearV * sizeU + u ], &mask[ clearV * sizeU + u ] + width, static_cast<unsigned char>( 0 ) );
+                        }
+
+                        int planeCoords[ 3 ];
+                        planeCoords[ axis ] = slice + ( direction > 0 ? 1 : 0 );
+                        planeCoords[ uAxis ] = mins[ uAxis ] + u;
+                        planeCoords[ vAxis ] = mins[ vAxis ] + v;
+                        AppendVoxelQuad( volume, chunk, axis, direction, planeCoords, width, height, block );
+                        u += width;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename VertexType>
+void AppendGreedyVoxelMesh( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
+                            const unsigned char* voxels, const IntVec3& dimensions, const Vec3& origin,
+                            const float voxelSize, const Rgba8* blockColors, const bool useJobSystem )
+{
+    GUARANTEE_OR_DIE( dimensions.x > 0 && dimensions.y > 0 && dimensions.z > 0,
+                      "AppendGreedyVoxelMesh: Volume is empty" );
+
+    VoxelVolume volume;
+    volume.voxels = voxels;
+    volume.dimensions = dimensions;
+    volume.origin = origin;
+    volume.voxelSize = voxelSize;
+    volume.blockColors = blockColors;
+
+    GenerateChunks( vertexes, indexes, dimensions, useJobSystem,
+                    [&]( const IntVec3& chunkMins, const IntVec3& chunkMaxs, MeshGeneratorChunk<VertexType>& chunk )
+    {
+        GreedyMeshChunk( volume, chunkMins, chunkMaxs, chunk );
+    } );
+}
+
+//-----------------------------------------------------------------------------
+#define INSTANTIATE_MESH_GENERATORS( VertexType )                                                                          \
+    template void AppendMarchingSquares( std::vector<VertexType>&, std::vector<unsigned int>&, const float*,              \
+                                         const IntVec2&, float, const AABB2&, const Rgba8& );                             \
+    template void AppendMarchingCubes( std::vector<VertexType>&, std::vector<unsigned int>&, const float*,                \
+                                       const IntVec3&, float, const AABB3&, const Rgba8&, bool );                         \
+    template void AppendGreedyVoxelMesh( std::vector<VertexType>&, std::vector<unsigned int>&, const unsigned char*,      \
+                                         const IntVec3&, const Vec3&, float, const Rgba8*, bool );
+
+INSTANTIATE_MESH_GENERATORS( VertexMaster )
+INSTANTIATE_MESH_GENERATORS( Vertex_PCU )
+INSTANTIATE_MESH_GENERATORS( Vertex_PCUTBN )
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+
+#include <vector>
+
+struct AABB2;
+struct AABB3;
+struct IntVec2;
+class IntVec3;
+struct LineSeg2D;
+
+// Volumes larger than this a side are meshed in chunks of it, one job each. Chunks always have
+//  the same bounds, so the output does not depend on the job system being used
+constexpr int MESH_GENERATOR_CHUNK_SIZE = 32;
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// +++++                                     Marching Squares                                    +++++
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// values holds dimensions.x * dimensions.y samples, x first. Samples above isoLevel are inside and
+//  saddle cells keep the inside connected. The first sample lands on bounds.mins and the last on
+//  bounds.maxs
+
+// Inside is on the left of every segment
+void GetMarchingSquaresContour( const float* values, const IntVec2& dimensions, float isoLevel,
+                                const AABB2& bounds, OUT_PARAM std::vector<LineSeg2D>& segments );
+
+// Fills the inside with triangles that share vertexes along cell edges
+template <typename VertexType>
+void AppendMarchingSquares( std::vector<VertexType>& vertexes,
+                            std::vector<unsigned int>& indexes,
+                            const float* values,
+                            const IntVec2& dimensions,
+                            float isoLevel,
+                            const AABB2& bounds,
+                            const Rgba8& tint );
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// +++++                                      Volume Meshing                                     +++++
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Volumes are x first, then y, then z, the same order SparseGrid3D::GetCells writes. Vertexes are
+//  shared inside a chunk and repeated on chunk borders, CleanMesh welds them if that matters
+
+// Isosurface of values, same inside rule and placement as marching squares. Normals point away
+//  from the inside along the sampled gradient. Cube faces keep the inside connected, so
+//  neighboring cubes always agree and the surface has no cracks
+template <typename VertexType>
+void AppendMarchingCubes( std::vector<VertexType>& vertexes,
+                          std::vector<unsigned int>& indexes,
+                          const float* values,
+                          const IntVec3& dimensions,
+                          float isoLevel,
+                          const AABB3& bounds,
+                          const Rgba8& tint,
+                          bool useJobSystem = true );
+
+// One quad per rectangle of equal faces between a solid voxel ( block id above 0 ) and an empty
+//  one. Voxel x y z spans origin + voxelSize * [x, x + 1]. UVs count voxels, so textures tile with
+//  a wrapping sampler. blockColors is indexed by block id, nullptr tints everything white
+template <typename VertexType>
+void AppendGreedyVoxelMesh( std::vector<VertexType>& vertexes,
+                            std::vector<unsigned int>& indexes,
+                            const unsigned char* voxels,
+                            const IntVec3& dimensions,
+                            const Vec3& origin,
+                            float voxelSize,
+                            const Rgba8* blockColors = nullptr,
+                            bool useJobSystem = true );
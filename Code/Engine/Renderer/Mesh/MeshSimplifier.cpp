@@ -0,0 +1,434 @@
+#include "MeshSimplifier.hpp"
+
+#include "Engine/Renderer/Mesh/MeshUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+// Collapses that bend a neighboring triangle's normal past this are rejected
+static constexpr float MIN_NORMAL_AGREEMENT = .5f;
+// ...as are collapses that squash a neighboring triangle into a sliver
+static constexpr float MIN_AREA_RATIO = .01f;
+
+//-----------------------------------------------------------------------------
+// Symmetric 4x4 plane quadric, stored as the upper triangle plus the area weight
+struct Quadric
+{
+    double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+    double b2 = 0.0, bc = 0.0, bd = 0.0;
+    double c2 = 0.0, cd = 0.0;
+    double d2 = 0.0;
+    double weight = 0.0;
+
+    void AddPlane( const Vec3& normal, const float distance, const double planeWeight )
+    {
+        const double a = normal.x;
+        const double b = normal.y;
+        const double c = normal.z;
+        const double d = distance;
+
+        a2 += a * a * planeWeight; ab += a * b * planeWeight; ac += a * c * planeWeight; ad += a * d * planeWeight;
+        b2 += b * b * planeWeight; bc += b * c * planeWeight; bd += b * d * planeWeight;
+        c2 += c * c * planeWeight; cd += c * d * planeWeight;
+        d2 += d * d * planeWeight;
+        weight += planeWeight;
+    }
+
+    void operator+=( const Quadric& rhs )
+    {
+        a2 += rhs.a2; ab += rhs.ab; ac += rhs.ac; ad += rhs.ad;
+        b2 += rhs.b2; bc += rhs.bc; bd += rhs.bd;
+        c2 += rhs.c2; cd += rhs.cd;
+        d2 += rhs.d2;
+        weight += rhs.weight;
+    }
+
+    // Mean squared distance from point to the accumulated planes
+    float GetError( const Vec3& point ) const
+    {
+        const double x = point.x;
+        const double y = point.y;
+        const double z = point.z;
+        const double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+                             b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+                             c2 * z * z + 2.0 * cd * z +
+                             d2;
+        return weight > 0.0 ? static_cast<float>( fabs( error ) / weight ) : 0.f;
+    }
+};
+
+struct CollapseCandidate
+{
+    float cost = 0.f;
+    unsigned int from = 0;
+    unsigned int to = 0;
+
+    bool operator<( const CollapseCandidate& rhs ) const { return cost < rhs.cost; }
+};
+
+struct PositionKey
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+
+    bool operator==( const PositionKey& rhs ) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()( const PositionKey& key ) const
+    {
+        return (key.x * 73856093u) ^ (key.y * 19349663u) ^ (key.z * 83492791u);
+    }
+};
+
+static Vec3 GetTriangleNormal( const Vec3& a, const Vec3& b, const Vec3& c )
+{
+    return (b - a).GetCross( c - a );
+}
+
+// Vertexes that share a position are simplified as one, so seams stay closed
+static unsigned int BuildPositionGroups( const std::vector<VertexMaster>& vertexes,
+                                         OUT_PARAM std::vector<unsigned int>& positionGroups )
+{
+    std::unordered_map<PositionKey, unsigned int, PositionKeyHash> groupLookup;
+    groupLookup.reserve( vertexes.size() );
+    positionGroups.resize( vertexes.size() );
+
+    for( size_t vertexIndex = 0; vertexIndex < vertexes.size(); ++vertexIndex )
+    {
+        const Vec3& position = vertexes[ vertexIndex ].position;
+        PositionKey key;
+        memcpy( &key.x, &position.x, sizeof( float ) );
+        memcpy( &key.y, &position.y, sizeof( float ) );
+        memcpy( &key.z, &position.z, sizeof( float ) );
+
+        const unsigned int nextGroup = static_cast<unsigned int>( groupLookup.size() );
+        positionGroups[ vertexIndex ] = groupLookup.emplace( key, nextGroup ).first->second;
+    }
+    return static_cast<unsigned int>( groupLookup.size() );
+}
+
+// A vertex may only move when it is the only vertex at its position and every edge around it is
+//  shared by exactly two triangles
+static void FindMovableVertexes( const std::vector<unsigned int>& indexes,
+                                 const std::vector<unsigned int>& positionGroups,
+                                 const unsigned int groupCount,
+                                 OUT_PARAM std::vector<unsigned char>& isMovable )
+{
+    std::vector<unsigned int> groupOwner( groupCount, ~0u );
+    std::vector<unsigned char> isGroupLocked( groupCount, 0 );
+    for( const unsigned int index : indexes )
+    {
+        unsigned int& owner = groupOwner[ positionGroups[ index ] ];
+        if( owner == ~0u )
+        {
+            owner = index;
+        }
+        else if( owner != index )
+        {
+            isGroupLocked[ positionGroups[ index ] ] = 1;
+        }
+    }
+
+    std::vector<uint64_t> edges;
+    edges.reserve( indexes.size() );
+    for( size_t triangle = 0; triangle + 2 < indexes.size(); triangle += 3 )
+    {
+        for( int corner = 0; corner < 3; ++corner )
+        {
+            const uint64_t groupA = positionGroups[ indexes[ triangle + corner ] ];
+            const uint64_t groupB = positionGroups[ indexes[ triangle + (corner + 1) % 3 ] ];
+            edges.push_back( groupA < groupB ? (groupA << 32) | groupB : (groupB << 32) | groupA );
+        }
+    }
+    std::sort( edges.begin(), edges.end() );
+
+    for( size_t runStart = 0; runStart < edges.size(); )
+    {
+        size_t runEnd = runStart + 1;
+        while( runEnd < edges.size() && edges[ runEnd ] == edges[ runStart ] )
+        {
+            ++runEnd;
+        }
+        if( runEnd - runStart != 2 )
+        {
+            isGroupLocked[ static_cast<unsigned int>( edges[ runStart ] >> 32 ) ] = 1;
+            isGroupLocked[ static_cast<unsigned int>( edges[ runStart ] & 0xFFFFFFFFu ) ] = 1;
+        }
+        runStart = runEnd;
+    }
+
+    isMovable.assign( positionGroups.size(), 0 );
+    for( size_t vertexIndex = 0; vertexIndex < positionGroups.size(); ++vertexIndex )
+    {
+        isMovable[ vertexIndex ] = isGroupLocked[ positionGroups[ vertexIndex ] ] ? 0 : 1;
+    }
+}
+
+float SimplifyMesh( const std::vector<VertexMaster>& vertexes, const std::vector<unsigned int>& indexes,
+                    const unsigned int targetIndexCount, std::vector<unsigned int>& simplifiedIndexes,
+                    const float maxError )
+{
+    simplifiedIndexes = indexes;
+    simplifiedIndexes.resize( indexes.size() - indexes.size() % 3 );
+
+    std::vector<unsigned int> positionGroups;
+    const unsigned int groupCount = BuildPositionGroups( vertexes, positionGroups );
+
+    std::vector<Quadric> quadrics( groupCount );
+    for( size_t triangle = 0; triangle < simplifiedIndexes.size(); triangle += 3 )
+    {
+        const Vec3& a = vertexes[ simplifiedIndexes[ triangle ] ].position;
+        const Vec3& b = vertexes[ simplifiedIndexes[ triangle + 1 ] ].position;
+        const Vec3& c = vertexes[ simplifiedIndexes[ triangle + 2 ] ].position;
+
+        Vec3 normal = GetTriangleNormal( a, b, c );
+        const float doubleArea = normal.GetLength();
+        if( doubleArea <= 0.f )
+        {
+            continue;
+        }
+        normal *= 1.f / doubleArea;
+
+        const float distance = -Vec3::Dot( normal, a );
+        for( int corner = 0; corner < 3; ++corner )
+        {
+            quadrics[ positionGroups[ simplifiedIndexes[ triangle + corner ] ] ].AddPlane( normal, distance, doubleArea * .5 );
+        }
+    }
+
+    const float maxErrorSquared = maxError * maxError;
+    float largestError = 0.f;
+
+    std::vector<unsigned char> isMovable;
+    std::vector<CollapseCandidate> candidates;
+    std::vector<unsigned int> adjacencyOffsets;
+    std::vector<unsigned int> adjacency;
+    std::vector<unsigned int> remap( vertexes.size() );
+    std::vector<unsigned char> isTouched( groupCount );
+    std::vector<unsigned int> fromRing;
+    std::vector<unsigned int> sharedRing;
+
+    while( simplifiedIndexes.size() > targetIndexCount )
+    {
+        FindMovableVertexes( simplifiedIndexes, positionGroups, groupCount, isMovable );
+
+        // Every directed edge whose start can move is a candidate
+        candidates.clear();
+        for( size_t triangle = 0; triangle < simplifiedIndexes.size(); triangle += 3 )
+        {
+            for( int corner = 0; corner < 3; ++corner )
+            {
+                const unsigned int from = simplifiedIndexes[ triangle + corner ];
+                const unsigned int to = simplifiedIndexes[ triangle + (corner + 1) % 3 ];
+                if( !isMovable[ from ] || positionGroups[ from ] == positionGroups[ to ] )
+                {
+                    continue;
+                }
+
+                Quadric combined = quadrics[ positionGroups[ from ] ];
+                combined += quadrics[ positionGroups[ to ] ];
+
+                CollapseCandidate candidate;
+                candidate.cost = combined.GetError( vertexes[ to ].position );
+                candidate.from = from;
+                candidate.to = to;
+                candidates.push_back( candidate );
+            }
+        }
+        std::sort( candidates.begin(), candidates.end() );
+
+        // Triangles around each position, as one flat list. A movable vertex is alone at its
+        //  position, so its list is its own triangles
+        adjacencyOffsets.assign( groupCount + 1, 0 );
+        for( const unsigned int index : simplifiedIndexes )
+        {
+            ++adjacencyOffsets[ positionGroups[ index ] + 1 ];
+        }
+        for( unsigned int group = 0; group < groupCount; ++group )
+        {
+            adjacencyOffsets[ group + 1 ] += adjacencyOffsets[ group ];
+        }
+        adjacency.resize( simplifiedIndexes.size() );
+        {
+            std::vector<unsigned int> fill( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+            for( size_t corner = 0; corner < simplifiedIndexes.size(); ++corner )
+            {
+                adjacency[ fill[ positionGroups[ simplifiedIndexes[ corner ] ] ]++ ] = static_cast<unsigned int>( corner / 3 );
+            }
+        }
+
+        for( unsigned int vertexIndex = 0; vertexIndex < remap.size(); ++vertexIndex )
+        {
+            remap[ vertexIndex ] = vertexIndex;
+        }
+        std::fill( isTouched.begin(), isTouched.end(), static_cast<unsigned char>( 0 ) );
+
+        const size_t triangleCount = simplifiedIndexes.size() / 3;
+        const size_t targetTriangles = targetIndexCount / 3;
+        size_t removedTriangles = 0;
+        size_t collapses = 0;
+
+        for( const CollapseCandidate& candidate : candidates )
+        {
+            if( candidate.cost > maxErrorSquared || triangleCount - removedTriangles <= targetTriangles )
+            {
+                break;
+            }
+            const unsigned int fromGroup = positionGroups[ candidate.from ];
+            const unsigned int toGroup = positionGroups[ candidate.to ];
+            if( isTouched[ fromGroup ] || isTouched[ toGroup ] )
+            {
+                continue;
+            }
+
+            // Link condition: only the tips of the triangles on the edge may neighbor both ends.
+            //  Any other shared neighbor gets two triangles folded onto the same three positions
+            fromRing.clear();
+            for( unsigned int adjacent = adjacencyOffsets[ fromGroup ]; adjacent < adjacencyOffsets[ fromGroup + 1 ]; ++adjacent )
+            {
+                const unsigned int* triangle = &simplifiedIndexes[ adjacency[ adjacent ] * 3 ];
+                for( int corner = 0; corner < 3; ++corner )
+                {
+                    const unsigned int group = positionGroups[ triangle[ corner ] ];
+                    if( group != fromGroup && group != toGroup )
+                    {
+                        fromRing.push_back( group );
+                    }
+                }
+            }
+            std::sort( fromRing.begin(), fromRing.end() );
+
+            sharedRing.clear();
+            for( unsigned int adjacent = adjacencyOffsets[ toGroup ]; adjacent < adjacencyOffsets[ toGroup + 1 ]; ++adjacent )
+            {
+                const unsigned int* triangle = &simplifiedIndexes[ adjacency[ adjacent ] * 3 ];
+                for( int corner = 0; corner < 3; ++corner )
+                {
+                    const unsigned int group = positionGroups[ triangle[ corner ] ];
+                    if( group != fromGroup && group != toGroup && std::binary_search( fromRing.begin(), fromRing.end(), group ) )
+                    {
+                        sharedRing.push_back( group );
+                    }
+                }
+            }
+            std::sort( sharedRing.begin(), sharedRing.end() );
+            const size_t sharedCount = std::unique( sharedRing.begin(), sharedRing.end() ) - sharedRing.begin();
+
+            // Reject collapses that would flip or fold a surviving triangle
+            const Vec3& newPosition = vertexes[ candidate.to ].position;
+            bool isValid = true;
+            size_t collapsedTriangles = 0;
+            for( unsigned int adjacent = adjacencyOffsets[ fromGroup ]; adjacent < adjacencyOffsets[ fromGroup + 1 ]; ++adjacent )
+            {
+                const unsigned int* triangle = &simplifiedIndexes[ adjacency[ adjacent ] * 3 ];
+                if( positionGroups[ triangle[ 0 ] ] == toGroup || positionGroups[ triangle[ 1 ] ] == toGroup ||
+                    positionGroups[ triangle[ 2 ] ] == toGroup )
+                {
+                    ++collapsedTriangles;
+                    continue;
+                }
+
+                Vec3 corners[ 3 ] = { vertexes[ triangle[ 0 ] ].position, vertexes[ triangle[ 1 ] ].position,
+                                      vertexes[ triangle[ 2 ] ].position };
+                const Vec3 oldNormal = GetTriangleNormal( corners[ 0 ], corners[ 1 ], corners[ 2 ] );
+                for( Vec3& corner : corners )
+                {
+                    if( corner == vertexes[ candidate.from ].position )
+                    {
+                        corner = newPosition;
+                    }
+                }
+                const Vec3 newNormal = GetTriangleNormal( corners[ 0 ], corners[ 1 ], corners[ 2 ] );
+                const float oldArea = oldNormal.GetLength();
+                const float newArea = newNormal.GetLength();
+                if( newArea < MIN_AREA_RATIO * oldArea ||
+                    Vec3::Dot( oldNormal, newNormal ) <= MIN_NORMAL_AGREEMENT * oldArea * newArea )
+                {
+                    isValid = false;
+                    break;
+                }
+            }
+            if( !isValid || sharedCount > collapsedTriangles )
+            {
+                continue;
+            }
+
+            remap[ candidate.from ] = candidate.to;
+            quadrics[ positionGroups[ candidate.to ] ] += quadrics[ positionGroups[ candidate.from ] ];
+            largestError = std::max( largestError, candidate.cost );
+            removedTriangles += collapsedTriangles;
+            ++collapses;
+
+            // Anything sharing a triangle with the moved vertex saw its neighborhood change
+            for( unsigned int adjacent = adjacencyOffsets[ fromGroup ]; adjacent < adjacencyOffsets[ fromGroup + 1 ]; ++adjacent )
+            {
+                const unsigned int* triangle = &simplifiedIndexes[ adjacency[ adjacent ] * 3 ];
+                isTouched[ positionGroups[ triangle[ 0 ] ] ] = 1;
+                isTouched[ positionGroups[ triangle[ 1 ] ] ] = 1;
+                isTouched[ positionGroups[ triangle[ 2 ] ] ] = 1;
+            }
+        }
+
+        if( collapses == 0 )
+        {
+            break;
+        }
+
+        // Rewrite through the remap and drop triangles that lost an edge
+        size_t writeIndex = 0;
+        for( size_t triangle = 0; triangle < simplifiedIndexes.size(); triangle += 3 )
+        {
+            const unsigned int a = remap[ simplifiedIndexes[ triangle ] ];
+            const unsigned int b = remap[ simplifiedIndexes[ triangle + 1 ] ];
+            const unsigned int c = remap[ simplifiedIndexes[ triangle + 2 ] ];
+            if( positionGroups[ a ] == positionGroups[ b ] || positionGroups[ b ] == positionGroups[ c ] ||
+                positionGroups[ a ] == positionGroups[ c ] )
+            {
+                continue;
+            }
+            simplifiedIndexes[ writeIndex++ ] = a;
+            simplifiedIndexes[ writeIndex++ ] = b;
+            simplifiedIndexes[ writeIndex++ ] = c;
+        }
+        simplifiedIndexes.resize( writeIndex );
+    }
+
+    return sqrtf( largestError );
+}
+
+void GenerateMeshLods( const std::vector<VertexMaster>& vertexes, const std::vector<unsigned int>& indexes,
+                       const unsigned int lodCount, const float reductionPerLod,
+                       std::vector<std::vector<unsigned int>>& lodIndexes, std::vector<float>& lodErrors )
+{
+    lodIndexes.clear();
+    lodErrors.clear();
+    lodIndexes.push_back( indexes );
+    lodErrors.push_back( 0.f );
+
+    for( unsigned int lod = 1; lod < lodCount; ++lod )
+    {
+        const std::vector<unsigned int>& previous = lodIndexes.back();
+        const size_t targetTriangles = static_cast<size_t>( static_cast<float>( previous.size() / 3 ) * reductionPerLod );
+
+        std::vector<unsigned int> simplified;
+        const float error = SimplifyMesh( vertexes, previous, static_cast<unsigned int>( targetTriangles * 3 ), simplified );
+
+        // Not worth a LOD if it barely moved
+        if( simplified.size() * 10 >= previous.size() * 9 )
+        {
+            break;
+        }
+
+        // Collapses scatter the surviving triangles, put them back in cache order
+        OptimizeVertexCache( simplified, vertexes.size() );
+
+        // Each LOD simplifies the previous one, so its error stacks on top
+        lodErrors.push_back( lodErrors.back() + error );
+        lodIndexes.push_back( std::move( simplified ) );
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+
+#include <vector>
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// +++++                                       Simplification                                    +++++
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Quadric error metric edge collapse. Vertexes are only ever collapsed onto other existing
+//  vertexes, so every result indexes into the original vertex array and a whole LOD chain can
+//  share one vertex buffer. Open borders, UV/normal seams and non-manifold edges are locked in place.
+//  The returned error is the RMS distance (in mesh units) between moved vertexes and the planes they
+//  used to lie on
+
+float SimplifyMesh( const std::vector<VertexMaster>& vertexes, const std::vector<unsigned int>& indexes,
+                    unsigned int targetIndexCount, OUT_PARAM std::vector<unsigned int>& simplifiedIndexes,
+                    float maxError = 1e30f );
+
+// lodIndexes[ 0 ] is a copy of indexes, each following LOD targets reductionPerLod of the
+//  previous one's triangles. Stops early once a LOD can not be reduced any further
+void GenerateMeshLods( const std::vector<VertexMaster>& vertexes, const std::vector<unsigned int>& indexes,
+                       unsigned int lodCount, float reductionPerLod,
+                       OUT_PARAM std::vector<std::vector<unsigned int>>& lodIndexes,
+                       OUT_PARAM std::vector<float>& lodErrors );
@@ -12,6 +12,11 @@
 #include "Engine/Core/Math/Primatives/LineSeg3D.hpp"
 #include "Engine/Core/Math/Primatives/Mat44.hpp"
 #include "Engine/Core/Math/Primatives/OBB2.hpp"
+#include "Engine/Event/JobSystem.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 static constexpr int CIRCLE_RADIUSES = 64;
 
@@ -139,7 +144,75 @@ void MikkTangentCalculation( MikkTangentSupport* support )
     genTangSpaceDefault( &context );
 }
 
-void MikkTangentCalculation( std::vector<VertexMaster>& vertexes )
+// MikkTSpace welds corners with equal position, normal and uv. Each welded vertex's tangent only
+//  depends on the triangles around it, which is what lets large meshes be split into clusters
+struct TangentWeldKey
+{
+    float values[ 8 ] = {};
+
+    bool operator==( const TangentWeldKey& rhs ) const { return memcmp( values, rhs.values, sizeof( values ) ) == 0; }
+};
+
+struct TangentWeldKeyHash
+{
+    size_t operator()( const TangentWeldKey& key ) const
+    {
+        unsigned int bits[ 8 ];
+        memcpy( bits, key.values, sizeof( bits ) );
+
+        unsigned long long hash = 0xCBF29CE484222325ull;
+        for( const unsigned int value : bits )
+        {
+            hash = ( hash ^ value ) * 0x100000001B3ull;
+            hash ^= hash >> 29;
+        }
+        return static_cast<size_t>( hash );
+    }
+};
+
+// Meshes with fewer triangles per cluster than this are done in one go
+static constexpr unsigned int MIKK_MIN_CLUSTER_TRIANGLES = 8192;
+
+// Clusters per thread, a few extra keep threads busy when the rings make some clusters bigger
+static constexpr unsigned int MIKK_CLUSTERS_PER_THREAD = 2;
+
+// Past this many ring triangles per mesh triangle the clusters redo more work than they split
+static constexpr size_t MIKK_MAX_RING_RATIO = 1;
+
+static TangentWeldKey MakeTangentWeldKey( const VertexMaster& vertex )
+{
+    // MikkTSpace compares with float ==, adding zero folds -0 onto 0 so the bits agree as well
+    TangentWeldKey key;
+    key.values[ 0 ] = vertex.position.x + 0.f;
+    key.values[ 1 ] = vertex.position.y + 0.f;
+    key.values[ 2 ] = vertex.position.z + 0.f;
+    key.values[ 3 ] = vertex.normal.x + 0.f;
+    key.values[ 4 ] = vertex.normal.y + 0.f;
+    key.values[ 5 ] = vertex.normal.z + 0.f;
+    key.values[ 6 ] = vertex.uv.x + 0.f;
+    key.values[ 7 ] = vertex.uv.y + 0.f;
+    return key;
+}
+
+// Gives every corner MikkTSpace would weld together the same id. Returns the number of ids
+static unsigned int GetTangentWeldIds( const std::vector<VertexMaster>& vertexes,
+                                       OUT_PARAM std::vector<unsigned int>& weldIds )
+{
+    std::unordered_map<TangentWeldKey, unsigned int, TangentWeldKeyHash> ids;
+    ids.reserve( vertexes.size() );
+    weldIds.resize( vertexes.size() );
+
+    for( size_t corner = 0; corner < vertexes.size(); ++corner )
+    {
+        const auto inserted = ids.emplace( MakeTangentWeldKey( vertexes[ corner ] ),
+                                           static_cast<unsigned int>( ids.size() ) );
+        weldIds[ corner ] = inserted.first->second;
+    }
+
+    return static_cast<unsigned int>( ids.size() );
+}
+
+static void MikkTangentCalculationSerial( std::vector<VertexMaster>& vertexes )
 {
     MikkTangentSupport support;
     support.vertexes = &vertexes;
@@ -148,6 +221,187 @@ void MikkTangentCalculation( std::vector<VertexMaster>& vertexes )
     MikkTangentCalculation( &support );
 }
 
+// Each cluster is a run of triangles plus every triangle sharing a welded vertex with it. Those
+//  ring triangles are all MikkTSpace reads for the cluster's vertexes, so the results match
+//  a single run over the whole mesh. Only the cluster's own corners are written back
+static void MikkTangentCalculationInClusters( std::vector<VertexMaster>& vertexes, const unsigned int clusterCount )
+{
+    const unsigned int triangleCount = static_cast<unsigned int>( vertexes.size() / 3 );
+
+    std::vector<unsigned int> weldIds;
+    const unsigned int weldCount = GetTangentWeldIds( vertexes, weldIds );
+
+    // Triangles around each welded vertex, packed into one array
+    std::vector<unsigned int> ringStart( weldCount + 1, 0 );
+    for( const unsigned int weldId : weldIds )
+    {
+        ++ringStart[ weldId + 1 ];
+    }
+    for( unsigned int weldId = 0; weldId < weldCount; ++weldId )
+    {
+        ringStart[ weldId + 1 ] += ringStart[ weldId ];
+    }
+
+    std::vector<unsigned int> rings( weldIds.size() );
+    std::vector<unsigned int> ringFill( ringStart.begin(), ringStart.end() - 1 );
+    for( size_t corner = 0; corner < weldIds.size(); ++corner )
+    {
+        rings[ ringFill[ weldIds[ corner ] ]++ ] = static_cast<unsigned int>( corner / 3 );
+    }
+
+    const auto getClusterStart = [&]( const unsigned int cluster )
+    {
+        return static_cast<unsigned int>( static_cast<unsigned long long>( triangleCount ) * cluster / clusterCount );
+    };
+
+    // Triangles outside each cluster that share a welded vertex with it, in whole mesh order
+    std::vector<std::vector<unsigned int>> clusterRings( clusterCount );
+    JobSystem& jobSystem = JobSystem::INSTANCE();
+    jobSystem.ParallelFor( clusterCount, 1, [&]( const unsigned int startCluster, const unsigned int endCluster )
+    {
+        for( unsigned int cluster = startCluster; cluster < endCluster; ++cluster )
+        {
+            const unsigned int firstTriangle = getClusterStart( cluster );
+            const unsigned int endTriangle = getClusterStart( cluster + 1 );
+
+            std::vector<unsigned int>& ringTriangles = clusterRings[ cluster ];
+            for( unsigned int corner = firstTriangle * 3; corner < endTriangle * 3; ++corner )
+            {
+                const unsigned int weldId = weldIds[ corner ];
+                for( unsigned int ringIndex = ringStart[ weldId ]; ringIndex < ringStart[ weldId + 1 ]; ++ringIndex )
+                {
+                    const unsigned int triangle = rings[ ringIndex ];
+                    if( triangle < firstTriangle || triangle >= endTriangle )
+                    {
+                        ringTriangles.push_back( triangle );
+                    }
+                }
+            }
+            std::sort( ringTriangles.begin(), ringTriangles.end() );
+            ringTriangles.erase( std::unique( ringTriangles.begin(), ringTriangles.end() ), ringTriangles.end() );
+        }
+    } );
+
+    // Scattered triangle orders give rings as big as the mesh, that is only extra work
+    size_t ringTriangleCount = 0;
+    for( const std::vector<unsigned int>& ringTriangles : clusterRings )
+    {
+        ringTriangleCount += ringTriangles.size();
+    }
+    if( ringTriangleCount > triangleCount * MIKK_MAX_RING_RATIO )
+    {
+        MikkTangentCalculationSerial( vertexes );
+        return;
+    }
+
+    jobSystem.ParallelFor( clusterCount, 1, [&]( const unsigned int startCluster, const unsigned int endCluster )
+    {
+        for( unsigned int cluster = startCluster; cluster < endCluster; ++cluster )
+        {
+            const unsigned int firstTriangle = getClusterStart( cluster );
+            const unsigned int endTriangle = getClusterStart( cluster + 1 );
+            const std::vector<unsigned int>& ringTriangles = clusterRings[ cluster ];
+
+            // Triangles keep the whole mesh's order, MikkTSpace sums each group in that order
+            const size_t ringsBefore = std::lower_bound( ringTriangles.begin(), ringTriangles.end(), firstTriangle ) - ringTriangles.begin();
+            std::vector<VertexMaster> clusterVertexes;
+            clusterVertexes.reserve( ( endTriangle - firstTriangle + ringTriangles.size() ) * 3 );
+            for( size_t ringIndex = 0; ringIndex < ringsBefore; ++ringIndex )
+            {
+                const size_t corner = ringTriangles[ ringIndex ] * 3ull;
+                clusterVertexes.insert( clusterVertexes.end(), vertexes.begin() + corner, vertexes.begin() + corner + 3 );
+            }
+            clusterVertexes.insert( clusterVertexes.end(), vertexes.begin() + firstTriangle * 3ull, vertexes.begin() + endTriangle * 3ull );
+            for( size_t ringIndex = ringsBefore; ringIndex < ringTriangles.size(); ++ringIndex )
+            {
+                const size_t corner = ringTriangles[ ringIndex ] * 3ull;
+                clusterVertexes.insert( clusterVertexes.end(), vertexes.begin() + corner, vertexes.begin() + corner + 3 );
+            }
+
+            MikkTangentCalculationSerial( clusterVertexes );
+
+            const VertexMaster* clusterCorners = &clusterVertexes[ ringsBefore * 3 ];
+            for( unsigned int corner = firstTriangle * 3; corner < endTriangle * 3; ++corner, ++clusterCorners )
+            {
+                vertexes[ corner ].tangent = clusterCorners->tangent;
+                vertexes[ corner ].bitangent = clusterCorners->bitangent;
+            }
+        }
+    } );
+}
+
+void MikkTangentCalculation( std::vector<VertexMaster>& vertexes, const bool useJobSystem )
+{
+    const unsigned int triangleCount = static_cast<unsigned int>( vertexes.size() / 3 );
+    const unsigned int threadCount = JobSystem::INSTANCE().GetNumWorkerThreads() + 1;
+
+    const unsigned int clusterCount = static_cast<unsigned int>( Minu( threadCount * MIKK_CLUSTERS_PER_THREAD,
+                                                                        triangleCount / MIKK_MIN_CLUSTER_TRIANGLES ) );
+    if( !useJobSystem || threadCount == 1 || clusterCount < 2 )
+    {
+        MikkTangentCalculationSerial( vertexes );
+        return;
+    }
+
+    MikkTangentCalculationInClusters( vertexes, clusterCount );
+}
+
+void ApproximateTangentCalculation( std::vector<VertexMaster>& vertexes )
+{
+    std::vector<unsigned int> weldIds;
+    const unsigned int weldCount = GetTangentWeldIds( vertexes, weldIds );
+
+    // Like MikkTSpace, triangles with mirrored uvs never share a tangent with unmirrored ones.
+    //  Sums are kept per welded vertex and orientation, larger triangles weigh more
+    std::vector<Vec3> tangentSums( weldCount * 2, Vec3::ZERO );
+    std::vector<unsigned char> isMirrored( vertexes.size() / 3, 0 );
+    for( size_t corner = 0; corner + 2 < vertexes.size(); corner += 3 )
+    {
+        const VertexMaster& pointOne = vertexes[ corner ];
+        const VertexMaster& pointTwo = vertexes[ corner + 1 ];
+        const VertexMaster& pointThree = vertexes[ corner + 2 ];
+
+        const Vec3 edgeOne = pointTwo.position - pointOne.position;
+        const Vec3 edgeTwo = pointThree.position - pointOne.position;
+        const Vec2 uvEdgeOne = pointTwo.uv - pointOne.uv;
+        const Vec2 uvEdgeTwo = pointThree.uv - pointOne.uv;
+
+        const float uvArea = uvEdgeOne.x * uvEdgeTwo.y - uvEdgeTwo.x * uvEdgeOne.y;
+        if( uvArea == 0.f ) { continue; }
+
+        const unsigned char mirrored = uvArea < 0.f ? 1 : 0;
+        isMirrored[ corner / 3 ] = mirrored;
+
+        const Vec3 tangent = ( edgeOne * uvEdgeTwo.y - edgeTwo * uvEdgeOne.y ) * ( 1.f / uvArea );
+        for( size_t triangleCorner = corner; triangleCorner < corner + 3; ++triangleCorner )
+        {
+            tangentSums[ weldIds[ triangleCorner ] * 2 + mirrored ] += tangent;
+        }
+    }
+
+    for( size_t corner = 0; corner < vertexes.size(); ++corner )
+    {
+        VertexMaster& vertex = vertexes[ corner ];
+        const Vec3& normal = vertex.normal;
+        const unsigned char mirrored = isMirrored[ corner / 3 ];
+        const Vec3& tangentSum = tangentSums[ weldIds[ corner ] * 2 + mirrored ];
+
+        // Gram-Schmidt onto the normal's plane, fall back to any perpendicular for degenerate uvs
+        Vec3 tangent = tangentSum - normal * Vec3::Dot( normal, tangentSum );
+        if( tangent.GetLengthSquared() < 1e-20f )
+        {
+            const Vec3 axis = fabsf( normal.x ) < .9f ? Vec3( 1.f, 0.f, 0.f ) : Vec3( 0.f, 1.f, 0.f );
+            tangent = axis - normal * Vec3::Dot( normal, axis );
+        }
+        tangent.Normalize();
+
+        // Same handedness rule as MikkTSpace, the sign of the triangle's uv area
+        const float sign = mirrored ? -1.f : 1.f;
+        vertex.tangent = tangent;
+        vertex.bitangent = sign * normal.GetCross( tangent ).GetNormalized();
+    }
+}
+
 void MikkTangentCalculation( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes )
 {
     MikkTangentSupport support;
@@ -158,45 +412,106 @@ void MikkTangentCalculation( std::vector<VertexMaster>& vertexes, std::vector<un
     MikkTangentCalculation( &support );
 }
 
-// Purposefully overflow lastIndex 
-static bool IsVertexInVector( const VertexMaster& value, const std::vector<VertexMaster>& vector, 
-                              unsigned int& foundIndex, const size_t lastIndex = -1 )
+// Welding buckets vertexes by position into cells at least twice epsilon wide, so every vertex
+//  within epsilon of a position lies in one of at most 2x2x2 neighboring cells
+struct WeldCell
 {
-    const size_t size = Minu( vector.size(), lastIndex );
+    long long x = 0;
+    long long y = 0;
+    long long z = 0;
+
+    bool operator==( const WeldCell& rhs ) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+};
 
-    for( size_t index = 0; index < size; ++index )
+struct WeldCellHash
+{
+    size_t operator()( const WeldCell& cell ) const
     {
-        if( value.IsMostlyEqual( vector.at( index ) ) )
-        {
-            foundIndex = static_cast<unsigned int>(index);
-            return true;
-        }
+        unsigned long long hash = static_cast<unsigned long long>( cell.x ) * 0x9E3779B97F4A7C15ull;
+        hash ^= static_cast<unsigned long long>( cell.y ) * 0xC2B2AE3D27D4EB4Full + ( hash >> 29 );
+        hash ^= static_cast<unsigned long long>( cell.z ) * 0x165667B19E3779F9ull + ( hash >> 32 );
+        return static_cast<size_t>( hash ^ ( hash >> 31 ) );
     }
+};
+
+static constexpr float WELD_MIN_CELL_SIZE = 1e-6f;
 
-    return false;
+static long long GetWeldCellCoordinate( const double value, const double inverseCellSize )
+{
+    // Keeps huge or non-finite positions from overflowing the cell coordinate
+    constexpr double CELL_LIMIT = 4.0e18;
+    double cell = std::floor( value * inverseCellSize );
+    if( !( cell > -CELL_LIMIT ) ) { cell = -CELL_LIMIT; }
+    if( !( cell < CELL_LIMIT ) ) { cell = CELL_LIMIT; }
+    return static_cast<long long>( cell );
 }
 
-void CleanMesh( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes )
+void CleanMesh( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes, const float epsilon )
 {
+    const double inverseCellSize = 1.0 / static_cast<double>( Maxf( epsilon * 2.f, WELD_MIN_CELL_SIZE ) );
+
+    // Each cell holds the first unique vertex in it, the rest are chained through nextInCell
+    std::unordered_map<WeldCell, unsigned int, WeldCellHash> cells;
+    cells.reserve( vertexes.size() );
+    std::vector<unsigned int> nextInCell;
+    nextInCell.reserve( vertexes.size() );
+    indexes.reserve( indexes.size() + vertexes.size() );
+
+    constexpr unsigned int END_OF_CELL = ~0u;
     unsigned int insertIndex = 0;
-    size_t searchIndex = 0;
 
     for( const VertexMaster& vertex : vertexes )
     {
-        unsigned int foundIndex;
-        const bool foundInVector = IsVertexInVector( vertex, vertexes, foundIndex, searchIndex );
-        if( foundInVector )
+        const Vec3& position = vertex.position;
+        const WeldCell minCell = { GetWeldCellCoordinate( static_cast<double>( position.x ) - epsilon, inverseCellSize ),
+                                   GetWeldCellCoordinate( static_cast<double>( position.y ) - epsilon, inverseCellSize ),
+                                   GetWeldCellCoordinate( static_cast<double>( position.z ) - epsilon, inverseCellSize ) };
+        const WeldCell maxCell = { GetWeldCellCoordinate( static_cast<double>( position.x ) + epsilon, inverseCellSize ),
+                                   GetWeldCellCoordinate( static_cast<double>( position.y ) + epsilon, inverseCellSize ),
+                                   GetWeldCellCoordinate( static_cast<double>( position.z ) + epsilon, inverseCellSize ) };
+
+        // Welds to the earliest matching vertex, same as the old front to back search
+        unsigned int foundIndex = END_OF_CELL;
+        WeldCell cell;
+        for( cell.z = minCell.z; cell.z <= maxCell.z; ++cell.z )
         {
-            indexes.push_back( foundIndex );
+            for( cell.y = minCell.y; cell.y <= maxCell.y; ++cell.y )
+            {
+                for( cell.x = minCell.x; cell.x <= maxCell.x; ++cell.x )
+                {
+                    const auto found = cells.find( cell );
+                    if( found == cells.end() ) { continue; }
+
+                    for( unsigned int candidate = found->second; candidate != END_OF_CELL;
+                         candidate = nextInCell[ candidate ] )
+                    {
+                        if( candidate < foundIndex && vertex.IsMostlyEqual( vertexes[ candidate ], epsilon ) )
+                        {
+                            foundIndex = candidate;
+                        }
+                    }
+                }
+            }
         }
-        else
+
+        if( foundIndex != END_OF_CELL )
         {
-            vertexes.at( insertIndex ) = vertex;
-            indexes.push_back( insertIndex );
-            insertIndex++;
+            indexes.push_back( foundIndex );
+            continue;
         }
 
-        searchIndex++;
+        // Unique vertexes are compacted to the front as they are found, insertIndex never passes the read
+        vertexes[ insertIndex ] = vertex;
+        indexes.push_back( insertIndex );
+
+        const WeldCell ownCell = { GetWeldCellCoordinate( vertexes[ insertIndex ].position.x, inverseCellSize ),
+                                   GetWeldCellCoordinate( vertexes[ insertIndex ].position.y, inverseCellSize ),
+                                   GetWeldCellCoordinate( vertexes[ insertIndex ].position.z, inverseCellSize ) };
+        const auto inserted = cells.emplace( ownCell, insertIndex );
+        nextInCell.push_back( inserted.second ? END_OF_CELL : inserted.first->second );
+        inserted.first->second = insertIndex;
+
+        insertIndex++;
     }
 
     const size_t oldSize = vertexes.size();
@@ -220,7 +535,223 @@ void IndexMesh( const std::vector<VertexMaster>& vertexes, std::vector<unsigned
     }
 }
 
-void AppendLine( std::vector<VertexMaster>& vertexes, const LineSeg2D& lineSeg,
+// Tom Forsyth's linear-speed vertex cache optimization. Vertexes score higher the more recently
+//  they were used and the fewer triangles they have left, each step emits the best scoring
+//  triangle touching the simulated cache
+static constexpr unsigned int FORSYTH_CACHE_SIZE = 32;
+static constexpr unsigned int FORSYTH_MAX_VALENCE = 32;
+static constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+static constexpr float FORSYTH_LAST_TRIANGLE_SCORE = .75f;
+static constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.f;
+static constexpr float FORSYTH_VALENCE_BOOST_POWER = .5f;
+
+struct ForsythScoreTable
+{
+    float cacheScores[ FORSYTH_CACHE_SIZE ];
+    float valenceScores[ FORSYTH_MAX_VALENCE + 1 ];
+
+    ForsythScoreTable()
+    {
+        for( unsigned int position = 0; position < FORSYTH_CACHE_SIZE; ++position )
+        {
+            if( position < 3 )
+            {
+                // The last triangle's vertexes are scored flat so it is not just repeated
+                cacheScores[ position ] = FORSYTH_LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                const float scaler = 1.f / static_cast<float>( FORSYTH_CACHE_SIZE - 3 );
+                const float score = 1.f - static_cast<float>( position - 3 ) * scaler;
+                cacheScores[ position ] = powf( score, FORSYTH_CACHE_DECAY_POWER );
+            }
+        }
+
+        valenceScores[ 0 ] = 0.f;
+        for( unsigned int valence = 1; valence <= FORSYTH_MAX_VALENCE; ++valence )
+        {
+            valenceScores[ valence ] = FORSYTH_VALENCE_BOOST_SCALE *
+                                       powf( static_cast<float>( valence ), -FORSYTH_VALENCE_BOOST_POWER );
+        }
+    }
+
+    float GetScore( const int cachePosition, const unsigned int remainingTriangles ) const
+    {
+        // No triangles left to emit, never pick this vertex
+        if( remainingTriangles == 0 ) { return -1.f; }
+
+        float score = valenceScores[ remainingTriangles < FORSYTH_MAX_VALENCE ? remainingTriangles : FORSYTH_MAX_VALENCE ];
+        if( cachePosition >= 0 )
+        {
+            score += cacheScores[ cachePosition ];
+        }
+        return score;
+    }
+};
+
+void OptimizeVertexCache( std::vector<unsigned int>& indexes, const size_t vertexCount )
+{
+    static const ForsythScoreTable s_ScoreTable;
+
+    const size_t triangleCount = indexes.size() / 3;
+    if( triangleCount == 0 ) { return; }
+
+    // Triangles touching each vertex, packed into one array
+    std::vector<unsigned int> remainingTriangles( vertexCount, 0 );
+    for( const unsigned int index : indexes )
+    {
+        ++remainingTriangles[ index ];
+    }
+
+    std::vector<unsigned int> adjacencyStart( vertexCount + 1, 0 );
+    for( size_t vertex = 0; vertex < vertexCount; ++vertex )
+    {
+        adjacencyStart[ vertex + 1 ] = adjacencyStart[ vertex ] + remainingTriangles[ vertex ];
+    }
+
+    std::vector<unsigned int> adjacency( indexes.size() );
+    std::vector<unsigned int> adjacencyFill( adjacencyStart.begin(), adjacencyStart.end() - 1 );
+    for( size_t triangle = 0; triangle < triangleCount; ++triangle )
+    {
+        for( size_t corner = 0; corner < 3; ++corner )
+        {
+            adjacency[ adjacencyFill[ indexes[ triangle * 3 + corner ] ]++ ] = static_cast<unsigned int>( triangle );
+        }
+    }
+
+    std::vector<int> cachePositions( vertexCount, -1 );
+    std::vector<float> vertexScores( vertexCount );
+    for( size_t vertex = 0; vertex < vertexCount; ++vertex )
+    {
+        vertexScores[ vertex ] = s_ScoreTable.GetScore( -1, remainingTriangles[ vertex ] );
+    }
+
+    std::vector<float> triangleScores( triangleCount );
+    std::vector<bool> isEmitted( triangleCount, false );
+    for( size_t triangle = 0; triangle < triangleCount; ++triangle )
+    {
+        const unsigned int* corners = &indexes[ triangle * 3 ];
+        triangleScores[ triangle ] = vertexScores[ corners[ 0 ] ] + vertexScores[ corners[ 1 ] ] +
+                                     vertexScores[ corners[ 2 ] ];
+    }
+
+    // Start from the best triangle anywhere, after that only the cache's triangles are considered
+    size_t bestTriangle = std::max_element( triangleScores.begin(), triangleScores.end() ) - triangleScores.begin();
+
+    std::vector<unsigned int> optimized;
+    optimized.reserve( indexes.size() );
+
+    // Three extra slots hold vertexes pushed out of the cache this step so their scores update
+    unsigned int cache[ FORSYTH_CACHE_SIZE + 3 ];
+    unsigned int cacheCount = 0;
+    size_t nextUnemittedTriangle = 0;
+
+    while( optimized.size() < indexes.size() )
+    {
+        const unsigned int* corners = &indexes[ bestTriangle * 3 ];
+        isEmitted[ bestTriangle ] = true;
+
+        unsigned int newCache[ FORSYTH_CACHE_SIZE + 3 ];
+        unsigned int newCacheCount = 0;
+        for( unsigned int corner = 0; corner < 3; ++corner )
+        {
+            const unsigned int vertex = corners[ corner ];
+            optimized.push_back( vertex );
+
+            // Degenerate triangles repeat a vertex, it only takes one cache slot
+            if( newCacheCount == 0 || ( newCache[ newCacheCount - 1 ] != vertex && newCache[ 0 ] != vertex ) )
+            {
+                newCache[ newCacheCount++ ] = vertex;
+            }
+
+            // Drop the emitted triangle from the vertex's remaining list
+            unsigned int* vertexTriangles = &adjacency[ adjacencyStart[ vertex ] ];
+            const unsigned int remaining = remainingTriangles[ vertex ];
+            for( unsigned int triangle = 0; triangle < remaining; ++triangle )
+            {
+                if( vertexTriangles[ triangle ] == bestTriangle )
+                {
+                    vertexTriangles[ triangle ] = vertexTriangles[ remaining - 1 ];
+                    break;
+                }
+            }
+            --remainingTriangles[ vertex ];
+        }
+
+        for( unsigned int cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+        {
+            const unsigned int vertex = cache[ cacheIndex ];
+            if( vertex != corners[ 0 ] && vertex != corners[ 1 ] && vertex != corners[ 2 ] )
+            {
+                newCache[ newCacheCount++ ] = vertex;
+            }
+        }
+
+        // Rescore everything that was or is in the cache and find the best triangle they touch
+        float bestScore = -1.f;
+        for( unsigned int cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+        {
+            const unsigned int vertex = newCache[ cacheIndex ];
+            const int cachePosition = cacheIndex < FORSYTH_CACHE_SIZE ? static_cast<int>( cacheIndex ) : -1;
+            cachePositions[ vertex ] = cachePosition;
+
+            const float newScore = s_ScoreTable.GetScore( cachePosition, remainingTriangles[ vertex ] );
+            const float scoreDelta = newScore - vertexScores[ vertex ];
+            vertexScores[ vertex ] = newScore;
+
+            const unsigned int* vertexTriangles = &adjacency[ adjacencyStart[ vertex ] ];
+            for( unsigned int triangle = 0; triangle < remainingTriangles[ vertex ]; ++triangle )
+            {
+                const unsigned int adjacentTriangle = vertexTriangles[ triangle ];
+                triangleScores[ adjacentTriangle ] += scoreDelta;
+                if( triangleScores[ adjacentTriangle ] > bestScore )
+                {
+                    bestScore = triangleScores[ adjacentTriangle ];
+                    bestTriangle = adjacentTriangle;
+                }
+            }
+        }
+
+        cacheCount = newCacheCount < FORSYTH_CACHE_SIZE ? newCacheCount : FORSYTH_CACHE_SIZE;
+        std::copy( newCache, newCache + cacheCount, cache );
+
+        // Nothing in the cache has triangles left, continue with the next unemitted triangle
+        if( bestScore < 0.f )
+        {
+            while( nextUnemittedTriangle < triangleCount && isEmitted[ nextUnemittedTriangle ] )
+            {
+                ++nextUnemittedTriangle;
+            }
+            bestTriangle = nextUnemittedTriangle;
+        }
+    }
+
+    indexes.swap( optimized );
+}
+
+float GetAverageCacheMissRatio( const std::vector<unsigned int>& indexes, const size_t vertexCount,
+                                const unsigned int cacheSize )
+{
+    const size_t triangleCount = indexes.size() / 3;
+    if( triangleCount == 0 ) { return 0.f; }
+
+    // FIFO cache, a vertex is a hit if it was inserted within the last cacheSize misses
+    std::vector<size_t> insertedAt( vertexCount, 0 );
+    size_t misses = 0;
+    for( const unsigned int index : indexes )
+    {
+        if( insertedAt[ index ] == 0 || misses - insertedAt[ index ] + 1 > cacheSize )
+        {
+            ++misses;
+            insertedAt[ index ] = misses;
+        }
+    }
+
+    return static_cast<float>( misses ) / static_cast<float>( triangleCount );
+}
+
+template <typename VertexType>
+void AppendLine( std::vector<VertexType>& vertexes, const LineSeg2D& lineSeg,
                  const Rgba8& startTint, const Rgba8& endTint, const float thickness )
 {
     const Vec2 displacement = lineSeg.GetDisplacement();
@@ -238,19 +769,22 @@ void AppendLine( std::vector<VertexMaster>& vertexes, const LineSeg2D& lineSeg,
     vertexes.emplace_back( lineSeg.start - forward - left, startTint );
 }
 
-void AppendLine( std::vector<VertexMaster>& vertexes, const LineSeg2D& lineSeg, const Rgba8& tint,
+template <typename VertexType>
+void AppendLine( std::vector<VertexType>& vertexes, const LineSeg2D& lineSeg, const Rgba8& tint,
                  float thickness )
 {
     AppendLine( vertexes, lineSeg, tint, tint, thickness );
 }
 
-void AppendRay( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes,
                 const LineSeg3D& lineSeg, const Rgba8& tint, float thickness )
 {
     AppendRay( vertexes, lineSeg, tint, tint, thickness );
 }
 
-void AppendRay( std::vector<VertexMaster>& vertexes, const LineSeg3D& lineSeg, const Rgba8& startTint,
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes, const LineSeg3D& lineSeg, const Rgba8& startTint,
                 const Rgba8& endTint, float thickness )
 {
     const Vec3 displacement = lineSeg.end - lineSeg.start;
@@ -295,7 +829,8 @@ void AppendRay( std::vector<VertexMaster>& vertexes, const LineSeg3D& lineSeg, c
     vertexes.emplace_back( lineSeg.end + forward + top, endTint );
 }
 
-void AppendRay( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, 
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, 
     const Rgba8& tint, float thickness )
 {
     const Vec3 displacement = lineSeg.end - lineSeg.start;
@@ -359,7 +894,8 @@ void AppendRay( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>&
 // void AppendArrow( std::vector<Vertex_PCU>& vertexes, const Vec2& start, const Vec2& end,
 //                   const Rgba8& color, float thickness )
 // {
-void AppendArrow( std::vector<VertexMaster>& vertexes, const LineSeg2D& lineSeg,
+template <typename VertexType>
+void AppendArrow( std::vector<VertexType>& vertexes, const LineSeg2D& lineSeg,
                   const Rgba8& startTint, const Rgba8& endTint, const float thickness )
 {
     const float totalLength = lineSeg.GetLength();
@@ -380,7 +916,8 @@ void AppendArrow( std::vector<VertexMaster>& vertexes, const LineSeg2D& lineSeg,
     vertexes.emplace_back( lineSeg.end, endTint );
 }
 
-void AppendArrow3D( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes,
+template <typename VertexType>
+void AppendArrow3D( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
                     const LineSeg3D& lineSeg, const Rgba8& startTint, const Rgba8& endTint,
                     const float thickness )
 {
@@ -400,14 +937,16 @@ void AppendArrow3D( std::vector<VertexMaster>& vertexes, std::vector<unsigned in
                     arrowThickness );
 }
 
-void AppendArrow3D( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes,
+template <typename VertexType>
+void AppendArrow3D( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
                     const LineSeg3D& lineSeg, const Rgba8& tint, const float thickness )
 {
     AppendArrow3D( vertexes, indexes, lineSeg, tint, tint, thickness );
 }
 
 //-----------------------------------------------------------------------------
-void AppendCross( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendCross( std::vector<VertexType>& vertexes,
                   const Vec2& center,
                   const float height,
                   const float thickness,
@@ -424,7 +963,8 @@ void AppendCross( std::vector<VertexMaster>& vertexes,
 }
 
 //-----------------------------------------------------------------------------
-void AppendDisc( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendDisc( std::vector<VertexType>& vertexes,
                  const Disc& disc,
                  const Rgba8& tint )
 {
@@ -449,7 +989,8 @@ void AppendDisc( std::vector<VertexMaster>& vertexes,
 }
 
 //-----------------------------------------------------------------------------
-void AppendDiscPerimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendDiscPerimeter( std::vector<VertexType>& vertexes,
                           const Disc& disc,
                           const Rgba8& tint,
                           float thickness )
@@ -490,7 +1031,8 @@ void AppendDiscPerimeter( std::vector<VertexMaster>& vertexes,
 }
 
 //-----------------------------------------------------------------------------
-void AppendAABB2( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB2( std::vector<VertexType>& vertexes,
                   const AABB2& box,
                   const Rgba8& tint )
 {
@@ -505,7 +1047,8 @@ void AppendAABB2( std::vector<VertexMaster>& vertexes,
     vertexes.emplace_back( box.maxs, tint, Vec2( 1.f, 1.f ) );
 }
 
-void AppendAABB2( std::vector<VertexMaster>& vertexes, const AABB2& box, const Rgba8& tint, const Vec2& uvMins, const Vec2& uvMaxs )
+template <typename VertexType>
+void AppendAABB2( std::vector<VertexType>& vertexes, const AABB2& box, const Rgba8& tint, const Vec2& uvMins, const Vec2& uvMaxs )
 {
     Vec2 topLeft( box.mins.x, box.maxs.y );
     Vec2 botRight( box.maxs.x, box.mins.y );
@@ -519,7 +1062,8 @@ void AppendAABB2( std::vector<VertexMaster>& vertexes, const AABB2& box, const R
 }
 
 //-----------------------------------------------------------------------------
-void AppendAABB2Perimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB2Perimeter( std::vector<VertexType>& vertexes,
                            const AABB2& box,
                            const Rgba8& tint,
                            float thickness )
@@ -533,7 +1077,8 @@ void AppendAABB2Perimeter( std::vector<VertexMaster>& vertexes,
     AppendLine( vertexes, LineSeg2D( botRight, box.mins ), tint, thickness );
 }
 
-void AppendAABB3( std::vector<VertexMaster>& vertexes, const AABB3& cube, const Rgba8& tint )
+template <typename VertexType>
+void AppendAABB3( std::vector<VertexType>& vertexes, const AABB3& cube, const Rgba8& tint )
 {
     const Vec3 center = cube.GetCenter();
     const Vec3 dimens = cube.GetDimensions();
@@ -554,7 +1099,8 @@ void AppendAABB3( std::vector<VertexMaster>& vertexes, const AABB3& cube, const
     AppendPlaneSegment( vertexes, center - topOffset, iBasis, kBasis, tint );
 }
 
-void AppendCylinder( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes,
+template <typename VertexType>
+void AppendCylinder( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes,
                      const LineSeg3D& lineSeg, const Rgba8& startTint, const Rgba8& endTint,
                      float startRadius, float endRadius, unsigned int sides )
 {
@@ -628,7 +1174,8 @@ void AppendCylinder( std::vector<VertexMaster>& vertexes, std::vector<unsigned i
     }
 }
 
-void AppendCylinderPerimeter( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, const Rgba8& tint, float startRadius, float endRadius, float thickness, unsigned int sides )
+template <typename VertexType>
+void AppendCylinderPerimeter( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, const Rgba8& tint, float startRadius, float endRadius, float thickness, unsigned int sides )
 {
     GUARANTEE_OR_DIE( sides >= 3, "AppendCylinder: There must be 3 or more sides" );
     constexpr unsigned int numVertexesPerStep = 10;
@@ -662,13 +1209,15 @@ void AppendCylinderPerimeter( std::vector<VertexMaster>& vertexes, std::vector<u
     }
 }
 
-void AppendCone( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, const Rgba8& startTint, const Rgba8& endTint, float startRadius, unsigned int sides )
+template <typename VertexType>
+void AppendCone( std::vector<VertexType>& vertexes, std::vector<unsigned int>& indexes, const LineSeg3D& lineSeg, const Rgba8& startTint, const Rgba8& endTint, float startRadius, unsigned int sides )
 {
     AppendCylinder( vertexes, indexes, lineSeg, startTint, endTint, startRadius, 0.f, sides );
 }
 
 //-----------------------------------------------------------------------------
-void AppendPolygon2D( std::vector<VertexMaster>& vertexes, const std::vector<Vec2>& points,
+template <typename VertexType>
+void AppendPolygon2D( std::vector<VertexType>& vertexes, const std::vector<Vec2>& points,
                       const Rgba8& color )
 {
     const Vec2& zeroPoint = points.at( 0 );
@@ -684,7 +1233,8 @@ void AppendPolygon2D( std::vector<VertexMaster>& vertexes, const std::vector<Vec
 }
 
 //-----------------------------------------------------------------------------
-void AppendPolygon2DPerimeter( std::vector<VertexMaster>& vertexes, const std::vector<Vec2>& points,
+template <typename VertexType>
+void AppendPolygon2DPerimeter( std::vector<VertexType>& vertexes, const std::vector<Vec2>& points,
                                const Rgba8& color, float thickness )
 {
     for ( size_t drawPointIndex = 0; drawPointIndex < points.size() - 1; ++drawPointIndex )
@@ -698,7 +1248,8 @@ void AppendPolygon2DPerimeter( std::vector<VertexMaster>& vertexes, const std::v
                 thickness );
 }
 
-void AppendPlaneSegment( std::vector<VertexMaster>& vertexes, const Mat44& basis, const Rgba8& tint,
+template <typename VertexType>
+void AppendPlaneSegment( std::vector<VertexType>& vertexes, const Mat44& basis, const Rgba8& tint,
                          const Vec2& ijSize, const Vec2& pivot, const Vec2& uvAtMin,
                          const Vec2& uvAtMax )
 {
@@ -720,7 +1271,8 @@ void AppendPlaneSegment( std::vector<VertexMaster>& vertexes, const Mat44& basis
     vertexes.emplace_back( topRight, tint, Vec2( uvAtMax.x, uvAtMin.y ) );
 }
 
-void AppendPlaneSegment( std::vector<VertexMaster>& vertexes, const Vec3& center,
+template <typename VertexType>
+void AppendPlaneSegment( std::vector<VertexType>& vertexes, const Vec3& center,
                          const Vec3& scaledIBasis, const Vec3& scaledJBasis, const Rgba8& tint,
                          const Vec2& uvAtMin, const Vec2& uvAtMax )
 {
@@ -740,3 +1292,40 @@ void AppendPlaneSegment( std::vector<VertexMaster>& vertexes, const Vec3& center
     vertexes.emplace_back( bottomRight, tint, uvAtMax );
     vertexes.emplace_back( topRight, tint, Vec2( uvAtMax.x, uvAtMin.y ) );
 }
+
+//-----------------------------------------------------------------------------
+#define INSTANTIATE_MESH_UTILS( VertexType )                                                                                \
+    template void AppendLine( std::vector<VertexType>&, const LineSeg2D&, const Rgba8&, const Rgba8&, float );            \
+    template void AppendLine( std::vector<VertexType>&, const LineSeg2D&, const Rgba8&, float );                          \
+    template void AppendRay( std::vector<VertexType>&, const LineSeg3D&, const Rgba8&, float );                           \
+    template void AppendRay( std::vector<VertexType>&, const LineSeg3D&, const Rgba8&, const Rgba8&, float );             \
+    template void AppendRay( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&, const Rgba8&,        \
+                             float );                                                                                      \
+    template void AppendArrow( std::vector<VertexType>&, const LineSeg2D&, const Rgba8&, const Rgba8&, float );           \
+    template void AppendArrow3D( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&, const Rgba8&,    \
+                                 const Rgba8&, float );                                                                    \
+    template void AppendArrow3D( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&, const Rgba8&,    \
+                                 float );                                                                                  \
+    template void AppendCross( std::vector<VertexType>&, const Vec2&, float, float, const Rgba8&, float, float );         \
+    template void AppendDisc( std::vector<VertexType>&, const Disc&, const Rgba8& );                                      \
+    template void AppendDiscPerimeter( std::vector<VertexType>&, const Disc&, const Rgba8&, float );                      \
+    template void AppendAABB2( std::vector<VertexType>&, const AABB2&, const Rgba8& );                                    \
+    template void AppendAABB2( std::vector<VertexType>&, const AABB2&, const Rgba8&, const Vec2&, const Vec2& );          \
+    template void AppendAABB2Perimeter( std::vector<VertexType>&, const AABB2&, const Rgba8&, float );                    \
+    template void AppendAABB3( std::vector<VertexType>&, const AABB3&, const Rgba8& );                                    \
+    template void AppendCylinder( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&, const Rgba8&,   \
+                                  const Rgba8&, float, float, unsigned int );                                              \
+    template void AppendCylinderPerimeter( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&,        \
+                                           const Rgba8&, float, float, float, unsigned int );                              \
+    template void AppendCone( std::vector<VertexType>&, std::vector<unsigned int>&, const LineSeg3D&, const Rgba8&,       \
+                              const Rgba8&, float, unsigned int );                                                         \
+    template void AppendPolygon2D( std::vector<VertexType>&, const std::vector<Vec2>&, const Rgba8& );                    \
+    template void AppendPolygon2DPerimeter( std::vector<VertexType>&, const std::vector<Vec2>&, const Rgba8&, float );    \
+    template void AppendPlaneSegment( std::vector<VertexType>&, const Mat44&, const Rgba8&, const Vec2&, const Vec2&,     \
+                                      const Vec2&, const Vec2& );                                                          \
+    template void AppendPlaneSegment( std::vector<VertexType>&, const Vec3&, const Vec3&, const Vec3&, const Rgba8&,      \
+                                      const Vec2&, const Vec2& );
+
+INSTANTIATE_MESH_UTILS( VertexMaster )
+INSTANTIATE_MESH_UTILS( Vertex_PCU )
+INSTANTIATE_MESH_UTILS( Vertex_PCUTBN )
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
 
 #include <vector>
 
@@ -23,59 +24,86 @@ struct MikkTangentSupport
     bool useIndex = true;
 };
 
-void MikkTangentCalculation( std::vector<VertexMaster>& vertexes );
+// Large unindexed meshes are split into triangle clusters on the JobSystem. Clusters carry the
+//  triangles around their vertexes, so the tangents match a single threaded run exactly
+void MikkTangentCalculation( std::vector<VertexMaster>& vertexes, bool useJobSystem = true );
 void MikkTangentCalculation( std::vector<VertexMaster>& vertexes,
                              std::vector<unsigned int>& indexes );
 
-void CleanMesh( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes );
+// Per vertex sum of triangle uv directions projected onto the normal, mirrored uvs kept apart.
+//  Several times cheaper than MikkTSpace but only close to it, avoid for baked normal maps
+void ApproximateTangentCalculation( std::vector<VertexMaster>& vertexes );
+
+// Welds vertexes that are VertexMaster::IsMostlyEqual within epsilon onto the earliest one, using
+//  a position hash so it stays linear. Unique vertexes keep their order at the front of vertexes
+void CleanMesh( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes,
+                float epsilon = 1e-7f );
 
 void IndexMesh( const std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes );
 
+// Reorders triangles for the post transform vertex cache (Forsyth). Does not touch the vertexes
+void OptimizeVertexCache( std::vector<unsigned int>& indexes, size_t vertexCount );
+
+// Vertex shader runs per triangle through a FIFO cache of cacheSize, 3 is the worst and .5 the best
+float GetAverageCacheMissRatio( const std::vector<unsigned int>& indexes, size_t vertexCount,
+                                unsigned int cacheSize = 16 );
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // +++++                                       Appending Functions                               +++++
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// Templated on the output vertex so 2D and UI geometry can be written directly as Vertex_PCU.
+//  Instantiated for VertexMaster, Vertex_PCU, and Vertex_PCUTBN in MeshUtils.cpp
 
-void AppendLine( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendLine( std::vector<VertexType>& vertexes,
                  const LineSeg2D& lineSeg,
                  const Rgba8& startTint,
                  const Rgba8& endTint,
                  float thickness = 1.f );
-void AppendLine( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendLine( std::vector<VertexType>& vertexes,
                  const LineSeg2D& lineSeg,
                  const Rgba8& tint,
                  float thickness = 1.f );
 
-void AppendRay( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes,
                 const LineSeg3D& lineSeg,
                 const Rgba8& tint,
                 float thickness = 1.f );
-void AppendRay( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes,
                 const LineSeg3D& lineSeg,
                 const Rgba8& startTint,
                 const Rgba8& endTint,
                 float thickness = 1.f );
-void AppendRay( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendRay( std::vector<VertexType>& vertexes,
                 std::vector<unsigned int>& indexes,
                 const LineSeg3D& lineSeg,
                 const Rgba8& tint, float thickness = 1.f );
 
-void AppendArrow( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendArrow( std::vector<VertexType>& vertexes,
                   const LineSeg2D& lineSeg,
                   const Rgba8& startTint,
                   const Rgba8& endTint,
                   float thickness = 1.f );
-void AppendArrow3D( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendArrow3D( std::vector<VertexType>& vertexes,
                     std::vector<unsigned int>& indexes,
                     const LineSeg3D& lineSeg,
                     const Rgba8& startTint,
                     const Rgba8& endTint,
                     float thickness = 1.f );
-void AppendArrow3D( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendArrow3D( std::vector<VertexType>& vertexes,
                     std::vector<unsigned int>& indexes,
                     const LineSeg3D& lineSeg,
                     const Rgba8& tint,
                     float thickness = 1.f );
-void AppendCross( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendCross( std::vector<VertexType>& vertexes,
                   const Vec2& center,
                   float height,
                   float thickness,
@@ -83,31 +111,38 @@ void AppendCross( std::vector<VertexMaster>& vertexes,
                   float angleDegrees = 0.f,
                   float aspect = 1.f );
 
-void AppendDisc( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendDisc( std::vector<VertexType>& vertexes,
                  const Disc& disc,
                  const Rgba8& tint );
-void AppendDiscPerimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendDiscPerimeter( std::vector<VertexType>& vertexes,
                           const Disc& disc,
                           const Rgba8& tint,
                           float thickness );
 
-void AppendAABB2( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB2( std::vector<VertexType>& vertexes,
                   const AABB2& box,
                   const Rgba8& tint );
-void AppendAABB2( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB2( std::vector<VertexType>& vertexes,
                   const AABB2& box,
                   const Rgba8& tint,
                   const Vec2& uvMins,
                   const Vec2& uvMaxs );
-void AppendAABB2Perimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB2Perimeter( std::vector<VertexType>& vertexes,
                            const AABB2& box,
                            const Rgba8& tint,
                            float thickness = 1.f );
-void AppendAABB3( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendAABB3( std::vector<VertexType>& vertexes,
                   const AABB3& cube,
                   const Rgba8& tint );
 
-void AppendCylinder( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendCylinder( std::vector<VertexType>& vertexes,
                      std::vector<unsigned int>& indexes,
                      const LineSeg3D& lineSeg,
                      const Rgba8& startTint,
@@ -116,7 +151,8 @@ void AppendCylinder( std::vector<VertexMaster>& vertexes,
                      float endRadius = 1.f,
                      unsigned int sides = 16u );
 
-void AppendCylinderPerimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendCylinderPerimeter( std::vector<VertexType>& vertexes,
                               std::vector<unsigned int>& indexes,
                               const LineSeg3D& lineSeg,
                               const Rgba8& tint,
@@ -125,7 +161,8 @@ void AppendCylinderPerimeter( std::vector<VertexMaster>& vertexes,
                               float thickness = 1.f,
                               unsigned int sides = 16u );
 
-void AppendCone( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendCone( std::vector<VertexType>& vertexes,
                  std::vector<unsigned int>& indexes,
                  const LineSeg3D& lineSeg,
                  const Rgba8& startTint,
@@ -133,21 +170,25 @@ void AppendCone( std::vector<VertexMaster>& vertexes,
                  float startRadius = 1.f,
                  unsigned int sides = 16u );
 
-void AppendPolygon2D( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendPolygon2D( std::vector<VertexType>& vertexes,
                       const std::vector<Vec2>& points,
                       const Rgba8& color );
-void AppendPolygon2DPerimeter( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendPolygon2DPerimeter( std::vector<VertexType>& vertexes,
                                const std::vector<Vec2>& points,
                                const Rgba8& color,
                                float thickness = 1.f );
-void AppendPlaneSegment( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendPlaneSegment( std::vector<VertexType>& vertexes,
                          const Mat44& basis,
                          const Rgba8& tint,
                          const Vec2& ijSize = Vec2::ONE,
                          const Vec2& pivot = Vec2::ZERO,
                          const Vec2& uvAtMin = Vec2::ZERO,
                          const Vec2& uvAtMax = Vec2::ONE );
-void AppendPlaneSegment( std::vector<VertexMaster>& vertexes,
+template <typename VertexType>
+void AppendPlaneSegment( std::vector<VertexType>& vertexes,
                          const Vec3& center,
                          const Vec3& scaledIBasis,
                          const Vec3& scaledJBasis,
@@ -15,7 +15,9 @@
 #include "Engine/Core/VertexTypes/Vertex_PCUTBN.hpp"
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/Time/Clock.hpp"
+#include "Engine/IO/CookedTextureUtils.hpp"
 #include "Engine/OS/Window.hpp"
+#include "Engine/Renderer/AsyncAssetLoader.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/Fonts/BitmapFont.hpp"
 #include "Engine/Renderer/Sampler.hpp"
@@ -102,11 +104,19 @@ void RenderContext::Startup( Window* window )
 
 
     m_EffectCamera = new Camera( this );
+
+    m_RenderTargetPool = new RenderTargetPool(
+        [this]( const RenderTargetDescription& description ) { return Texture::CreateRenderTarget( this, description ); },
+        []( Texture* texture ) { delete texture; } );
+
+    m_AsyncAssetLoader = new AsyncAssetLoader( this );
 }
 
 //-----------------------------------------------------------------------------
 void RenderContext::BeginFrame()
 {
+    m_RenderTargetPool->BeginFrame();
+    m_AsyncAssetLoader->Update( m_AsyncUploadBudgetSeconds );
 }
 
 //-------------------------------------------------------------------------------
@@ -118,6 +128,10 @@ void RenderContext::EndFrame()
 //-------------------------------------------------------------------------------
 void RenderContext::Shutdown()
 {
+    // Anything still loading would land in the caches below after they are cleared
+    delete m_AsyncAssetLoader;
+    m_AsyncAssetLoader = nullptr;
+
     std::map<const std::string, Shader*>::iterator shaderIterator;
     for ( shaderIterator = m_LoadedShaders.begin(); shaderIterator != m_LoadedShaders.end(); ++
           shaderIterator )
@@ -219,14 +233,10 @@ void RenderContext::Shutdown()
         }
     }
 
-    GUARANTEE_OR_DIE( m_TexturePool.size() == m_NumTexturesInPool, "Failed to release all textures in texture pool" );
-    for( Texture*& texture : m_TexturePool )
+    if( m_RenderTargetPool != nullptr )
     {
-        if( texture != nullptr )
-        {
-            delete texture;
-            texture = nullptr;
-        }
+        delete m_RenderTargetPool;
+        m_RenderTargetPool = nullptr;
     }
 
     if( m_EffectCamera != nullptr )
@@ -483,6 +493,38 @@ Texture* RenderContext::CreateOrGetTextureFromFile( const std::string& filePath,
     return newlyCreatedTexture;
 }
 
+// Every option that changes the cooked texture, so differently cooked loads of one file get
+//  their own entries and never the plain load's
+static std::string GetCookedTextureCacheKey( const std::string& filePath, const TextureCookOptions& cookOptions )
+{
+    return Stringf( "%s?format=%u&mipFilter=%u&mips=%d&srgb=%d&flipV=%d", filePath.c_str(),
+                    static_cast<unsigned int>( cookOptions.format ), static_cast<unsigned int>( cookOptions.mipFilter ),
+                    cookOptions.generateMips, cookOptions.isSrgb, cookOptions.flipV );
+}
+
+Texture* RenderContext::CreateOrGetTextureFromFile( const std::string& filePath, const TextureCookOptions& cookOptions )
+{
+    const std::string cacheKey = GetCookedTextureCacheKey( filePath, cookOptions );
+    if ( m_LoadedTextures.find( cacheKey ) != m_LoadedTextures.end() )
+    {
+        return m_LoadedTextures.at( cacheKey );
+    }
+    Texture* newlyCreatedTexture = Texture::CreateFromFile( this, filePath, cookOptions );
+    if( newlyCreatedTexture == nullptr )
+    {
+#if !defined(ENGINE_DISABLE_CONSOLE)
+        g_Console->Log( LOG_ERROR, Stringf( "RenderContext::CreateOrGetTextureFromFile - Failed to load %s. Using builtin error texture", filePath.c_str() ) );
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+
+        newlyCreatedTexture = m_LoadedTextures.at( "ERROR_TEXTURE" );
+
+        GUARANTEE_OR_DIE( newlyCreatedTexture, "RenderContext::CreateOrGetTextureFromFile - Builtin error texture does not exist" );
+    }
+    m_LoadedTextures[ cacheKey ] = newlyCreatedTexture;
+
+    return newlyCreatedTexture;
+}
+
 Sampler* RenderContext::CreateOrGetSamplerFromFile( const std::string& filePath )
 {
     if ( m_LoadedSamplers.find( filePath ) != m_LoadedSamplers.cend() )
@@ -520,6 +562,21 @@ ShaderProgram* RenderContext::CreateOrGetShaderProgramFromFile( const std::strin
     return newlyCreatedShaderProgram;
 }
 
+AsyncAsset<ShaderProgram>* RenderContext::CreateOrGetShaderProgramFromFileAsync( const std::string& filePath )
+{
+    return m_AsyncAssetLoader->CreateOrGetShaderProgram( filePath );
+}
+
+AsyncAsset<Texture>* RenderContext::CreateOrGetTextureFromFileAsync( const std::string& filePath, bool flipV )
+{
+    return m_AsyncAssetLoader->CreateOrGetTexture( filePath, flipV );
+}
+
+AsyncAsset<BitmapFont>* RenderContext::CreateOrGetBitmapFontFromFileAsync( const std::string& filePath )
+{
+    return m_AsyncAssetLoader->CreateOrGetBitmapFont( filePath );
+}
+
 SpriteSheet* RenderContext::CreateOrGetSpriteSheetFromFile( const std::string& filePath,
                                                             const IntVec2& size, bool flipV )
 {
@@ -573,41 +630,32 @@ MaterialSheet* RenderContext::GetMaterialSheet( const std::string& name )
 
 Texture* RenderContext::AcquireMatchingRenderTarget( Texture* texture )
 {
-    const IntVec2 size = texture->GetTextureSize();
-
-    for( size_t index = 0; index < m_TexturePool.size(); ++index )
-    {
-        Texture* renderTexture = m_TexturePool.at( index );
-        if( size == renderTexture->GetTextureSize() )
-        {
-            m_TexturePool[ index ] = m_TexturePool[ m_TexturePool.size() - 1 ];
-            m_TexturePool.pop_back();
-
-            return renderTexture;
-        }
-    }
-
-    m_NumTexturesInPool++;
-
-    GUARANTEE_OR_DIE( m_NumTexturesInPool < 256, "RenderContext::AcquireMatchingRenderTarget - Too many texture to allocate" );
+    return AcquireRenderTarget( RenderTargetDescription( texture->GetTextureSize() ) );
+}
 
-    Texture* renderTarget = Texture::CreateRenderTargetFromSize( this, size );
-    return renderTarget;
+Texture* RenderContext::AcquireRenderTarget( const RenderTargetDescription& description )
+{
+    return m_RenderTargetPool->Acquire( description );
 }
 
 void RenderContext::ReleaseRenderTarget( Texture* texture )
 {
-    m_TexturePool.push_back( texture );
+    m_RenderTargetPool->Release( texture );
 }
 
 size_t RenderContext::GetTotalTexturePoolCount() const
 {
-    return m_TexturePool.size();
+    return m_RenderTargetPool->GetStats().totalTargets;
 }
 
 size_t RenderContext::GetFreeTexturePoolCount() const
 {
-    return m_NumTexturesInPool;
+    return m_RenderTargetPool->GetStats().freeTargets;
+}
+
+RenderTargetPoolStats RenderContext::GetRenderTargetPoolStats() const
+{
+    return m_RenderTargetPool->GetStats();
 }
 
 void RenderContext::StartEffect( Texture* dst, Texture* src, ShaderProgram* shader )
@@ -1010,13 +1058,22 @@ void RenderContext::DrawVertexArray( const std::vector<VertexMaster>& vertexes )
     const size_t vectorSize = vertexes.size();
     if ( vectorSize > 0 )
     {
-        // TODO: Fix up vertex_pcu
+        // Prefer building Vertex_PCU directly, this down converts every vertex
         std::vector<Vertex_PCU> pcu;
         Vertex_PCU::ConvertFromMaster( pcu, vertexes );
         DrawVertexArray( vectorSize, &pcu[ 0 ] );
     }
 }
 
+void RenderContext::DrawVertexArray( const std::vector<Vertex_PCU>& vertexes )
+{
+    const size_t vectorSize = vertexes.size();
+    if ( vectorSize > 0 )
+    {
+        DrawVertexArray( vectorSize, &vertexes[ 0 ] );
+    }
+}
+
 void RenderContext::CopyTexture( Texture* des, Texture* src ) const
 {
     m_Context->CopyResource( des->GetHandle(), src->GetHandle() );
@@ -1059,7 +1116,7 @@ void RenderContext::DrawVertexArray( size_t numVertexes, const Vertex_PCU* verte
     m_IndexBuffer->AppendLocalBuffer( numVertexes, bufferStart );
 }
 
-void RenderContext::DrawMesh( GPUMesh* mesh )
+void RenderContext::DrawMesh( GPUMesh* mesh, const unsigned int lodIndex )
 {
     UpdateLayoutIfNeeded( mesh->GetVertexBuffer()->m_BufferAttribute );
     Finalize();
@@ -1073,7 +1130,8 @@ void RenderContext::DrawMesh( GPUMesh* mesh )
     {
         mesh->GetIndexBuffer()->UpdateAndBind( );
 
-        m_Context->DrawIndexed( static_cast<UINT>(mesh->GetIndexCount()), 0, 0 );
+        const MeshLod lod = mesh->GetLod( lodIndex );
+        m_Context->DrawIndexed( static_cast<UINT>(lod.indexCount), static_cast<UINT>(lod.indexStart), 0 );
     }
     else
     {
@@ -1084,14 +1142,20 @@ void RenderContext::DrawMesh( GPUMesh* mesh )
 void RenderContext::DrawIndexed( std::vector<VertexMaster>& vertexes,
                                  std::vector<unsigned int>& indexes )
 {
-    // TODO: Fix up vertex_pcu
+    // Prefer building Vertex_PCU directly, this down converts every vertex
     std::vector<Vertex_PCU> pcu;
     Vertex_PCU::ConvertFromMaster( pcu, vertexes );
 
+    DrawIndexed( pcu, indexes );
+}
+
+void RenderContext::DrawIndexed( const std::vector<Vertex_PCU>& vertexes,
+                                 std::vector<unsigned int>& indexes )
+{
     UpdateLayoutIfNeeded( Vertex_PCU::LAYOUT );
 
     VertexBuffer<Vertex_PCU>* vertexBuffer = VertexBuffer<Vertex_PCU>::FromRenderBuffer( m_VertexBuffer );
-    const size_t bufferStart = vertexBuffer->AppendLocalBuffer( pcu );
+    const size_t bufferStart = vertexBuffer->AppendLocalBuffer( vertexes );
     m_IndexBuffer->AppendLocalBuffer( indexes, bufferStart );
 }
 
@@ -1107,7 +1171,7 @@ void RenderContext::Draw( size_t numVertexes, size_t vertexOffset )
 Sampler* RenderContext::CreateSamplerFromFile( const std::string& filePath )
 {
     XmlDocument doc;
-    doc.LoadFile( filePath.c_str() );
+    LoadXmlFromFile( doc, filePath );
     Sampler* newSampler = Sampler::PopulateFromXmlElement( this, *doc.RootElement() );
     return newSampler;
 }
@@ -1115,7 +1179,7 @@ Sampler* RenderContext::CreateSamplerFromFile( const std::string& filePath )
 Shader* RenderContext::CreateShaderFromFile( const std::string& filePath )
 {
     XmlDocument doc;
-    doc.LoadFile( filePath.c_str() );
+    LoadXmlFromFile( doc, filePath );
     Shader* newShader = Shader::PopulateFromXmlElement( this, *doc.RootElement() );
     return newShader;
 }
@@ -15,6 +15,7 @@
 #include "D3D11Common.hpp"
 #include "Light/Light.hpp"
 #include "Rasterizer.hpp"
+#include "RenderTargetPool.hpp"
 
 #include "Shaders/Shader.hpp"
 
@@ -34,7 +35,10 @@ struct ID3D11DepthStencilState;
 struct Rgba8;
 struct AABB2;
 struct Disc;
+struct TextureCookOptions;
 
+template <typename AssetType> class AsyncAsset;
+class AsyncAssetLoader;
 class BitmapFont;
 class Camera;
 class GPUMesh;
@@ -58,6 +62,8 @@ enum TextureSlot: unsigned int
 
 class RenderContext
 {
+    friend class AsyncAssetLoader;
+
 public:
     void* m_DebugModule = nullptr;
     IDXGIDebug* m_Debug = nullptr;
@@ -87,19 +93,32 @@ public:
     Shader* CreateOrGetShaderFromFile( const std::string& filePath );
     ShaderProgram* CreateOrGetShaderProgramFromFile( const std::string& filePath );
     Texture* CreateOrGetTextureFromFile( const std::string& filePath, bool flipV = false );
+    // Cached per file and cook options, so it never returns the overload above's texture
+    Texture* CreateOrGetTextureFromFile( const std::string& filePath, const TextureCookOptions& cookOptions );
     BitmapFont* CreateOrGetBitmapFontFromFile( const std::string& filePath );
     SpriteSheet* CreateOrGetSpriteSheetFromFile( const std::string& filePath,
                                                  const IntVec2& size, bool flipV = false );
     Rasterizer* CreateOrGetRasterizer( CullMode cullMode, FillMode fillMode, WindOrder order );
 
+    // Async versions return straight away. Files are read and decoded on the JobSystem workers and
+    //  uploaded during BeginFrame, at most the upload budget per frame. Handles stay valid until
+    //  Shutdown, which has to run before JobSystem::Shutdown
+    AsyncAsset<ShaderProgram>* CreateOrGetShaderProgramFromFileAsync( const std::string& filePath );
+    AsyncAsset<Texture>* CreateOrGetTextureFromFileAsync( const std::string& filePath, bool flipV = false );
+    AsyncAsset<BitmapFont>* CreateOrGetBitmapFontFromFileAsync( const std::string& filePath );
+    AsyncAssetLoader* GetAsyncAssetLoader() const { return m_AsyncAssetLoader; }
+    void SetAsyncUploadBudget( double budgetSeconds ) { m_AsyncUploadBudgetSeconds = budgetSeconds; }
+
     MaterialSheet* CreateOrGetMaterialSheetFromData( const std::string& name, const std::map<std::string, SpriteSheet*> data, const IntVec2& gridLayout );
     MaterialSheet* GetMaterialSheet( const std::string& name );
 
 
     Texture* AcquireMatchingRenderTarget( Texture* texture );
+    Texture* AcquireRenderTarget( const RenderTargetDescription& description );
     void ReleaseRenderTarget( Texture* texture );
     size_t GetTotalTexturePoolCount() const;
     size_t GetFreeTexturePoolCount() const;
+    RenderTargetPoolStats GetRenderTargetPoolStats() const;
 
     void StartEffect( Texture* dst, Texture* src, ShaderProgram* shader );
     void StartEffect( Texture* dst, Texture* src, Material* material );
@@ -127,9 +146,11 @@ public:
 
     void Draw( size_t numVertexes, size_t vertexOffset = 0 );
     void DrawIndexed( std::vector<VertexMaster>& vertexes, std::vector<unsigned int>& indexes );
-    void DrawMesh( GPUMesh* mesh );
+    void DrawIndexed( const std::vector<Vertex_PCU>& vertexes, std::vector<unsigned int>& indexes );
+    void DrawMesh( GPUMesh* mesh, unsigned int lodIndex = 0 );
     void DrawVertexArray( size_t numVertexes, const Vertex_PCU* vertexes );
     void DrawVertexArray( const std::vector<VertexMaster>& vertexes );
+    void DrawVertexArray( const std::vector<Vertex_PCU>& vertexes );
 
     void CopyTexture( Texture* des, Texture* src ) const;
 
@@ -167,8 +188,10 @@ private:
     Shader* m_EffectShader = nullptr;
     bool m_ShaderIsDirty = true;
 
-    std::vector<Texture*> m_TexturePool;
-    int m_NumTexturesInPool = 0;            // Debug purposes
+    RenderTargetPool* m_RenderTargetPool = nullptr;
+
+    AsyncAssetLoader* m_AsyncAssetLoader = nullptr;
+    double m_AsyncUploadBudgetSeconds = .002;
 
     Rasterizer* m_DefaultRasterizer = nullptr;
     const Rasterizer* m_CurrentRasterizer = nullptr;
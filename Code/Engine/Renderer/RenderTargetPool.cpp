@@ -0,0 +1,188 @@
+#include "RenderTargetPool.hpp"
+
+//-----------------------------------------------------------------------------
+// Render Target Description
+RenderTargetDescription::RenderTargetDescription( const IntVec2& targetSize, const RenderTargetFormat targetFormat,
+                                                  const unsigned int targetBindFlags )
+    : size( targetSize )
+      , format( targetFormat )
+      , bindFlags( targetBindFlags )
+{
+}
+
+size_t RenderTargetDescription::GetHash() const
+{
+    uint64_t key = static_cast<uint32_t>( size.x );
+    key = (key << 32) | static_cast<uint32_t>( size.y );
+    key ^= (static_cast<uint64_t>( format ) << 56) ^ (static_cast<uint64_t>( bindFlags ) << 48);
+
+    // splitmix64 finalizer so neighboring sizes land in different buckets
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return static_cast<size_t>( key );
+}
+
+size_t RenderTargetDescription::GetByteSize() const
+{
+    size_t bytesPerPixel = 4;
+    switch( format )
+    {
+    case RenderTargetFormat::RGBA8_UNORM: bytesPerPixel = 4; break;
+    case RenderTargetFormat::RGBA16_FLOAT: bytesPerPixel = 8; break;
+    case RenderTargetFormat::R32_FLOAT: bytesPerPixel = 4; break;
+    default: break;
+    }
+    return static_cast<size_t>( size.x ) * static_cast<size_t>( size.y ) * bytesPerPixel;
+}
+
+bool RenderTargetDescription::operator==( const RenderTargetDescription& rhs ) const
+{
+    return size == rhs.size && format == rhs.format && bindFlags == rhs.bindFlags;
+}
+
+bool RenderTargetDescription::operator!=( const RenderTargetDescription& rhs ) const
+{
+    return !(*this == rhs);
+}
+
+//-----------------------------------------------------------------------------
+// Render Target Pool
+RenderTargetPool::RenderTargetPool( const CreateFunction& createFunction, const DestroyFunction& destroyFunction,
+                                    const unsigned int framesBeforeEviction, const unsigned int maxTargets )
+    : m_Create( createFunction )
+      , m_Destroy( destroyFunction )
+      , m_FramesBeforeEviction( framesBeforeEviction )
+      , m_MaxTargets( maxTargets )
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    GUARANTEE_OR_DIE( m_Stats.inUseTargets == 0, "RenderTargetPool::~RenderTargetPool - Failed to release all render targets" );
+    EvictAllFree();
+}
+
+Texture* RenderTargetPool::Acquire( const RenderTargetDescription& description )
+{
+    ++m_Stats.acquires;
+
+    const auto foundBucket = m_FreeBuckets.find( description );
+    if( foundBucket != m_FreeBuckets.end() && !foundBucket->second.empty() )
+    {
+        // Most recently released first, it is the most likely to still be warm
+        Texture* reused = foundBucket->second.back().texture;
+        foundBucket->second.pop_back();
+
+        m_OwnedTargets[ reused ].inUse = true;
+        ++m_Stats.reuses;
+        ++m_Stats.inUseTargets;
+        --m_Stats.freeTargets;
+        m_Stats.freeBytes -= description.GetByteSize();
+        return reused;
+    }
+
+    GUARANTEE_OR_DIE( m_Stats.totalTargets < m_MaxTargets, "RenderTargetPool::Acquire - Too many render targets allocated" );
+
+    Texture* created = m_Create( description );
+    OwnedTarget& owned = m_OwnedTargets[ created ];
+    owned.description = description;
+    owned.inUse = true;
+
+    ++m_Stats.creations;
+    ++m_Stats.totalTargets;
+    ++m_Stats.inUseTargets;
+    m_Stats.totalBytes += description.GetByteSize();
+    if( m_Stats.totalTargets > m_Stats.peakTargets )
+    {
+        m_Stats.peakTargets = m_Stats.totalTargets;
+    }
+    return created;
+}
+
+void RenderTargetPool::Release( Texture* texture )
+{
+    const auto foundOwned = m_OwnedTargets.find( texture );
+    GUARANTEE_OR_DIE( foundOwned != m_OwnedTargets.end(), "RenderTargetPool::Release - Texture did not come from this pool" );
+    GUARANTEE_OR_DIE( foundOwned->second.inUse, "RenderTargetPool::Release - Texture was released twice" );
+
+    foundOwned->second.inUse = false;
+
+    FreeTarget freeTarget;
+    freeTarget.texture = texture;
+    freeTarget.releasedFrame = m_CurrentFrame;
+    m_FreeBuckets[ foundOwned->second.description ].push_back( freeTarget );
+
+    --m_Stats.inUseTargets;
+    ++m_Stats.freeTargets;
+    m_Stats.freeBytes += foundOwned->second.description.GetByteSize();
+}
+
+void RenderTargetPool::BeginFrame()
+{
+    ++m_CurrentFrame;
+
+    for( auto bucket = m_FreeBuckets.begin(); bucket != m_FreeBuckets.end(); )
+    {
+        std::vector<FreeTarget>& freeTargets = bucket->second;
+
+        size_t evictCount = 0;
+        while( evictCount < freeTargets.size() &&
+               freeTargets[ evictCount ].releasedFrame + m_FramesBeforeEviction < m_CurrentFrame )
+        {
+            DestroyTarget( freeTargets[ evictCount ].texture );
+            ++evictCount;
+        }
+        freeTargets.erase( freeTargets.begin(), freeTargets.begin() + evictCount );
+
+        if( freeTargets.empty() )
+        {
+            bucket = m_FreeBuckets.erase( bucket );
+        }
+        else
+        {
+            ++bucket;
+        }
+    }
+}
+
+void RenderTargetPool::EvictAllFree()
+{
+    for( auto& bucket : m_FreeBuckets )
+    {
+        for( const FreeTarget& freeTarget : bucket.second )
+        {
+            DestroyTarget( freeTarget.texture );
+        }
+    }
+    m_FreeBuckets.clear();
+}
+
+bool RenderTargetPool::IsPooled( const Texture* texture ) const
+{
+    return m_OwnedTargets.find( texture ) != m_OwnedTargets.cend();
+}
+
+RenderTargetPoolStats RenderTargetPool::GetStats() const
+{
+    RenderTargetPoolStats stats = m_Stats;
+    stats.bucketCount = static_cast<unsigned int>( m_FreeBuckets.size() );
+    return stats;
+}
+
+void RenderTargetPool::DestroyTarget( Texture* texture )
+{
+    const auto foundOwned = m_OwnedTargets.find( texture );
+    const size_t byteSize = foundOwned->second.description.GetByteSize();
+    m_OwnedTargets.erase( foundOwned );
+
+    --m_Stats.totalTargets;
+    --m_Stats.freeTargets;
+    m_Stats.totalBytes -= byteSize;
+    m_Stats.freeBytes -= byteSize;
+    ++m_Stats.evictions;
+
+    m_Destroy( texture );
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class Texture;
+
+enum class RenderTargetFormat : unsigned char
+{
+    RGBA8_UNORM,
+    RGBA16_FLOAT,
+    R32_FLOAT,
+};
+
+enum RenderTargetBindBit : unsigned int
+{
+    RENDER_TARGET_BIND_NONE_BIT = 0u,
+
+    RENDER_TARGET_BIND_RENDER_TARGET_BIT = BIT_FLAG<0>,
+    RENDER_TARGET_BIND_SHADER_RESOURCE_BIT = BIT_FLAG<1>,
+    RENDER_TARGET_BIND_UNORDERED_ACCESS_BIT = BIT_FLAG<2>,
+};
+
+struct RenderTargetDescription
+{
+    IntVec2 size = IntVec2::ZERO;
+    RenderTargetFormat format = RenderTargetFormat::RGBA8_UNORM;
+    unsigned int bindFlags = RENDER_TARGET_BIND_RENDER_TARGET_BIT | RENDER_TARGET_BIND_SHADER_RESOURCE_BIT;
+
+public:
+    RenderTargetDescription() = default;
+    explicit RenderTargetDescription( const IntVec2& targetSize,
+                                      RenderTargetFormat targetFormat = RenderTargetFormat::RGBA8_UNORM,
+                                      unsigned int targetBindFlags = RENDER_TARGET_BIND_RENDER_TARGET_BIT |
+                                                                     RENDER_TARGET_BIND_SHADER_RESOURCE_BIT );
+
+    size_t GetHash() const;
+    size_t GetByteSize() const;
+
+    bool operator==( const RenderTargetDescription& rhs ) const;
+    bool operator!=( const RenderTargetDescription& rhs ) const;
+};
+
+struct RenderTargetDescriptionHash
+{
+    size_t operator()( const RenderTargetDescription& description ) const { return description.GetHash(); }
+};
+
+struct RenderTargetPoolStats
+{
+    unsigned int totalTargets = 0;
+    unsigned int freeTargets = 0;
+    unsigned int inUseTargets = 0;
+    unsigned int peakTargets = 0;
+    unsigned int bucketCount = 0;
+    size_t totalBytes = 0;
+    size_t freeBytes = 0;
+
+    // Lifetime counters
+    unsigned int acquires = 0;
+    unsigned int reuses = 0;
+    unsigned int creations = 0;
+    unsigned int evictions = 0;
+};
+
+//-----------------------------------------------------------------------------
+// Transient render targets bucketed by description. Acquire is a hash lookup plus a pop, Release
+//  a hash lookup plus a push. Targets left free for more than framesBeforeEviction BeginFrames are
+//  destroyed. Textures are only ever created and destroyed through the given functions, so the
+//  pool itself never touches D3D
+class RenderTargetPool
+{
+public:
+    typedef std::function<Texture*( const RenderTargetDescription& description )> CreateFunction;
+    typedef std::function<void( Texture* texture )> DestroyFunction;
+
+    RenderTargetPool( const CreateFunction& createFunction, const DestroyFunction& destroyFunction,
+                      unsigned int framesBeforeEviction = 3, unsigned int maxTargets = 256 );
+    ~RenderTargetPool();
+
+    RenderTargetPool( const RenderTargetPool& ) = delete;
+    void operator=( const RenderTargetPool& ) = delete;
+
+    Texture* Acquire( const RenderTargetDescription& description );
+    void Release( Texture* texture );
+
+    void BeginFrame();
+    void EvictAllFree();
+
+    bool IsPooled( const Texture* texture ) const;
+    RenderTargetPoolStats GetStats() const;
+
+private:
+    struct FreeTarget
+    {
+        Texture* texture = nullptr;
+        uint64_t releasedFrame = 0;
+    };
+
+    struct OwnedTarget
+    {
+        RenderTargetDescription description;
+        bool inUse = false;
+    };
+
+    CreateFunction m_Create;
+    DestroyFunction m_Destroy;
+    unsigned int m_FramesBeforeEviction = 3;
+    unsigned int m_MaxTargets = 256;
+    uint64_t m_CurrentFrame = 0;
+
+    // Each bucket is ordered by release, oldest first
+    std::unordered_map<RenderTargetDescription, std::vector<FreeTarget>, RenderTargetDescriptionHash> m_FreeBuckets;
+    std::unordered_map<const Texture*, OwnedTarget> m_OwnedTargets;
+
+    RenderTargetPoolStats m_Stats;
+
+    void DestroyTarget( Texture* texture );
+};
@@ -59,6 +59,19 @@ bool ShaderStage::Compile( RenderContext* ctx,
                            const void* source, 
                            const size_t sourceByteLen, 
                            ShaderType stage )
+{
+    if( !CompileByteCode( shaderName, source, sourceByteLen, stage ) )
+    {
+        return false;
+    }
+
+    return CreateFromByteCode( ctx );
+}
+
+bool ShaderStage::CompileByteCode( const char* shaderName,
+                                   const void* source,
+                                   const size_t sourceByteLen,
+                                   ShaderType stage )
 {
     const char* entrypoint = GetDefaultEntryPointForStage( stage );
     const char* shaderModel = GetShaderModelForStage( stage );
@@ -112,20 +125,33 @@ bool ShaderStage::Compile( RenderContext* ctx,
                             errorString );
         }
 
+        DX_SAFE_RELEASE( errors );
         if ( shaderName != BuiltInShader::ERROR_SHADER.builtInName )
         {
             DebuggerPrintf( "Fall back to using the built-in error shader\n" );
-            return CompileBuiltIn( ctx, BuiltInShader::ERROR_SHADER, stage );
+            const BuiltInShader& errorShader = BuiltInShader::ERROR_SHADER;
+            return CompileByteCode( errorShader.builtInName, errorShader.sourceCode,
+                                    strlen( (const char*)errorShader.sourceCode ), stage );
         }
         else
         {
             DebugBreak();
+            return false;
         }
     }
 
     DX_SAFE_RELEASE( errors );
 
-    return CreateShaderFromByteCode( ctx, byteCode, stage );
+    DX_SAFE_RELEASE( m_ByteCode );
+    m_ByteCode = byteCode;
+    m_Type = stage;
+    return true;
+}
+
+bool ShaderStage::CreateFromByteCode( RenderContext* ctx )
+{
+    GUARANTEE_OR_DIE( m_ByteCode != nullptr, "ShaderStage::CreateFromByteCode - Nothing has been compiled" );
+    return CreateShaderFromByteCode( ctx, m_ByteCode, m_Type );
 }
 
 bool ShaderStage::CompileBuiltIn( RenderContext* ctx, const BuiltInShader& builtInShader, ShaderType stage )
@@ -197,20 +223,41 @@ ShaderProgram::~ShaderProgram()
 
 bool ShaderProgram::CreateFromFile( const std::string& fileName )
 {
-    m_FileName = fileName;
+    const bool compiled = CompileFromFile( fileName );
+    GUARANTEE_OR_DIE( compiled, Stringf( "ShaderProgram::CreateFromFile - Failed to load file %s", fileName.c_str() ) );
 
-    size_t fileSize = 0;
-    void* src = FileReadToNewBuffer( fileName, &fileSize );
-    GUARANTEE_OR_DIE( src != nullptr, Stringf( "ShaderProgram::CreateFromFile - Failed to load file %s", fileName.c_str() ) );
+    return CreateFromByteCode();
+}
+
+bool ShaderProgram::CompileFromFile( const std::string& fileName )
+{
+    const MappedFile sourceFile( fileName );
+    if( !sourceFile.IsOpen() )
+    {
+        m_FileName = fileName;
+        return false;
+    }
+
+    return CompileFromSource( fileName, sourceFile.GetView() );
+}
+
+bool ShaderProgram::CompileFromSource( const std::string& fileName, const BufferView& source )
+{
+    m_FileName = fileName;
 
     m_VertexStage = new ShaderStage();
-    m_VertexStage->Compile( m_Owner, fileName, src, fileSize, SHADER_TYPE_VERTEX );
+    const bool vertexCompiled = m_VertexStage->CompileByteCode( fileName.c_str(), source.data, source.size, SHADER_TYPE_VERTEX );
 
     m_FragmentStage = new ShaderStage();
-    m_FragmentStage->Compile( m_Owner, fileName, src, fileSize, SHADER_TYPE_FRAGMENT );
+    const bool fragmentCompiled = m_FragmentStage->CompileByteCode( fileName.c_str(), source.data, source.size, SHADER_TYPE_FRAGMENT );
 
-    delete[] src;
-    fileSize = 0;
+    return vertexCompiled && fragmentCompiled;
+}
+
+bool ShaderProgram::CreateFromByteCode()
+{
+    m_VertexStage->CreateFromByteCode( m_Owner );
+    m_FragmentStage->CreateFromByteCode( m_Owner );
 
     return m_VertexStage->IsValid() && m_FragmentStage->IsValid();
 }
@@ -308,15 +355,15 @@ void ShaderProgram::Reload()
     delete m_VertexStage;
     delete m_FragmentStage;
 
-    size_t fileSize = 0;
-    void* src = FileReadToNewBuffer( m_FileName, &fileSize );
+    const MappedFile sourceFile( m_FileName );
+    const BufferView source = sourceFile.GetView();
 
     m_VertexStage = new ShaderStage();
     m_FragmentStage = new ShaderStage();
 
-    m_VertexStage->Compile( m_Owner, m_FileName, src, fileSize, SHADER_TYPE_VERTEX );
+    m_VertexStage->Compile( m_Owner, m_FileName, source.data, source.size, SHADER_TYPE_VERTEX );
 
-    m_FragmentStage->Compile( m_Owner, m_FileName, src, fileSize, SHADER_TYPE_FRAGMENT );
+    m_FragmentStage->Compile( m_Owner, m_FileName, source.data, source.size, SHADER_TYPE_FRAGMENT );
 }
 
 
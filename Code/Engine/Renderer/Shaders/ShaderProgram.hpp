@@ -15,6 +15,7 @@ struct ID3D11InputLayout;
 
 // Engine Predefines
 class RenderContext;
+struct BufferView;
 struct BuiltInShader;
 
 enum ShaderType
@@ -52,6 +53,14 @@ public:
                          const BuiltInShader& builtInShader,
                          ShaderType stage );
 
+    // The two halves of Compile. CompileByteCode does not touch the device so it can run on a
+    //  worker thread, CreateFromByteCode has to run on the render thread
+    bool CompileByteCode( const char* shaderName,
+                          const void* source,
+                          size_t sourceByteLen,
+                          ShaderType stage );
+    bool CreateFromByteCode( RenderContext* ctx );
+
     const void* GetByteCode() const;
     size_t GetByteCodeLength() const;
 
@@ -74,6 +83,11 @@ public:
     ~ShaderProgram();
 
     bool CreateFromFile( const std::string& fileName );
+    // CreateFromFile split for async loading. CompileFromFile reads and compiles to byte code off
+    //  the render thread, CreateFromByteCode then creates the device shaders on it
+    bool CompileFromFile( const std::string& fileName );
+    bool CompileFromSource( const std::string& fileName, const BufferView& source );
+    bool CreateFromByteCode();
     bool CreateFromBuiltIn( const BuiltInShader& builtInShader );
     ShaderStage* GetVertexShader() { return m_VertexStage; }
     ShaderStage* GetFragmentShader() { return m_FragmentStage; }
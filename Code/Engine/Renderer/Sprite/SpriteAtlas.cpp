@@ -0,0 +1,257 @@
+#include "SpriteAtlas.hpp"
+
+#include "Engine/Console/Console.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Math/RectPacker.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/Sprite/SpriteSheet.hpp"
+
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+SpriteAtlas::SpriteAtlas( const IntVec2& pageSize, const int padding )
+    : m_PageSize( pageSize )
+    , m_Padding( padding > 0 ? padding : 0 )
+{
+}
+
+SpriteAtlas::~SpriteAtlas()
+{
+    DestroyGpuResources();
+}
+
+bool SpriteAtlas::AddImageFromFile( const std::string& name, const std::string& filePath,
+                                    const IntVec2& gridLayout, const bool flipV )
+{
+    AtlasImage image;
+    if( !Image::DecodeFromFile( filePath, flipV, image.dimensions, image.texels ) )
+    {
+#if !defined(ENGINE_DISABLE_CONSOLE)
+        g_Console->Log( LOG_ERROR, Stringf( "SpriteAtlas::AddImageFromFile - Failed to load image \"%s\"", filePath.c_str() ) );
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+        return false;
+    }
+
+    image.name = name;
+    image.gridLayout = gridLayout;
+    image.flipV = flipV;
+
+    // A name added twice keeps the newest image
+    for( AtlasImage& existingImage : m_Images )
+    {
+        if( existingImage.name == name )
+        {
+            existingImage = std::move( image );
+            m_IsPacked = false;
+            return true;
+        }
+    }
+
+    m_Images.push_back( std::move( image ) );
+    m_IsPacked = false;
+    return true;
+}
+
+void SpriteAtlas::AddImage( const std::string& name, const Image& image, const IntVec2& gridLayout, const bool flipV )
+{
+    AtlasImage atlasImage;
+    atlasImage.name = name;
+    atlasImage.dimensions = image.GetDimensions();
+    atlasImage.texels.assign( image.GetTexels(), image.GetTexels() + static_cast<size_t>( atlasImage.dimensions.x ) * atlasImage.dimensions.y );
+    atlasImage.gridLayout = gridLayout;
+    atlasImage.flipV = flipV;
+
+    for( AtlasImage& existingImage : m_Images )
+    {
+        if( existingImage.name == name )
+        {
+            existingImage = std::move( atlasImage );
+            m_IsPacked = false;
+            return;
+        }
+    }
+
+    m_Images.push_back( std::move( atlasImage ) );
+    m_IsPacked = false;
+}
+
+bool SpriteAtlas::Pack()
+{
+    m_PageDimensions.clear();
+    m_PageTexels.clear();
+
+    // Every image is packed with a border of padding texels, filled from its edges so
+    //  filtering near the edge never samples a neighbour
+    std::vector<IntVec2> paddedSizes;
+    paddedSizes.reserve( m_Images.size() );
+    for( const AtlasImage& image : m_Images )
+    {
+        const bool isEmpty = image.dimensions.x <= 0 || image.dimensions.y <= 0;
+        paddedSizes.push_back( isEmpty ? IntVec2::ZERO : image.dimensions + IntVec2( m_Padding * 2, m_Padding * 2 ) );
+    }
+
+    std::vector<RectPlacement> placements;
+    const int pageCount = PackRects( paddedSizes, m_PageSize, placements );
+
+    // Pages only grow as far as they are used, rounded up to whole 4x4 blocks
+    m_PageDimensions.assign( pageCount, IntVec2::ZERO );
+    for( size_t imageIndex = 0; imageIndex < m_Images.size(); ++imageIndex )
+    {
+        const RectPlacement& placement = placements[ imageIndex ];
+        if( placement.binIndex < 0 )
+        {
+            continue;
+        }
+
+        IntVec2& pageDimensions = m_PageDimensions[ placement.binIndex ];
+        const IntVec2 rectMaxs = placement.position + paddedSizes[ imageIndex ];
+        pageDimensions.x = rectMaxs.x > pageDimensions.x ? rectMaxs.x : pageDimensions.x;
+        pageDimensions.y = rectMaxs.y > pageDimensions.y ? rectMaxs.y : pageDimensions.y;
+    }
+    for( IntVec2& pageDimensions : m_PageDimensions )
+    {
+        pageDimensions.x = ( pageDimensions.x + 3 ) & ~3;
+        pageDimensions.y = ( pageDimensions.y + 3 ) & ~3;
+        m_PageTexels.emplace_back( static_cast<size_t>( pageDimensions.x ) * pageDimensions.y, Rgba8( 0, 0, 0, 0 ) );
+    }
+
+    bool packedAll = true;
+    for( size_t imageIndex = 0; imageIndex < m_Images.size(); ++imageIndex )
+    {
+        AtlasImage& image = m_Images[ imageIndex ];
+        const RectPlacement& placement = placements[ imageIndex ];
+        image.pageIndex = placement.binIndex;
+        if( placement.binIndex < 0 )
+        {
+#if !defined(ENGINE_DISABLE_CONSOLE)
+            g_Console->Log( LOG_ERROR, Stringf( "SpriteAtlas::Pack - Image \"%s\" does not fit a page", image.name.c_str() ) );
+#endif // !defined(ENGINE_DISABLE_CONSOLE)
+            packedAll = false;
+            continue;
+        }
+
+        CopyImageToPage( image, placement.position );
+
+        const Vec2 pageDimensions = Vec2( static_cast<float>( m_PageDimensions[ image.pageIndex ].x ),
+                                          static_cast<float>( m_PageDimensions[ image.pageIndex ].y ) );
+        const IntVec2 imageMins = placement.position + IntVec2( m_Padding, m_Padding );
+        const IntVec2 imageMaxs = imageMins + image.dimensions;
+        image.uvBounds = AABB2( static_cast<float>( imageMins.x ) / pageDimensions.x,
+                                static_cast<float>( imageMins.y ) / pageDimensions.y,
+                                static_cast<float>( imageMaxs.x ) / pageDimensions.x,
+                                static_cast<float>( imageMaxs.y ) / pageDimensions.y );
+    }
+
+    m_IsPacked = true;
+    return packedAll;
+}
+
+bool SpriteAtlas::Build( RenderContext* context )
+{
+    bool packedAll = true;
+    if( !m_IsPacked )
+    {
+        packedAll = Pack();
+    }
+
+    DestroyGpuResources();
+    for( size_t pageIndex = 0; pageIndex < m_PageTexels.size(); ++pageIndex )
+    {
+        m_PageTextures.push_back( Texture::CreateFromColorArray( context, m_PageTexels[ pageIndex ].data(), m_PageDimensions[ pageIndex ] ) );
+    }
+
+    // Same grid as a sheet made from the image on its own, then squeezed into the packed rect
+    for( const AtlasImage& image : m_Images )
+    {
+        if( image.pageIndex < 0 )
+        {
+            continue;
+        }
+
+        SpriteSheet* sheet = new SpriteSheet( *m_PageTextures[ image.pageIndex ], image.gridLayout, image.flipV );
+        sheet->RemapSpriteUVs( image.uvBounds );
+        m_SpriteSheets[ image.name ] = sheet;
+    }
+
+    return packedAll;
+}
+
+SpriteSheet* SpriteAtlas::GetSpriteSheet( const std::string& name ) const
+{
+    const auto foundSheet = m_SpriteSheets.find( name );
+    return foundSheet != m_SpriteSheets.cend() ? foundSheet->second : nullptr;
+}
+
+bool SpriteAtlas::GetImageBounds( const std::string& name, OUT_PARAM int& pageIndex, OUT_PARAM AABB2& uvBounds ) const
+{
+    for( const AtlasImage& image : m_Images )
+    {
+        if( image.name == name && m_IsPacked && image.pageIndex >= 0 )
+        {
+            pageIndex = image.pageIndex;
+            uvBounds = image.uvBounds;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+float SpriteAtlas::GetOccupancy() const
+{
+    long long imageArea = 0;
+    for( const AtlasImage& image : m_Images )
+    {
+        if( image.pageIndex >= 0 )
+        {
+            imageArea += static_cast<long long>( image.dimensions.x ) * image.dimensions.y;
+        }
+    }
+
+    long long pageArea = 0;
+    for( const IntVec2& pageDimensions : m_PageDimensions )
+    {
+        pageArea += static_cast<long long>( pageDimensions.x ) * pageDimensions.y;
+    }
+
+    return pageArea > 0 ? static_cast<float>( static_cast<double>( imageArea ) / static_cast<double>( pageArea ) ) : 0.f;
+}
+
+void SpriteAtlas::CopyImageToPage( const AtlasImage& image, const IntVec2& position )
+{
+    std::vector<Rgba8>& page = m_PageTexels[ image.pageIndex ];
+    const int pageWidth = m_PageDimensions[ image.pageIndex ].x;
+    const int paddedHeight = image.dimensions.y + m_Padding * 2;
+
+    for( int paddedY = 0; paddedY < paddedHeight; ++paddedY )
+    {
+        int sourceY = paddedY - m_Padding;
+        sourceY = sourceY < 0 ? 0 : ( sourceY >= image.dimensions.y ? image.dimensions.y - 1 : sourceY );
+        const Rgba8* sourceRow = &image.texels[ static_cast<size_t>( sourceY ) * image.dimensions.x ];
+        Rgba8* pageRow = &page[ static_cast<size_t>( position.y + paddedY ) * pageWidth + position.x ];
+
+        for( int paddedX = 0; paddedX < m_Padding; ++paddedX )
+        {
+            pageRow[ paddedX ] = sourceRow[ 0 ];
+            pageRow[ m_Padding + image.dimensions.x + paddedX ] = sourceRow[ image.dimensions.x - 1 ];
+        }
+        memcpy( static_cast<void*>( pageRow + m_Padding ), sourceRow, image.dimensions.x * sizeof( Rgba8 ) );
+    }
+}
+
+void SpriteAtlas::DestroyGpuResources()
+{
+    for( auto& sheet : m_SpriteSheets )
+    {
+        delete sheet.second;
+        sheet.second = nullptr;
+    }
+    m_SpriteSheets.clear();
+
+    for( Texture*& pageTexture : m_PageTextures )
+    {
+        delete pageTexture;
+        pageTexture = nullptr;
+    }
+    m_PageTextures.clear();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
+#include "Engine/Core/Math/Primatives/IntVec2.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class Image;
+class RenderContext;
+class SpriteSheet;
+class Texture;
+
+//-----------------------------------------------------------------------------
+// Packs many sprite images into a few large pages so a 2D scene draws with one or two texture
+//  binds. Every image keeps its grid and comes back as a SpriteSheet on its page with the
+//  UVs moved into the packed rect, so code written against SpriteSheet works unchanged. Those
+//  sheets can be handed to RenderContext::CreateOrGetMaterialSheetFromData as well
+class SpriteAtlas
+{
+public:
+    explicit SpriteAtlas( const IntVec2& pageSize = IntVec2( 2048, 2048 ), int padding = 2 );
+    ~SpriteAtlas();
+
+    SpriteAtlas( const SpriteAtlas& ) = delete;
+    void operator=( const SpriteAtlas& ) = delete;
+
+    // Queued until Pack. flipV decodes the same way Texture::CreateFromFile does, and is passed
+    //  to the SpriteSheet so its UVs match
+    bool AddImageFromFile( const std::string& name, const std::string& filePath,
+                           const IntVec2& gridLayout = IntVec2( 1, 1 ), bool flipV = false );
+    void AddImage( const std::string& name, const Image& image,
+                   const IntVec2& gridLayout = IntVec2( 1, 1 ), bool flipV = false );
+
+    // CPU half of Build, touches no device. Images too big for a page are left out and fail the pack
+    bool Pack();
+    // Packs if needed, uploads the pages and creates the sprite sheets
+    bool Build( RenderContext* context );
+
+    SpriteSheet* GetSpriteSheet( const std::string& name ) const;
+
+    int GetPageCount() const { return static_cast<int>( m_PageDimensions.size() ); }
+    IntVec2 GetPageDimensions( int pageIndex ) const { return m_PageDimensions.at( pageIndex ); }
+    const std::vector<Rgba8>& GetPageTexels( int pageIndex ) const { return m_PageTexels.at( pageIndex ); }
+    const Texture* GetPageTexture( int pageIndex ) const { return m_PageTextures.at( pageIndex ); }
+
+    // Page and UV rect of a packed image, false if it was not packed
+    bool GetImageBounds( const std::string& name, OUT_PARAM int& pageIndex, OUT_PARAM AABB2& uvBounds ) const;
+    // Image area over the area of every page
+    float GetOccupancy() const;
+
+private:
+    struct AtlasImage
+    {
+        std::string name;
+        IntVec2 dimensions = IntVec2::ZERO;
+        std::vector<Rgba8> texels;
+        IntVec2 gridLayout = IntVec2( 1, 1 );
+        bool flipV = false;
+
+        int pageIndex = -1;
+        AABB2 uvBounds;
+    };
+
+    IntVec2 m_PageSize = IntVec2::ZERO;
+    int m_Padding = 0;
+    bool m_IsPacked = false;
+
+    std::vector<AtlasImage> m_Images;
+    std::vector<IntVec2> m_PageDimensions;
+    std::vector<std::vector<Rgba8>> m_PageTexels;
+    std::vector<Texture*> m_PageTextures;
+    std::map<std::string, SpriteSheet*> m_SpriteSheets;
+
+    void CopyImageToPage( const AtlasImage& image, const IntVec2& position );
+    void DestroyGpuResources();
+};
@@ -1,5 +1,6 @@
 #include "SpriteDefinition.hpp"
 
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/Sprite/SpriteSheet.hpp"
 
@@ -27,3 +28,9 @@ void SpriteDefinition::GetUVs( OUT_PARAM Vec2& uvAtBottomLeft, OUT_PARAM Vec2& u
     uvAtBottomLeft = m_UVAtBottomLeft;
     uvAtTopRight = m_UVAtTopRight;
 }
+
+void SpriteDefinition::RemapUVs( const AABB2& uvBounds )
+{
+    m_UVAtBottomLeft = uvBounds.GetPointAtUV( m_UVAtBottomLeft );
+    m_UVAtTopRight = uvBounds.GetPointAtUV( m_UVAtTopRight );
+}
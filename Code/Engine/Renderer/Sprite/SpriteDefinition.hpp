@@ -3,6 +3,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Math/Primatives/Vec2.hpp"
 
+struct AABB2;
 class SpriteSheet;
 class Texture;
 
@@ -18,6 +19,8 @@ public:
     float GetAspectRatio() const;
 
     void GetUVs( OUT_PARAM Vec2& uvAtBottomLeft, OUT_PARAM Vec2& uvAtTopRight ) const;
+    // Moves the UVs from the whole texture into uvBounds of it
+    void RemapUVs( const AABB2& uvBounds );
 
 private:
     const SpriteSheet& m_SpriteSheet;
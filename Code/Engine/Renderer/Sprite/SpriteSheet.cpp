@@ -1,5 +1,6 @@
 #include "SpriteSheet.hpp"
 
+#include "Engine/Core/Math/Primatives/AABB2.hpp"
 #include "Engine/Core/Math/Primatives/IntVec2.hpp"
 #include "Engine/Renderer/Sprite/SpriteDefinition.hpp"
 
@@ -73,3 +74,11 @@ void SpriteSheet::GetSpriteUVs( const IntVec2& spriteIndex, OUT_PARAM Vec2& uvAt
     const int index = spriteIndex.y * m_SpriteSheetSize.x + spriteIndex.x;
     GetSpriteUVs( index, uvAtBottomLeft, uvAtTopRight );
 }
+
+void SpriteSheet::RemapSpriteUVs( const AABB2& uvBounds )
+{
+    for( SpriteDefinition& spriteDef : m_Definitions )
+    {
+        spriteDef.RemapUVs( uvBounds );
+    }
+}
@@ -6,6 +6,7 @@
 #include "Engine/Core/Math/Primatives/IntVec2.hpp"
 #include "Engine/Renderer/Sprite/SpriteDefinition.hpp"
 
+struct AABB2;
 struct IntVec2;
 class Texture;
 
@@ -21,6 +22,9 @@ public:
     void GetSpriteUVs( const IntVec2& spriteIndex, OUT_PARAM Vec2& uvAtBottomLeft, OUT_PARAM Vec2& uvAtTopRight ) const;
     int GetNumberOfSprites() const { return ( int) m_Definitions.size(); }
 
+    // For a sheet whose image was packed into part of the texture, such as a SpriteAtlas page
+    void RemapSpriteUVs( const AABB2& uvBounds );
+
 private:
     const Texture& m_Texture;
 
@@ -1,9 +1,10 @@
 #include "Texture.hpp"
 
-#include "ThirdParty/stb/stb_image.h"
-
+#include "Engine/Core/Image.hpp"
+#include "Engine/IO/CookedTextureUtils.hpp"
 #include "Engine/Renderer/D3D11Common.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/RenderTargetPool.hpp"
 #include "Engine/Renderer/TextureView.hpp"
 #include "Engine/Console/Console.hpp"
 
@@ -36,21 +37,11 @@ Texture::~Texture()
 
 STATIC Texture* Texture::CreateFromFile( RenderContext* context, const std::string& filePath, bool flipV )
 {
-    int imageTexelSizeX = 0;
-    int imageTexelSizeY = 0;
-    int numComponents = 0;
-    const int numComponentsRequested = 4;
-
-    stbi_set_flip_vertically_on_load( flipV );
-    unsigned char* imageData = stbi_load( filePath.c_str(),
-                                          &imageTexelSizeX,
-                                          &imageTexelSizeY,
-                                          &numComponents,
-                                          numComponentsRequested
-                                        );
+    IntVec2 imageSize;
+    std::vector<Rgba8> imageTexels;
 
     // Ensure that the data was correctly read in
-    if( !imageData )
+    if( !Image::DecodeFromFile( filePath, flipV, imageSize, imageTexels ) )
     {
 #if !defined(ENGINE_DISABLE_CONSOLE)
         g_Console->Log( LOG_ERROR, Stringf( "Failed too load image \"%s\"", filePath.c_str() ) );
@@ -62,69 +53,108 @@ STATIC Texture* Texture::CreateFromFile( RenderContext* context, const std::stri
 #endif // defined(ENGINE_DISABLE_CONSOLE)
     }
 
-    if( !(numComponents == 3 || numComponents == 4) && imageTexelSizeX <= 0 && imageTexelSizeY <= 0 )
+    return CreateFromColorArray( context, imageTexels.data(), imageSize );
+}
+
+STATIC Texture* Texture::CreateFromFile( RenderContext* context, const std::string& filePath, const TextureCookOptions& cookOptions )
+{
+    TextureData textureData;
+    if( !LoadTextureDataFromFile( filePath, cookOptions, textureData ) )
     {
 #if !defined(ENGINE_DISABLE_CONSOLE)
-        g_Console->Log( LOG_ERROR,
-                        Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)",
-                                 filePath.c_str(),
-                                 numComponents,
-                                 imageTexelSizeX,
-                                 imageTexelSizeY
-                               )
-                      );
+        g_Console->Log( LOG_ERROR, Stringf( "Failed too load image \"%s\"", filePath.c_str() ) );
         return nullptr;
 #endif // !defined(ENGINE_DISABLE_CONSOLE)
 #if defined(ENGINE_DISABLE_CONSOLE)
-        ERROR_RECOVERABLE( Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)",
-                              filePath.c_str(),
-                              numComponents,
-                              imageTexelSizeX,
-                              imageTexelSizeY )
-                         );
+        ERROR_RECOVERABLE( Stringf( "Failed to load image \"%s\"", filePath.c_str() ) );
         return nullptr;
 #endif // defined(ENGINE_DISABLE_CONSOLE)
     }
 
+    return CreateFromTextureData( context, textureData );
+}
+
+STATIC Texture* Texture::CreateFromTextureData( RenderContext* context, const TextureData& textureData )
+{
+    if( textureData.mips.empty() )
+    {
+        return nullptr;
+    }
+
     D3D11_TEXTURE2D_DESC desc;
-    desc.Width = imageTexelSizeX;
-    desc.Height = imageTexelSizeY;
-    desc.MipLevels = 1;
+    desc.Width = textureData.mips.front().dimensions.x;
+    desc.Height = textureData.mips.front().dimensions.y;
+    desc.MipLevels = static_cast<UINT>( textureData.mips.size() );
     desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    switch( textureData.format )
+    {
+        case TextureFormat::BC1: desc.Format = DXGI_FORMAT_BC1_UNORM; break;
+        case TextureFormat::BC3: desc.Format = DXGI_FORMAT_BC3_UNORM; break;
+        case TextureFormat::BC7: desc.Format = DXGI_FORMAT_BC7_UNORM; break;
+        default: desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+    }
     desc.SampleDesc.Count = 1; // MSAA
     desc.SampleDesc.Quality = 0;
-    desc.Usage = D3D11_USAGE_IMMUTABLE; // If using mip-chains, need to be GPU or dynamic
+    desc.Usage = D3D11_USAGE_IMMUTABLE; // Every mip is given up front
     desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
     desc.CPUAccessFlags = 0;
     desc.MiscFlags = 0;
 
-    D3D11_SUBRESOURCE_DATA initialData;
-    initialData.pSysMem = imageData;
-    initialData.SysMemPitch = imageTexelSizeX * 4;
-    initialData.SysMemSlicePitch = 0;
+    std::vector<D3D11_SUBRESOURCE_DATA> initialData( textureData.mips.size() );
+    for( size_t mipIndex = 0; mipIndex < textureData.mips.size(); ++mipIndex )
+    {
+        const TextureMip& mip = textureData.mips[ mipIndex ];
+        initialData[ mipIndex ].pSysMem = &textureData.data[ static_cast<size_t>( mip.dataOffset ) ];
+        initialData[ mipIndex ].SysMemPitch = mip.rowPitch;
+        initialData[ mipIndex ].SysMemSlicePitch = 0;
+    }
 
     ID3D11Device* device = context->m_Device;
     ID3D11Texture2D* texHandle = nullptr;
-    device->CreateTexture2D( &desc, &initialData, &texHandle );
-
-    stbi_image_free( imageData );
+    device->CreateTexture2D( &desc, initialData.data(), &texHandle );
+    if( texHandle == nullptr )
+    {
+        return nullptr;
+    }
 
     return new Texture( context, texHandle );
 }
 
 Texture* Texture::CreateRenderTargetFromSize( RenderContext* context, const IntVec2& size )
+{
+    return CreateRenderTarget( context, RenderTargetDescription( size ) );
+}
+
+Texture* Texture::CreateRenderTarget( RenderContext* context, const RenderTargetDescription& description )
 {
     D3D11_TEXTURE2D_DESC desc;
-    desc.Width = size.x;
-    desc.Height = size.y;
+    desc.Width = description.size.x;
+    desc.Height = description.size.y;
     desc.MipLevels = 1;
     desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    switch( description.format )
+    {
+    case RenderTargetFormat::RGBA16_FLOAT: desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT; break;
+    case RenderTargetFormat::R32_FLOAT: desc.Format = DXGI_FORMAT_R32_FLOAT; break;
+    case RenderTargetFormat::RGBA8_UNORM: // Explicit Fallthrough
+    default: desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+    }
     desc.SampleDesc.Count = 1;
     desc.SampleDesc.Quality = 0;
     desc.Usage = D3D11_USAGE_DEFAULT;
-    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    desc.BindFlags = 0;
+    if( description.bindFlags & RENDER_TARGET_BIND_RENDER_TARGET_BIT )
+    {
+        desc.BindFlags |= D3D11_BIND_RENDER_TARGET;
+    }
+    if( description.bindFlags & RENDER_TARGET_BIND_SHADER_RESOURCE_BIT )
+    {
+        desc.BindFlags |= D3D11_BIND_SHADER_RESOURCE;
+    }
+    if( description.bindFlags & RENDER_TARGET_BIND_UNORDERED_ACCESS_BIT )
+    {
+        desc.BindFlags |= D3D11_BIND_UNORDERED_ACCESS;
+    }
     desc.CPUAccessFlags = 0;
     desc.MiscFlags = 0;
 
@@ -179,7 +209,7 @@ Texture* Texture::CreateFromColorArray( RenderContext* context, const Rgba8* col
 
     D3D11_SUBRESOURCE_DATA initialData;
     initialData.pSysMem = colorArray;
-    initialData.SysMemPitch = 4;
+    initialData.SysMemPitch = size.x * 4;
     initialData.SysMemSlicePitch = 0;
 
     ID3D11Device* device = context->m_Device;
@@ -11,6 +11,9 @@ struct ID3D11Texture2D;
 class RenderContext;
 class TextureView;
 struct Rgba8;
+struct RenderTargetDescription;
+struct TextureCookOptions;
+struct TextureData;
 
 enum class TextureViewType
 {
@@ -37,7 +40,11 @@ public:
     //-------------------------------------------------------------------------
     // Static Methods
     static Texture* CreateFromFile( RenderContext* context, const std::string& filePath, bool flipV = false );
+    // Goes through the texture cooker, so the result has mips and may be block compressed
+    static Texture* CreateFromFile( RenderContext* context, const std::string& filePath, const TextureCookOptions& cookOptions );
+    static Texture* CreateFromTextureData( RenderContext* context, const TextureData& textureData );
     static Texture* CreateRenderTargetFromSize( RenderContext* context, const IntVec2& size );
+    static Texture* CreateRenderTarget( RenderContext* context, const RenderTargetDescription& description );
     static Texture* CreateFromColor( RenderContext* context, const Rgba8& color );
     static Texture* CreateFromColorArray( RenderContext* context, const Rgba8* colorArray, const IntVec2& size );
     static Texture* CreateDepthBuffer( RenderContext* context, const IntVec2& size );
@@ -0,0 +1,631 @@
+#include "TextureEncoder.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+constexpr int BC7_INDEX_WEIGHTS[ 16 ] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+constexpr float BC1_INDEX_WEIGHTS[ 4 ] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+
+// Endpoint fits after the first, each re-solves the endpoints for the indexes the last one chose
+constexpr int ENDPOINT_REFINE_PASSES = 2;
+
+static int GetChannel( const Rgba8& texel, const int channel )
+{
+    switch( channel )
+    {
+        case 0: return texel.r;
+        case 1: return texel.g;
+        case 2: return texel.b;
+        default: return texel.a;
+    }
+}
+
+static int ClampInt( const int value, const int minValue, const int maxValue )
+{
+    return value < minValue ? minValue : ( value > maxValue ? maxValue : value );
+}
+
+static int GetSquaredError( const Rgba8& texel, const int* color, const int channelCount )
+{
+    int error = 0;
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        const int delta = GetChannel( texel, channel ) - color[ channel ];
+        error += delta * delta;
+    }
+    return error;
+}
+
+//-----------------------------------------------------------------------------
+// Principal axis of the block's colors, from the mean out to the furthest projections each way
+static void FitEndpointLine( const Rgba8* texels, const int channelCount, float* lineStart, float* lineEnd )
+{
+    float mean[ 4 ] = {};
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        for( int channel = 0; channel < channelCount; ++channel )
+        {
+            mean[ channel ] += static_cast<float>( GetChannel( texels[ texelIndex ], channel ) );
+        }
+    }
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        mean[ channel ] /= static_cast<float>( TEXTURE_BLOCK_TEXEL_COUNT );
+    }
+
+    float covariance[ 4 ][ 4 ] = {};
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        float delta[ 4 ];
+        for( int channel = 0; channel < channelCount; ++channel )
+        {
+            delta[ channel ] = static_cast<float>( GetChannel( texels[ texelIndex ], channel ) ) - mean[ channel ];
+        }
+        for( int row = 0; row < channelCount; ++row )
+        {
+            for( int column = 0; column < channelCount; ++column )
+            {
+                covariance[ row ][ column ] += delta[ row ] * delta[ column ];
+            }
+        }
+    }
+
+    // Power iteration, starting from the channel with the most variance
+    int widestChannel = 0;
+    for( int channel = 1; channel < channelCount; ++channel )
+    {
+        if( covariance[ channel ][ channel ] > covariance[ widestChannel ][ widestChannel ] ) { widestChannel = channel; }
+    }
+    float axis[ 4 ] = {};
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        axis[ channel ] = covariance[ widestChannel ][ channel ];
+    }
+    for( int iteration = 0; iteration < 8; ++iteration )
+    {
+        float next[ 4 ] = {};
+        float largest = 0.f;
+        for( int row = 0; row < channelCount; ++row )
+        {
+            for( int column = 0; column < channelCount; ++column )
+            {
+                next[ row ] += covariance[ row ][ column ] * axis[ column ];
+            }
+            largest = fmaxf( largest, fabsf( next[ row ] ) );
+        }
+        if( largest <= 0.f ) { break; }
+        for( int channel = 0; channel < channelCount; ++channel )
+        {
+            axis[ channel ] = next[ channel ] / largest;
+        }
+    }
+
+    float lengthSquared = 0.f;
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        lengthSquared += axis[ channel ] * axis[ channel ];
+    }
+
+    float minProjection = 0.f;
+    float maxProjection = 0.f;
+    if( lengthSquared > 1e-12f )
+    {
+        const float inverseLength = 1.f / sqrtf( lengthSquared );
+        for( int channel = 0; channel < channelCount; ++channel )
+        {
+            axis[ channel ] *= inverseLength;
+        }
+
+        for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+        {
+            float projection = 0.f;
+            for( int channel = 0; channel < channelCount; ++channel )
+            {
+                projection += ( static_cast<float>( GetChannel( texels[ texelIndex ], channel ) ) - mean[ channel ] ) * axis[ channel ];
+            }
+            minProjection = fminf( minProjection, projection );
+            maxProjection = fmaxf( maxProjection, projection );
+        }
+    }
+
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        lineStart[ channel ] = mean[ channel ] + axis[ channel ] * minProjection;
+        lineEnd[ channel ] = mean[ channel ] + axis[ channel ] * maxProjection;
+    }
+}
+
+// Least squares endpoints for fixed interpolation weights, false when every weight is the same
+static bool SolveEndpoints( const Rgba8* texels, const float* weights, const int channelCount,
+                            float* start, float* end )
+{
+    float startSquared = 0.f;
+    float endSquared = 0.f;
+    float startEnd = 0.f;
+    float startSum[ 4 ] = {};
+    float endSum[ 4 ] = {};
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        const float endWeight = weights[ texelIndex ];
+        const float startWeight = 1.f - endWeight;
+        startSquared += startWeight * startWeight;
+        endSquared += endWeight * endWeight;
+        startEnd += startWeight * endWeight;
+        for( int channel = 0; channel < channelCount; ++channel )
+        {
+            const float value = static_cast<float>( GetChannel( texels[ texelIndex ], channel ) );
+            startSum[ channel ] += startWeight * value;
+            endSum[ channel ] += endWeight * value;
+        }
+    }
+
+    const float determinant = startSquared * endSquared - startEnd * startEnd;
+    if( fabsf( determinant ) < 1e-6f ) { return false; }
+
+    const float inverseDeterminant = 1.f / determinant;
+    for( int channel = 0; channel < channelCount; ++channel )
+    {
+        start[ channel ] = ( startSum[ channel ] * endSquared - endSum[ channel ] * startEnd ) * inverseDeterminant;
+        end[ channel ] = ( endSum[ channel ] * startSquared - startSum[ channel ] * startEnd ) * inverseDeterminant;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Little endian bit stream over a zeroed block, the layout BC7 uses
+class BlockBitWriter
+{
+public:
+    explicit BlockBitWriter( unsigned char* block ) : m_Block( block ) {}
+
+    void Write( const unsigned int value, const int bitCount )
+    {
+        for( int bit = 0; bit < bitCount; ++bit, ++m_BitPosition )
+        {
+            if( ( value >> bit ) & 1u ) { m_Block[ m_BitPosition >> 3 ] |= static_cast<unsigned char>( 1u << ( m_BitPosition & 7 ) ); }
+        }
+    }
+
+private:
+    unsigned char* m_Block = nullptr;
+    int m_BitPosition = 0;
+};
+
+class BlockBitReader
+{
+public:
+    explicit BlockBitReader( const unsigned char* block ) : m_Block( block ) {}
+
+    unsigned int Read( const int bitCount )
+    {
+        unsigned int value = 0;
+        for( int bit = 0; bit < bitCount; ++bit, ++m_BitPosition )
+        {
+            value |= static_cast<unsigned int>( ( m_Block[ m_BitPosition >> 3 ] >> ( m_BitPosition & 7 ) ) & 1u ) << bit;
+        }
+        return value;
+    }
+
+private:
+    const unsigned char* m_Block = nullptr;
+    int m_BitPosition = 0;
+};
+
+//-----------------------------------------------------------------------------
+static unsigned short PackRgb565( const float* color )
+{
+    const int red = ClampInt( static_cast<int>( color[ 0 ] * 31.f / 255.f + .5f ), 0, 31 );
+    const int green = ClampInt( static_cast<int>( color[ 1 ] * 63.f / 255.f + .5f ), 0, 63 );
+    const int blue = ClampInt( static_cast<int>( color[ 2 ] * 31.f / 255.f + .5f ), 0, 31 );
+    return static_cast<unsigned short>( ( red << 11 ) | ( green << 5 ) | blue );
+}
+
+static void UnpackRgb565( const unsigned short packed, int* color )
+{
+    const int red = packed >> 11;
+    const int green = ( packed >> 5 ) & 63;
+    const int blue = packed & 31;
+    color[ 0 ] = ( red << 3 ) | ( red >> 2 );
+    color[ 1 ] = ( green << 2 ) | ( green >> 4 );
+    color[ 2 ] = ( blue << 3 ) | ( blue >> 2 );
+}
+
+// The palette hardware builds. Three color mode, with black at index 3, only when color0 <= color1
+//  and allowed, BC3 always decodes four colors
+static void GetBC1Palette( const unsigned short color0, const unsigned short color1, const bool allowThreeColor,
+                           int palette[ 4 ][ 3 ] )
+{
+    UnpackRgb565( color0, palette[ 0 ] );
+    UnpackRgb565( color1, palette[ 1 ] );
+    for( int channel = 0; channel < 3; ++channel )
+    {
+        const int start = palette[ 0 ][ channel ];
+        const int end = palette[ 1 ][ channel ];
+        if( color0 > color1 || !allowThreeColor )
+        {
+            palette[ 2 ][ channel ] = ( 2 * start + end ) / 3;
+            palette[ 3 ][ channel ] = ( start + 2 * end ) / 3;
+        }
+        else
+        {
+            palette[ 2 ][ channel ] = ( start + end ) / 2;
+            palette[ 3 ][ channel ] = 0;
+        }
+    }
+}
+
+static unsigned short ReadUint16( const unsigned char* bytes )
+{
+    return static_cast<unsigned short>( bytes[ 0 ] | ( bytes[ 1 ] << 8 ) );
+}
+
+// Always four color mode, returns the squared RGB error of the block
+static int WriteBC1ColorBlock( const Rgba8* texels, unsigned short color0, unsigned short color1, unsigned char* block )
+{
+    if( color0 < color1 )
+    {
+        const unsigned short swap = color0;
+        color0 = color1;
+        color1 = swap;
+    }
+
+    int palette[ 4 ][ 3 ];
+    GetBC1Palette( color0, color1, false, palette );
+
+    unsigned int indexes = 0;
+    int error = 0;
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        // Equal endpoints leave every index at 0, which decodes the same in either mode
+        int bestIndex = 0;
+        int bestError = GetSquaredError( texels[ texelIndex ], palette[ 0 ], 3 );
+        for( int paletteIndex = 1; paletteIndex < 4 && color0 != color1; ++paletteIndex )
+        {
+            const int paletteError = GetSquaredError( texels[ texelIndex ], palette[ paletteIndex ], 3 );
+            if( paletteError < bestError )
+            {
+                bestError = paletteError;
+                bestIndex = paletteIndex;
+            }
+        }
+        indexes |= static_cast<unsigned int>( bestIndex ) << ( texelIndex * 2 );
+        error += bestError;
+    }
+
+    block[ 0 ] = static_cast<unsigned char>( color0 & 0xff );
+    block[ 1 ] = static_cast<unsigned char>( color0 >> 8 );
+    block[ 2 ] = static_cast<unsigned char>( color1 & 0xff );
+    block[ 3 ] = static_cast<unsigned char>( color1 >> 8 );
+    for( int byteIndex = 0; byteIndex < 4; ++byteIndex )
+    {
+        block[ 4 + byteIndex ] = static_cast<unsigned char>( indexes >> ( byteIndex * 8 ) );
+    }
+    return error;
+}
+
+static void EncodeBC1ColorBlock( const Rgba8* texels, unsigned char* block )
+{
+    float start[ 4 ];
+    float end[ 4 ];
+    FitEndpointLine( texels, 3, start, end );
+
+    // Pulled in a sixteenth from each end so the outliers that set the line do not waste its range
+    for( int channel = 0; channel < 3; ++channel )
+    {
+        const float inset = ( end[ channel ] - start[ channel ] ) / 16.f;
+        start[ channel ] += inset;
+        end[ channel ] -= inset;
+    }
+
+    int bestError = WriteBC1ColorBlock( texels, PackRgb565( start ), PackRgb565( end ), block );
+    for( int pass = 0; pass < ENDPOINT_REFINE_PASSES && bestError > 0; ++pass )
+    {
+        float weights[ TEXTURE_BLOCK_TEXEL_COUNT ];
+        for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+        {
+            weights[ texelIndex ] = BC1_INDEX_WEIGHTS[ ( block[ 4 + texelIndex / 4 ] >> ( ( texelIndex % 4 ) * 2 ) ) & 3 ];
+        }
+        if( !SolveEndpoints( texels, weights, 3, start, end ) ) { break; }
+
+        unsigned char refined[ BC1_BLOCK_SIZE ];
+        const int refinedError = WriteBC1ColorBlock( texels, PackRgb565( start ), PackRgb565( end ), refined );
+        if( refinedError >= bestError ) { break; }
+
+        bestError = refinedError;
+        memcpy( block, refined, BC1_BLOCK_SIZE );
+    }
+}
+
+static void EncodeBC3AlphaBlock( const Rgba8* texels, unsigned char* block )
+{
+    int minAlpha = 255;
+    int maxAlpha = 0;
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        minAlpha = texels[ texelIndex ].a < minAlpha ? texels[ texelIndex ].a : minAlpha;
+        maxAlpha = texels[ texelIndex ].a > maxAlpha ? texels[ texelIndex ].a : maxAlpha;
+    }
+
+    // alpha0 > alpha1 picks the eight value mode
+    int palette[ 8 ];
+    palette[ 0 ] = maxAlpha;
+    palette[ 1 ] = minAlpha;
+    for( int step = 1; step < 7; ++step )
+    {
+        palette[ step + 1 ] = ( ( 7 - step ) * maxAlpha + step * minAlpha ) / 7;
+    }
+
+    unsigned long long indexes = 0;
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT && maxAlpha > minAlpha; ++texelIndex )
+    {
+        int bestIndex = 0;
+        int bestError = 256;
+        for( int paletteIndex = 0; paletteIndex < 8; ++paletteIndex )
+        {
+            const int paletteError = abs( texels[ texelIndex ].a - palette[ paletteIndex ] );
+            if( paletteError < bestError )
+            {
+                bestError = paletteError;
+                bestIndex = paletteIndex;
+            }
+        }
+        indexes |= static_cast<unsigned long long>( bestIndex ) << ( texelIndex * 3 );
+    }
+
+    block[ 0 ] = static_cast<unsigned char>( maxAlpha );
+    block[ 1 ] = static_cast<unsigned char>( minAlpha );
+    for( int byteIndex = 0; byteIndex < 6; ++byteIndex )
+    {
+        block[ 2 + byteIndex ] = static_cast<unsigned char>( indexes >> ( byteIndex * 8 ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// 7 bit endpoint plus the p bit that together land closest to the unquantized endpoint
+static void QuantizeBC7Endpoint( const float* endpoint, int* quantized, int& pBit )
+{
+    int bestError = -1;
+    for( int candidateBit = 0; candidateBit < 2; ++candidateBit )
+    {
+        int candidate[ 4 ];
+        int error = 0;
+        for( int channel = 0; channel < 4; ++channel )
+        {
+            candidate[ channel ] = ClampInt( static_cast<int>( ( endpoint[ channel ] - candidateBit ) * .5f + .5f ), 0, 127 );
+            const int delta = ( ( candidate[ channel ] << 1 ) | candidateBit ) - static_cast<int>( endpoint[ channel ] + .5f );
+            error += delta * delta;
+        }
+        if( bestError < 0 || error < bestError )
+        {
+            bestError = error;
+            pBit = candidateBit;
+            memcpy( quantized, candidate, sizeof( candidate ) );
+        }
+    }
+}
+
+static int InterpolateBC7( const int start, const int end, const int weight )
+{
+    return ( ( 64 - weight ) * start + weight * end + 32 ) >> 6;
+}
+
+// Returns the squared RGBA error of the block
+static int WriteBC7Mode6Block( const Rgba8* texels, const float* start, const float* end, unsigned char* block )
+{
+    int quantized[ 2 ][ 4 ];
+    int pBits[ 2 ];
+    QuantizeBC7Endpoint( start, quantized[ 0 ], pBits[ 0 ] );
+    QuantizeBC7Endpoint( end, quantized[ 1 ], pBits[ 1 ] );
+
+    int endpoints[ 2 ][ 4 ];
+    for( int channel = 0; channel < 4; ++channel )
+    {
+        endpoints[ 0 ][ channel ] = ( quantized[ 0 ][ channel ] << 1 ) | pBits[ 0 ];
+        endpoints[ 1 ][ channel ] = ( quantized[ 1 ][ channel ] << 1 ) | pBits[ 1 ];
+    }
+
+    int palette[ 16 ][ 4 ];
+    for( int paletteIndex = 0; paletteIndex < 16; ++paletteIndex )
+    {
+        for( int channel = 0; channel < 4; ++channel )
+        {
+            palette[ paletteIndex ][ channel ] = InterpolateBC7( endpoints[ 0 ][ channel ], endpoints[ 1 ][ channel ],
+                                                                 BC7_INDEX_WEIGHTS[ paletteIndex ] );
+        }
+    }
+
+    int indexes[ TEXTURE_BLOCK_TEXEL_COUNT ];
+    int error = 0;
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        int bestIndex = 0;
+        int bestError = GetSquaredError( texels[ texelIndex ], palette[ 0 ], 4 );
+        for( int paletteIndex = 1; paletteIndex < 16; ++paletteIndex )
+        {
+            const int paletteError = GetSquaredError( texels[ texelIndex ], palette[ paletteIndex ], 4 );
+            if( paletteError < bestError )
+            {
+                bestError = paletteError;
+                bestIndex = paletteIndex;
+            }
+        }
+        indexes[ texelIndex ] = bestIndex;
+        error += bestError;
+    }
+
+    // The first index is stored without its top bit, so it has to be in the lower half
+    if( indexes[ 0 ] >= 8 )
+    {
+        for( int channel = 0; channel < 4; ++channel )
+        {
+            const int swap = quantized[ 0 ][ channel ];
+            quantized[ 0 ][ channel ] = quantized[ 1 ][ channel ];
+            quantized[ 1 ][ channel ] = swap;
+        }
+        const int swapBit = pBits[ 0 ];
+        pBits[ 0 ] = pBits[ 1 ];
+        pBits[ 1 ] = swapBit;
+        for( int& index : indexes )
+        {
+            index = 15 - index;
+        }
+    }
+
+    memset( block, 0, BC7_BLOCK_SIZE );
+    BlockBitWriter writer( block );
+    writer.Write( 1u << 6, 7 );
+    for( int channel = 0; channel < 4; ++channel )
+    {
+        writer.Write( static_cast<unsigned int>( quantized[ 0 ][ channel ] ), 7 );
+        writer.Write( static_cast<unsigned int>( quantized[ 1 ][ channel ] ), 7 );
+    }
+    writer.Write( static_cast<unsigned int>( pBits[ 0 ] ), 1 );
+    writer.Write( static_cast<unsigned int>( pBits[ 1 ] ), 1 );
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        writer.Write( static_cast<unsigned int>( indexes[ texelIndex ] ), texelIndex == 0 ? 3 : 4 );
+    }
+    return error;
+}
+
+//-----------------------------------------------------------------------------
+void EncodeBC1Block( const Rgba8* texels, unsigned char* block )
+{
+    EncodeBC1ColorBlock( texels, block );
+}
+
+void EncodeBC3Block( const Rgba8* texels, unsigned char* block )
+{
+    EncodeBC3AlphaBlock( texels, block );
+    EncodeBC1ColorBlock( texels, block + 8 );
+}
+
+void EncodeBC7Block( const Rgba8* texels, unsigned char* block )
+{
+    float start[ 4 ];
+    float end[ 4 ];
+    FitEndpointLine( texels, 4, start, end );
+
+    int bestError = WriteBC7Mode6Block( texels, start, end, block );
+    for( int pass = 0; pass < ENDPOINT_REFINE_PASSES && bestError > 0; ++pass )
+    {
+        // The weights come back out of the block, which may have swapped its endpoints. Skips the
+        //  mode, the eight 7 bit endpoint channels and both p bits
+        BlockBitReader reader( block );
+        reader.Read( 7 );
+        reader.Read( 28 );
+        reader.Read( 28 );
+        reader.Read( 2 );
+
+        float weights[ TEXTURE_BLOCK_TEXEL_COUNT ];
+        for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+        {
+            weights[ texelIndex ] = static_cast<float>( BC7_INDEX_WEIGHTS[ reader.Read( texelIndex == 0 ? 3 : 4 ) ] ) / 64.f;
+        }
+        if( !SolveEndpoints( texels, weights, 4, start, end ) ) { break; }
+
+        unsigned char refined[ BC7_BLOCK_SIZE ];
+        const int refinedError = WriteBC7Mode6Block( texels, start, end, refined );
+        if( refinedError >= bestError ) { break; }
+
+        bestError = refinedError;
+        memcpy( block, refined, BC7_BLOCK_SIZE );
+    }
+}
+
+void DecodeBC1Block( const unsigned char* block, Rgba8* texels )
+{
+    const unsigned short color0 = ReadUint16( block );
+    const unsigned short color1 = ReadUint16( block + 2 );
+    int palette[ 4 ][ 3 ];
+    GetBC1Palette( color0, color1, true, palette );
+
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        const int index = ( block[ 4 + texelIndex / 4 ] >> ( ( texelIndex % 4 ) * 2 ) ) & 3;
+        const bool isTransparent = color0 <= color1 && index == 3;
+        texels[ texelIndex ] = Rgba8( static_cast<unsigned char>( palette[ index ][ 0 ] ),
+                                      static_cast<unsigned char>( palette[ index ][ 1 ] ),
+                                      static_cast<unsigned char>( palette[ index ][ 2 ] ),
+                                      isTransparent ? 0 : 255 );
+    }
+}
+
+void DecodeBC3Block( const unsigned char* block, Rgba8* texels )
+{
+    const int alpha0 = block[ 0 ];
+    const int alpha1 = block[ 1 ];
+    int alphaPalette[ 8 ] = { alpha0, alpha1 };
+    if( alpha0 > alpha1 )
+    {
+        for( int step = 1; step < 7; ++step )
+        {
+            alphaPalette[ step + 1 ] = ( ( 7 - step ) * alpha0 + step * alpha1 ) / 7;
+        }
+    }
+    else
+    {
+        for( int step = 1; step < 5; ++step )
+        {
+            alphaPalette[ step + 1 ] = ( ( 5 - step ) * alpha0 + step * alpha1 ) / 5;
+        }
+        alphaPalette[ 6 ] = 0;
+        alphaPalette[ 7 ] = 255;
+    }
+
+    unsigned long long alphaIndexes = 0;
+    for( int byteIndex = 0; byteIndex < 6; ++byteIndex )
+    {
+        alphaIndexes |= static_cast<unsigned long long>( block[ 2 + byteIndex ] ) << ( byteIndex * 8 );
+    }
+
+    int palette[ 4 ][ 3 ];
+    GetBC1Palette( ReadUint16( block + 8 ), ReadUint16( block + 10 ), false, palette );
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        const int index = ( block[ 12 + texelIndex / 4 ] >> ( ( texelIndex % 4 ) * 2 ) ) & 3;
+        const int alphaIndex = static_cast<int>( ( alphaIndexes >> ( texelIndex * 3 ) ) & 7 );
+        texels[ texelIndex ] = Rgba8( static_cast<unsigned char>( palette[ index ][ 0 ] ),
+                                      static_cast<unsigned char>( palette[ index ][ 1 ] ),
+                                      static_cast<unsigned char>( palette[ index ][ 2 ] ),
+                                      static_cast<unsigned char>( alphaPalette[ alphaIndex ] ) );
+    }
+}
+
+bool DecodeBC7Block( const unsigned char* block, Rgba8* texels )
+{
+    BlockBitReader reader( block );
+    if( reader.Read( 7 ) != ( 1u << 6 ) )
+    {
+        for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+        {
+            texels[ texelIndex ] = Rgba8( 255, 0, 255, 255 );
+        }
+        return false;
+    }
+
+    int endpoints[ 2 ][ 4 ];
+    for( int channel = 0; channel < 4; ++channel )
+    {
+        endpoints[ 0 ][ channel ] = static_cast<int>( reader.Read( 7 ) ) << 1;
+        endpoints[ 1 ][ channel ] = static_cast<int>( reader.Read( 7 ) ) << 1;
+    }
+    const int pBit0 = static_cast<int>( reader.Read( 1 ) );
+    const int pBit1 = static_cast<int>( reader.Read( 1 ) );
+    for( int channel = 0; channel < 4; ++channel )
+    {
+        endpoints[ 0 ][ channel ] |= pBit0;
+        endpoints[ 1 ][ channel ] |= pBit1;
+    }
+
+    for( int texelIndex = 0; texelIndex < TEXTURE_BLOCK_TEXEL_COUNT; ++texelIndex )
+    {
+        const int weight = BC7_INDEX_WEIGHTS[ reader.Read( texelIndex == 0 ? 3 : 4 ) ];
+        texels[ texelIndex ] = Rgba8( static_cast<unsigned char>( InterpolateBC7( endpoints[ 0 ][ 0 ], endpoints[ 1 ][ 0 ], weight ) ),
+                                      static_cast<unsigned char>( InterpolateBC7( endpoints[ 0 ][ 1 ], endpoints[ 1 ][ 1 ], weight ) ),
+                                      static_cast<unsigned char>( InterpolateBC7( endpoints[ 0 ][ 2 ], endpoints[ 1 ][ 2 ], weight ) ),
+                                      static_cast<unsigned char>( InterpolateBC7( endpoints[ 0 ][ 3 ], endpoints[ 1 ][ 3 ], weight ) ) );
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+// Block compression for textures, pure CPU so it runs on workers and off Windows. Every block is
+//  4x4 texels given as 16 Rgba8 in row order, the first row being the first row in memory
+
+constexpr int TEXTURE_BLOCK_DIMENSION = 4;
+constexpr int TEXTURE_BLOCK_TEXEL_COUNT = TEXTURE_BLOCK_DIMENSION * TEXTURE_BLOCK_DIMENSION;
+constexpr size_t BC1_BLOCK_SIZE = 8;
+constexpr size_t BC3_BLOCK_SIZE = 16;
+constexpr size_t BC7_BLOCK_SIZE = 16;
+
+// Opaque color, alpha is ignored
+void EncodeBC1Block( const Rgba8* texels, unsigned char* block );
+// BC1 color with a separate interpolated alpha block
+void EncodeBC3Block( const Rgba8* texels, unsigned char* block );
+// Mode 6 only, one RGBA line with 4 bit indices. Good for most color and alpha, weaker than a
+//  full mode search on blocks with several distinct colors
+void EncodeBC7Block( const Rgba8* texels, unsigned char* block );
+
+void DecodeBC1Block( const unsigned char* block, Rgba8* texels );
+void DecodeBC3Block( const unsigned char* block, Rgba8* texels );
+// Only mode 6, the one EncodeBC7Block writes. Other modes decode to magenta and return false
+bool DecodeBC7Block( const unsigned char* block, Rgba8* texels );
@@ -3,7 +3,7 @@
 
 #include "Engine/Core/Engine.hpp"
 #include "Engine/Core/Rgba8.hpp"
-#include "Engine/Core/VertexTypes/VertexMaster.hpp"
+#include "Engine/Core/VertexTypes/Vertex_PCU.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Mesh/MeshUtils.hpp"
@@ -124,7 +124,7 @@ void UIButton::Update()
 
 void UIButton::DefaultRender( RenderContext& context )
 {
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
 
     AppendAABB2( visual, m_ScreenBoundingBox, Rgba8::GRAY );
     context.BindTexture( nullptr );
@@ -118,7 +118,7 @@ void UIElement::DebugRender( RenderContext& context )
 {
     if( m_Visibility == Visibility::HIDDEN ) { return; }
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendAABB2Perimeter( visual, m_ScreenBoundingBox, Rgba8::CYAN, 5.f );
 
     AppendCross( visual, m_ScreenBoundingBox.GetPointAtUV( m_Pivot ), 5.f, 2.5f, Rgba8::MAGENTA );
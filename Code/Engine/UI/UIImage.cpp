@@ -125,7 +125,7 @@ void UIImage::DefaultRender( RenderContext& context )
     AABB2 plane, uvs;
     GetImageDisplayedBounds( plane, uvs );
 
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
     AppendAABB2( visual, plane, Rgba8::WHITE, uvs.mins, uvs.maxs );
 
     const Texture* textureToBind = m_Texture != nullptr ? m_Texture : &m_Sprite->GetTexture();
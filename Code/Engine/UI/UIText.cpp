@@ -62,11 +62,11 @@ void UIText::PreUpdate()
 
 void UIText::DefaultRender( RenderContext& context )
 {
-    std::vector<VertexMaster> visual;
+    std::vector<Vertex_PCU> visual;
 
     if( m_FontStyle.fontBackground.a != 0 )
     {
-        std::vector<VertexMaster> background;
+        std::vector<Vertex_PCU> background;
         AppendAABB2( background, m_ScreenBoundingBox, m_FontStyle.fontBackground );
         context.BindTexture( nullptr );
         context.DrawVertexArray( background );